@@ -0,0 +1,240 @@
+/* Parallel versions of the selection algorithms in selection.hpp;
+ *  - find k-smallest value (counting from 0) in an array, with a random pivot or the median-of-medians
+ *
+ * Like quick_select and deterministic_select, these leave [first, last) untouched, and throw std::out_of_range
+ * if the range is empty or k is not within it.
+ * Each round counts, per thread, the items less than and equal to the pivot in that thread's chunk,
+ * picks L, E or G as in the general guidelines (see selection.hpp), and has every thread copy its chunk's share
+ * of the chosen subsequence into a common buffer at offsets given by prefix sums of the counts.
+ * Rounds continue until fewer than _PARALLEL_SELECT_MINIMUM items remain, which the sequential algorithm
+ * (select_nth or deterministic_select_nth) finishes in place in that buffer.
+ *
+ * Every algorithm takes either a thread count (0 meaning all of TaskPool::shared()'s workers),
+ * or a TaskPool to run on (using all of its workers).
+ */
+#ifndef ALGORITHMS_PARALLEL_SELECTION_HPP
+#define ALGORITHMS_PARALLEL_SELECTION_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "selection.hpp"
+#include "../tools/task_pool.hpp"
+
+
+namespace
+{
+    int _PARALLEL_SELECT_MINIMUM = 1 << 15;
+
+    /* Runs one round of parallel selection over [first, first + size) with the given pivot.
+     * Returns true if the k-th smallest item equals the pivot;
+     * otherwise, copies the subsequence that contains it into chosen, and adjusts k to index into it.
+     */
+    template <typename RandomAccessIterator, typename Value>
+    bool parallel_select_round(RandomAccessIterator first, int size, int& k, const Value& pivot, std::vector<Value>& chosen,
+                               TaskPool& pool, int threads)
+    {
+        std::vector<int> less(threads);
+        std::vector<int> equal(threads);
+        pool.parallel_for(threads, [&](int c) {
+            int chunk_less = 0;
+            int chunk_equal = 0;
+            for (int i = static_cast<long long>(size) * c / threads, end = static_cast<long long>(size) * (c + 1) / threads; i < end; ++i)
+            {
+                if (first[i] < pivot)
+                {
+                    ++chunk_less;
+                }
+                else if (!(pivot < first[i]))
+                {
+                    ++chunk_equal;
+                }
+            }
+            less[c] = chunk_less;
+            equal[c] = chunk_equal;
+        });
+
+        int total_less = 0;
+        int total_equal = 0;
+        for (int c = 0; c < threads; ++c)
+        {
+            total_less += less[c];
+            total_equal += equal[c];
+        }
+
+        bool keep_less = k < total_less;
+        if (!keep_less && k < total_less + total_equal)
+        {
+            return true;
+        }
+        else if (!keep_less)
+        {
+            k -= total_less + total_equal;
+        }
+
+        // offsets[c] is where chunk c starts writing its share of the chosen subsequence
+        std::vector<int> offsets(threads + 1, 0);
+        for (int c = 0; c < threads; ++c)
+        {
+            int chunk_size = static_cast<long long>(size) * (c + 1) / threads - static_cast<long long>(size) * c / threads;
+            offsets[c + 1] = offsets[c] + (keep_less ? less[c] : chunk_size - less[c] - equal[c]);
+        }
+        chosen.resize(offsets[threads]);
+        pool.parallel_for(threads, [&](int c) {
+            int next = offsets[c];
+            for (int i = static_cast<long long>(size) * c / threads, end = static_cast<long long>(size) * (c + 1) / threads; i < end; ++i)
+            {
+                if (keep_less ? first[i] < pivot : pivot < first[i])
+                {
+                    chosen[next++] = first[i];
+                }
+            }
+        });
+        return false;
+    }
+
+    /* Shared body of the parallel selection algorithms.
+     * choose_pivot(first, size) returns the pivot for a round over [first, first + size),
+     * and select(first, nth, last) is the sequential, in-place algorithm that finishes the search.
+     */
+    template <typename RandomAccessIterator, typename PivotFunction, typename SelectFunction>
+    typename std::iterator_traits<RandomAccessIterator>::value_type
+    parallel_select(RandomAccessIterator first, RandomAccessIterator last, int k, TaskPool& pool, int threads,
+                    PivotFunction choose_pivot, SelectFunction select)
+    {
+        using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+        bound_check(first, last);
+        int size = last - first;
+        if (k < 0 || k >= size)
+        {
+            throw std::out_of_range{"k is out of range"};
+        }
+        if (threads <= 0)
+        {
+            threads = pool.threads();
+        }
+
+        // the first round reads the caller's range; later rounds alternate between two buffers
+        std::vector<Value> current;
+        std::vector<Value> next;
+        if (threads <= 1 || size < _PARALLEL_SELECT_MINIMUM)
+        {
+            current.assign(first, last);
+        }
+        else
+        {
+            Value pivot = choose_pivot(first, size);
+            if (parallel_select_round(first, size, k, pivot, current, pool, threads))
+            {
+                return pivot;
+            }
+            while (static_cast<int>(current.size()) >= _PARALLEL_SELECT_MINIMUM)
+            {
+                pivot = choose_pivot(current.begin(), current.size());
+                if (parallel_select_round(current.begin(), current.size(), k, pivot, next, pool, threads))
+                {
+                    return pivot;
+                }
+                current.swap(next);
+            }
+        }
+        select(current.begin(), current.begin() + k, current.end());
+        return std::move(current[k]);
+    }
+}
+
+
+/* Parallel quick select.
+ * Each round's pivot is the median of three randomly-chosen items.
+ *
+ * O(n/p + log n) expected time on p threads (each round filters out a constant fraction on average).
+ * O(n) extra space.
+ */
+template <typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+parallel_quick_select(RandomAccessIterator first, RandomAccessIterator last, int k, TaskPool& pool, int threads)
+{
+    using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    std::random_device rd;
+    std::mt19937 engine{rd()};
+    auto choose_pivot = [&engine](auto from, int size) {
+        std::uniform_int_distribution<int> uid{0, size - 1};
+        Value samples[] = {from[uid(engine)], from[uid(engine)], from[uid(engine)]};
+        sort_three(samples, samples + 1, samples + 2, std::less<Value>{});
+        return samples[1];
+    };
+    auto select = [](auto from, auto nth, auto to) { select_nth(from, nth, to); };
+    return parallel_select(first, last, k, pool, threads, choose_pivot, select);
+}
+
+template <typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+parallel_quick_select(RandomAccessIterator first, RandomAccessIterator last, int k, TaskPool& pool)
+{
+    return parallel_quick_select(first, last, k, pool, pool.threads());
+}
+
+template <typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+parallel_quick_select(RandomAccessIterator first, RandomAccessIterator last, int k, int threads = 0)
+{
+    return parallel_quick_select(first, last, k, TaskPool::shared(), threads);
+}
+
+
+/* Parallel deterministic select.
+ * Each round's pivot is the median-of-medians: the threads find the medians of their chunks' groups of 5 concurrently,
+ * and the median of those is selected (in parallel too, while there are enough of them).
+ * This guarantees each round discards at least 3/10 of the items.
+ *
+ * O(n/p + log n) time on p threads.
+ * O(n) extra space.
+ */
+template <typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+parallel_deterministic_select(RandomAccessIterator first, RandomAccessIterator last, int k, TaskPool& pool, int threads)
+{
+    using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    if (threads <= 0)
+    {
+        threads = pool.threads();
+    }
+    auto choose_pivot = [&pool, threads](auto from, int size) {
+        int groups = (size + 4) / 5;
+        std::vector<Value> medians(groups);
+        pool.parallel_for(threads, [&](int c) {
+            for (int g = static_cast<long long>(groups) * c / threads, end = static_cast<long long>(groups) * (c + 1) / threads; g < end; ++g)
+            {
+                Value group[5];
+                int group_size = std::min(5, size - 5 * g);
+                std::copy(from + 5 * g, from + 5 * g + group_size, group);
+                insertion_sort(group, group + group_size);
+                medians[g] = std::move(group[group_size / 2]);
+            }
+        });
+        return parallel_deterministic_select(medians.begin(), medians.end(), groups / 2, pool, threads);
+    };
+    auto select = [](auto from, auto nth, auto to) { deterministic_select_nth(from, nth, to); };
+    return parallel_select(first, last, k, pool, threads, choose_pivot, select);
+}
+
+template <typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+parallel_deterministic_select(RandomAccessIterator first, RandomAccessIterator last, int k, TaskPool& pool)
+{
+    return parallel_deterministic_select(first, last, k, pool, pool.threads());
+}
+
+template <typename RandomAccessIterator>
+typename std::iterator_traits<RandomAccessIterator>::value_type
+parallel_deterministic_select(RandomAccessIterator first, RandomAccessIterator last, int k, int threads = 0)
+{
+    return parallel_deterministic_select(first, last, k, TaskPool::shared(), threads);
+}
+
+#endif // ALGORITHMS_PARALLEL_SELECTION_HPP
@@ -0,0 +1,316 @@
+/* Templated header file defining parallel versions of the comparison-based sorts in sorting.hpp.
+ *
+ * Every algorithm takes either a thread count (0 meaning all of TaskPool::shared()'s workers),
+ * or a TaskPool to run on (using all of its workers).
+ * Ranges smaller than _PARALLEL_SORT_MINIMUM items, or a single thread, fall back to the sequential quick_sort.
+ * The value type must be default-constructible, as both sorts move the items through a scratch buffer of n items.
+ *
+ *   - parallel_merge_sort quick-sorts one chunk per thread, then merges pairs of sorted runs until one is left;
+ *     each merge is itself split into pieces at co-ranked positions, so the last rounds use every thread too.
+ *     Stable merging, but the chunk sorts are not, so the whole sort is unstable.
+ *   - parallel_sample_sort picks splitters from a sorted sample, scatters the items into one bucket per splitter interval
+ *     (counting into each chunk's slice of every bucket first, so no locking is needed), then sorts the buckets in parallel.
+ *     One pass of data movement instead of log(threads) merge rounds, but its balance depends on the sample.
+ *
+ * Unstable.
+ */
+#ifndef _ALGORITHMS_PARALLEL_SORTING_HPP
+#define _ALGORITHMS_PARALLEL_SORTING_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+#include "sorting.hpp"
+#include "../tools/task_pool.hpp"
+
+
+namespace
+{
+    int _PARALLEL_SORT_MINIMUM = 1 << 15;
+    int _SAMPLE_SORT_BUCKETS_PER_THREAD = 4;    // more buckets than threads evens out the load when a bucket runs large
+    int _SAMPLE_SORT_OVERSAMPLING = 32;         // sampled items per bucket
+}
+
+
+// ================================================
+// HELPER FUNCTIONS
+// ================================================
+/* Helper function for parallel_merge_sort;
+ * Returns how many of the first d items of the (stable) merge of [a, a + a_size) and [b, b + b_size) come from a.
+ * O(log n).
+ */
+template <typename RandomAccessIterator, typename Compare>
+std::ptrdiff_t merge_co_rank(std::ptrdiff_t d, RandomAccessIterator a, std::ptrdiff_t a_size,
+                             RandomAccessIterator b, std::ptrdiff_t b_size, Compare less)
+{
+    std::ptrdiff_t low = std::max<std::ptrdiff_t>(0, d - b_size);
+    std::ptrdiff_t high = std::min(d, a_size);
+    while (low < high)
+    {
+        std::ptrdiff_t i = low + (high - low) / 2;
+        std::ptrdiff_t j = d - i;
+        if (j > 0 && i < a_size && !less(b[j - 1], a[i]))
+        {
+            low = i + 1;    // a[i] precedes b[j - 1] in the merge, so more than i items come from a
+        }
+        else
+        {
+            high = i;
+        }
+    }
+    return low;
+}
+
+/* Helper function for parallel_merge_sort;
+ * Merges the sorted runs [source + bounds[r], source + bounds[r + 1]) pairwise into destination, at the same offsets;
+ * a trailing unpaired run is moved over as it is. Replaces bounds with the boundaries of the merged runs.
+ */
+template <typename RandomAccessIterator, typename OutputIterator, typename Compare>
+void merge_round(RandomAccessIterator source, OutputIterator destination, std::vector<std::ptrdiff_t>& bounds,
+                 Compare less, TaskPool& pool, int threads)
+{
+    struct Piece
+    {
+        std::ptrdiff_t left, middle, right;     // the two runs being merged
+        std::ptrdiff_t from, to;                // the slice of their merge (as offsets into it) that this piece produces
+    };
+
+    std::ptrdiff_t total = bounds.back() - bounds.front();
+    std::vector<Piece> pieces;
+    std::vector<std::ptrdiff_t> merged_bounds{bounds.front()};
+    for (std::size_t r = 0; r + 1 < bounds.size(); r += 2)
+    {
+        std::ptrdiff_t left = bounds[r];
+        std::ptrdiff_t middle = bounds[r + 1];
+        std::ptrdiff_t right = r + 2 < bounds.size() ? bounds[r + 2] : middle;
+        std::ptrdiff_t length = right - left;
+
+        // each pair gets a share of the threads proportional to its length
+        std::ptrdiff_t parts = std::max<std::ptrdiff_t>(1, (length * threads + total - 1) / total);
+        for (std::ptrdiff_t p = 0; p < parts; ++p)
+        {
+            pieces.push_back(Piece{left, middle, right, length * p / parts, length * (p + 1) / parts});
+        }
+        merged_bounds.push_back(right);
+    }
+
+    // every piece is co-ranked before any is merged, so that no search reads an item another piece has moved out
+    std::vector<std::ptrdiff_t> a_from(pieces.size());
+    std::vector<std::ptrdiff_t> a_to(pieces.size());
+    pool.parallel_for(pieces.size(), [&](int p) {
+        const Piece& piece = pieces[p];
+        RandomAccessIterator a = source + piece.left;
+        RandomAccessIterator b = source + piece.middle;
+        a_from[p] = merge_co_rank(piece.from, a, piece.middle - piece.left, b, piece.right - piece.middle, less);
+        a_to[p] = merge_co_rank(piece.to, a, piece.middle - piece.left, b, piece.right - piece.middle, less);
+    });
+    pool.parallel_for(pieces.size(), [&](int p) {
+        const Piece& piece = pieces[p];
+        RandomAccessIterator a = source + piece.left;
+        RandomAccessIterator b = source + piece.middle;
+        std::merge(std::make_move_iterator(a + a_from[p]), std::make_move_iterator(a + a_to[p]),
+                   std::make_move_iterator(b + (piece.from - a_from[p])), std::make_move_iterator(b + (piece.to - a_to[p])),
+                   destination + piece.left + piece.from, less);
+    });
+    bounds = std::move(merged_bounds);
+}
+
+/* Helper function for the parallel sorts;
+ * Returns the number of threads to use, or 1 if [first, last) should be sorted sequentially.
+ */
+template <typename RandomAccessIterator>
+int sort_threads(RandomAccessIterator first, RandomAccessIterator last, TaskPool& pool, int threads)
+{
+    if (threads <= 0)
+    {
+        threads = pool.threads();
+    }
+    return last - first < _PARALLEL_SORT_MINIMUM ? 1 : threads;
+}
+
+// ================================================
+// END HELPER FUNCTIONS
+// ================================================
+
+
+
+/* Parallel merge sort.
+ * Splits [first, last) into one chunk per thread and quick-sorts the chunks concurrently,
+ * then merges pairs of sorted runs, in log(threads) rounds that ping-pong between [first, last) and a scratch buffer.
+ * Every merge is split into as many pieces as its share of the threads:
+ * the co-ranking binary search finds where each piece's slice of the output starts in either run.
+ *
+ * O((n/p) log n + n log(p) / p) time on p threads.
+ * Θ(n) extra space.
+ * Unstable.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less, TaskPool& pool, int threads)
+{
+    threads = sort_threads(first, last, pool, threads);
+    if (threads <= 1)
+    {
+        quick_sort(first, last, less);
+        return;
+    }
+
+    std::ptrdiff_t size = last - first;
+    std::vector<std::ptrdiff_t> bounds;
+    for (int c = 0; c <= threads; ++c)
+    {
+        bounds.push_back(size * c / threads);
+    }
+    pool.parallel_for(threads, [&](int c) {
+        quick_sort(first + bounds[c], first + bounds[c + 1], less);
+    });
+
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+    std::vector<T> buffer(size);
+    bool in_buffer = false;
+    while (bounds.size() > 2)
+    {
+        if (in_buffer)
+        {
+            merge_round(buffer.begin(), first, bounds, less, pool, threads);
+        }
+        else
+        {
+            merge_round(first, buffer.begin(), bounds, less, pool, threads);
+        }
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+    {
+        pool.parallel_for(threads, [&](int c) {
+            std::ptrdiff_t from = size * c / threads;
+            std::ptrdiff_t to = size * (c + 1) / threads;
+            std::move(buffer.begin() + from, buffer.begin() + to, first + from);
+        });
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less, TaskPool& pool)
+{
+    parallel_merge_sort(first, last, less, pool, pool.threads());
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less, int threads = 0)
+{
+    parallel_merge_sort(first, last, less, TaskPool::shared(), threads);
+}
+
+template <typename RandomAccessIterator>
+void parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last, int threads = 0)
+{
+    parallel_merge_sort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{}, threads);
+}
+
+
+/* Parallel sample sort.
+ * Sorts an oversampled set of items, and takes every _SAMPLE_SORT_OVERSAMPLING-th one as a splitter,
+ * so that bucket b receives the items between splitters b - 1 and b.
+ * Each thread counts how many items of its chunk fall into each bucket; prefix sums over (bucket, chunk)
+ * then give every chunk a private slice of every bucket in the scratch buffer, into which it scatters its items.
+ * Finally, the buckets are quick-sorted concurrently and moved back into [first, last).
+ *
+ * O((n/p) log n) expected time on p threads, for a representative sample.
+ * Θ(n) extra space.
+ * Unstable.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void parallel_sample_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less, TaskPool& pool, int threads)
+{
+    threads = sort_threads(first, last, pool, threads);
+    if (threads <= 1)
+    {
+        quick_sort(first, last, less);
+        return;
+    }
+
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+    std::ptrdiff_t size = last - first;
+    int buckets = threads * _SAMPLE_SORT_BUCKETS_PER_THREAD;
+
+    // 1. choose buckets - 1 splitters from a sorted random sample
+    std::mt19937 engine{static_cast<unsigned int>(size)};
+    std::uniform_int_distribution<std::ptrdiff_t> position{0, size - 1};
+    std::vector<T> sample(buckets * _SAMPLE_SORT_OVERSAMPLING);
+    for (T& item : sample)
+    {
+        item = first[position(engine)];
+    }
+    quick_sort(sample.begin(), sample.end(), less);
+    std::vector<T> splitters;
+    for (int b = 1; b < buckets; ++b)
+    {
+        splitters.push_back(sample[b * _SAMPLE_SORT_OVERSAMPLING]);
+    }
+    auto bucket_of = [&](const T& item) {
+        return std::upper_bound(splitters.begin(), splitters.end(), item, less) - splitters.begin();
+    };
+
+    // 2. count each chunk's items per bucket
+    std::vector<std::vector<std::ptrdiff_t>> counts(threads, std::vector<std::ptrdiff_t>(buckets, 0));
+    pool.parallel_for(threads, [&](int c) {
+        for (std::ptrdiff_t i = size * c / threads, end = size * (c + 1) / threads; i < end; ++i)
+        {
+            ++counts[c][bucket_of(first[i])];
+        }
+    });
+
+    // 3. turn the counts into each chunk's starting offset within each bucket, bucket by bucket
+    std::vector<std::ptrdiff_t> bucket_bounds{0};
+    std::ptrdiff_t offset = 0;
+    for (int b = 0; b < buckets; ++b)
+    {
+        for (int c = 0; c < threads; ++c)
+        {
+            std::ptrdiff_t count = counts[c][b];
+            counts[c][b] = offset;
+            offset += count;
+        }
+        bucket_bounds.push_back(offset);
+    }
+
+    // 4. scatter, then sort each bucket and move it back
+    std::vector<T> buffer(size);
+    pool.parallel_for(threads, [&](int c) {
+        std::vector<std::ptrdiff_t>& next = counts[c];
+        for (std::ptrdiff_t i = size * c / threads, end = size * (c + 1) / threads; i < end; ++i)
+        {
+            buffer[next[bucket_of(first[i])]++] = std::move(first[i]);
+        }
+    });
+    pool.parallel_for(buckets, [&](int b) {
+        auto from = buffer.begin() + bucket_bounds[b];
+        auto to = buffer.begin() + bucket_bounds[b + 1];
+        quick_sort(from, to, less);
+        std::move(from, to, first + bucket_bounds[b]);
+    });
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void parallel_sample_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less, TaskPool& pool)
+{
+    parallel_sample_sort(first, last, less, pool, pool.threads());
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void parallel_sample_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less, int threads = 0)
+{
+    parallel_sample_sort(first, last, less, TaskPool::shared(), threads);
+}
+
+template <typename RandomAccessIterator>
+void parallel_sample_sort(RandomAccessIterator first, RandomAccessIterator last, int threads = 0)
+{
+    parallel_sample_sort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{}, threads);
+}
+
+#endif // _ALGORITHMS_PARALLEL_SORTING_HPP
@@ -0,0 +1,311 @@
+/* Vectorized kernels for the reductions in selection.hpp;
+ *  - minimum and/or maximum, the position of the first minimum or maximum, and the two largest values
+ * over contiguous arrays of int or float.
+ *
+ * Each kernel is written once, with the GCC/Clang vector extensions, and instantiated for every instruction set:
+ *   - x86: AVX2 (32-byte vectors) or SSE4.1 (16-byte vectors), chosen at run time by what the CPU supports,
+ *     and SSE2 (16-byte vectors, part of x86-64 itself) otherwise;
+ *   - ARM: NEON (16-byte vectors, part of AArch64 itself);
+ *   - anything else: 16-byte vectors, which the compiler lowers to whatever the target offers.
+ * The run time-dispatched instantiations are compiled for their instruction set by wrappers with a target attribute
+ * that the kernels are inlined into, so no -m flags are needed to build.
+ * Other compilers have no vector extensions; ALGORITHMS_HAS_REDUCTION_KERNELS is left undefined,
+ * and run_reduction_kernel always declines, leaving the callers to their generic paths.
+ *
+ * Kernels take (data, size) with size at least 1 (2 for TopTwoKernel), and size no larger than INT_MAX.
+ * Results are unspecified if the array contains NaN.
+ */
+#ifndef ALGORITHMS_REDUCTION_KERNELS_HPP
+#define ALGORITHMS_REDUCTION_KERNELS_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ALGORITHMS_HAS_REDUCTION_KERNELS
+#endif
+
+
+namespace
+{
+    /* True if Iterator points into a contiguous array of int or float:
+     * a pointer, or an iterator of a std::vector (std::array's iterators are pointers).
+     */
+    template <typename Iterator>
+    struct is_reducible_range
+    {
+        using Value = typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type;
+        static const bool value = (std::is_same<Value, int>::value || std::is_same<Value, float>::value)
+                                  && (std::is_pointer<Iterator>::value
+                                      || std::is_same<Iterator, typename std::vector<Value>::iterator>::value
+                                      || std::is_same<Iterator, typename std::vector<Value>::const_iterator>::value);
+    };
+
+#ifdef ALGORITHMS_HAS_REDUCTION_KERNELS
+#define ALGORITHMS_KERNEL_INLINE __attribute__((always_inline)) inline
+
+    template <typename T, int Bytes>
+    struct VectorOf
+    {
+        typedef T type __attribute__((vector_size(Bytes)));
+    };
+
+    // vectors wider than the default target's registers are passed by reference, which keeps their ABI out of it
+    template <typename Vector, typename T>
+    ALGORITHMS_KERNEL_INLINE void load_vector(Vector& into, const T* data)
+    {
+        std::memcpy(&into, data, sizeof(into));
+    }
+
+    /* Computes the minimum (if Minimum) and maximum (if Maximum) of the array; returns them as (minimum, maximum) */
+    template <bool Minimum, bool Maximum>
+    struct MinMaxKernel
+    {
+        template <typename Vector, typename T>
+        static ALGORITHMS_KERNEL_INLINE std::pair<T, T> run(const T* data, std::size_t size)
+        {
+            const std::size_t lanes = sizeof(Vector) / sizeof(T);
+            T low = data[0];
+            T high = data[0];
+            std::size_t i = 0;
+            if (size >= lanes)
+            {
+                Vector lows;
+                load_vector(lows, data);
+                Vector highs = lows;
+                for (i = lanes; i + lanes <= size; i += lanes)
+                {
+                    Vector items;
+                    load_vector(items, data + i);
+                    if (Minimum)
+                    {
+                        lows = items < lows ? items : lows;
+                    }
+                    if (Maximum)
+                    {
+                        highs = items > highs ? items : highs;
+                    }
+                }
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                {
+                    low = lows[lane] < low ? lows[lane] : low;
+                    high = highs[lane] > high ? highs[lane] : high;
+                }
+            }
+            for (; i < size; ++i)
+            {
+                low = data[i] < low ? data[i] : low;
+                high = data[i] > high ? data[i] : high;
+            }
+            return std::make_pair(low, high);
+        }
+    };
+
+    /* Computes the index of the first maximum (if Maximum) or minimum (otherwise) of the array.
+     * Every lane tracks the best item it has seen and where, replacing it only with strictly better items.
+     */
+    template <bool Maximum>
+    struct ArgExtremumKernel
+    {
+        template <typename Vector, typename T>
+        static ALGORITHMS_KERNEL_INLINE std::size_t run(const T* data, std::size_t size)
+        {
+            using Indices = typename VectorOf<std::int32_t, sizeof(Vector)>::type;
+            const std::size_t lanes = sizeof(Vector) / sizeof(T);
+            std::size_t best = 0;
+            std::size_t i = 1;
+            if (size >= 2 * lanes)
+            {
+                Vector bests;
+                load_vector(bests, data);
+                Indices where;
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                {
+                    where[lane] = lane;
+                }
+                Indices positions = where;
+                for (i = lanes; i + lanes <= size; i += lanes)
+                {
+                    positions += static_cast<std::int32_t>(lanes);
+                    Vector items;
+                    load_vector(items, data + i);
+                    auto better = Maximum ? items > bests : items < bests;
+                    bests = better ? items : bests;
+                    where = better ? positions : where;
+                }
+
+                best = where[0];
+                for (std::size_t lane = 1; lane < lanes; ++lane)
+                {
+                    std::size_t candidate = where[lane];
+                    bool better = Maximum ? data[candidate] > data[best] : data[candidate] < data[best];
+                    if (better || (!(Maximum ? data[best] > data[candidate] : data[best] < data[candidate]) && candidate < best))
+                    {
+                        best = candidate;
+                    }
+                }
+            }
+            for (; i < size; ++i)
+            {
+                if (Maximum ? data[i] > data[best] : data[i] < data[best])
+                {
+                    best = i;
+                }
+            }
+            return best;
+        }
+    };
+
+    /* Computes the two largest items of the array (counting duplicates); returns them as (largest, second largest).
+     * Every lane tracks the two largest items it has seen; the answer is among those of all lanes.
+     */
+    struct TopTwoKernel
+    {
+        template <typename Vector, typename T>
+        static ALGORITHMS_KERNEL_INLINE std::pair<T, T> run(const T* data, std::size_t size)
+        {
+            const std::size_t lanes = sizeof(Vector) / sizeof(T);
+            T first = data[0] > data[1] ? data[0] : data[1];
+            T second = data[0] > data[1] ? data[1] : data[0];
+            std::size_t i = 2;
+            auto offer = [&first, &second](T item) {
+                if (item > first)
+                {
+                    second = first;
+                    first = item;
+                }
+                else if (item > second)
+                {
+                    second = item;
+                }
+            };
+
+            if (size >= 2 * lanes)
+            {
+                // a lane's second starts at the lowest value, which can never displace an item from the answer
+                Vector firsts;
+                load_vector(firsts, data);
+                Vector seconds = firsts;
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                {
+                    seconds[lane] = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+                }
+                for (i = lanes; i + lanes <= size; i += lanes)
+                {
+                    Vector items;
+                    load_vector(items, data + i);
+                    Vector displaced = items < firsts ? items : firsts;
+                    firsts = items > firsts ? items : firsts;
+                    seconds = displaced > seconds ? displaced : seconds;
+                }
+
+                first = firsts[0] > firsts[1] ? firsts[0] : firsts[1];
+                second = firsts[0] > firsts[1] ? firsts[1] : firsts[0];
+                for (std::size_t lane = 2; lane < lanes; ++lane)
+                {
+                    offer(firsts[lane]);
+                }
+                for (std::size_t lane = 0; lane < lanes; ++lane)
+                {
+                    offer(seconds[lane]);
+                }
+            }
+            for (; i < size; ++i)
+            {
+                offer(data[i]);
+            }
+            return std::make_pair(first, second);
+        }
+    };
+
+    template <typename Kernel, typename T, typename... Arguments>
+    auto run_kernel_16(const T* data, Arguments... arguments)
+    {
+        return Kernel::template run<typename VectorOf<T, 16>::type>(data, arguments...);
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    template <typename Kernel, typename T, typename... Arguments>
+    __attribute__((target("avx2"))) auto run_kernel_avx2(const T* data, Arguments... arguments)
+    {
+        return Kernel::template run<typename VectorOf<T, 32>::type>(data, arguments...);
+    }
+
+    template <typename Kernel, typename T, typename... Arguments>
+    __attribute__((target("sse4.1"))) auto run_kernel_sse41(const T* data, Arguments... arguments)
+    {
+        return Kernel::template run<typename VectorOf<T, 16>::type>(data, arguments...);
+    }
+
+    enum class InstructionSet { sse2, sse41, avx2 };
+
+    inline InstructionSet detect_instruction_set()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return InstructionSet::avx2;
+        }
+        return __builtin_cpu_supports("sse4.1") ? InstructionSet::sse41 : InstructionSet::sse2;
+    }
+#endif
+
+    /* Runs Kernel on the array with the widest instruction set available */
+    template <typename Kernel, typename T>
+    auto dispatch_kernel(const T* data, std::size_t size)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        static const InstructionSet instruction_set = detect_instruction_set();
+        if (instruction_set == InstructionSet::avx2)
+        {
+            return run_kernel_avx2<Kernel>(data, size);
+        }
+        if (instruction_set == InstructionSet::sse41)
+        {
+            return run_kernel_sse41<Kernel>(data, size);
+        }
+#endif
+        return run_kernel_16<Kernel>(data, size);
+    }
+
+    template <typename Kernel, typename Iterator, typename Result>
+    bool run_reduction_kernel(Iterator first, Iterator last, Result& result, std::true_type)
+    {
+        std::size_t size = last - first;
+        if (size > static_cast<std::size_t>(INT_MAX))
+        {
+            return false;
+        }
+        result = dispatch_kernel<Kernel>(&*first, size);
+        return true;
+    }
+#endif // ALGORITHMS_HAS_REDUCTION_KERNELS
+
+    template <typename Kernel, typename Iterator, typename Result>
+    bool run_reduction_kernel(Iterator, Iterator, Result&, std::false_type)
+    {
+        return false;
+    }
+
+    /* Runs Kernel over [first, last) into result and returns true, if the range is a contiguous array of int or float;
+     * otherwise, returns false without running it.
+     */
+    template <typename Kernel, typename Iterator, typename Result>
+    bool run_reduction_kernel(Iterator first, Iterator last, Result& result)
+    {
+#ifdef ALGORITHMS_HAS_REDUCTION_KERNELS
+        return run_reduction_kernel<Kernel>(first, last, result, std::integral_constant<bool, is_reducible_range<Iterator>::value>{});
+#else
+        return run_reduction_kernel<Kernel>(first, last, result, std::false_type{});
+#endif
+    }
+}
+
+#endif // ALGORITHMS_REDUCTION_KERNELS_HPP
@@ -1,7 +1,7 @@
 /* Selection algorithms;
- *  - find maximum value of an array
- *  - find second-largest value in an array
- *  - find k-smallest value in an array
+ *  - find maximum, minimum, or both values of an array, or the position of either
+ *  - find second-largest value in an array (or the two largest)
+ *  - find k-smallest value in an array (in place, or on a copy), the k smallest values, or those in sorted order
  *
  * Author: Geoffrey Ko (2017)
  * Developed using the following configuration:
@@ -12,15 +12,20 @@
 #ifndef ALGORITHMS_SELECTION_HPP
 #define ALGORITHMS_SELECTION_HPP
 
+#include <algorithm>
 #include <array>
 #include <deque>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
-#include <random>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
+#include <cmath>
+#include "reduction_kernels.hpp"
+#include "sorting.hpp"
 
 
 namespace
@@ -33,25 +38,25 @@ namespace
             throw std::out_of_range{"empty range"};
         }
     }
-
-    template <typename InputIterator>
-    int brute_force_select(InputIterator first, InputIterator last, int k)
-    {
-        std::vector<int> temp{first, last};
-        std::sort(temp.begin(), temp.end());
-        return temp[k];
-    }
 }
 
-/* Trivial algorithm to find the maximum value in the sequence [first, last).
+/* Trivial algorithms to find the maximum (or minimum) value in the sequence [first, last).
+ * On a contiguous array of int or float, the scan runs vectorized (see reduction_kernels.hpp).
  * Θ(n) time.
  * Θ(n - 1) comparisons.
  */
 template <typename InputIterator>
-int find_maximum(InputIterator first, InputIterator last)
+typename std::iterator_traits<InputIterator>::value_type find_maximum(InputIterator first, InputIterator last)
 {
+    using Value = typename std::iterator_traits<InputIterator>::value_type;
     bound_check(first, last);
-    int current_max = *(first++);
+    std::pair<Value, Value> extremes;
+    if (run_reduction_kernel<MinMaxKernel<false, true>>(first, last, extremes))
+    {
+        return extremes.second;
+    }
+
+    Value current_max = *(first++);
     while (first != last)
     {
         if (*first > current_max)
@@ -63,6 +68,102 @@ int find_maximum(InputIterator first, InputIterator last)
     return current_max;
 }
 
+template <typename InputIterator>
+typename std::iterator_traits<InputIterator>::value_type find_minimum(InputIterator first, InputIterator last)
+{
+    using Value = typename std::iterator_traits<InputIterator>::value_type;
+    bound_check(first, last);
+    std::pair<Value, Value> extremes;
+    if (run_reduction_kernel<MinMaxKernel<true, false>>(first, last, extremes))
+    {
+        return extremes.first;
+    }
+
+    Value current_min = *(first++);
+    while (first != last)
+    {
+        if (*first < current_min)
+        {
+            current_min = *first;
+        }
+        ++first;
+    }
+    return current_min;
+}
+
+
+/* Finds both the minimum and the maximum value in [first, last), returned as (minimum, maximum).
+ * Rather than comparing every item with both, items are taken in pairs:
+ * the smaller of each pair is compared with the minimum, and the larger with the maximum.
+ * On a contiguous array of int or float, the scan runs vectorized (see reduction_kernels.hpp).
+ *
+ * Θ(n) time.
+ * Θ(⌈3n/2⌉ - 2) comparisons.
+ */
+template <typename InputIterator>
+std::pair<typename std::iterator_traits<InputIterator>::value_type, typename std::iterator_traits<InputIterator>::value_type>
+find_minmax(InputIterator first, InputIterator last)
+{
+    using Value = typename std::iterator_traits<InputIterator>::value_type;
+    bound_check(first, last);
+    std::pair<Value, Value> extremes;
+    if (run_reduction_kernel<MinMaxKernel<true, true>>(first, last, extremes))
+    {
+        return extremes;
+    }
+
+    Value current_min = *(first++);
+    Value current_max = current_min;
+    while (first != last)
+    {
+        Value a = *(first++);
+        if (first == last)
+        {
+            current_min = std::min(current_min, a);
+            current_max = std::max(current_max, a);
+            break;
+        }
+        Value b = *(first++);
+        if (b < a)
+        {
+            std::swap(a, b);
+        }
+        current_min = std::min(current_min, a);
+        current_max = std::max(current_max, b);
+    }
+    return std::make_pair(current_min, current_max);
+}
+
+
+/* Finds the position of the first maximum (or minimum) value in [first, last).
+ * On a contiguous array of int or float, the scan runs vectorized (see reduction_kernels.hpp).
+ * Θ(n) time.
+ * Θ(n - 1) comparisons.
+ */
+template <typename ForwardIterator>
+ForwardIterator find_argmax(ForwardIterator first, ForwardIterator last)
+{
+    bound_check(first, last);
+    std::size_t position;
+    if (run_reduction_kernel<ArgExtremumKernel<true>>(first, last, position))
+    {
+        return std::next(first, position);
+    }
+    return std::max_element(first, last);
+}
+
+template <typename ForwardIterator>
+ForwardIterator find_argmin(ForwardIterator first, ForwardIterator last)
+{
+    bound_check(first, last);
+    std::size_t position;
+    if (run_reduction_kernel<ArgExtremumKernel<false>>(first, last, position))
+    {
+        return std::next(first, position);
+    }
+    return std::min_element(first, last);
+}
+
 
 /* Tournament selection algorithm to find the second largest element in [first, last).
  * Trivially, the second-largest item can be found by:
@@ -96,66 +197,83 @@ int find_maximum(InputIterator first, InputIterator last)
  *   (64, 62), (68, 75)
  *
  * Continue doing this until the entire tree is built.
+ * An odd item out at any level advances to the next one unopposed.
  * Descend the tree in Θ(log n) time (considering only nodes of which 75 is a child)
  * to find the maximum value that 75 was compared to.
  * This incurs Θ(⌈log n⌉ - 1) comparisons.
+ *
+ * On a contiguous array of int or float, the two largest are instead tracked in a single vectorized scan,
+ * with Θ(3n) comparisons spread over the vector lanes (see reduction_kernels.hpp).
+ *
+ * find_top_two returns (largest, second largest); find_second_largest returns just the latter
+ * (and the only item, if there is just one). Duplicates count separately, so the second largest may equal the largest.
  */
-template <typename InputIterator>
-int find_second_largest(InputIterator first, InputIterator last)
+template <typename ForwardIterator>
+std::pair<typename std::iterator_traits<ForwardIterator>::value_type, typename std::iterator_traits<ForwardIterator>::value_type>
+find_top_two(ForwardIterator first, ForwardIterator last)
 {
+    using Value = typename std::iterator_traits<ForwardIterator>::value_type;
     bound_check(first, last);
-    int size = std::distance(first, last);
-    if (size == 1)
+    if (std::next(first) == last)
     {
-        return *first;
+        throw std::out_of_range{"fewer than 2 items"};
     }
+    std::pair<Value, Value> top_two;
+    if (run_reduction_kernel<TopTwoKernel>(first, last, top_two))
+    {
+        return top_two;
+    }
+    std::vector<std::vector<Value>> levels(1, std::vector<Value>{first, last});    // levels[0] holds the leaves
 
-    std::deque<int> tournament{first, last};    // initially contains just the leaves
-    int current_level_size = size;
-
-    // O(n): builds the heap, bottom-up
-    while (current_level_size > 1)
+    // O(n): builds the tree, bottom-up; each level holds the winners of the one below
+    while (levels.back().size() > 1)
     {
-        // winners represents the parents of the current level of the tournament-tree
-        std::vector<int> winners;
-        for (unsigned int i = 0; i < current_level_size; i += 2)
+        const std::vector<Value>& competitors = levels.back();
+        std::vector<Value> winners;
+        winners.reserve((competitors.size() + 1) / 2);
+        for (std::size_t i = 0; i < competitors.size(); i += 2)
         {
-            int winner = (i + 1) < current_level_size ? std::max(tournament[i], tournament[i + 1]) : tournament[i];
-            winners.push_back(winner);
+            winners.push_back(i + 1 < competitors.size() ? std::max(competitors[i], competitors[i + 1]) : competitors[i]);
         }
-        for (auto i = winners.rbegin(); i != winners.rend(); ++i)
-        {
-            tournament.push_front(*i);
-        }
-        current_level_size = winners.size();
+        levels.push_back(std::move(winners));
     }
 
-    const int largest = tournament.front();
-    int second_largest = std::numeric_limits<int>::min();
-    unsigned int i = 0;
-
-    // descend the winner's competitors to find the second-largest element
-    while (i < tournament.size())
+    // descend the winner's path to find the largest item it was compared with
+    const Value& largest = levels.back().front();
+    const Value* second_largest = nullptr;
+    std::size_t position = 0;
+    for (std::size_t level = levels.size() - 1; level > 0; --level)
     {
-        int left_child = 2 * i + 1;
-        int right_child = 2 * i + 2;
-        if (left_child < tournament.size() && tournament[left_child] == largest)
+        const std::vector<Value>& below = levels[level - 1];
+        std::size_t left = 2 * position;
+        std::size_t right = left + 1;
+        if (right >= below.size())
         {
-            second_largest = std::max(second_largest, tournament[right_child]);
-            i = left_child;
+            position = left;
+            continue;
         }
-        else if (right_child < tournament.size() && tournament[right_child] == largest)
-        {
-            second_largest = std::max(second_largest, tournament[left_child]);
-            i = right_child;
-        }
-        else
+
+        // std::max returns the left competitor on ties, so the winner came from the right only if it is strictly greater
+        bool from_left = !(below[left] < below[right]);
+        const Value& opponent = from_left ? below[right] : below[left];
+        if (second_largest == nullptr || *second_largest < opponent)
         {
-            break;
+            second_largest = &opponent;
         }
+        position = from_left ? left : right;
     }
+    return std::make_pair(largest, *second_largest);
+}
 
-    return second_largest;
+template <typename ForwardIterator>
+typename std::iterator_traits<ForwardIterator>::value_type find_second_largest(ForwardIterator first, ForwardIterator last)
+{
+    bound_check(first, last);
+    if (std::next(first) == last)
+    {
+        return *first;
+    }
+    return find_top_two(first, last).second;
 }
 
 
@@ -170,157 +288,278 @@ int find_second_largest(InputIterator first, InputIterator last)
  *   E: all items in S equal to m*
  *   G: all items in S greater than m*
  *
- * 3. Choose the appropriate subsequence is by comparing k with the cumulative sizes.
+ * 3. Choose the appropriate subsequence is by comparing k (counting from 0) with the cumulative sizes.
  *    If k is:
  *       - less than |L|, then recursively search L.
- *       - less than or equal to |L| + |E|, then return m* (the kth smallest element is m*).
- *       - less than or equal to |l| + |E| + |G|, then recursively search G for the (k - |L| - |E|)th smallest element.
+ *       - less than |L| + |E|, then return m* (the kth smallest element is m*).
+ *       - less than |l| + |E| + |G|, then recursively search G for the (k - |L| - |E|)th smallest element.
+ *
+ * The algorithms below partition S in place, into L, E and G laid out side by side,
+ * so every "recursive search" just narrows the range being partitioned, and no level allocates.
  *
  * ========================================================================
  * ========================================================================
  */
 
-
-/* Quick select.
- * Prune-and-search algorithm for finding the k-th smallest value in the iterator range [first, last).
- * Choose an approximate median "m*" randomly from [first, last).
- * Follow the general guidelines, using randomly-chosen median m*.
- *
- * Worst case: O(n^2) time
- * Best/Average case: O(n) time.
- */
-template <typename InputIterator>
-int quick_select(InputIterator first, InputIterator last, int k)
+namespace
 {
-    bound_check(first, last);
-    int size = std::distance(first, last);
-    if (size == 1)
+    /* Reorders [first, last) around the pivot *first into L, E and G, in that order.
+     * Returns the range of E.
+     */
+    template <typename RandomAccessIterator, typename Compare>
+    std::pair<RandomAccessIterator, RandomAccessIterator> partition_three_way(RandomAccessIterator first, RandomAccessIterator last, Compare less)
     {
-        return *first;
+        // [first + 1, lt) holds L, [lt, i) holds E (but for the pivot), and [gt, last) holds G
+        auto lt = first + 1;
+        auto i = first + 1;
+        auto gt = last;
+        while (i < gt)
+        {
+            if (less(*i, *first))
+            {
+                std::iter_swap(lt++, i++);
+            }
+            else if (less(*first, *i))
+            {
+                std::iter_swap(i, --gt);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        std::iter_swap(first, --lt);
+        return std::make_pair(lt, gt);
     }
 
-    std::random_device rd;
-    std::mt19937 engine{rd()};
-    std::uniform_int_distribution<int> uid{0, size - 1};
-    int random_median_index = uid(engine);
-    int random_median = *(first + random_median_index);
-
-    std::vector<int> less;
-    std::vector<int> equal;
-    std::vector<int> greater;
+    // defined below, as the two recurse into each other
+    template <typename RandomAccessIterator, typename Compare>
+    void introselect(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare less, int depth_limit);
 
-    while (first != last)
+    /* Finds the median-of-medians of [first, last) for use as m*:
+     * sorts each group of 5 (the last of which may be smaller), swaps the groups' medians to the front,
+     * and selects the median of those recursively.
+     * Returns the iterator to it.
+     */
+    template <typename RandomAccessIterator, typename Compare>
+    RandomAccessIterator median_of_medians(RandomAccessIterator first, RandomAccessIterator last, Compare less)
     {
-        if (*first < random_median)
-        {
-            less.push_back(*first);
-        }
-        else if (*first > random_median)
+        auto size = last - first;
+        auto medians = first;
+        for (decltype(size) group = 0; group < size; group += 5)
         {
-            greater.push_back(*first);
+            auto group_first = first + group;
+            auto group_last = first + std::min(group + 5, size);
+            insertion_sort(group_first, group_last, less);
+            std::iter_swap(medians++, group_first + (group_last - group_first) / 2);
         }
-        else
-        {
-            equal.push_back(*first);
-        }
-        ++first;
+
+        auto median = first + (medians - first) / 2;
+        introselect(first, median, medians, less, 0);
+        return median;
     }
 
-    if (k <= less.size())
+    /* Reorders [first, last) so that *nth is the item that would be there were the range sorted,
+     * following the general guidelines with m* chosen like quick_sort's pivot,
+     * until depth_limit partitioning rounds have passed, and the median-of-medians from then on.
+     * Ranges of at most _INSERTION_SORT_THRESHOLD items are finished with insertion sort.
+     */
+    template <typename RandomAccessIterator, typename Compare>
+    void introselect(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare less, int depth_limit)
     {
-        return quick_select(less.begin(), less.end(), k);
+        while (last - first > _INSERTION_SORT_THRESHOLD)
+        {
+            if (depth_limit > 0)
+            {
+                --depth_limit;
+                choose_pivot(first, last, less);
+            }
+            else
+            {
+                std::iter_swap(first, median_of_medians(first, last, less));
+            }
+
+            auto equal = partition_three_way(first, last, less);
+            if (nth < equal.first)
+            {
+                last = equal.first;
+            }
+            else if (nth >= equal.second)
+            {
+                first = equal.second;
+            }
+            else
+            {
+                return;
+            }
+        }
+        insertion_sort(first, last, less);
     }
-    else if (k <= (less.size() + equal.size()))
+
+    /* Copies [first, last) and checks that k is within it */
+    template <typename InputIterator>
+    std::vector<typename std::iterator_traits<InputIterator>::value_type> selection_copy(InputIterator first, InputIterator last, int k)
     {
-        return random_median;
+        bound_check(first, last);
+        std::vector<typename std::iterator_traits<InputIterator>::value_type> items{first, last};
+        if (k < 0 || k >= static_cast<int>(items.size()))
+        {
+            throw std::out_of_range{"k is out of range"};
+        }
+        return items;
     }
-    else
+}
+
+
+/* Select nth (in place, like std::nth_element).
+ * Reorders [first, last) so that *nth is the item that would be there were the range sorted under less,
+ * no item before nth is greater than it, and no item after nth is less than it.
+ * This is an introselect: quick select with quick_sort's pivot choice,
+ * which switches to the median-of-medians for m* if partitioning takes more than 2log n rounds.
+ *
+ * Worst case: O(n) time.
+ * O(log n) extra space (recursive stack space, from median-of-medians).
+ * Unstable.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void select_nth(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare less)
+{
+    auto size = last - first;
+    if (size > 1 && nth != last)
     {
-        return quick_select(greater.begin(), greater.end(), k - less.size() - equal.size());
+        introselect(first, nth, last, less, 2 * static_cast<int>(std::log2(size)));
     }
 }
 
+template <typename RandomAccessIterator>
+void select_nth(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+{
+    select_nth(first, nth, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{});
+}
 
-/* Deterministic select.
- * Choose the median-of-medians as m* to better-balance the partitioning of L, E, and G.
- * Divide S into ⌈n/5⌉ groups, all of which are of exactly size 5 (except possibly the last one).
- * Find the median of each subgroup through brute force.
- * Find the median-of-medians by recursively calling deterministic_select on the sequence of each group's median value.
- * Follow the general guidelines, using the calculated median-of-medians m*.
+/* Deterministic select nth (in place).
+ * Same as select_nth, but always chooses the median-of-medians as m*.
  *
  * Best/Worst/Average case: O(n) time.
- * 
- * Though deterministic selection is asymptotically optimal, there is a high constant associated with its run time,
- * making quick select a viable candidate for empirical performance.
+ * O(log n) extra space (recursive stack space).
+ * Unstable.
  */
-template <typename InputIterator>
-int deterministic_select(InputIterator first, InputIterator last, int k)
+template <typename RandomAccessIterator, typename Compare>
+void deterministic_select_nth(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare less)
 {
-    int size = std::distance(first, last);
-    if (size <= 5)
+    if (last - first > 1 && nth != last)
     {
-        return brute_force_select(first, last, k);
+        introselect(first, nth, last, less, 0);
     }
+}
 
-    const double group_factor = 5.0;
-    const int n_groups = std::ceil(size / group_factor);
-    const double median_of_n_groups = n_groups / static_cast<double>(2);
-    std::vector<int> medians(n_groups);
-    std::vector<std::vector<int>> groups(n_groups);
-    std::for_each(groups.begin(), groups.end(), [&group_factor](std::vector<int>& group){ group = std::vector<int>(group_factor); });
+template <typename RandomAccessIterator>
+void deterministic_select_nth(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+{
+    deterministic_select_nth(first, nth, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{});
+}
 
-    // 1. divide into ⌈n/5⌉ groups
-    auto current = first;
-    for (unsigned int i = 0; i < size; ++i)
+/* Top-k select (in place).
+ * Reorders [first, last) so that its k smallest items under less (in no particular order) are in [first, first + k),
+ * and returns first + k; pass std::greater for the k largest.
+ * Throws std::out_of_range if k is not within [0, n].
+ *
+ * Worst case: O(n) time.
+ */
+template <typename RandomAccessIterator, typename Compare>
+RandomAccessIterator select_top_k(RandomAccessIterator first, RandomAccessIterator last, int k, Compare less)
+{
+    if (k < 0 || k > last - first)
     {
-        int group_factor_i = group_factor;
-        groups[std::floor(i / group_factor)][i % group_factor_i] = *(current++);
+        throw std::out_of_range{"k is out of range"};
     }
+    select_nth(first, first + k, last, less);
+    return first + k;
+}
 
-    // 2. find the median of each group, again using brute force
-    for (unsigned int i = 0; i < n_groups; ++i)
-    {
-        const std::vector<int>& target = groups[i];
-        medians[i] = brute_force_select(target.begin(), target.end(), std::floor(median_of_n_groups));
-    }
+template <typename RandomAccessIterator>
+RandomAccessIterator select_top_k(RandomAccessIterator first, RandomAccessIterator last, int k)
+{
+    return select_top_k(first, last, k, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{});
+}
 
-    // 3. recurisvely compute m* (median-of-medians)
-    int median_of_medians = deterministic_select(medians.begin(), medians.end(), std::floor(median_of_n_groups));
+/* Partial quick sort (in place, like std::partial_sort).
+ * Reorders [first, last) so that [first, middle) holds its (middle - first) smallest items under less, in sorted order.
+ * Selects them with select_nth, then quick sorts just that part.
+ *
+ * Let k be (middle - first).
+ * Worst case: O(n + klog k) time.
+ * Unstable.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void partial_quick_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare less)
+{
+    select_nth(first, middle, last, less);
+    quick_sort(first, middle, less);
+}
 
-    // 4. parition into L, E, G
-    std::vector<int> less;
-    std::vector<int> equal;
-    std::vector<int> greater;
+template <typename RandomAccessIterator>
+void partial_quick_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+{
+    partial_quick_sort(first, middle, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{});
+}
 
-    while (first != last)
-    {
-        if (*first < median_of_medians)
-        {
-            less.push_back(*first);
-        }
-        else if (*first > median_of_medians)
-        {
-            greater.push_back(*first);
-        }
-        else
-        {
-            equal.push_back(*first);
-        }
-        ++first;
-    }
 
-    if (k <= less.size())
-    {
-        return deterministic_select(less.begin(), less.end(), k);
-    }
-    else if (k <= (less.size() + equal.size()))
-    {
-        return median_of_medians;
-    }
-    else
-    {
-        return deterministic_select(greater.begin(), greater.end(), k - less.size() - equal.size());
-    }
+/* Quick select.
+ * Finds the k-th smallest value (counting from 0) under less in the iterator range [first, last), leaving it untouched.
+ * k = 0 is the smallest value and k = n - 1 the largest, as with select_nth and std::nth_element.
+ * Note: quick_select and deterministic_select used to count k from 1; a caller written for that must now pass k - 1
+ * (and the old n now throws).
+ * Copies the range once, and runs select_nth on the copy;
+ * to avoid the copy, call select_nth (or select_top_k) on a range that may be reordered.
+ * Throws std::out_of_range if the range is empty, or k is not within it.
+ *
+ * Worst case: O(n) time (the median-of-medians takes over from unlucky pivots).
+ * Θ(n) extra space, allocated once.
+ */
+template <typename InputIterator, typename Compare>
+typename std::iterator_traits<InputIterator>::value_type quick_select(InputIterator first, InputIterator last, int k, Compare less)
+{
+    auto items = selection_copy(first, last, k);
+    select_nth(items.begin(), items.begin() + k, items.end(), less);
+    return std::move(items[k]);
+}
+
+template <typename InputIterator>
+typename std::iterator_traits<InputIterator>::value_type quick_select(InputIterator first, InputIterator last, int k)
+{
+    return quick_select(first, last, k, std::less<typename std::iterator_traits<InputIterator>::value_type>{});
+}
+
+
+/* Deterministic select.
+ * Choose the median-of-medians as m* to better-balance the partitioning of L, E, and G.
+ * Divide S into ⌈n/5⌉ groups, all of which are of exactly size 5 (except possibly the last one).
+ * Find the median of each subgroup by sorting it, and gather the medians at the front of S.
+ * Find the median-of-medians by recursively selecting the middle of those medians.
+ * Follow the general guidelines, using the calculated median-of-medians m*.
+ * Like quick_select, leaves [first, last) untouched by working on a single copy of it (see deterministic_select_nth),
+ * and counts k from 0 (it used to count from 1; see quick_select).
+ * Throws std::out_of_range if the range is empty, or k is not within it.
+ *
+ * Best/Worst/Average case: O(n) time.
+ * Θ(n) extra space, allocated once.
+ *
+ * Though deterministic selection is asymptotically optimal, there is a high constant associated with its run time,
+ * making quick select a viable candidate for empirical performance.
+ */
+template <typename InputIterator, typename Compare>
+typename std::iterator_traits<InputIterator>::value_type deterministic_select(InputIterator first, InputIterator last, int k, Compare less)
+{
+    auto items = selection_copy(first, last, k);
+    deterministic_select_nth(items.begin(), items.begin() + k, items.end(), less);
+    return std::move(items[k]);
+}
+
+template <typename InputIterator>
+typename std::iterator_traits<InputIterator>::value_type deterministic_select(InputIterator first, InputIterator last, int k)
+{
+    return deterministic_select(first, last, k, std::less<typename std::iterator_traits<InputIterator>::value_type>{});
 }
 
 #endif // ALGORITHMS_SELECTION_HPP
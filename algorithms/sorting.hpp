@@ -11,13 +11,27 @@
 #define _ALGORITHMS_SORTING_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <cmath>
 
 
+namespace
+{
+    int _INSERTION_SORT_THRESHOLD = 24;     // quick_sort finishes ranges of at most this many items with insertion sort
+    int _NINTHER_THRESHOLD = 128;           // quick_sort picks the pivot of larger ranges as a median of three medians
+    int _RADIX_SORT_DIGIT_BITS = 11;        // radix_sort distributes on digits of this many bits (2^11 buckets stay in L1 cache)
+    int _STRING_RADIX_SORT_THRESHOLD = 32;  // string_radix_sort finishes buckets of at most this many items with insertion sort
+}
+
+
 // ================================================
 // HELPER FUNCTIONS
 // ================================================
@@ -37,40 +51,320 @@ InputIterator iterator_min(InputIterator a, InputIterator b)
     return *a <= *b ? a : b;
 }
 
-/* Helper function for partition;
- * Returns the median value between the first, middle, and last items in [first, last).
+/* Helper function for choose_pivot;
+ * Reorders *a, *b and *c so that *a <= *b <= *c under less.
  */
-template <typename RandomAccessIterator>
-RandomAccessIterator median_of_three(RandomAccessIterator first, RandomAccessIterator last)
+template <typename RandomAccessIterator, typename Compare>
+void sort_three(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare less)
+{
+    if (less(*b, *a))
+    {
+        std::iter_swap(a, b);
+    }
+    if (less(*c, *b))
+    {
+        std::iter_swap(b, c);
+        if (less(*b, *a))
+        {
+            std::iter_swap(a, b);
+        }
+    }
+}
+
+/* Helper function for quick_sort;
+ * Moves the pivot for [first, last) (which holds at least 3 items) to *first:
+ * the median of the first, middle and last items, or for large ranges, the median of three such medians (Tukey's ninther).
+ */
+template <typename RandomAccessIterator, typename Compare>
+void choose_pivot(RandomAccessIterator first, RandomAccessIterator last, Compare less)
 {
-    int size = std::distance(first, last);
-    if (size < 3)
+    auto size = last - first;
+    auto mid = first + size / 2;
+    if (size > _NINTHER_THRESHOLD)
     {
-        return first;
+        sort_three(first, mid, last - 1, less);
+        sort_three(first + 1, mid - 1, last - 2, less);
+        sort_three(first + 2, mid + 1, last - 3, less);
+        sort_three(mid - 1, mid, mid + 1, less);
+        std::iter_swap(first, mid);
+    }
+    else
+    {
+        sort_three(mid, first, last - 1, less);
     }
-    auto mid = first + std::floor(size / 2);
-    return iterator_max(iterator_min(first, mid), iterator_min(iterator_max(first, mid), last - 1));
 }
 
 /* Helper function for quick_sort;
- * Reorders keys so that all items less than the pivot appear before it,
+ * Reorders [first, last) around the pivot *first, so that all items less than the pivot appear before it,
  * and all items greater than or equal to it appear after.
- * Returns the iterator to the selected pivot value.
+ * Returns the iterator to the pivot's final position.
  */
-template <typename RandomAccessIterator>
-RandomAccessIterator partition(RandomAccessIterator first, RandomAccessIterator last)
+template <typename RandomAccessIterator, typename Compare>
+RandomAccessIterator partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare less)
+{
+    auto i = first + 1;
+    auto j = last - 1;
+    while (true)
+    {
+        while (i <= j && less(*i, *first))
+        {
+            ++i;
+        }
+        while (i <= j && !less(*j, *first))
+        {
+            --j;
+        }
+        if (i >= j)
+        {
+            break;
+        }
+        std::iter_swap(i++, j--);
+    }
+    std::iter_swap(first, i - 1);
+    return i - 1;
+}
+
+/* Helper function for quick_sort;
+ * Reorders [first, last), none of whose items is less than the pivot *first,
+ * so that the items equal to the pivot appear first, followed by those greater than it.
+ * Returns the iterator to the first item greater than the pivot.
+ */
+template <typename RandomAccessIterator, typename Compare>
+RandomAccessIterator partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare less)
+{
+    auto i = first + 1;
+    auto j = last - 1;
+    while (true)
+    {
+        while (i <= j && !less(*first, *i))
+        {
+            ++i;
+        }
+        while (i <= j && less(*first, *j))
+        {
+            --j;
+        }
+        if (i >= j)
+        {
+            break;
+        }
+        std::iter_swap(i++, j--);
+    }
+    return i;
+}
+
+/* Helper function for heap_sort;
+ * Moves the item at index i of the max heap [first, first + size) down until the heap invariant is restored.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void heap_sift_down(RandomAccessIterator first, std::ptrdiff_t i, std::ptrdiff_t size, Compare less)
+{
+    auto moving = std::move(first[i]);
+    for (std::ptrdiff_t child = 2 * i + 1; child < size; child = 2 * i + 1)
+    {
+        if (child + 1 < size && less(first[child], first[child + 1]))
+        {
+            ++child;
+        }
+        if (!less(moving, first[child]))
+        {
+            break;
+        }
+        first[i] = std::move(first[child]);
+        i = child;
+    }
+    first[i] = std::move(moving);
+}
+
+// defined with the other comparison-based sorts below
+template <typename BidirectionalIterator, typename Compare>
+void insertion_sort(BidirectionalIterator first, BidirectionalIterator last, Compare less);
+template <typename RandomAccessIterator, typename Compare>
+void heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less);
+
+/* Helper function for quick_sort;
+ * Sorts [first, last), where depth_limit more partitioning rounds are allowed before falling back to heap sort.
+ * leftmost is false if the item just before first is known to be no greater than any item in [first, last).
+ */
+template <typename RandomAccessIterator, typename Compare>
+void introsort(RandomAccessIterator first, RandomAccessIterator last, Compare less, int depth_limit, bool leftmost)
+{
+    while (last - first > _INSERTION_SORT_THRESHOLD)
+    {
+        if (depth_limit-- == 0)
+        {
+            heap_sort(first, last, less);
+            return;
+        }
+
+        choose_pivot(first, last, less);
+
+        // a pivot equal to its predecessor is the smallest item in the range, so every copy of it is already in place;
+        // this keeps ranges with many duplicates linear instead of quadratic
+        if (!leftmost && !less(*(first - 1), *first))
+        {
+            first = partition_left(first, last, less);
+            continue;
+        }
+
+        auto size = last - first;
+        auto pivot = partition_right(first, last, less);
+        auto left_size = pivot - first;
+        auto right_size = last - (pivot + 1);
+
+        // a lopsided split suggests a pattern in the input; swapping a few items breaks it up for the next round
+        if (left_size < size / 8 && left_size >= _INSERTION_SORT_THRESHOLD)
+        {
+            std::iter_swap(first, first + left_size / 4);
+            std::iter_swap(pivot - 1, pivot - left_size / 4);
+        }
+        if (right_size < size / 8 && right_size >= _INSERTION_SORT_THRESHOLD)
+        {
+            std::iter_swap(pivot + 1, pivot + 1 + right_size / 4);
+            std::iter_swap(last - 1, last - right_size / 4);
+        }
+
+        // recurse into the smaller side and loop on the larger one, so the stack stays O(log n)
+        if (left_size < right_size)
+        {
+            introsort(first, pivot, less, depth_limit, leftmost);
+            first = pivot + 1;
+            leftmost = false;
+        }
+        else
+        {
+            introsort(pivot + 1, last, less, depth_limit, false);
+            last = pivot;
+        }
+    }
+    insertion_sort(first, last, less);
+}
+
+/* Helper functions for radix_sort;
+ * Map a key to an unsigned integer of the same width whose natural order is the key's order,
+ * so that it can be sorted a digit at a time:
+ *   - unsigned integers are used as they are;
+ *   - signed integers have their sign bit flipped, so negative keys come first;
+ *   - floating-point keys have their sign bit flipped if positive, and every bit flipped if negative
+ *     (larger negative magnitudes are smaller keys). -0.0 sorts just before 0.0, and NaNs sort at the ends.
+ */
+template <typename Key>
+typename std::enable_if<std::is_integral<Key>::value && std::is_unsigned<Key>::value, Key>::type radix_bits(Key key)
+{
+    return key;
+}
+
+template <typename Key>
+typename std::enable_if<std::is_integral<Key>::value && std::is_signed<Key>::value, typename std::make_unsigned<Key>::type>::type
+radix_bits(Key key)
+{
+    using Bits = typename std::make_unsigned<Key>::type;
+    return static_cast<Bits>(key) ^ static_cast<Bits>(Bits{1} << (8 * sizeof(Bits) - 1));
+}
+
+inline std::uint32_t radix_bits(float key)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return bits & 0x80000000u ? ~bits : bits ^ 0x80000000u;
+}
+
+inline std::uint64_t radix_bits(double key)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return bits & 0x8000000000000000ull ? ~bits : bits ^ 0x8000000000000000ull;
+}
+
+/* Helper function for radix_sort;
+ * Returns the digit of bits that starts at bit shift.
+ */
+template <typename Bits>
+std::size_t radix_digit(Bits bits, int shift)
 {
-    // TODO: intelligently choose pivot
-    auto pivot = first;
-    for (auto k = first + 1; k < last; ++k)
+    return static_cast<std::size_t>(bits >> shift) & ((std::size_t{1} << _RADIX_SORT_DIGIT_BITS) - 1);
+}
+
+/* Helper function for radix_sort;
+ * Stably moves every item of [first, last) into destination, at the position offsets gives for its key's digit at shift
+ * (advancing that offset).
+ */
+template <typename InputIterator, typename RandomAccessIterator, typename KeyFunction>
+void radix_scatter(InputIterator first, InputIterator last, RandomAccessIterator destination,
+                   std::size_t* offsets, int shift, KeyFunction& key)
+{
+    for (auto current = first; current != last; ++current)
     {
-        if (*k < *first)
+        destination[offsets[radix_digit(radix_bits(key(*current)), shift)]++] = std::move(*current);
+    }
+}
+
+/* Helper function for string_radix_sort;
+ * Returns true if the string key a is less than b, comparing bytes as unsigned from index depth onwards.
+ */
+template <typename String>
+bool string_key_less(const String& a, const String& b, std::size_t depth)
+{
+    std::size_t a_size = a.size();
+    std::size_t b_size = b.size();
+    for (std::size_t i = depth; i < a_size && i < b_size; ++i)
+    {
+        unsigned char a_byte = static_cast<unsigned char>(a[i]);
+        unsigned char b_byte = static_cast<unsigned char>(b[i]);
+        if (a_byte != b_byte)
         {
-            std::swap(*(++pivot), *k);
+            return a_byte < b_byte;
+        }
+    }
+    return a_size < b_size;
+}
+
+/* Helper function for string_radix_sort;
+ * Sorts [first, last), whose keys all share their first depth bytes, using scratch (which has room for as many items).
+ * Items are counted into 257 buckets - keys that end at depth, then one per byte value -
+ * moved into scratch in bucket order, and moved back, after which every bucket but the first is sorted from depth + 1.
+ */
+template <typename RandomAccessIterator, typename ScratchIterator, typename KeyFunction>
+void msd_radix_sort(RandomAccessIterator first, RandomAccessIterator last, ScratchIterator scratch,
+                    std::size_t depth, KeyFunction& key)
+{
+    if (last - first <= _STRING_RADIX_SORT_THRESHOLD)
+    {
+        insertion_sort(first, last, [&key, depth](const auto& a, const auto& b) { return string_key_less(key(a), key(b), depth); });
+        return;
+    }
+
+    auto bucket_of = [&key, depth](const auto& item) -> std::size_t {
+        const auto& item_key = key(item);
+        return depth < item_key.size() ? static_cast<unsigned char>(item_key[depth]) + 1 : 0;
+    };
+
+    std::size_t offsets[258] = {};
+    for (auto current = first; current != last; ++current)
+    {
+        ++offsets[bucket_of(*current) + 1];
+    }
+    for (int b = 1; b < 258; ++b)
+    {
+        offsets[b] += offsets[b - 1];
+    }
+
+    // offsets[b] is now where bucket b starts; next[b] is where its next item goes
+    std::size_t next[257];
+    std::copy(offsets, offsets + 257, next);
+    for (auto current = first; current != last; ++current)
+    {
+        scratch[next[bucket_of(*current)]++] = std::move(*current);
+    }
+    std::move(scratch, scratch + (last - first), first);
+
+    for (int b = 1; b < 257; ++b)
+    {
+        if (offsets[b + 1] - offsets[b] > 1)
+        {
+            msd_radix_sort(first + offsets[b], first + offsets[b + 1], scratch + offsets[b], depth + 1, key);
         }
     }
-    std::swap(*first, *pivot);
-    return pivot;
 }
 
 // ================================================
@@ -118,20 +412,68 @@ void selection_sort(BidirectionalIterator first, BidirectionalIterator last)
  * O(1) extra space.
  * Stable.
  */
-template <typename BidirectionalIterator>
-void insertion_sort(BidirectionalIterator first, BidirectionalIterator last)
+template <typename BidirectionalIterator, typename Compare>
+void insertion_sort(BidirectionalIterator first, BidirectionalIterator last, Compare less)
 {
-    for (BidirectionalIterator current = first; current != last; ++current)
+    if (first == last)
+    {
+        return;
+    }
+
+    // rather than swapping at every step, the value is lifted out and its neighbors are moved into the hole
+    for (BidirectionalIterator current = std::next(first); current != last; ++current)
     {
-        auto left_neighbor = current;
-        auto back = left_neighbor--;
-        while (back != first && *back < *left_neighbor)
+        auto value = std::move(*current);
+        auto hole = current;
+        while (hole != first)
         {
-            std::swap(*(back--), *(left_neighbor--));
+            auto left_neighbor = std::prev(hole);
+            if (!less(value, *left_neighbor))
+            {
+                break;
+            }
+            *hole = std::move(*left_neighbor);
+            hole = left_neighbor;
         }
+        *hole = std::move(value);
     }
 }
 
+template <typename BidirectionalIterator>
+void insertion_sort(BidirectionalIterator first, BidirectionalIterator last)
+{
+    insertion_sort(first, last, std::less<typename std::iterator_traits<BidirectionalIterator>::value_type>{});
+}
+
+/* Heap sort.
+ * Rearranges [first, last) into a max heap in place (bottom-up, in linear time),
+ * then repeatedly swaps the maximum to the back of the shrinking heap and restores the invariant.
+ *
+ * Θ(nlog n) time, in every case.
+ * O(1) extra space.
+ * Unstable.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less)
+{
+    std::ptrdiff_t size = last - first;
+    for (std::ptrdiff_t i = size / 2; i-- > 0;)
+    {
+        heap_sift_down(first, i, size, less);
+    }
+    for (std::ptrdiff_t end = size; end-- > 1;)
+    {
+        std::iter_swap(first, first + end);
+        heap_sift_down(first, 0, end, less);
+    }
+}
+
+template <typename RandomAccessIterator>
+void heap_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    heap_sort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{});
+}
+
 /* Quick sort.
  * Divide-and-conquer algorithm that splits the input sequence into 2 halves,
  * choosing a "pivot" element and moving all elements less than the pivot to its left,
@@ -145,22 +487,36 @@ void insertion_sort(BidirectionalIterator first, BidirectionalIterator last)
  * but will iterate through without having accomplished any re-ordering, thus effectively invoking a recursive call
  * on one subsequence of size 1, and another on one of size (n - 1).
  *
- * Worst case: O(n^2) time.
- * Best/Average case: O(nlog n) time.
- * Ω(log n) extra space (recursive stack space).
+ * This implementation is an introsort, which guards against all of the above:
+ *   - the pivot is the median of three items (or of three medians of three, for large ranges);
+ *   - a pivot equal to the item just before the range is the range's minimum, so its copies are gathered
+ *     in one linear pass and skipped, making inputs with few distinct keys fast rather than quadratic;
+ *   - lopsided partitions (which patterns in the input produce) have a few items swapped around to break the pattern;
+ *   - after 2log n levels of partitioning, the remaining range is heap sorted, bounding the worst case;
+ *   - ranges of at most _INSERTION_SORT_THRESHOLD items are finished with insertion sort;
+ *   - the smaller side is recursed into and the larger one looped on, bounding the stack depth.
+ *
+ * Worst case: O(nlog n) time.
+ * Best case: Ω(n) time (e.g., all keys equal).
+ * O(log n) extra space (recursive stack space).
  * Unstable.
  */
-template <typename RandomAccessIterator>
-void quick_sort(RandomAccessIterator first, RandomAccessIterator last)
+template <typename RandomAccessIterator, typename Compare>
+void quick_sort(RandomAccessIterator first, RandomAccessIterator last, Compare less)
 {
-    if (first < last)
+    auto size = last - first;
+    if (size > 1)
     {
-        auto pivot = partition(first, last);
-        quick_sort(first, pivot);
-        quick_sort(pivot + 1, last);
+        introsort(first, last, less, 2 * static_cast<int>(std::log2(size)), true);
     }
 }
 
+template <typename RandomAccessIterator>
+void quick_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    quick_sort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>{});
+}
+
 
 // ===================================================
 // Linear-time, Address-Calculation Sorting Algorithms
@@ -230,10 +586,11 @@ void counting_sort(RandomAccessIterator first, RandomAccessIterator last)
  * O(n + b) extra space.
  * Stable - keys are added to each bucket in the same order they appear.
  */
-template <typename BidirectionalIterator, typename BucketContainer = std::vector<int>>
+template <typename BidirectionalIterator,
+          typename BucketContainer = std::vector<typename std::iterator_traits<BidirectionalIterator>::value_type>>
 void bucket_sort(BidirectionalIterator first, BidirectionalIterator last, int range, int number_of_buckets)
 {
-    std::unique_ptr<BucketContainer[]> buckets{new std::vector<int>[number_of_buckets]};
+    std::unique_ptr<BucketContainer[]> buckets{new BucketContainer[number_of_buckets]};
     int cutoff = range / number_of_buckets;
     for (auto current = first; current != last; ++current)
     {
@@ -253,4 +610,121 @@ void bucket_sort(BidirectionalIterator first, BidirectionalIterator last, int ra
     }
 }
 
+/* Radix sort (least-significant digit first), for integer and floating-point keys.
+ * key(item) returns the item's key (by default, the item itself) - any integer or floating-point type,
+ * so that records can be sorted by one of their fields.
+ * Let n be the number of items in [first, last), w be the width of the key in bits, and r be _RADIX_SORT_DIGIT_BITS.
+ *
+ * One pass over the input builds a histogram of every r-bit digit of the keys at once.
+ * Then, for each digit from least to most significant, the items are stably scattered by that digit
+ * between [first, last) and a single scratch buffer, at offsets given by the prefix sums of its histogram;
+ * since each pass is stable, the order the earlier passes established among equal digits is preserved.
+ * A digit that every key shares is skipped, so narrow value ranges take fewer passes.
+ *
+ * Θ((w / r)(n + 2^r)) time.
+ * Θ(n + (w / r)2^r) extra space (the items must be default-constructible and move-assignable).
+ * Stable.
+ */
+template <typename RandomAccessIterator, typename KeyFunction>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyFunction key)
+{
+    using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    using Bits = decltype(radix_bits(key(*first)));
+
+    std::size_t size = last - first;
+    if (size < 2)
+    {
+        return;
+    }
+
+    const int width = 8 * sizeof(Bits);
+    const int passes = (width + _RADIX_SORT_DIGIT_BITS - 1) / _RADIX_SORT_DIGIT_BITS;
+    const std::size_t buckets = std::size_t{1} << _RADIX_SORT_DIGIT_BITS;
+    std::vector<std::size_t> counts(passes * buckets, 0);
+    for (auto current = first; current != last; ++current)
+    {
+        Bits bits = radix_bits(key(*current));
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            ++counts[pass * buckets + radix_digit(bits, pass * _RADIX_SORT_DIGIT_BITS)];
+        }
+    }
+
+    std::vector<Value> scratch(size);
+    bool in_scratch = false;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        int shift = pass * _RADIX_SORT_DIGIT_BITS;
+        std::size_t* offsets = counts.data() + pass * buckets;
+        if (offsets[radix_digit(radix_bits(key(in_scratch ? scratch[0] : *first)), shift)] == size)
+        {
+            continue;
+        }
+
+        // turn the histogram into the position each digit value's first item goes to
+        std::size_t total = 0;
+        for (std::size_t d = 0; d < buckets; ++d)
+        {
+            std::size_t count = offsets[d];
+            offsets[d] = total;
+            total += count;
+        }
+
+        if (in_scratch)
+        {
+            radix_scatter(scratch.begin(), scratch.end(), first, offsets, shift, key);
+        }
+        else
+        {
+            radix_scatter(first, last, scratch.begin(), offsets, shift, key);
+        }
+        in_scratch = !in_scratch;
+    }
+
+    if (in_scratch)
+    {
+        std::move(scratch.begin(), scratch.end(), first);
+    }
+}
+
+template <typename RandomAccessIterator>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    radix_sort(first, last, [](const auto& item) { return item; });
+}
+
+/* String radix sort (most-significant digit first).
+ * key(item) returns the item's key (by default, the item itself) - a std::string, or anything with size() and operator[]
+ * returning chars - compared byte by byte as unsigned values, so that order matches std::string's.
+ * Let n be the number of items in [first, last), and d be the total number of bytes that must be looked at
+ * to tell every key apart (the distinguishing prefixes).
+ *
+ * Distributes the items into buckets by their first byte (with keys that have run out of bytes first),
+ * then sorts each bucket recursively by the next byte;
+ * buckets of at most _STRING_RADIX_SORT_THRESHOLD items are finished with insertion sort instead,
+ * where the counting overhead would outweigh the comparisons.
+ * Every level distributes into the same scratch buffer, at the same offsets as the bucket being sorted.
+ *
+ * O(n + d) time, for alphabets no larger than the byte.
+ * Θ(n) extra space (the items must be default-constructible and move-assignable), plus recursive stack space
+ * proportional to the longest distinguishing prefix.
+ * Stable.
+ */
+template <typename RandomAccessIterator, typename KeyFunction>
+void string_radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyFunction key)
+{
+    using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    if (last - first > 1)
+    {
+        std::vector<Value> scratch(last - first);
+        msd_radix_sort(first, last, scratch.begin(), 0, key);
+    }
+}
+
+template <typename RandomAccessIterator>
+void string_radix_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    string_radix_sort(first, last, [](const auto& item) -> const auto& { return item; });
+}
+
 #endif // _ALGORITHMS_SORTING_HPP
@@ -0,0 +1,131 @@
+// This program measures how a ConcurrentHashMap scales with the number of threads, against a HashMap behind one std::mutex,
+// with 1, 2, 4, 8 (and up to one per hardware thread) threads.
+//
+// The map is filled with [keys] keys first; then every thread runs [operations] operations on random keys,
+// of which [read percent]% are lookups and the rest are split evenly between insert_or_assign and erase.
+// Each line reports the total operations per second, and the speedup over 1 thread with the same map.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -pthread -I. benchmarks/concurrent_hash_map_benchmark.cpp tools/ms_timer.cpp -o concurrent_hash_map_benchmark
+//   ./concurrent_hash_map_benchmark [keys] [operations] [read percent]
+#include "data_structures/concurrent_hash_map.hpp"
+#include "data_structures/hash_map.hpp"
+#include "tools/ms_timer.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    int keys = 1 << 16;
+    int operations = 1 << 20;
+    int read_percent = 90;
+    std::atomic<long long> checksum{0};     // printed at the end, so the lookups cannot be optimized away
+
+    class LockedMap
+    {
+    public:
+        bool find(int key, int& value)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            auto position = map.find(key);
+            if (position == map.end())
+                return false;
+            value = position.value();
+            return true;
+        }
+
+        void insert_or_assign(int key, int value)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            map.insert_or_assign(key, value);
+        }
+
+        void erase(int key)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            if (map.contains(key))
+                map.erase(key);
+        }
+
+    private:
+        HashMap<int, int> map;
+        std::mutex lock;
+    };
+
+    template <typename Map>
+    void work(Map& map, int seed)
+    {
+        std::mt19937 random{static_cast<unsigned int>(seed)};
+        long long found = 0;
+        for (int i = 0; i < operations; ++i)
+        {
+            int key = static_cast<int>(random() % keys);
+            int choice = static_cast<int>(random() % 100);
+            int value;
+            if (choice < read_percent)
+                found += map.find(key, value) ? value : 0;
+            else if (choice % 2 == 0)
+                map.insert_or_assign(key, i);
+            else
+                map.erase(key);
+        }
+        checksum += found;
+    }
+
+    template <typename Map>
+    void run(const std::string& name, const std::vector<int>& thread_counts)
+    {
+        double sequential = 0;
+        for (int threads : thread_counts)
+        {
+            Map map;
+            for (int key = 0; key < keys; ++key)
+                map.insert_or_assign(key, key);
+
+            ms_timer timer{true};
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t)
+                workers.emplace_back([&map, t] { work(map, t + 1); });
+            for (std::thread& worker : workers)
+                worker.join();
+            timer.stop();
+
+            double throughput = static_cast<double>(operations) * threads / (timer.read() * 1000.0);
+            if (threads == 1)
+                sequential = throughput;
+            std::cout << std::left << std::setw(20) << name << std::right << std::setw(4) << threads << " threads"
+                      << std::fixed << std::setprecision(2) << std::setw(10) << throughput << " M ops/s"
+                      << std::setw(8) << throughput / sequential << "x" << std::endl;
+        }
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        keys = std::atoi(argv[1]);
+    if (argc > 2)
+        operations = std::atoi(argv[2]);
+    if (argc > 3)
+        read_percent = std::atoi(argv[3]);
+
+    std::vector<int> thread_counts{1, 2, 4, 8};
+    for (int threads = 16; threads <= static_cast<int>(std::thread::hardware_concurrency()); threads *= 2)
+        thread_counts.push_back(threads);
+
+    std::cout << keys << " keys, " << operations << " operations per thread, " << read_percent << "% reads" << std::endl;
+    run<LockedMap>("mutex + HashMap", thread_counts);
+    run<ConcurrentHashMap<int, int>>("ConcurrentHashMap", thread_counts);
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+// This program measures the throughput and latency of the queues in data_structures/concurrent_queue.hpp
+// against a bounded Queue guarded by a std::mutex, with 1, 2, 4, 8 (and up to one per hardware thread) producers
+// all feeding one consumer. SPSCQueue is only run with a single producer.
+//
+// Every message carries the time it was pushed; the consumer records how long each one waited (push to pop).
+// A push into a full queue (or a pop from an empty one) yields, and tries again.
+// Throughput is every message over the time from the first push to the last pop.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -pthread -I. benchmarks/concurrent_queue_benchmark.cpp tools/ms_timer.cpp -o concurrent_queue_benchmark
+//   ./concurrent_queue_benchmark [messages] [capacity]
+#include "data_structures/concurrent_queue.hpp"
+#include "data_structures/queue.hpp"
+#include "tools/ms_timer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    int messages = 1 << 20;
+    int capacity = 1024;
+
+    struct Message
+    {
+        long long sent;     // nanoseconds, on std::chrono::steady_clock
+        int producer;
+    };
+
+    long long now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    class LockedQueue
+    {
+    public:
+        explicit LockedQueue(int capacity) : queue{capacity} {}
+
+        bool try_push(const Message& message)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            return queue.try_push(message);
+        }
+
+        bool try_pop(Message& message)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            return queue.try_pop(message);
+        }
+
+    private:
+        Queue<Message> queue;
+        std::mutex lock;
+    };
+
+    template <typename QueueType>
+    void run(const std::string& name, int producers)
+    {
+        QueueType queue{capacity};
+        int per_producer = messages / producers;
+        std::vector<long long> latencies;
+        latencies.reserve(per_producer * producers);
+
+        ms_timer timer{true};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&queue, per_producer, p] {
+                for (int i = 0; i < per_producer; ++i)
+                    while (!queue.try_push(Message{now(), p}))
+                        std::this_thread::yield();
+            });
+        }
+
+        Message message;
+        for (int received = 0; received < per_producer * producers; ++received)
+        {
+            while (!queue.try_pop(message))
+                std::this_thread::yield();
+            latencies.push_back(now() - message.sent);
+        }
+        timer.stop();
+        for (std::thread& thread : threads)
+            thread.join();
+
+        std::sort(latencies.begin(), latencies.end());
+        double throughput = latencies.size() / (timer.read() * 1000.0);
+        std::cout << std::left << std::setw(16) << name << std::right << std::setw(4) << producers << " producers"
+                  << std::fixed << std::setprecision(2) << std::setw(10) << throughput << " M/s"
+                  << std::setw(12) << latencies[latencies.size() / 2] / 1000.0 << " us p50"
+                  << std::setw(12) << latencies[latencies.size() * 99 / 100] / 1000.0 << " us p99" << std::endl;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        messages = std::atoi(argv[1]);
+    if (argc > 2)
+        capacity = std::atoi(argv[2]);
+
+    std::vector<int> producer_counts{1, 2, 4, 8};
+    for (int producers = 16; producers <= static_cast<int>(std::thread::hardware_concurrency()); producers *= 2)
+        producer_counts.push_back(producers);
+
+    std::cout << messages << " messages, capacity " << capacity << ", 1 consumer" << std::endl;
+    for (int producers : producer_counts)
+    {
+        run<LockedQueue>("mutex + Queue", producers);
+        run<MPMCQueue<Message>>("MPMCQueue", producers);
+        if (producers == 1)
+            run<SPSCQueue<Message>>("SPSCQueue", producers);
+    }
+    return 0;
+}
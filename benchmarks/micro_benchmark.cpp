@@ -0,0 +1,596 @@
+// This program times every container in data_structures/ and every routine in algorithms/ next to their std
+// equivalents, at 10^3 up to 10^8 elements, and reports for each operation:
+//   ns/op         - wall time over the number of operations (for small sizes, the best of several repeats)
+//   allocs/op     - calls to the global operator new over the number of operations
+//   bytes/element - for containers, the heap they hold once all n elements are in; for algorithms,
+//                   the most scratch memory they had allocated at once; either over n
+// Containers insert, look up, iterate over and erase (or push and pop) n sequential or random keys;
+// algorithms run on sorted, reversed, random and duplicate-heavy inputs (an algorithm's op is one element).
+// Quadratic sorts stop at 10^4 elements. With -o, every result is also written as JSON, to compare releases.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. benchmarks/micro_benchmark.cpp tools/ms_timer.cpp -pthread -o micro_benchmark
+//   ./micro_benchmark [-n max exponent] [-f filter] [-o results.json]
+// max exponent defaults to 6 (10^6 elements); filter keeps only the benchmarks whose name contains it.
+#include "algorithms/parallel_selection.hpp"
+#include "algorithms/parallel_sorting.hpp"
+#include "algorithms/selection.hpp"
+#include "algorithms/sorting.hpp"
+#include "data_structures/binary_heap.hpp"
+#include "data_structures/binary_search_tree.hpp"
+#include "data_structures/cache.hpp"
+#include "data_structures/concurrent_hash_map.hpp"
+#include "data_structures/concurrent_queue.hpp"
+#include "data_structures/flat_hash_map.hpp"
+#include "data_structures/hash_map.hpp"
+#include "data_structures/hash_set.hpp"
+#include "data_structures/linked_hash_map.hpp"
+#include "data_structures/linked_hash_set.hpp"
+#include "data_structures/linked_list.hpp"
+#include "data_structures/pool_allocator.hpp"
+#include "data_structures/queue.hpp"
+#include "tools/ms_timer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <map>
+#include <new>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+// Every allocation goes through these, which count the calls, the heap in use, and its peak since measure() began
+namespace
+{
+    const std::size_t HEADER = alignof(std::max_align_t);     // holds the block's size, and keeps it aligned
+    std::atomic<long long> allocations{0};
+    std::atomic<long long> heap_in_use{0};
+    std::atomic<long long> heap_peak{0};
+
+    // kept out of line: inlined into a delete, its free would look to g++ like freeing a pointer operator new returned
+    __attribute__((noinline)) void release(void* pointer) noexcept
+    {
+        if (pointer == nullptr)
+            return;
+
+        char* block = static_cast<char*>(pointer) - HEADER;
+        heap_in_use.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + HEADER));
+    if (block == nullptr)
+        throw std::bad_alloc{};
+
+    *reinterpret_cast<std::size_t*>(block) = size;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    long long in_use = heap_in_use.fetch_add(size, std::memory_order_relaxed) + size;
+    long long peak = heap_peak.load(std::memory_order_relaxed);
+    while (in_use > peak && !heap_peak.compare_exchange_weak(peak, in_use, std::memory_order_relaxed))
+        ;
+    return block + HEADER;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    release(pointer);
+}
+
+// sized deletes would otherwise go to the library's, which frees a block without this header
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    release(pointer);
+}
+
+
+namespace
+{
+    struct Result
+    {
+        std::string name;
+        std::string operation;
+        std::string pattern;
+        long long n;
+        double ns_per_op;
+        double allocations_per_op;
+        double bytes_per_element;
+    };
+
+    struct Sample
+    {
+        double ns;
+        long long allocations;
+        long long retained;     // heap still held afterwards
+        long long peak;         // most heap held at once, above what was held before
+    };
+
+    // the best (fastest) of several repeats of one operation
+    struct Best
+    {
+        double ns = std::numeric_limits<double>::infinity();
+        long long allocations = 0;
+        long long bytes = 0;
+
+        void add(const Sample& sample, long long sample_bytes)
+        {
+            if (sample.ns < ns)
+            {
+                ns = sample.ns;
+                allocations = sample.allocations;
+                bytes = sample_bytes;
+            }
+        }
+    };
+
+    std::vector<Result> results;
+    std::string filter;
+    volatile long long sink;        // keeps the compiler from discarding what is computed
+
+    template <typename Function>
+    Sample measure(Function f)
+    {
+        long long allocated = allocations.load();
+        long long in_use = heap_in_use.load();
+        heap_peak.store(in_use);
+        ms_timer timer{true};
+        f();
+        timer.stop();
+        return Sample{timer.read() * 1e6, allocations.load() - allocated, heap_in_use.load() - in_use, heap_peak.load() - in_use};
+    }
+
+    int repeats_for(long long n)
+    {
+        return static_cast<int>(std::max(1LL, std::min(20LL, 1000000 / n)));
+    }
+
+    bool selected(const std::string& name)
+    {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    }
+
+    void report(const std::string& name, const std::string& operation, const std::string& pattern, long long n, long long ops, const Best& best)
+    {
+        Result result{name, operation, pattern, n, best.ns / ops, best.allocations / static_cast<double>(ops), best.bytes / static_cast<double>(n)};
+        results.push_back(result);
+        std::cout << std::left << std::setw(34) << name << std::setw(10) << operation << std::setw(11) << pattern << std::right;
+        std::cout << std::setw(11) << n << std::fixed << std::setprecision(2) << std::setw(12) << result.ns_per_op;
+        std::cout << std::setprecision(3) << std::setw(11) << result.allocations_per_op;
+        std::cout << std::setprecision(1) << std::setw(11) << result.bytes_per_element << std::endl;
+    }
+
+
+    // Containers: an adapter per container gives the benchmarks one interface
+
+    template <typename Map>
+    struct IndexedMap       // HashMap, FlatHashMap, LinkedHashMap and the std maps: insert and find with operator[]
+    {
+        typedef Map Container;
+        static const bool iterable = true;
+        static Map* make(int) { return new Map; }
+        static void insert(Map& map, int key) { map[key] = key; }
+        static long long find(Map& map, int key) { return static_cast<const Map&>(map)[key]; }
+        static void erase(Map& map, int key) { map.erase(key); }
+    };
+
+    template <typename Map>
+    long long sum_values(const Map& map)
+    {
+        long long sum = 0;
+        for (const auto& pair : map)
+            sum += pair.second;
+        return sum;
+    }
+
+    template <typename Map>
+    struct TableMap : IndexedMap<Map>       // HashMap and FlatHashMap iterate over keys, and give values on the side
+    {
+        static long long iterate(Map& map)
+        {
+            long long sum = 0;
+            for (auto i = map.begin(); i != map.end(); ++i)
+                sum += i.value();
+            return sum;
+        }
+    };
+
+    template <typename Map>
+    struct KeyMap : IndexedMap<Map>         // LinkedHashMap iterates over keys, in insertion order
+    {
+        static long long iterate(Map& map)
+        {
+            long long sum = 0;
+            for (int key : map)
+                sum += static_cast<const Map&>(map)[key];
+            return sum;
+        }
+    };
+
+    template <typename Map>
+    struct StdMap : IndexedMap<Map>         // the std maps iterate over pairs
+    {
+        static long long iterate(Map& map) { return sum_values(map); }
+        static long long find(Map& map, int key) { return map.find(key)->second; }
+    };
+
+    struct ConcurrentMap
+    {
+        typedef ConcurrentHashMap<int, int> Container;
+        static const bool iterable = true;
+        static Container* make(int) { return new Container; }
+        static void insert(Container& map, int key) { map.insert_or_assign(key, key); }
+        static long long find(Container& map, int key) { int value = 0; map.find(key, value); return value; }
+        static long long iterate(Container& map) { long long sum = 0; map.for_each([&sum](int, int value) { sum += value; }); return sum; }
+        static void erase(Container& map, int key) { map.erase(key); }
+    };
+
+    struct LRUCache
+    {
+        typedef Cache<int, int> Container;
+        static const bool iterable = false;
+        static Container* make(int n) { return new Container{n}; }
+        static void insert(Container& cache, int key) { cache.put(key, key); }
+        static long long find(Container& cache, int key) { return *cache.find(key); }
+        static long long iterate(Container&) { return 0; }
+        static void erase(Container& cache, int key) { cache.erase(key); }
+    };
+
+    template <typename Set>
+    struct SetOf            // HashSet, LinkedHashSet and the std sets
+    {
+        typedef Set Container;
+        static const bool iterable = true;
+        static Set* make(int) { return new Set; }
+        static void insert(Set& set, int key) { set.insert(key); }
+        static long long find(Set& set, int key) { return set.count(key); }
+        static long long iterate(Set& set) { return std::accumulate(set.begin(), set.end(), 0LL); }
+        static void erase(Set& set, int key) { set.erase(key); }
+    };
+
+    template <typename Set>
+    struct ContainsSet : SetOf<Set>
+    {
+        static long long find(Set& set, int key) { return set.contains(key); }
+    };
+
+    struct Tree : ContainsSet<BinarySearchTree<int>>
+    {
+        static void insert(Container& tree, int key) { tree.push(key); }
+    };
+
+    // constructs and inserts, looks up, iterates over, then erases keys, in their order
+    template <typename Adapter>
+    void bench_associative(const std::string& name, const std::vector<int>& keys, const std::string& pattern)
+    {
+        if (!selected(name))
+            return;
+
+        long long n = keys.size();
+        Best insert, find, iterate, erase;
+        for (int repeat = 0; repeat < repeats_for(n); ++repeat)
+        {
+            typename Adapter::Container* container = nullptr;
+            Sample sample = measure([&] { container = Adapter::make(n); for (int key : keys) Adapter::insert(*container, key); });
+            insert.add(sample, sample.retained);
+
+            sample = measure([&] { long long sum = 0; for (int key : keys) sum += Adapter::find(*container, key); sink = sum; });
+            find.add(sample, 0);
+            if (Adapter::iterable)
+            {
+                sample = measure([&] { sink = Adapter::iterate(*container); });
+                iterate.add(sample, 0);
+            }
+            sample = measure([&] { for (int key : keys) Adapter::erase(*container, key); });
+            erase.add(sample, 0);
+            delete container;
+        }
+
+        report(name, "insert", pattern, n, n, insert);
+        report(name, "find", pattern, n, n, find);
+        if (Adapter::iterable)
+            report(name, "iterate", pattern, n, n, iterate);
+        report(name, "erase", pattern, n, n, erase);
+    }
+
+
+    template <typename Sequence>
+    struct BackSequence     // Queue, LinkedList and the std sequences: push at the back, pop at the front
+    {
+        typedef Sequence Container;
+        static const bool iterable = true;
+        static Sequence* make(int) { return new Sequence; }
+        static void push(Sequence& sequence, int key) { sequence.push_back(key); }
+        static long long pop(Sequence& sequence) { int front = sequence.front(); sequence.pop_front(); return front; }
+        static long long iterate(Sequence& sequence) { return std::accumulate(sequence.begin(), sequence.end(), 0LL); }
+    };
+
+    struct UnboundedQueue : BackSequence<Queue<int>>
+    {
+        static void push(Container& queue, int key) { queue.push(key); }
+        static long long pop(Container& queue) { int front = queue.front(); queue.pop(); return front; }
+    };
+
+    struct BoundedQueue : UnboundedQueue
+    {
+        static Container* make(int n) { return new Container{n}; }
+    };
+
+    struct List : BackSequence<LinkedList<int>>
+    {
+        static long long pop(Container& list) { return list.pop_front(); }
+    };
+
+    struct StdQueue : BackSequence<std::queue<int>>
+    {
+        static const bool iterable = false;
+        static void push(Container& queue, int key) { queue.push(key); }
+        static long long pop(Container& queue) { int front = queue.front(); queue.pop(); return front; }
+        static long long iterate(Container&) { return 0; }
+    };
+
+    template <typename RingQueue>
+    struct ConcurrentRing : BackSequence<RingQueue>      // SPSCQueue and MPMCQueue, from one thread
+    {
+        static const bool iterable = false;
+        static RingQueue* make(int n) { return new RingQueue{n}; }
+        static void push(RingQueue& queue, int key) { queue.push(key); }
+        static long long pop(RingQueue& queue) { int front = 0; queue.try_pop(front); return front; }
+        static long long iterate(RingQueue&) { return 0; }
+    };
+
+    struct Heap : BackSequence<BinaryHeap<int>>
+    {
+        static const bool iterable = false;
+        static void push(Container& heap, int key) { heap.insert(key); }
+        static long long pop(Container& heap) { return heap.extract(); }
+        static long long iterate(Container&) { return 0; }
+    };
+
+    struct StdHeap : BackSequence<std::priority_queue<int, std::vector<int>, std::greater<int>>>
+    {
+        static const bool iterable = false;
+        static void push(Container& heap, int key) { heap.push(key); }
+        static long long pop(Container& heap) { int top = heap.top(); heap.pop(); return top; }
+        static long long iterate(Container&) { return 0; }
+    };
+
+    // constructs and pushes every key, iterates, then pops every key
+    template <typename Adapter>
+    void bench_sequence(const std::string& name, const std::vector<int>& keys, const std::string& pattern)
+    {
+        if (!selected(name))
+            return;
+
+        long long n = keys.size();
+        Best push, iterate, pop;
+        for (int repeat = 0; repeat < repeats_for(n); ++repeat)
+        {
+            typename Adapter::Container* container = nullptr;
+            Sample sample = measure([&] { container = Adapter::make(n); for (int key : keys) Adapter::push(*container, key); });
+            push.add(sample, sample.retained);
+            if (Adapter::iterable)
+            {
+                sample = measure([&] { sink = Adapter::iterate(*container); });
+                iterate.add(sample, 0);
+            }
+            sample = measure([&] { long long sum = 0; for (long long i = 0; i < n; ++i) sum += Adapter::pop(*container); sink = sum; });
+            pop.add(sample, 0);
+            delete container;
+        }
+
+        report(name, "push", pattern, n, n, push);
+        if (Adapter::iterable)
+            report(name, "iterate", pattern, n, n, iterate);
+        report(name, "pop", pattern, n, n, pop);
+    }
+
+    void bench_containers(int n)
+    {
+        std::vector<int> sequential(n);
+        std::iota(sequential.begin(), sequential.end(), 0);
+        // distinct, scattered keys: multiplying by an odd constant is a bijection of the 32-bit integers
+        std::vector<int> random(n);
+        for (int i = 0; i < n; ++i)
+            random[i] = static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+        std::shuffle(random.begin(), random.end(), std::mt19937{static_cast<unsigned>(n)});
+
+        for (int which = 0; which < 2; ++which)
+        {
+            const std::vector<int>& keys = which == 0 ? sequential : random;
+            std::string pattern = which == 0 ? "sequential" : "random";
+            bench_associative<TableMap<HashMap<int, int>>>("HashMap", keys, pattern);
+            bench_associative<TableMap<HashMap<int, int, std::hash<int>, PoolAllocator<std::pair<int, int>>>>>("HashMap (PoolAllocator)", keys, pattern);
+            bench_associative<TableMap<FlatHashMap<int, int>>>("FlatHashMap", keys, pattern);
+            bench_associative<KeyMap<LinkedHashMap<int, int>>>("LinkedHashMap", keys, pattern);
+            bench_associative<ConcurrentMap>("ConcurrentHashMap", keys, pattern);
+            bench_associative<LRUCache>("Cache (LRU)", keys, pattern);
+            bench_associative<StdMap<std::unordered_map<int, int>>>("std::unordered_map", keys, pattern);
+            bench_associative<StdMap<std::map<int, int>>>("std::map", keys, pattern);
+
+            bench_associative<ContainsSet<HashSet<int>>>("HashSet", keys, pattern);
+            bench_associative<ContainsSet<LinkedHashSet<int>>>("LinkedHashSet", keys, pattern);
+            bench_associative<Tree>("BinarySearchTree", keys, pattern);
+            bench_associative<SetOf<std::unordered_set<int>>>("std::unordered_set", keys, pattern);
+            bench_associative<SetOf<std::set<int>>>("std::set", keys, pattern);
+
+            bench_sequence<Heap>("BinaryHeap", keys, pattern);
+            bench_sequence<StdHeap>("std::priority_queue", keys, pattern);
+        }
+
+        // the order of the keys does not matter to a sequence
+        bench_sequence<UnboundedQueue>("Queue", sequential, "sequential");
+        bench_sequence<BoundedQueue>("Queue (bounded)", sequential, "sequential");
+        bench_sequence<ConcurrentRing<SPSCQueue<int>>>("SPSCQueue", sequential, "sequential");
+        bench_sequence<ConcurrentRing<MPMCQueue<int>>>("MPMCQueue", sequential, "sequential");
+        bench_sequence<List>("LinkedList", sequential, "sequential");
+        bench_sequence<StdQueue>("std::queue", sequential, "sequential");
+        bench_sequence<BackSequence<std::deque<int>>>("std::deque", sequential, "sequential");
+        bench_sequence<BackSequence<std::list<int>>>("std::list", sequential, "sequential");
+    }
+
+
+    // Algorithms: each runs on a fresh copy of the input, and its op is one element
+
+    template <typename T>
+    void bench_algorithm(const std::string& name, const std::vector<T>& input, const std::string& pattern, std::function<long long(std::vector<T>&)> run)
+    {
+        if (!selected(name))
+            return;
+
+        long long n = input.size();
+        Best best;
+        for (int repeat = 0; repeat < repeats_for(n); ++repeat)
+        {
+            std::vector<T> data = input;
+            Sample sample = measure([&] { sink = run(data); });
+            best.add(sample, sample.peak);
+        }
+        report(name, "run", pattern, n, n, best);
+    }
+
+    void bench_algorithms(int n)
+    {
+        const int DUPLICATES = 16;
+        const int QUADRATIC_LIMIT = 10000;
+        std::mt19937 generator{static_cast<unsigned>(n)};
+        std::vector<std::pair<std::string, std::vector<int>>> inputs(4, {"", std::vector<int>(n)});
+        inputs[0].first = "sorted";
+        std::iota(inputs[0].second.begin(), inputs[0].second.end(), 0);
+        inputs[1].first = "reversed";
+        std::iota(inputs[1].second.rbegin(), inputs[1].second.rend(), 0);
+        inputs[2].first = "random";
+        inputs[2].second = inputs[0].second;
+        std::shuffle(inputs[2].second.begin(), inputs[2].second.end(), generator);
+        inputs[3].first = "duplicates";
+        for (int& value : inputs[3].second)
+            value = generator() % DUPLICATES;
+
+        typedef std::vector<int> Data;
+        int k = n / 2;
+        int top = std::max(1, n / 100);
+        for (const auto& input : inputs)
+        {
+            const std::string& pattern = input.first;
+            const Data& values = input.second;
+            int range = pattern == "duplicates" ? DUPLICATES : n;
+            auto first = [](const Data& data) -> long long { return data.front(); };
+
+            if (n <= QUADRATIC_LIMIT)
+            {
+                bench_algorithm<int>("selection_sort", values, pattern, [&](Data& d) { selection_sort(d.begin(), d.end()); return first(d); });
+                bench_algorithm<int>("insertion_sort", values, pattern, [&](Data& d) { insertion_sort(d.begin(), d.end()); return first(d); });
+            }
+            bench_algorithm<int>("heap_sort", values, pattern, [&](Data& d) { heap_sort(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("std::make_heap + std::sort_heap", values, pattern, [&](Data& d) { std::make_heap(d.begin(), d.end()); std::sort_heap(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("quick_sort", values, pattern, [&](Data& d) { quick_sort(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("std::sort", values, pattern, [&](Data& d) { std::sort(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("std::stable_sort", values, pattern, [&](Data& d) { std::stable_sort(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("counting_sort", values, pattern, [&](Data& d) { counting_sort(d.begin(), d.end(), range); return first(d); });
+            bench_algorithm<int>("bucket_sort", values, pattern, [&](Data& d) { bucket_sort(d.begin(), d.end(), range, std::min(range, std::max(1, n / 8))); return first(d); });
+            bench_algorithm<int>("radix_sort", values, pattern, [&](Data& d) { radix_sort(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("parallel_merge_sort", values, pattern, [&](Data& d) { parallel_merge_sort(d.begin(), d.end()); return first(d); });
+            bench_algorithm<int>("parallel_sample_sort", values, pattern, [&](Data& d) { parallel_sample_sort(d.begin(), d.end()); return first(d); });
+
+            if (selected("string_radix_sort") || selected("std::sort (strings)"))
+            {
+                std::vector<std::string> strings;
+                strings.reserve(n);
+                for (int value : values)
+                    strings.push_back(std::to_string(value));
+                auto length = [](const std::vector<std::string>& data) -> long long { return data.front().size(); };
+                bench_algorithm<std::string>("string_radix_sort", strings, pattern, [&](std::vector<std::string>& d) { string_radix_sort(d.begin(), d.end()); return length(d); });
+                bench_algorithm<std::string>("std::sort (strings)", strings, pattern, [&](std::vector<std::string>& d) { std::sort(d.begin(), d.end()); return length(d); });
+            }
+
+            bench_algorithm<int>("find_maximum", values, pattern, [](Data& d) { return find_maximum(d.begin(), d.end()); });
+            bench_algorithm<int>("std::max_element", values, pattern, [](Data& d) { return *std::max_element(d.begin(), d.end()); });
+            bench_algorithm<int>("find_minimum", values, pattern, [](Data& d) { return find_minimum(d.begin(), d.end()); });
+            bench_algorithm<int>("std::min_element", values, pattern, [](Data& d) { return *std::min_element(d.begin(), d.end()); });
+            bench_algorithm<int>("find_minmax", values, pattern, [](Data& d) { return find_minmax(d.begin(), d.end()).second; });
+            bench_algorithm<int>("std::minmax_element", values, pattern, [](Data& d) { return *std::minmax_element(d.begin(), d.end()).second; });
+            bench_algorithm<int>("find_argmax", values, pattern, [](Data& d) { return find_argmax(d.begin(), d.end()) - d.begin(); });
+            bench_algorithm<int>("find_argmin", values, pattern, [](Data& d) { return find_argmin(d.begin(), d.end()) - d.begin(); });
+            bench_algorithm<int>("find_top_two", values, pattern, [](Data& d) { return find_top_two(d.begin(), d.end()).second; });
+            bench_algorithm<int>("find_second_largest", values, pattern, [](Data& d) { return find_second_largest(d.begin(), d.end()); });
+
+            bench_algorithm<int>("select_nth", values, pattern, [&](Data& d) { select_nth(d.begin(), d.begin() + k, d.end()); return d[k]; });
+            bench_algorithm<int>("deterministic_select_nth", values, pattern, [&](Data& d) { deterministic_select_nth(d.begin(), d.begin() + k, d.end()); return d[k]; });
+            bench_algorithm<int>("std::nth_element", values, pattern, [&](Data& d) { std::nth_element(d.begin(), d.begin() + k, d.end()); return d[k]; });
+            bench_algorithm<int>("quick_select", values, pattern, [&](Data& d) { return quick_select(d.begin(), d.end(), k); });
+            bench_algorithm<int>("deterministic_select", values, pattern, [&](Data& d) { return deterministic_select(d.begin(), d.end(), k); });
+            bench_algorithm<int>("parallel_quick_select", values, pattern, [&](Data& d) { return parallel_quick_select(d.begin(), d.end(), k); });
+            bench_algorithm<int>("parallel_deterministic_select", values, pattern, [&](Data& d) { return parallel_deterministic_select(d.begin(), d.end(), k); });
+            bench_algorithm<int>("select_top_k", values, pattern, [&](Data& d) { return *select_top_k(d.begin(), d.end(), top); });
+            bench_algorithm<int>("partial_quick_sort", values, pattern, [&](Data& d) { partial_quick_sort(d.begin(), d.begin() + top, d.end()); return first(d); });
+            bench_algorithm<int>("std::partial_sort", values, pattern, [&](Data& d) { std::partial_sort(d.begin(), d.begin() + top, d.end()); return first(d); });
+        }
+    }
+
+
+    void write_json(const std::string& path, int max_exponent)
+    {
+        std::ofstream out{path};
+        out << "{\n  \"max_elements\": 1e" << max_exponent << ",\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "\", \"operation\": \"" << result.operation;
+            out << "\", \"pattern\": \"" << result.pattern << "\", \"n\": " << result.n;
+            out << std::setprecision(6) << std::defaultfloat << ", \"ns_per_op\": " << result.ns_per_op;
+            out << ", \"allocations_per_op\": " << result.allocations_per_op << ", \"bytes_per_element\": " << result.bytes_per_element << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    int max_exponent = 6;
+    std::string json_path;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (option == "-n")
+            max_exponent = std::atoi(argv[i + 1]);
+        else if (option == "-f")
+            filter = argv[i + 1];
+        else if (option == "-o")
+            json_path = argv[i + 1];
+    }
+    max_exponent = std::min(8, std::max(3, max_exponent));
+
+    std::cout << std::left << std::setw(34) << "benchmark" << std::setw(10) << "operation" << std::setw(11) << "pattern";
+    std::cout << std::right << std::setw(11) << "n" << std::setw(12) << "ns/op" << std::setw(11) << "allocs/op";
+    std::cout << std::setw(11) << "bytes/el" << std::endl;
+
+    int n = 1;
+    for (int exponent = 1; exponent <= max_exponent; ++exponent)
+    {
+        n *= 10;
+        if (exponent < 3)
+            continue;
+        bench_containers(n);
+        bench_algorithms(n);
+    }
+
+    if (!json_path.empty())
+        write_json(json_path, max_exponent);
+    return 0;
+}
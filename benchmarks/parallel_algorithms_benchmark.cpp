@@ -0,0 +1,92 @@
+// This program measures how the parallel sorts and selections scale with the number of threads,
+// from 1 up to one per hardware thread (doubling each time, and always including the maximum).
+//
+// Each line reports the time for that thread count, and the speedup over the 1-thread run of the same algorithm;
+// with 1 thread every algorithm falls back to its sequential counterpart.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -pthread -I. benchmarks/parallel_algorithms_benchmark.cpp tools/ms_timer.cpp -o parallel_algorithms_benchmark
+//   ./parallel_algorithms_benchmark [size] [max threads]
+#include "algorithms/parallel_selection.hpp"
+#include "algorithms/parallel_sorting.hpp"
+#include "tools/ms_timer.hpp"
+#include "tools/task_pool.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    int size = 1 << 24;
+    long long checksum = 0;     // printed at the end, so the work cannot be optimized away
+
+    std::vector<int> make_input()
+    {
+        std::mt19937 random{12345};
+        std::vector<int> result(size);
+        for (int& item : result)
+            item = static_cast<int>(random() >> 1);
+        return result;
+    }
+
+    void run(const std::string& name, const std::vector<int>& thread_counts, const std::vector<int>& input,
+             const std::function<void(std::vector<int>&, int)>& algorithm)
+    {
+        double sequential = 0;
+        for (int threads : thread_counts)
+        {
+            std::vector<int> data{input};
+            ms_timer timer{true};
+            algorithm(data, threads);
+            timer.stop();
+
+            if (threads == 1)
+                sequential = timer.read();
+            std::cout << std::left << std::setw(32) << name << std::right << std::setw(4) << threads << " threads"
+                      << std::setw(12) << std::fixed << std::setprecision(2) << timer.read() << " ms"
+                      << std::setw(8) << std::setprecision(2) << sequential / timer.read() << "x" << std::endl;
+        }
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        size = std::atoi(argv[1]);
+    int max_threads = argc > 2 ? std::atoi(argv[2]) : TaskPool::shared().threads();
+
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+
+    // the pool has max_threads workers; an algorithm given fewer threads splits its work into fewer pieces
+    TaskPool pool{max_threads};
+    std::vector<int> input = make_input();
+    std::cout << size << " ints, up to " << max_threads << " threads" << std::endl;
+
+    run("parallel_merge_sort", thread_counts, input, [&](std::vector<int>& data, int threads) {
+        parallel_merge_sort(data.begin(), data.end(), std::less<int>{}, pool, threads);
+        checksum += data[data.size() / 2];
+    });
+    run("parallel_sample_sort", thread_counts, input, [&](std::vector<int>& data, int threads) {
+        parallel_sample_sort(data.begin(), data.end(), std::less<int>{}, pool, threads);
+        checksum += data[data.size() / 2];
+    });
+    run("parallel_quick_select", thread_counts, input, [&](std::vector<int>& data, int threads) {
+        checksum += parallel_quick_select(data.begin(), data.end(), size / 2, pool, threads);
+    });
+    run("parallel_deterministic_select", thread_counts, input, [&](std::vector<int>& data, int threads) {
+        checksum += parallel_deterministic_select(data.begin(), data.end(), size / 2, pool, threads);
+    });
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,200 @@
+// This program compares the default allocator against PoolAllocator and ArenaAllocator
+// on an insert/erase mix, for each of the node-based containers.
+//
+// Each round inserts a batch of keys and then erases most of them again,
+// so the containers continually free nodes and ask for new ones of the same size.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. benchmarks/pool_allocator_benchmark.cpp tools/ms_timer.cpp -o pool_allocator_benchmark
+//   ./pool_allocator_benchmark [rounds] [batch]
+#include "data_structures/binary_search_tree.hpp"
+#include "data_structures/hash_map.hpp"
+#include "data_structures/hash_set.hpp"
+#include "data_structures/linked_hash_set.hpp"
+#include "data_structures/linked_list.hpp"
+#include "data_structures/pool_allocator.hpp"
+#include "tools/ms_timer.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    int rounds = 50;
+    int batch = 20000;
+    long long checksum = 0;     // printed at the end, so the work cannot be optimized away
+
+    std::vector<int> make_keys()
+    {
+        std::vector<int> keys;
+        keys.reserve(batch);
+        unsigned int state = 12345;
+        for (int i = 0; i < batch; ++i)
+        {
+            state = state * 1103515245 + 12345;
+            keys.push_back(static_cast<int>(state >> 1));
+        }
+        return keys;
+    }
+
+    void report(const std::string& container, const std::string& allocator, double ms)
+    {
+        std::cout << std::left << std::setw(20) << container << std::setw(10) << allocator
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms" << std::endl;
+    }
+
+
+    template <typename List>
+    double run_linked_list(List list, const std::vector<int>& keys)
+    {
+        ms_timer timer{true};
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (int key : keys)
+            {
+                list.push_front(key);
+            }
+            for (int i = 0; i < batch * 9 / 10; ++i)
+            {
+                checksum += list.pop_front();
+            }
+        }
+        timer.stop();
+        checksum += list.size();
+        return timer.read();
+    }
+
+    template <typename Map>
+    double run_hash_map(Map map, const std::vector<int>& keys)
+    {
+        ms_timer timer{true};
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (int key : keys)
+            {
+                map[key + r] = r;
+            }
+            for (int i = 0; i < batch * 9 / 10; ++i)
+            {
+                if (map.contains(keys[i] + r))
+                {
+                    map.erase(keys[i] + r);
+                }
+            }
+        }
+        timer.stop();
+        checksum += map.size();
+        return timer.read();
+    }
+
+    template <typename Set>
+    double run_hash_set(Set set, const std::vector<int>& keys)
+    {
+        ms_timer timer{true};
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (int key : keys)
+            {
+                set.insert(key + r);
+            }
+            for (int i = 0; i < batch * 9 / 10; ++i)
+            {
+                if (set.contains(keys[i] + r))
+                {
+                    set.erase(keys[i] + r);
+                }
+            }
+        }
+        timer.stop();
+        checksum += set.size();
+        return timer.read();
+    }
+
+    template <typename Set>
+    double run_linked_hash_set(Set set, const std::vector<int>& keys)
+    {
+        ms_timer timer{true};
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (int key : keys)
+            {
+                set.insert(key + r);
+            }
+            for (int i = 0; i < batch * 9 / 10; ++i)
+            {
+                if (set.contains(keys[i] + r))
+                {
+                    set.erase(keys[i] + r);
+                }
+            }
+        }
+        timer.stop();
+        checksum += set.size();
+        return timer.read();
+    }
+
+    template <typename Tree>
+    double run_binary_search_tree(Tree tree, const std::vector<int>& keys)
+    {
+        // the tree is only filled and then discarded;
+        // node allocation and destruction both fall inside the timed region
+        ms_timer timer{true};
+        for (int r = 0; r < rounds / 10 + 1; ++r)
+        {
+            Tree copy{tree};
+            for (int key : keys)
+            {
+                copy.push(key);
+            }
+            checksum += copy.size();
+        }
+        timer.stop();
+        return timer.read();
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        rounds = std::atoi(argv[1]);
+    }
+    if (argc > 2)
+    {
+        batch = std::atoi(argv[2]);
+    }
+    std::vector<int> keys = make_keys();
+    std::cout << rounds << " rounds of " << batch << " inserts and " << batch * 9 / 10 << " erases" << std::endl;
+
+    report("LinkedList", "default", run_linked_list(LinkedList<int>{}, keys));
+    report("LinkedList", "pool", run_linked_list(LinkedList<int, PoolAllocator<int>>{PoolAllocator<int>{}}, keys));
+    report("LinkedList", "arena", run_linked_list(LinkedList<int, ArenaAllocator<int>>{ArenaAllocator<int>{}}, keys));
+
+    typedef std::pair<int, int> Pair;
+    report("HashMap", "default", run_hash_map(HashMap<int, int>{}, keys));
+    report("HashMap", "pool", run_hash_map(HashMap<int, int, std::hash<int>, PoolAllocator<Pair>>{PoolAllocator<Pair>{}}, keys));
+    report("HashMap", "arena", run_hash_map(HashMap<int, int, std::hash<int>, ArenaAllocator<Pair>>{ArenaAllocator<Pair>{}}, keys));
+
+    report("HashSet", "default", run_hash_set(HashSet<int>{}, keys));
+    report("HashSet", "pool", run_hash_set(HashSet<int, std::hash<int>, PoolAllocator<int>>{PoolAllocator<int>{}}, keys));
+    report("HashSet", "arena", run_hash_set(HashSet<int, std::hash<int>, ArenaAllocator<int>>{ArenaAllocator<int>{}}, keys));
+
+    report("LinkedHashSet", "default", run_linked_hash_set(LinkedHashSet<int>{}, keys));
+    report("LinkedHashSet", "pool", run_linked_hash_set(
+        LinkedHashSet<int, std::hash<int>, std::equal_to<int>, PoolAllocator<int>>{PoolAllocator<int>{}}, keys));
+    report("LinkedHashSet", "arena", run_linked_hash_set(
+        LinkedHashSet<int, std::hash<int>, std::equal_to<int>, ArenaAllocator<int>>{ArenaAllocator<int>{}}, keys));
+
+    report("BinarySearchTree", "default", run_binary_search_tree(BinarySearchTree<int>{}, keys));
+    report("BinarySearchTree", "pool", run_binary_search_tree(
+        BinarySearchTree<int, PoolAllocator<int>>{std::less<int>{}, PoolAllocator<int>{}}, keys));
+    report("BinarySearchTree", "arena", run_binary_search_tree(
+        BinarySearchTree<int, ArenaAllocator<int>>{std::less<int>{}, ArenaAllocator<int>{}}, keys));
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
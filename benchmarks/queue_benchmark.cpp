@@ -0,0 +1,108 @@
+// This program times Queue (unbounded, and bounded with try_push/try_pop) against std::queue
+// backed by std::list (Queue's former representation) and by std::deque.
+//
+// Each run streams the same number of messages through a queue that holds up to a fixed backlog
+// (push a batch of messages, then pop a batch), the way a pipeline stage does.
+// The batched run moves the same messages with push_range/pop_n instead.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. benchmarks/queue_benchmark.cpp tools/ms_timer.cpp -o queue_benchmark
+//   ./queue_benchmark [messages] [backlog]
+#include "data_structures/queue.hpp"
+#include "tools/ms_timer.hpp"
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <queue>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    int messages = 1 << 22;
+    int backlog = 1024;
+
+    struct Message
+    {
+        long long id;
+        int payload[6];
+    };
+
+    void run(const std::string& name, const std::function<long long()>& stream)
+    {
+        ms_timer timer{true};
+        long long checksum = stream();
+        timer.stop();
+        std::cout << std::left << std::setw(36) << name << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                  << timer.read() << " ms    (checksum " << checksum << ")" << std::endl;
+    }
+
+    template <typename StdQueue>
+    long long stream_std()
+    {
+        StdQueue queue;
+        long long checksum = 0;
+        for (int sent = 0; sent < messages; sent += backlog)
+        {
+            for (int i = 0; i < backlog; ++i)
+                queue.push(Message{sent + i, {}});
+            for (int i = 0; i < backlog; ++i)
+            {
+                checksum += queue.front().id;
+                queue.pop();
+            }
+        }
+        return checksum;
+    }
+
+    long long stream_queue(Queue<Message>& queue)
+    {
+        long long checksum = 0;
+        for (int sent = 0; sent < messages; sent += backlog)
+        {
+            for (int i = 0; i < backlog; ++i)
+                queue.try_push(Message{sent + i, {}});
+            Message message;
+            while (queue.try_pop(message))
+                checksum += message.id;
+        }
+        return checksum;
+    }
+
+    long long stream_batches(Queue<Message>& queue)
+    {
+        std::vector<Message> batch(backlog);
+        long long checksum = 0;
+        for (int sent = 0; sent < messages; sent += backlog)
+        {
+            for (int i = 0; i < backlog; ++i)
+                batch[i].id = sent + i;
+            queue.push_range(batch.begin(), batch.end());
+            queue.pop_n(backlog, batch.begin());
+            for (const Message& message : batch)
+                checksum += message.id;
+        }
+        return checksum;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        messages = std::atoi(argv[1]);
+    if (argc > 2)
+        backlog = std::atoi(argv[2]);
+    std::cout << messages << " messages, backlog of " << backlog << std::endl;
+
+    run("std::queue<std::list>", stream_std<std::queue<Message, std::list<Message>>>);
+    run("std::queue<std::deque>", stream_std<std::queue<Message, std::deque<Message>>>);
+    run("Queue (unbounded)", [] { Queue<Message> queue; return stream_queue(queue); });
+    run("Queue (bounded)", [] { Queue<Message> queue{backlog}; return stream_queue(queue); });
+    run("Queue (bounded, push_range/pop_n)", [] { Queue<Message> queue{backlog}; return stream_batches(queue); });
+    return 0;
+}
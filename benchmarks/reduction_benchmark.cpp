@@ -0,0 +1,102 @@
+// This program times the reductions in algorithms/selection.hpp (vectorized on contiguous arrays of int and float)
+// against their std:: counterparts, over consecutive windows of a large array.
+//
+// Every window's results are checked against the std:: ones.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. benchmarks/reduction_benchmark.cpp tools/ms_timer.cpp -o reduction_benchmark
+//   ./reduction_benchmark [size] [window]
+#include "algorithms/selection.hpp"
+#include "tools/ms_timer.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    int size = 1 << 24;
+    int window = 4096;
+
+    template <typename T>
+    std::vector<T> make_input()
+    {
+        std::mt19937 random{12345};
+        std::vector<T> result(size);
+        for (T& item : result)
+            item = static_cast<T>(static_cast<int>(random()) / 1024);
+        return result;
+    }
+
+    // runs reduce over every window, and returns the sum of its results (so that they are all checked, and not optimized away)
+    template <typename T>
+    double run(const std::string& name, const std::vector<T>& input, const std::function<double(const T*, const T*)>& reduce)
+    {
+        double total = 0;
+        ms_timer timer{true};
+        for (int start = 0; start + window <= size; start += window)
+            total += reduce(input.data() + start, input.data() + start + window);
+        timer.stop();
+
+        std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                  << timer.read() << " ms" << std::endl;
+        return total;
+    }
+
+    template <typename T>
+    void run_all(const std::string& type)
+    {
+        std::vector<T> input = make_input<T>();
+        std::cout << size / window << " windows of " << window << " " << type << "s" << std::endl;
+
+        auto check = [](const std::string& name, double expected, double actual) {
+            if (expected != actual)
+                std::cout << "    WRONG " << name << std::endl;
+        };
+
+        double expected = run<T>("std::max_element", input, [](const T* first, const T* last) { return *std::max_element(first, last); });
+        check("find_maximum", expected, run<T>("find_maximum", input, [](const T* first, const T* last) { return find_maximum(first, last); }));
+
+        expected = run<T>("std::minmax_element", input, [](const T* first, const T* last) {
+            auto extremes = std::minmax_element(first, last);
+            return *extremes.first + 2.0 * *extremes.second;
+        });
+        check("find_minmax", expected, run<T>("find_minmax", input, [](const T* first, const T* last) {
+            auto extremes = find_minmax(first, last);
+            return extremes.first + 2.0 * extremes.second;
+        }));
+
+        expected = run<T>("std::max_element (position)", input, [](const T* first, const T* last) { return std::max_element(first, last) - first; });
+        check("find_argmax", expected, run<T>("find_argmax", input, [](const T* first, const T* last) { return find_argmax(first, last) - first; }));
+
+        std::vector<T> scratch(window);
+        expected = run<T>("std::partial_sort_copy (top 2)", input, [&scratch](const T* first, const T* last) {
+            std::partial_sort_copy(first, last, scratch.begin(), scratch.begin() + 2, std::greater<T>{});
+            return scratch[0] + 2.0 * scratch[1];
+        });
+        check("find_top_two", expected, run<T>("find_top_two", input, [](const T* first, const T* last) {
+            auto top_two = find_top_two(first, last);
+            return top_two.first + 2.0 * top_two.second;
+        }));
+        std::cout << std::endl;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        size = std::atoi(argv[1]);
+    if (argc > 2)
+        window = std::atoi(argv[2]);
+
+    run_all<int>("int");
+    run_all<float>("float");
+    return 0;
+}
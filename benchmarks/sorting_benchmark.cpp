@@ -0,0 +1,117 @@
+// This program times quick_sort, heap_sort and radix_sort from algorithms/sorting.hpp against std::sort,
+// on random, sorted, reverse-sorted and low-cardinality (16 distinct keys) inputs.
+// It then sorts records with 64-bit keys (quick_sort and radix_sort against std::stable_sort),
+// and random strings (string_radix_sort against std::sort).
+//
+// Every sort gets its own copy of the same input, and its result is checked against std::sort's (or std::stable_sort's).
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. benchmarks/sorting_benchmark.cpp tools/ms_timer.cpp -o sorting_benchmark
+//   ./sorting_benchmark [size]
+#include "algorithms/sorting.hpp"
+#include "tools/ms_timer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    int size = 1000000;
+
+    struct Record
+    {
+        std::int64_t key;
+        int payload[3];
+    };
+
+    bool operator==(const Record& a, const Record& b)
+    {
+        return a.key == b.key && a.payload[0] == b.payload[0];
+    }
+
+    std::vector<int> make_input(const std::string& order)
+    {
+        std::mt19937 random{12345};
+        std::vector<int> result(size);
+        for (int i = 0; i < size; ++i)
+        {
+            if (order == "random")
+                result[i] = static_cast<int>(random());
+            else if (order == "sorted")
+                result[i] = i;
+            else if (order == "reversed")
+                result[i] = size - i;
+            else
+                result[i] = static_cast<int>(random() % 16);
+        }
+        return result;
+    }
+
+    template <typename T>
+    void run(const std::string& name, const std::string& order, const std::vector<T>& input, const std::vector<T>& expected,
+             const std::function<void(std::vector<T>&)>& sort)
+    {
+        std::vector<T> data{input};
+        ms_timer timer{true};
+        sort(data);
+        timer.stop();
+
+        std::cout << std::left << std::setw(20) << name << std::setw(16) << order
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << timer.read() << " ms"
+                  << (data == expected ? "" : "    WRONG") << std::endl;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        size = std::atoi(argv[1]);
+    std::cout << "sorting " << size << " ints" << std::endl;
+
+    for (const std::string order : {"random", "sorted", "reversed", "low-cardinality"})
+    {
+        std::vector<int> input = make_input(order);
+        std::vector<int> expected{input};
+        std::sort(expected.begin(), expected.end());
+
+        run<int>("std::sort", order, input, expected, [](std::vector<int>& v) { std::sort(v.begin(), v.end()); });
+        run<int>("quick_sort", order, input, expected, [](std::vector<int>& v) { quick_sort(v.begin(), v.end()); });
+        run<int>("heap_sort", order, input, expected, [](std::vector<int>& v) { heap_sort(v.begin(), v.end()); });
+        run<int>("radix_sort", order, input, expected, [](std::vector<int>& v) { radix_sort(v.begin(), v.end()); });
+    }
+
+    std::mt19937_64 random{12345};
+    std::vector<Record> records(size);
+    for (int i = 0; i < size; ++i)
+        records[i] = Record{static_cast<std::int64_t>(random()), {i, i, i}};
+    auto key_less = [](const Record& a, const Record& b) { return a.key < b.key; };
+    std::vector<Record> sorted_records{records};
+    std::stable_sort(sorted_records.begin(), sorted_records.end(), key_less);
+
+    run<Record>("std::stable_sort", "records", records, sorted_records,
+                [&](std::vector<Record>& v) { std::stable_sort(v.begin(), v.end(), key_less); });
+    run<Record>("quick_sort", "records", records, sorted_records,
+                [&](std::vector<Record>& v) { quick_sort(v.begin(), v.end(), key_less); });
+    run<Record>("radix_sort", "records", records, sorted_records,
+                [](std::vector<Record>& v) { radix_sort(v.begin(), v.end(), [](const Record& r) { return r.key; }); });
+
+    std::vector<std::string> strings(size);
+    for (std::string& item : strings)
+        item = std::to_string(random() % 1000000) + "-" + std::to_string(random());
+    std::vector<std::string> sorted_strings{strings};
+    std::sort(sorted_strings.begin(), sorted_strings.end());
+
+    run<std::string>("std::sort", "strings", strings, sorted_strings,
+                     [](std::vector<std::string>& v) { std::sort(v.begin(), v.end()); });
+    run<std::string>("string_radix_sort", "strings", strings, sorted_strings,
+                     [](std::vector<std::string>& v) { string_radix_sort(v.begin(), v.end()); });
+    return 0;
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "fifo_algorithm.hpp"
 
 
@@ -7,23 +8,34 @@ bool FIFOAlgorithm::empty() const
     return processes.empty();
 }
 
-Process& FIFOAlgorithm::get_next_process()
+int FIFOAlgorithm::next_process()
 {
     return processes.front();
 }
 
-void FIFOAlgorithm::add_process(const Process& process)
+void FIFOAlgorithm::add_process(int pid)
 {
-    processes.push_back(process);
+    processes.push_back(pid);
 }
 
 int FIFOAlgorithm::pop_next_process()
 {
-    int pid = processes.front().id();
+    int pid = processes.front();
     processes.pop_front();
     return pid;
 }
 
+int FIFOAlgorithm::steal_process()
+{
+    if (processes.size() < 2)
+    {
+        return -1;
+    }
+    int pid = processes.back();
+    processes.pop_back();
+    return pid;
+}
+
 std::string FIFOAlgorithm::name() const
 {
     return "FIFO";
@@ -36,12 +48,25 @@ std::string FIFOAlgorithm::to_string() const
     if (!empty())
     {
         auto i = processes.begin();
-        buf << *(i++);
+        buf << process(*(i++));
         for (; i != processes.end(); ++i)
         {
-            buf << ", " << *i;
+            buf << ", " << process(*i);
         }
     }
     buf << ")";
     return buf.str();
-}
\ No newline at end of file
+}
+
+std::vector<int> FIFOAlgorithm::completion_times(const std::vector<Process>& processes) const
+{
+    // each process runs to completion in arrival order, starting once it has arrived and the one before has finished
+    std::vector<int> result(processes.size());
+    int clock = 0;
+    for (int pid: arrival_order(processes))
+    {
+        clock = std::max(clock, processes[pid].arrival_time()) + processes[pid].run_time();
+        result[pid] = clock;
+    }
+    return result;
+}
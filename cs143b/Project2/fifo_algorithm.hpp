@@ -2,25 +2,28 @@
 #define PROJECT2_FIFO_ALGORITHM_HPP
 
 #include <deque>
+#include <vector>
 #include "scheduling_algorithm.hpp"
 
 
-class FIFOAlgorithm : public SchedulingAlgorithm
+class FIFOAlgorithm final : public SchedulingAlgorithm
 {
 public:
     // inherit SchedulingAlgorithm constructor
     using SchedulingAlgorithm::SchedulingAlgorithm;
 
     virtual bool empty() const override;
-    virtual Process& get_next_process() override;
-    virtual void add_process(const Process& process) override;
+    virtual int next_process() override;
+    virtual void add_process(int pid) override;
     virtual int pop_next_process() override;
+    virtual int steal_process() override;
 
     virtual std::string name() const override;
     virtual std::string to_string() const override;
+    virtual std::vector<int> completion_times(const std::vector<Process>& processes) const override;
 
 private:
-    std::deque<Process> processes;
+    std::deque<int> processes;     // pids
 };
 
 #endif //PROJECT2_FIFO_ALGORITHM_HPP
@@ -1,9 +1,19 @@
+// Runs the four scheduling algorithms on each input, and prints each input's times (FIFO, SJF, SRT, then MLF):
+//   Project2 [-j threads] [input files ...]
+// With no input files, reads tests/sample_input.txt and writes tests/__OUT.txt.
+// Every (input, algorithm) run is independent, so they all run at once on a TaskPool (-j threads, by default one
+// per hardware thread); the times are printed after, in input order, whichever run finished first.
+#include <cstdlib>
+#include <exception>
 #include <fstream>
 #include <iostream>
-#include <sstream>
-#include <utility>
 #include <string>
-#include <cctype>
+#include <utility>
+#include <vector>
+#include "tools/span_timer.hpp"
+#include "tools/task_pool.hpp"
+#include "process_trace.hpp"
+#include "schedule_result.hpp"
 #include "scheduler.hpp"
 #include "fifo_algorithm.hpp"
 #include "sjf_algorithm.hpp"
@@ -11,91 +21,98 @@
 #include "mlf_algorithm.hpp"
 
 
-std::vector<std::pair<int, int>> process_file(std::ifstream& file)
-{
-    std::vector<std::pair<int, int>> result;
-
-    for (std::string line; std::getline(file, line);)
-    {
-        std::istringstream processor{line};
-        while (processor)
-        {
-            char c = processor.peek();
-            if (!(std::isspace(c) || std::isdigit(c)))
-            {
-                break;
-            }
-            int arrival_time, total_time;
-            processor >> arrival_time;
-            processor >> total_time;
-
-            result.push_back(std::make_pair(arrival_time, total_time));
-        }
-        break;  // input file is 1 line long
-    }
-
-    return result;
-}
-
+const int ALGORITHMS = 4;
 
 template <typename Algorithm>
-Scheduler create()
+Scheduler create(Scheduler::Mode mode = Scheduler::Mode::EVENT)
 {
-    return Scheduler{new Algorithm};
+    return Scheduler{new Algorithm, mode};
 }
 
 template <typename Algorithm>
-void create_from_file(std::ifstream& file)
+ScheduleResult run_from_trace(const ProcessTrace& trace)
 {
-    std::vector<std::pair<int, int>> process_info = process_file(file);
-
     Scheduler s = create<Algorithm>();
-    for (const auto& pair: process_info)
+    for (std::size_t i = 0; i < trace.size(); ++i)
     {
+        std::pair<int, int> pair = trace[i];
         s.read_process(pair.first, pair.second);
     }
-    s.start();
+    s.run();
+    return s.result();
 }
 
-void run_all_from_file(std::ifstream& file)
+ScheduleResult run_one(const ProcessTrace& trace, int algorithm)
 {
-    std::vector<std::pair<int, int>> process_info = process_file(file);
-    Scheduler fifo = create<FIFOAlgorithm>();
-    Scheduler sjf = create<SJFAlgorithm>();
-    Scheduler srt = create<SRTAlgorithm>();
-    Scheduler mlf = create<MLFAlgorithm>();
-
-    for (const auto& pair: process_info)
+    switch (algorithm)
     {
-        fifo.read_process(pair.first, pair.second);
-        sjf.read_process(pair.first, pair.second);
-        srt.read_process(pair.first, pair.second);
-        mlf.read_process(pair.first, pair.second);
+        case 0:
+            return run_from_trace<FIFOAlgorithm>(trace);
+        case 1:
+            return run_from_trace<SJFAlgorithm>(trace);
+        case 2:
+            return run_from_trace<SRTAlgorithm>(trace);
+        default:
+            return run_from_trace<MLFAlgorithm>(trace);
     }
+}
 
-    fifo.start();
-    sjf.start();
-    srt.start();
-    mlf.start();
+/* Returns every trace's results, ALGORITHMS per trace, in order */
+std::vector<ScheduleResult> run_all_from_traces(const std::vector<ProcessTrace>& traces, TaskPool& pool)
+{
+    std::vector<ScheduleResult> results(traces.size() * ALGORITHMS);
+    pool.parallel_for(results.size(), [&](int run){
+        results[run] = run_one(traces[run / ALGORITHMS], run % ALGORITHMS);
+    });
+    return results;
 }
 
 
-int main()
+int main(int argc, char** argv)
 {
-    std::string file_path = "tests/sample_input.txt";
-    std::ifstream infile{file_path};
+    int threads = 0;
+    int first = 1;
+    if (argc > 2 && std::string{argv[1]} == "-j")
+    {
+        threads = std::atoi(argv[2]);
+        first = 3;
+    }
 
-    std::string outfile_path = "tests/__OUT.txt";
-    std::ofstream outfile{outfile_path};
+    std::vector<std::string> file_paths{argv + first, argv + argc};
+    bool defaults = file_paths.empty();
+    if (defaults)
+    {
+        file_paths.push_back("tests/sample_input.txt");
+    }
 
-    // -----------------------------------------
-    // redirect std::cout to outfile
-    auto buf = std::cout.rdbuf(outfile.rdbuf());
+    try
+    {
+        std::vector<ProcessTrace> traces;
+        for (const std::string& path: file_paths)
+        {
+            traces.push_back(ProcessTrace::from_text(path));
+        }
 
-    run_all_from_file(infile);
+        TaskPool pool{threads};
+        std::vector<ScheduleResult> results = run_all_from_traces(traces, pool);
 
-    // restore std::cout
-    std::cout.rdbuf(buf);
+        std::ofstream outfile;
+        if (defaults)
+        {
+            outfile.open("tests/__OUT.txt");
+        }
+        std::ostream& out = defaults ? outfile : std::cout;
+        for (const ScheduleResult& result: results)
+        {
+            result.print(out);
+        }
+        span_report(std::cerr);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
     return 0;
-}
\ No newline at end of file
+}
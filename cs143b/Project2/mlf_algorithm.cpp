@@ -1,58 +1,126 @@
-#include <map>
+#include <algorithm>
+#include <climits>
 #include <vector>
-#include <cmath>
 #include "mlf_algorithm.hpp"
 
 
+namespace
+{
+    inline int count_leading_zeros(uint64_t word)     // word must not be 0
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(word);
+#else
+        int result = 0;
+        for (uint64_t bit = uint64_t{1} << 63; (word & bit) == 0; bit >>= 1)
+        {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    inline int count_trailing_zeros(uint64_t word)     // word must not be 0
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int result = 0;
+        for (; (word & 1) == 0; word >>= 1)
+        {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    inline uint64_t level_bit(int level)
+    {
+        return uint64_t{1} << (63 - level);
+    }
+
+    std::vector<int> doubling_quanta(int levels)
+    {
+        std::vector<int> result;
+        for (int level = 0; level < levels; ++level)
+        {
+            result.push_back(1 << level);
+        }
+        return result;
+    }
+}
+
+
+const int MLFAlgorithm::MAX_LEVELS = 64;
+const int MLFAlgorithm::DEFAULT_LEVELS = 31;
+
 MLFAlgorithm::MLFAlgorithm()
-    : comparator{[this](const Process& a, const Process& b){ return priorities[a.id()].priority == priorities[b.id()].priority ?
-                                                                    priorities[a.id()].entered > priorities[b.id()].entered :
-                                                                    priorities[a.id()].priority > priorities[b.id()].priority; }},
-      processes{comparator}
+    : MLFAlgorithm{doubling_quanta(DEFAULT_LEVELS)}
+{
+}
+
+MLFAlgorithm::MLFAlgorithm(const std::vector<int>& level_quanta)
+    : quanta{level_quanta},
+      ready{static_cast<int>(level_quanta.size())}
 {
+    check_quanta();
 }
 
 bool MLFAlgorithm::empty() const
 {
-    return processes.empty();
+    return ready.empty();
 }
 
-Process& MLFAlgorithm::get_next_process()
+int MLFAlgorithm::next_process()
 {
-    Process& next = processes.top();
-    if (next.finishes_next())
+    int level = ready.first();
+    int pid = ready.queues[level].front();
+    if (!process(pid).finishes_next() && ++used[pid] >= quanta[level])
     {
-        return next;
+        // it runs this cycle, then waits at the back of the next level
+        ready.pop(level);
+        ready.push(std::min(level + 1, levels() - 1), pid);
+        used[pid] = 0;
     }
-    else
-    {
-        Process copy = next;
-        int pid = copy.id();
-        PriorityInfo& info = priorities[pid];
-
-        info.quantum += 1;
-        if (info.ready_for_preempt())
-        {
-            info.preempt();
-        }
+    return pid;
+}
 
-        processes.pop();
-        processes.push(copy);
-        return processes.get(copy);
+void MLFAlgorithm::add_process(int pid)
+{
+    if (pid >= static_cast<int>(used.size()))
+    {
+        used.resize(pid + 1);
     }
+    used[pid] = 0;
+    ready.push(0, pid);
 }
 
-void MLFAlgorithm::add_process(const Process& process)
+int MLFAlgorithm::pop_next_process()
 {
-    priorities[process.id()] = PriorityInfo{0, 0, Process::clock_time()};
-    processes.push(process);
+    if (empty())
+    {
+        throw AlgorithmException{"MLFAlgorithm::pop_next_process - empty"};
+    }
+
+    int level = ready.first();
+    int pid = ready.queues[level].front();
+    ready.pop(level);
+    return pid;
 }
 
-int MLFAlgorithm::pop_next_process()
+int MLFAlgorithm::steal_process()
 {
-    int pid = processes.top().id();
-    priorities.erase(pid);
-    processes.pop();
+    if (empty())
+    {
+        return -1;
+    }
+    int last = ready.last();
+    if (last == ready.first() && ready.queues[last].size() < 2)
+    {
+        return -1;
+    }
+    int pid = ready.queues[last].back();
+    ready.pop_back(last);
     return pid;
 }
 
@@ -64,36 +132,146 @@ std::string MLFAlgorithm::name() const
 std::string MLFAlgorithm::to_string() const
 {
     std::ostringstream buf;
-    std::map<int, std::vector<int>> sorted;
-    for (const auto& pair: priorities)
-    {
-        int pid = pair.first;
-        const MLFAlgorithm::PriorityInfo& info = pair.second;
-        sorted[info.priority].push_back(pid);
-    }
-
     buf << "MLF(" << std::endl;
-    for (const auto& pair: sorted)
+    for (int level = 0; level < levels(); ++level)
     {
-        buf << "  " << pair.first << ": [";
-        for (const auto& pid: pair.second)
+        if (!ready.queues[level].empty())
         {
-            buf << pid << ", ";
+            buf << "  " << level << ": [";
+            for (int pid: ready.queues[level])
+            {
+                buf << pid << ", ";
+            }
+            buf << "]," << std::endl;
         }
-        buf << "]," << std::endl;
     }
     buf << ")";
     return buf.str();
 }
 
-bool MLFAlgorithm::PriorityInfo::ready_for_preempt() const
+int MLFAlgorithm::levels() const
 {
-    return quantum >= std::pow(2, priority);
+    return quanta.size();
 }
 
-void MLFAlgorithm::PriorityInfo::preempt()
+int MLFAlgorithm::quantum(int level) const
 {
-    quantum = 0;
-    ++priority;
-    entered = Process::clock_time();
-}
\ No newline at end of file
+    if (level < 0 || level >= levels())
+    {
+        throw AlgorithmException{"MLFAlgorithm::quantum - no such level"};
+    }
+    return quanta[level];
+}
+
+void MLFAlgorithm::check_quanta() const
+{
+    if (quanta.empty() || levels() > MAX_LEVELS)
+    {
+        std::ostringstream buf;
+        buf << "MLFAlgorithm - needs 1 to " << MAX_LEVELS << " levels, not " << levels();
+        throw AlgorithmException{buf.str()};
+    }
+    for (int level = 0; level < levels(); ++level)
+    {
+        if (quanta[level] < 1)
+        {
+            std::ostringstream buf;
+            buf << "MLFAlgorithm - level " << level << " has a quantum of " << quanta[level] << " cycles";
+            throw AlgorithmException{buf.str()};
+        }
+    }
+}
+
+std::vector<int> MLFAlgorithm::completion_times(const std::vector<Process>& processes) const
+{
+    // The front process of the first non-empty level runs until it finishes, uses up its quantum,
+    // or the next process arrives, whichever is soonest; only an arrival can change what runs in between.
+    LevelQueues waiting{levels()};
+    std::vector<int> run_at_level(processes.size());
+    std::vector<int> remaining(processes.size());
+    std::vector<int> order = arrival_order(processes);
+    std::vector<int> result(processes.size());
+    std::size_t arrived = 0;
+    int clock = 0;
+
+    for (std::size_t finished = 0; finished < processes.size(); )
+    {
+        if (waiting.empty())
+        {
+            clock = std::max(clock, processes[order[arrived]].arrival_time());
+        }
+        for (; arrived < order.size() && processes[order[arrived]].arrival_time() <= clock; ++arrived)
+        {
+            int pid = order[arrived];
+            run_at_level[pid] = 0;
+            remaining[pid] = processes[pid].run_time();
+            waiting.push(0, pid);
+        }
+
+        int first = waiting.first();
+        int pid = waiting.queues[first].front();
+        int until_arrival = arrived < order.size() ? processes[order[arrived]].arrival_time() - clock : INT_MAX;
+        int cycles = std::min({remaining[pid], quanta[first] - run_at_level[pid], until_arrival});
+        clock += cycles;
+        remaining[pid] -= cycles;
+        run_at_level[pid] += cycles;
+
+        if (remaining[pid] == 0)
+        {
+            result[pid] = clock;
+            waiting.pop(first);
+            ++finished;
+        }
+        else if (run_at_level[pid] == quanta[first])
+        {
+            run_at_level[pid] = 0;
+            waiting.pop(first);
+            waiting.push(std::min(first + 1, levels() - 1), pid);
+        }
+    }
+    return result;
+}
+
+MLFAlgorithm::LevelQueues::LevelQueues(int levels)
+    : queues(levels), non_empty{0}
+{
+}
+
+bool MLFAlgorithm::LevelQueues::empty() const
+{
+    return non_empty == 0;
+}
+
+int MLFAlgorithm::LevelQueues::first() const
+{
+    return count_leading_zeros(non_empty);
+}
+
+int MLFAlgorithm::LevelQueues::last() const
+{
+    return 63 - count_trailing_zeros(non_empty);
+}
+
+void MLFAlgorithm::LevelQueues::push(int level, int pid)
+{
+    queues[level].push(pid);
+    non_empty |= level_bit(level);
+}
+
+void MLFAlgorithm::LevelQueues::pop(int level)
+{
+    queues[level].pop();
+    if (queues[level].empty())
+    {
+        non_empty &= ~level_bit(level);
+    }
+}
+
+void MLFAlgorithm::LevelQueues::pop_back(int level)
+{
+    queues[level].pop_back();
+    if (queues[level].empty())
+    {
+        non_empty &= ~level_bit(level);
+    }
+}
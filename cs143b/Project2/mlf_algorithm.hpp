@@ -1,45 +1,72 @@
 #ifndef PROJECT2_MLF_ALGORITHM_HPP
 #define PROJECT2_MLF_ALGORITHM_HPP
 
-#include <functional>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "data_structures/queue.hpp"
 #include "scheduling_algorithm.hpp"
-#include "mlf_queue.hpp"
 
 
 
-class MLFAlgorithm : public SchedulingAlgorithm
+// One FIFO ring of pids per priority level, level 0 first.
+// A process enters level 0, and drops a level whenever it has run for that level's quantum there
+// (on the last level, it goes to the back of it instead). The front of the first non-empty level runs;
+// a bitmask of the non-empty levels finds it with one count-leading-zeros.
+class MLFAlgorithm final : public SchedulingAlgorithm
 {
 public:
+    static const int MAX_LEVELS;        // 64, one per bit of the mask
+    static const int DEFAULT_LEVELS;    // 31
+
+    /* Makes DEFAULT_LEVELS levels, where level i's quantum is 2^i cycles;
+     * a process of any (int) run time finishes before it would run out of levels
+     */
     MLFAlgorithm();
 
+    /* Makes one level per quantum, in order.
+     * Throws an AlgorithmException unless there are 1 to MAX_LEVELS quanta, all positive.
+     */
+    explicit MLFAlgorithm(const std::vector<int>& level_quanta);
+
     virtual bool empty() const override;
-    virtual Process& get_next_process() override;
-    virtual void add_process(const Process& process) override;
+    virtual int next_process() override;
+    virtual void add_process(int pid) override;
     virtual int pop_next_process() override;
+    virtual int steal_process() override;
 
     virtual std::string name() const override;
     virtual std::string to_string() const override;
+    virtual std::vector<int> completion_times(const std::vector<Process>& processes) const override;
+
+    int levels() const;
+    int quantum(int level) const;
 
 
 private:
-    struct PriorityInfo
+    struct LevelQueues
     {
-        int priority;
-        int quantum;    // time spent so far in the current priority level
-        int entered;    // time entered the current priority level
+        std::vector<Queue<int>> queues;     // the pids at each level, in the order they entered it
+        uint64_t non_empty;                 // bit (63 - level) is set iff queues[level] is not empty
+
+        explicit LevelQueues(int levels);
+
+        bool empty() const;
+
+        /* Return the first and the last non-empty level; there must be one */
+        int first() const;
+        int last() const;
 
-        bool ready_for_preempt() const;
-        void preempt();
+        void push(int level, int pid);
+        void pop(int level);
+        void pop_back(int level);
     };
 
-    typedef std::function<bool(const Process&, const Process&)> MLFComparator;
-    typedef MLFQueue<Process> PriorityQueue;
+    std::vector<int> quanta;
+    LevelQueues ready;
+    std::vector<int> used;      // {pid: the cycles it has run at its current level}
 
-    std::unordered_map<int, PriorityInfo> priorities;    // {pid: PriorityInfo}
-    MLFComparator comparator;
-    PriorityQueue processes;
+    void check_quanta() const;
 };
 
 #endif //PROJECT2_MLF_ALGORITHM_HPP
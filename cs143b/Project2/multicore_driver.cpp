@@ -0,0 +1,77 @@
+// Runs an input through the four scheduling algorithms on several CPUs, and prints each algorithm's times,
+// overall and per CPU (MultiCoreScheduler::print_times):
+//   multicore [-c cpus] <input file | binary trace>
+// cpus defaults to 4.
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "multicore_scheduler.hpp"
+#include "process_trace.hpp"
+#include "fifo_algorithm.hpp"
+#include "sjf_algorithm.hpp"
+#include "srt_algorithm.hpp"
+#include "mlf_algorithm.hpp"
+
+
+template <typename Algorithm>
+void run_on(const ProcessTrace& trace, int cpus)
+{
+    std::vector<SchedulingAlgorithm*> algorithms;
+    for (int cpu = 0; cpu < cpus; ++cpu)
+    {
+        algorithms.push_back(new Algorithm);
+    }
+    MultiCoreScheduler scheduler{algorithms};
+    for (std::size_t i = 0; i < trace.size(); ++i)
+    {
+        std::pair<int, int> pair = trace[i];
+        scheduler.read_process(pair.first, pair.second);
+    }
+
+    std::cout << algorithms.front()->name() << " on " << cpus << " cpus" << std::endl;
+    scheduler.start();
+    std::cout << scheduler.cycles() << " cycles" << std::endl;
+}
+
+bool is_binary_trace(const std::string& path)
+{
+    MappedFile file{path};
+    return file.size() >= 4 && std::memcmp(file.data(), "TRCE", 4) == 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    int cpus = 4;
+    int first = 1;
+    if (argc > 2 && std::string{argv[1]} == "-c")
+    {
+        cpus = std::atoi(argv[2]);
+        first = 3;
+    }
+    if (argc - first != 1 || cpus < 1)
+    {
+        std::cerr << "usage: " << argv[0] << " [-c cpus] <input file | binary trace>" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        std::string path = argv[first];
+        ProcessTrace trace = is_binary_trace(path) ? ProcessTrace::from_binary(path) : ProcessTrace::from_text(path);
+        run_on<FIFOAlgorithm>(trace, cpus);
+        run_on<SJFAlgorithm>(trace, cpus);
+        run_on<SRTAlgorithm>(trace, cpus);
+        run_on<MLFAlgorithm>(trace, cpus);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
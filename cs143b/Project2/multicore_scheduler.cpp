@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "multicore_scheduler.hpp"
+#include "algorithm_exception.hpp"
+
+
+namespace
+{
+    double average_time(const std::map<int, int>& stats, const std::vector<int>& pids)
+    {
+        if (pids.empty())
+        {
+            return 0;
+        }
+        long long sum = 0;
+        for (int pid: pids)
+        {
+            sum += stats.at(pid);
+        }
+        return sum / static_cast<double>(pids.size());
+    }
+}
+
+
+MultiCoreScheduler::MultiCoreScheduler(const std::vector<SchedulingAlgorithm*>& the_algorithms)
+    : next_pending{0},
+      pending_sorted{true},
+      unfinished{0},
+      clock{0}
+{
+    for (SchedulingAlgorithm* algorithm: the_algorithms)
+    {
+        processors.push_back(CPU{algorithm, 0, -1, 0, 0, 0, {}});
+        algorithm->set_process_table(table);
+    }
+    if (processors.empty())
+    {
+        throw AlgorithmException{"MultiCoreScheduler - needs at least 1 CPU"};
+    }
+}
+
+MultiCoreScheduler::~MultiCoreScheduler()
+{
+    for (CPU& cpu: processors)
+    {
+        delete cpu.algorithm;
+    }
+}
+
+MultiCoreScheduler::operator bool() const
+{
+    if (unfinished == 0 && !ready_queue.empty())
+    {
+        throw AlgorithmException{"processes and ready_queue out of sync; both should be empty"};
+    }
+    return unfinished != 0;
+}
+
+int MultiCoreScheduler::operator++()
+{
+    load();
+    for (int cpu = 0; cpu < cpus(); ++cpu)
+    {
+        if (processors[cpu].queued == 0)
+        {
+            balance(cpu);
+        }
+    }
+    for (int cpu = 0; cpu < cpus(); ++cpu)
+    {
+        run(cpu);
+    }
+
+    // every arrived process that did not run this cycle waited through it
+    for (int pid: ready_queue)
+    {
+        if (processors[cpu_of[pid]].running != pid)
+        {
+            table[pid].wait();
+        }
+    }
+    return ++clock;
+}
+
+void MultiCoreScheduler::read_process(int arrival_time, int total_time)
+{
+    int pid = table.size();
+    table.push_back(Process{pid, arrival_time, total_time});
+    ready_position.push_back(-1);
+    cpu_of.push_back(-1);
+    pending_sorted = pending_sorted && (pending.size() == next_pending || table[pending.back()].arrival_time() <= arrival_time);
+    pending.push_back(pid);
+    ++unfinished;
+}
+
+void MultiCoreScheduler::start()
+{
+    // processes that arrived before the clock started are never loaded (as in Scheduler), so never finish
+    while (*this && (!ready_queue.empty() || next_pending < pending.size()))
+    {
+        operator++();
+    }
+    print_times();
+}
+
+int MultiCoreScheduler::cpus() const
+{
+    return processors.size();
+}
+
+int MultiCoreScheduler::cycles() const
+{
+    return clock;
+}
+
+int MultiCoreScheduler::busy_cycles(int cpu) const
+{
+    check_cpu(cpu);
+    return processors[cpu].busy;
+}
+
+double MultiCoreScheduler::utilization(int cpu) const
+{
+    check_cpu(cpu);
+    return clock == 0 ? 0 : processors[cpu].busy / static_cast<double>(clock);
+}
+
+int MultiCoreScheduler::migrations_in(int cpu) const
+{
+    check_cpu(cpu);
+    return processors[cpu].stolen;
+}
+
+int MultiCoreScheduler::migrations_out(int cpu) const
+{
+    check_cpu(cpu);
+    return processors[cpu].lost;
+}
+
+const std::vector<int>& MultiCoreScheduler::finished_on(int cpu) const
+{
+    check_cpu(cpu);
+    return processors[cpu].finished;
+}
+
+void MultiCoreScheduler::print_times() const
+{
+    std::vector<int> everyone;
+    for (const auto& pair: stats)
+    {
+        everyone.push_back(pair.first);
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << average_time(stats, everyone);
+    for (const auto& pair: stats)
+    {
+        std::cout << " " << pair.second;
+    }
+    std::cout << std::endl;
+
+    for (int cpu = 0; cpu < cpus(); ++cpu)
+    {
+        const CPU& processor = processors[cpu];
+        std::cout << "cpu " << cpu << ": " << average_time(stats, processor.finished);
+        std::cout << " over " << processor.finished.size() << " processes, utilization " << 100 * utilization(cpu) << "%";
+        std::cout << ", migrations " << processor.stolen << " in, " << processor.lost << " out" << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+void MultiCoreScheduler::load()
+{
+    if (!pending_sorted)
+    {
+        auto by_arrival = [this](int a, int b){ return table[a].arrival_time() < table[b].arrival_time(); };
+        std::stable_sort(pending.begin() + next_pending, pending.end(), by_arrival);
+        pending_sorted = true;
+    }
+
+    while (next_pending < pending.size() && table[pending[next_pending]].arrival_time() < clock)
+    {
+        ++next_pending;
+    }
+    for (; next_pending < pending.size() && table[pending[next_pending]].arrival_time() == clock; ++next_pending)
+    {
+        int pid = pending[next_pending];
+        ready_position[pid] = ready_queue.size();
+        ready_queue.push_back(pid);
+
+        auto by_load = [](const CPU& a, const CPU& b){ return a.queued < b.queued; };
+        int cpu = std::min_element(processors.begin(), processors.end(), by_load) - processors.begin();
+        cpu_of[pid] = cpu;
+        ++processors[cpu].queued;
+        processors[cpu].algorithm->add_process(pid);
+    }
+}
+
+void MultiCoreScheduler::balance(int thief)
+{
+    auto by_load = [](const CPU& a, const CPU& b){ return a.queued < b.queued; };
+    int victim = std::max_element(processors.begin(), processors.end(), by_load) - processors.begin();
+    if (processors[victim].queued < 2)
+    {
+        return;
+    }
+
+    int pid = processors[victim].algorithm->steal_process();
+    if (pid == -1)
+    {
+        return;
+    }
+    --processors[victim].queued;
+    ++processors[victim].lost;
+    cpu_of[pid] = thief;
+    ++processors[thief].queued;
+    ++processors[thief].stolen;
+    processors[thief].algorithm->add_process(pid);
+}
+
+void MultiCoreScheduler::run(int cpu)
+{
+    CPU& processor = processors[cpu];
+    processor.running = -1;
+    if (processor.queued == 0)
+    {
+        return;
+    }
+
+    int pid = processor.algorithm->next_process();
+    Process& job = table[pid];
+    job.unblock();
+    job.operator++();
+    processor.algorithm->process_ran(pid);
+    processor.running = pid;
+    ++processor.busy;
+
+    if (job.finished())
+    {
+        int popped = processor.algorithm->pop_next_process();
+        if (popped != pid)
+        {
+            std::ostringstream buf;
+            buf << "MultiCoreScheduler::run - " << processor.algorithm->name() << " on cpu " << cpu << " popped Process " << popped;
+            buf << ", but expected Process " << pid;
+            throw AlgorithmException{buf.str()};
+        }
+
+        stats[pid] = job.total_time();
+        processor.finished.push_back(pid);
+        --processor.queued;
+
+        // swap the last ready process into its place
+        int moved = ready_queue.back();
+        ready_queue[ready_position[pid]] = moved;
+        ready_position[moved] = ready_position[pid];
+        ready_queue.pop_back();
+        ready_position[pid] = -1;
+        cpu_of[pid] = -1;
+        --unfinished;
+    }
+}
+
+void MultiCoreScheduler::check_cpu(int cpu) const
+{
+    if (cpu < 0 || cpu >= cpus())
+    {
+        std::ostringstream buf;
+        buf << "MultiCoreScheduler - no cpu " << cpu << " of " << cpus();
+        throw AlgorithmException{buf.str()};
+    }
+}
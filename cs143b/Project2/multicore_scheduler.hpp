@@ -0,0 +1,104 @@
+#ifndef PROJECT2_MULTICORE_SCHEDULER_HPP
+#define PROJECT2_MULTICORE_SCHEDULER_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "scheduling_algorithm.hpp"
+#include "process.hpp"
+
+
+// Schedules processes on several CPUs, each with a run queue of its own: a SchedulingAlgorithm instance.
+// Each cycle:
+//   1. every process that arrives goes to the CPU holding the fewest processes (then the lowest numbered one)
+//   2. every CPU whose queue is empty steals a waiting process (SchedulingAlgorithm::steal_process)
+//      from the CPU holding the most, if that CPU has one to spare
+//   3. every CPU holding a process runs its algorithm's next process for 1 cycle; all other arrived processes wait
+// A migrating process keeps its progress, and joins the thief's algorithm as if it had just arrived.
+class MultiCoreScheduler
+{
+public:
+    /* One CPU per algorithm (all dynamically allocated, like Scheduler's, and deleted by the destructor).
+     * Throws an AlgorithmException if there are none.
+     */
+    explicit MultiCoreScheduler(const std::vector<SchedulingAlgorithm*>& the_algorithms);
+    ~MultiCoreScheduler();
+
+    MultiCoreScheduler(const MultiCoreScheduler& other) = delete;
+    MultiCoreScheduler& operator=(const MultiCoreScheduler& other) = delete;
+
+    /* Returns true if there are still processes to be scheduled */
+    operator bool() const;
+
+    /* Advances every CPU by 1 cycle.
+     * Returns the updated current time (after the cycle).
+     */
+    int operator++();
+
+    /* Creates a new process with the corresponding arguments */
+    void read_process(int arrival_time, int total_time);
+
+    /* Schedules until all processes have finished, then prints the times (MultiCoreScheduler::print_times) */
+    void start();
+
+    int cpus() const;
+
+    /* Returns the cycles scheduled so far (all of them, once start() returns) */
+    int cycles() const;
+
+    /* Per-CPU counters: cycles spent running a process (over cycles(), the CPU's utilization),
+     * processes stolen by the CPU and from it, and the pids of the processes it finished
+     */
+    int busy_cycles(int cpu) const;
+    double utilization(int cpu) const;
+    int migrations_in(int cpu) const;
+    int migrations_out(int cpu) const;
+    const std::vector<int>& finished_on(int cpu) const;
+
+    /* Prints the times in the format:
+     * <average turnaround time> t1 t2 t3 ... tn                     (every process, like Scheduler::print_times)
+     * cpu <i>: <average turnaround time> over <n> processes, utilization <percent>%, migrations <in> in, <out> out
+     * with one cpu line per CPU, averaging the processes it finished
+     */
+    void print_times() const;
+
+
+private:
+    struct CPU
+    {
+        SchedulingAlgorithm* algorithm;
+        int queued;             // the processes algorithm holds
+        int running;            // pid of the process run this cycle, or -1
+        int busy;
+        int stolen;             // migrations in
+        int lost;               // migrations out
+        std::vector<int> finished;
+    };
+
+    // Processes are referred to by pid, which indexes the table
+    std::vector<Process> table;
+    std::vector<int> pending;           // [next_pending, end) are the pids not loaded yet, by arrival time, then pid
+    std::size_t next_pending;
+    bool pending_sorted;
+    std::vector<int> ready_queue;       // the arrived, unfinished processes, in no particular order
+    std::vector<int> ready_position;    // {pid: its index in ready_queue, or -1}
+    std::vector<int> cpu_of;            // {pid: the CPU holding it, or -1}
+    int unfinished;
+    int clock;
+    std::map<int, int> stats;           // {pid: total_time}
+    std::vector<CPU> processors;
+
+    /* Hands the processes arriving now to the least loaded CPUs */
+    void load();
+
+    /* Moves a waiting process from the busiest CPU to the idle CPU thief, if there is one to spare */
+    void balance(int thief);
+
+    /* Runs CPU cpu's next process for 1 cycle, if it holds any */
+    void run(int cpu);
+
+    void check_cpu(int cpu) const;
+};
+
+#endif //PROJECT2_MULTICORE_SCHEDULER_HPP
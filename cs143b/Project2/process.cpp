@@ -2,8 +2,6 @@
 #include "process.hpp"
 
 
-int Process::c_time = 0;
-
 Process::Process(int process_id, int ar_time, int r_time)
     : pid{process_id}, arrival{ar_time}, run{r_time}, waiting{0}, current{0},
       done{false}, blocked{true}
@@ -78,20 +76,14 @@ int Process::current_time() const
     return current;
 }
 
-// static
-int Process::clock_time()
-{
-    return c_time;
-}
-
 int Process::remaining_time() const
 {
     return run_time() - current_time();
 }
 
-bool Process::arrived() const
+bool Process::arrived(int clock) const
 {
-    return arrival_time() <= Process::clock_time();
+    return arrival_time() <= clock;
 }
 
 bool Process::finished() const
@@ -122,14 +114,4 @@ void Process::unblock()
 void Process::wait()
 {
     ++waiting;
-}
-
-int Process::increment_clock_time()
-{
-    return ++c_time;
-}
-
-void Process::reset_clock_time()
-{
-    c_time = 0;
 }
\ No newline at end of file
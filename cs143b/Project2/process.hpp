@@ -31,10 +31,10 @@ public:
     int current_time() const;
     int remaining_time() const;
 
-    /* Returns true if this process has arrived;
-     * e.g., if arrival time is less than the total (static) current time.
+    /* Returns true if this process has arrived by the given clock cycle;
+     * e.g., if arrival time is at most clock.
      */
-    bool arrived() const;
+    bool arrived(int clock) const;
 
     /* Returns true if the process has finished */
     bool finished() const;
@@ -55,16 +55,6 @@ public:
     void wait();
 
 
-    /* Returns the current, global clock cycle number */
-    static int clock_time();
-
-    /* Increments the global clock cycle number */
-    static int increment_clock_time();
-
-    /* Resets the global clock cycle to 0 */
-    static void reset_clock_time();
-
-
 private:
     int pid;
     int arrival;
@@ -74,8 +64,6 @@ private:
 
     bool done;
     bool blocked;
-
-    static int c_time;
 };
 
 #endif //PROJECT2_PROCESS_HPP
@@ -0,0 +1,80 @@
+#include "process_trace.hpp"
+#include "algorithm_exception.hpp"
+
+
+const uint32_t ProcessTrace::PROCESSES = 4;
+
+ProcessTrace::ProcessTrace()
+    : view{PROCESSES, nullptr, 0}
+{
+}
+
+ProcessTrace ProcessTrace::from_text(const std::string& path)
+{
+    MappedFile file{path};
+
+    // the legacy format only takes unsigned numbers
+    auto values = std::make_shared<std::vector<int32_t>>();
+    const char* line_end = next_line(file.begin(), file.end());
+    for (const char* cursor = file.begin(); cursor != line_end; )
+    {
+        while (cursor != line_end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n'))
+        {
+            ++cursor;
+        }
+
+        int32_t value;
+        const char* end = cursor != line_end && *cursor != '-' ? parse_int(cursor, line_end, value) : cursor;
+        if (end == cursor)
+        {
+            break;
+        }
+        values->push_back(value);
+        cursor = end;
+    }
+    return from_values(std::move(*values));
+}
+
+ProcessTrace ProcessTrace::from_binary(const std::string& path)
+{
+    auto reader = std::make_shared<const TraceReader>(path);
+    const TraceSection* section = reader->find(PROCESSES);
+    if (section == nullptr || section->size % 2 != 0)
+    {
+        throw AlgorithmException{"ProcessTrace::from_binary - " + path + " has no well-formed section of processes"};
+    }
+
+    ProcessTrace trace;
+    trace.view = *section;
+    trace.mapped = reader;
+    return trace;
+}
+
+ProcessTrace ProcessTrace::from_values(std::vector<int32_t> values)
+{
+    auto pairs = std::make_shared<std::vector<int32_t>>(std::move(values));
+    pairs->resize(pairs->size() / 2 * 2);
+
+    ProcessTrace trace;
+    trace.view.data = pairs->data();
+    trace.view.size = pairs->size();
+    trace.parsed = pairs;
+    return trace;
+}
+
+void ProcessTrace::write_binary(const std::string& path) const
+{
+    TraceWriter writer;
+    writer.add_section(view.kind, view.data, view.size);
+    writer.write(path);
+}
+
+std::size_t ProcessTrace::size() const
+{
+    return view.size / 2;
+}
+
+std::pair<int, int> ProcessTrace::operator[](std::size_t i) const
+{
+    return std::make_pair(view.data[2 * i], view.data[2 * i + 1]);
+}
@@ -0,0 +1,52 @@
+#ifndef PROJECT2_PROCESS_TRACE_HPP
+#define PROJECT2_PROCESS_TRACE_HPP
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "tools/trace_file.hpp"
+
+
+// The processes of one input, as (arrival time, total time) pairs in a flat array of ints.
+//
+// A trace is parsed from a text input (the pairs on its first line), or mapped from a binary trace (see
+// tools/trace_file.hpp), whose pairs are then used in place; write_binary() converts the former into the latter.
+class ProcessTrace
+{
+public:
+    // The kind of a binary trace's section of pairs
+    static const uint32_t PROCESSES;
+
+    /* The pairs end at the end of the first line, or at its first character that is neither blank nor a digit;
+     * an unpaired last number is ignored. Throws a TraceError if the file cannot be opened.
+     */
+    static ProcessTrace from_text(const std::string& path);
+
+    /* Throws a TraceError if the file is not a trace, or an AlgorithmException if its pairs are missing or malformed */
+    static ProcessTrace from_binary(const std::string& path);
+
+    /* Takes the pairs, one after the other (e.g. from a workload generator); an unpaired last number is ignored */
+    static ProcessTrace from_values(std::vector<int32_t> values);
+
+    void write_binary(const std::string& path) const;
+
+    /* Returns the number of processes */
+    std::size_t size() const;
+
+    /* Returns (arrival time, total time) of the ith process */
+    std::pair<int, int> operator[](std::size_t i) const;
+
+
+private:
+    // the view points into one of these, which copies of the trace share
+    std::shared_ptr<const TraceReader> mapped;              // a binary trace
+    std::shared_ptr<const std::vector<int32_t>> parsed;     // a text trace
+    TraceSection view;
+
+    ProcessTrace();
+};
+
+#endif //PROJECT2_PROCESS_TRACE_HPP
@@ -0,0 +1,29 @@
+// Converts a text input into a binary trace, which loads without parsing:
+//   process_trace_converter <input file> <binary trace>
+#include <exception>
+#include <iostream>
+#include "process_trace.hpp"
+
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <input file> <binary trace>" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        ProcessTrace trace = ProcessTrace::from_text(argv[1]);
+        trace.write_binary(argv[2]);
+        std::cout << trace.size() << " processes" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
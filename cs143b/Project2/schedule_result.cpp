@@ -0,0 +1,23 @@
+#include <numeric>
+#include <stdio.h>
+#include "schedule_result.hpp"
+
+
+double ScheduleResult::average_turnaround_time() const
+{
+    long long sum = std::accumulate(turnaround_times.begin(), turnaround_times.end(), 0LL);
+    return sum / static_cast<double>(turnaround_times.size());
+}
+
+void ScheduleResult::print(std::ostream& os) const
+{
+    char average[32];
+    snprintf(average, sizeof(average), "%.2f", average_turnaround_time());
+    os << average;
+
+    for (int time: turnaround_times)
+    {
+        os << " " << time;
+    }
+    os << std::endl;
+}
@@ -0,0 +1,24 @@
+#ifndef PROJECT2_SCHEDULE_RESULT_HPP
+#define PROJECT2_SCHEDULE_RESULT_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// What one run of a scheduler produced; runs share nothing, so several can be computed at once and printed after.
+struct ScheduleResult
+{
+    std::string algorithm;                  // the algorithm's name()
+    int cycles;                             // the cycle the last process finished at
+    std::vector<int> turnaround_times;      // of every process that finished, by pid
+
+    double average_turnaround_time() const;
+
+    /* Prints the times in the format:
+     * <average turnaround time> t1 t2 t3 ... tn
+     */
+    void print(std::ostream& os) const;
+};
+
+#endif //PROJECT2_SCHEDULE_RESULT_HPP
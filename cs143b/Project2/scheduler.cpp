@@ -1,149 +1,237 @@
 #include <algorithm>
-#include <numeric>
 #include <sstream>
-#include <stdio.h>
+#include "tools/span_timer.hpp"
 #include "scheduler.hpp"
 #include "algorithm_exception.hpp"
+#include "fifo_algorithm.hpp"
+#include "sjf_algorithm.hpp"
+#include "srt_algorithm.hpp"
+#include "mlf_algorithm.hpp"
 
 
-Scheduler::Scheduler(SchedulingAlgorithm* the_algorithm)
-    : comparator{[](std::shared_ptr<Process> a, std::shared_ptr<Process> b){ return a->id() < b->id(); }},
-      processes{comparator},
+template <typename Algorithm>
+BasicScheduler<Algorithm>::BasicScheduler(Algorithm* the_algorithm, Mode the_mode)
+    : next_pending{0},
+      pending_sorted{true},
+      unfinished{0},
       algorithm{the_algorithm},
-      current_job{nullptr}
+      current_job{-1},
+      scheduling_mode{the_mode},
+      clock{0}
 {
+    algorithm->set_process_table(table);
 }
 
-Scheduler::~Scheduler()
+template <typename Algorithm>
+BasicScheduler<Algorithm>::~BasicScheduler()
 {
     delete algorithm;
 }
 
-Scheduler::operator bool() const
+template <typename Algorithm>
+BasicScheduler<Algorithm>::operator bool() const
 {
-    bool processes_empty = processes.empty();
-    if (processes_empty && !ready_queue.empty())
+    if (unfinished == 0 && !ready_queue.empty())
     {
         throw AlgorithmException{"processes and ready_queue out of sync; both should be empty"};
     }
-    return !processes_empty;
+    return unfinished != 0;
 }
 
-int Scheduler::operator++()
+template <typename Algorithm>
+int BasicScheduler<Algorithm>::operator++()
 {
     load();
     if (!ready_queue.empty())
     {
         schedule();
     }
-    return Process::increment_clock_time();
+    return ++clock;
 }
 
-void Scheduler::read_process(int arrival_time, int total_time)
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::read_process(int arrival_time, int total_time)
 {
-    int pid = processes.size();
-    std::shared_ptr<Process> process{new Process{pid, arrival_time, total_time}};
-    processes.insert(process);
+    int pid = table.size();
+    table.push_back(Process{pid, arrival_time, total_time});
+    ready_position.push_back(-1);
+    pending_sorted = pending_sorted && (pending.size() == next_pending || table[pending.back()].arrival_time() <= arrival_time);
+    pending.push_back(pid);
+    ++unfinished;
 }
 
-void Scheduler::schedule()
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::schedule()
 {
+    TIMED_SPAN("Scheduler::schedule");
     // get the next process to run from the scheduling algorithm,
     // and run it for 1 cycle.
-    Process& p = sync_current_process();
-    current_job->operator++();
-    p = *current_job;
+    Process& job = sync_current_process();
+    job.operator++();
+    algorithm->process_ran(current_job);
 
-    if (current_job->finished())
+    if (job.finished())
     {
         remove_current_process();
     }
 
     // go through all other already-arrived processes and increment their waiting times
-    for (auto& process: ready_queue)
+    for (int pid: ready_queue)
     {
-        if (*process != *current_job)
+        if (pid != current_job)
         {
-            process->wait();
+            table[pid].wait();
         }
     }
 }
 
-void Scheduler::start()
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::start()
 {
+    run();
+    print_times();
+}
+
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::run()
+{
+    if (scheduling_mode == Mode::EVENT)
+    {
+        run_events();
+        return;
+    }
+
     while (*this)
     {
         operator++();
     }
-    print_times();
-    Process::reset_clock_time();
 }
 
-void Scheduler::print_times() const
+template <typename Algorithm>
+SchedulingMode BasicScheduler<Algorithm>::mode() const
 {
-    auto sum_total_times = [](int acc, const std::pair<int, int>& p){ return acc + p.second; };
-    int sum = std::accumulate(stats.begin(), stats.end(), 0, sum_total_times);
-    double average = sum / static_cast<double>(stats.size());
+    return scheduling_mode;
+}
 
-    std::string average_as_str = std::to_string(average);
-    std::unique_ptr<char> allocated{new char[average_as_str.size() + 1]};
-    char* buf = allocated.get();
-    sprintf(buf, "%.2f", average);
-    std::cout << buf;
+template <typename Algorithm>
+int BasicScheduler<Algorithm>::cycles() const
+{
+    return clock;
+}
 
+template <typename Algorithm>
+ScheduleResult BasicScheduler<Algorithm>::result() const
+{
+    ScheduleResult result{algorithm->name(), clock, {}};
+    result.turnaround_times.reserve(stats.size());
     for (const auto& pair: stats)
     {
-        std::cout << " " << pair.second;
+        result.turnaround_times.push_back(pair.second);
     }
-    std::cout << std::endl;
+    return result;
+}
+
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::print_times() const
+{
+    result().print(std::cout);
 }
 
-void Scheduler::load()
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::load()
 {
-    for (auto& process: processes)
+    if (!pending_sorted)
     {
-        if (!process->finished() && process->arrival_time() == Process::clock_time())
-        {
-            ready_queue.insert(process);
-            algorithm->add_process(*process);
-        }
+        auto by_arrival = [this](int a, int b){ return table[a].arrival_time() < table[b].arrival_time(); };
+        std::stable_sort(pending.begin() + next_pending, pending.end(), by_arrival);
+        pending_sorted = true;
+    }
+
+    // processes that arrived before the clock started were never loaded, and never will be
+    while (next_pending < pending.size() && table[pending[next_pending]].arrival_time() < clock)
+    {
+        ++next_pending;
+    }
+    for (; next_pending < pending.size() && table[pending[next_pending]].arrival_time() == clock; ++next_pending)
+    {
+        int pid = pending[next_pending];
+        ready_position[pid] = ready_queue.size();
+        ready_queue.push_back(pid);
+        algorithm->add_process(pid);
     }
 }
 
-void Scheduler::set_current_process(const Process& process_from_algorithm)
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::set_current_process(int pid)
 {
-    auto locate = [&process_from_algorithm](std::shared_ptr<Process> p){ return *p == process_from_algorithm; };
-    auto found = std::find_if(processes.begin(), processes.end(), locate);
-
-    current_job = *found;
-    if (current_job->arrived())
+    current_job = pid;
+    if (table[current_job].arrived(clock))
     {
-        current_job->unblock();
+        table[current_job].unblock();
     }
 }
 
-Process& Scheduler::sync_current_process()
+template <typename Algorithm>
+Process& BasicScheduler<Algorithm>::sync_current_process()
 {
-    Process& p = algorithm->next_process();
-    if (!current_job || *current_job != p)
+    int pid = algorithm->next_process();
+    if (current_job != pid)
     {
-        set_current_process(p);
+        set_current_process(pid);
     }
-    return p;
+    return table[current_job];
 }
 
-void Scheduler::remove_current_process()
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::remove_current_process()
 {
     int pid = algorithm->pop_next_process();
-    if (pid != current_job->id())
+    if (pid != current_job)
     {
         std::ostringstream buf;
         buf << "Scheduler::remove_current_process - " << algorithm->name() << " popped Process " << pid;
-        buf << ", but expected Process " << current_job->id();
+        buf << ", but expected Process " << current_job;
         throw AlgorithmException{buf.str()};
     }
 
-    stats[pid] = current_job->total_time();
-    ready_queue.erase(current_job);
-    processes.erase(current_job);
-}
\ No newline at end of file
+    stats[pid] = table[pid].total_time();
+
+    // swap the last ready process into its place
+    int moved = ready_queue.back();
+    ready_queue[ready_position[pid]] = moved;
+    ready_position[moved] = ready_position[pid];
+    ready_queue.pop_back();
+    ready_position[pid] = -1;
+    --unfinished;
+}
+
+template <typename Algorithm>
+void BasicScheduler<Algorithm>::run_events()
+{
+    for (const Process& process: table)
+    {
+        if (process.arrival_time() < 0 || process.run_time() < 1)
+        {
+            std::ostringstream buf;
+            buf << "Scheduler::run_events - Process " << process.id() << " arrives at " << process.arrival_time();
+            buf << " and runs for " << process.run_time() << " cycles, so it can never finish";
+            throw AlgorithmException{buf.str()};
+        }
+    }
+
+    std::vector<int> completions = algorithm->completion_times(table);
+    for (const Process& process: table)
+    {
+        stats[process.id()] = completions[process.id()] - process.arrival_time();
+        clock = std::max(clock, completions[process.id()]);
+    }
+    next_pending = pending.size();
+    unfinished = 0;
+}
+
+
+template class BasicScheduler<SchedulingAlgorithm>;
+template class BasicScheduler<FIFOAlgorithm>;
+template class BasicScheduler<SJFAlgorithm>;
+template class BasicScheduler<SRTAlgorithm>;
+template class BasicScheduler<MLFAlgorithm>;
@@ -1,25 +1,40 @@
 #ifndef PROJECT2_SCHEDULER_HPP
 #define PROJECT2_SCHEDULER_HPP
 
-#include <functional>
+#include <cstddef>
 #include <iostream>
 #include <map>
-#include <memory>
-#include <set>
-#include <unordered_set>
+#include <vector>
 #include "scheduling_algorithm.hpp"
+#include "schedule_result.hpp"
 #include "process.hpp"
 
 
-class Scheduler
+enum class SchedulingMode
+{
+    TICK,       // the clock advances 1 cycle at a time, updating every arrived process each cycle
+    EVENT       // the clock jumps from one arrival, completion or preemption to the next (same results, much faster)
+};
+
+
+// Algorithm is the type of the scheduling algorithm the scheduler calls every cycle:
+//   SchedulingAlgorithm (Scheduler) - any algorithm, picked at run time and called through its virtual functions
+//   one of the (final) algorithms   - e.g. BasicScheduler<SRTAlgorithm>, which calls that algorithm directly
+// scheduler.cpp instantiates both kinds for each of the four algorithms.
+// Each scheduler keeps its own clock, so schedulers on different threads do not interfere.
+template <typename Algorithm = SchedulingAlgorithm>
+class BasicScheduler
 {
 public:
-    /* Takes in a raw pointer to a SchedulingAlgorithm derivative (for polymorphic purposes).
+    typedef SchedulingMode Mode;
+
+    /* Takes in a raw pointer to an Algorithm (for Scheduler, any SchedulingAlgorithm derivative).
      * Assumes that the_algorithm is dynamically allocated,
      * as the destructor will delete it.
+     * The algorithm is given this scheduler's process table, and holds only pids into it.
      */
-    explicit Scheduler(SchedulingAlgorithm* the_algorithm);
-    ~Scheduler();
+    explicit BasicScheduler(Algorithm* the_algorithm, Mode the_mode = Mode::TICK);
+    ~BasicScheduler();
 
     /* Returns true if there are still processes to be scheduled,
      * or false if not (i.e., all have finished).
@@ -43,46 +58,72 @@ public:
 
     /* Begins scheduling, until all processes have finished.
      * Prints the appropriate times at the end (Scheduler::print_times).
+     * In EVENT mode, throws an AlgorithmException if a process arrives before cycle 0 or does not run for at least
+     * 1 cycle (the TICK engine never finishes those).
      */
     void start();
 
+    /* Schedules like start(), without printing anything; start() is run() followed by print_times() */
+    void run();
+
+    Mode mode() const;
+
+    /* Returns the cycles scheduled so far: once run() returns, the cycle the last process finished at */
+    int cycles() const;
+
+    /* Returns the algorithm's name, the cycles, and the turnaround time of every process that has finished */
+    ScheduleResult result() const;
+
     /* Prints the times in the format:
      * <average turnaround time> t1 t2 t3 ... tn
+     * (ScheduleResult::print, to std::cout)
      */
     void print_times() const;
 
 
 private:
-    typedef std::function<bool(std::shared_ptr<Process>, std::shared_ptr<Process>)> PIDComparator;
-
-    PIDComparator comparator;
-    std::set<std::shared_ptr<Process>, PIDComparator> processes;
-    std::unordered_set<std::shared_ptr<Process>> ready_queue;
+    // Processes are referred to by pid, which indexes the table
+    std::vector<Process> table;
+    std::vector<int> pending;           // [next_pending, end) are the pids not loaded yet, by arrival time, then pid
+    std::size_t next_pending;
+    bool pending_sorted;
+    std::vector<int> ready_queue;       // the arrived, unfinished processes, in no particular order
+    std::vector<int> ready_position;    // {pid: its index in ready_queue, or -1}
+    int unfinished;
     std::map<int, int> stats;   // {pid: total_time}
-    SchedulingAlgorithm* algorithm;
-    std::shared_ptr<Process> current_job;
+    Algorithm* algorithm;
+    int current_job;            // pid, or -1 before the first cycle
+    Mode scheduling_mode;
+    int clock;
 
     /* Adds processes which have arrived at the current time,
      * and inserts them into the ready queue and scheduling algorithm.
+     * Only looks at the pending processes that arrive now.
      */
     void load();
 
-    /* Updates the current_job pointer to the process corresponding to process_from_algorithm.
+    /* Updates current_job to pid, which the scheduling algorithm returned, and unblocks it.
      */
-    void set_current_process(const Process& process_from_algorithm);
+    void set_current_process(int pid);
 
     /* Obtains the next process to be run from the scheduling algorithm.
-     * Updates the current_job pointer to that process.
+     * Updates current_job to that process.
      * Returns a reference to the process.
      */
     Process& sync_current_process();
 
     /* Pops the next process from the scheduling algorithm.
-     * Throws an AlgorithmException if that process is not the same process pointed to by current_job.
+     * Throws an AlgorithmException if that process is not current_job.
      * Updates statistics on total time for that process.
-     * Removes the process from the ready queue, and the global processes.
+     * Removes the process from the ready queue.
      */
     void remove_current_process();
+
+    /* Schedules every process at once, from the algorithm's completion times (waiting time = turnaround - run time)
+     */
+    void run_events();
 };
 
+typedef BasicScheduler<> Scheduler;
+
 #endif //PROJECT2_SCHEDULER_HPP
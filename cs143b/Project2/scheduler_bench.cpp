@@ -0,0 +1,196 @@
+// Generates synthetic workloads (see workload.hpp) and runs the four scheduling algorithms on each, reporting
+// how fast each simulates and how much heap it needs at its peak:
+//   scheduler_bench [-t] [-l load] [-a alpha] [-b max burst] [-s seed] [-o prefix] [processes ...]
+// -t schedules in TICK mode instead of EVENT mode; -o writes each workload to <prefix><processes>.trace,
+// a binary trace the other drivers can read. processes defaults to 1000 10000 100000 1000000.
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "tools/ms_timer.hpp"
+#include "tools/span_timer.hpp"
+#include "scheduler.hpp"
+#include "workload.hpp"
+#include "fifo_algorithm.hpp"
+#include "sjf_algorithm.hpp"
+#include "srt_algorithm.hpp"
+#include "mlf_algorithm.hpp"
+
+
+// Every allocation goes through these, which keep count of the heap in use, and of its peak since reset_heap_peak()
+namespace
+{
+    const std::size_t HEADER = alignof(std::max_align_t);     // holds the block's size, and keeps it aligned
+    std::size_t heap_in_use = 0;
+    std::size_t heap_peak = 0;
+
+    void reset_heap_peak()
+    {
+        heap_peak = heap_in_use;
+    }
+
+    // kept out of line: inlined into a delete, its free would look to g++ like freeing a pointer operator new returned
+    __attribute__((noinline)) void release(void* pointer) noexcept
+    {
+        if (pointer == nullptr)
+        {
+            return;
+        }
+        char* block = static_cast<char*>(pointer) - HEADER;
+        heap_in_use -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + HEADER));
+    if (block == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    heap_in_use += size;
+    heap_peak = std::max(heap_peak, heap_in_use);
+    return block + HEADER;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    release(pointer);
+}
+
+// sized deletes would otherwise go to the library's, which frees a block without this header
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    release(pointer);
+}
+
+
+namespace
+{
+    struct Options
+    {
+        WorkloadSpec spec;
+        SchedulingMode mode = SchedulingMode::EVENT;
+        std::string prefix;
+        std::vector<int> sizes;
+    };
+
+    template <typename Algorithm>
+    void bench(const ProcessTrace& trace, SchedulingMode mode)
+    {
+        std::size_t before = heap_in_use;
+        reset_heap_peak();
+        ms_timer timer{true};
+
+        BasicScheduler<Algorithm> scheduler{new Algorithm, mode};
+        for (std::size_t i = 0; i < trace.size(); ++i)
+        {
+            std::pair<int, int> pair = trace[i];
+            scheduler.read_process(pair.first, pair.second);
+        }
+        scheduler.run();
+
+        timer.stop();
+        double ms = timer.read();
+        double peak_mb = (heap_peak - before) / (1024.0 * 1024.0);
+        std::cout << std::setw(11) << trace.size() << std::setw(6) << Algorithm{}.name();
+        std::cout << std::setw(12) << scheduler.cycles() << std::setw(11) << ms;
+        std::cout << std::setw(14) << (ms > 0 ? scheduler.cycles() / (ms / 1000) : 0) << std::setw(10) << peak_mb << std::endl;
+    }
+
+    bool parse(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "-t")
+            {
+                options.mode = SchedulingMode::TICK;
+            }
+            else if (arg == "-l" && has_value)
+            {
+                options.spec.load = std::atof(argv[++i]);
+            }
+            else if (arg == "-a" && has_value)
+            {
+                options.spec.burst_alpha = std::atof(argv[++i]);
+            }
+            else if (arg == "-b" && has_value)
+            {
+                options.spec.max_burst = std::atoi(argv[++i]);
+            }
+            else if (arg == "-s" && has_value)
+            {
+                options.spec.seed = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "-o" && has_value)
+            {
+                options.prefix = argv[++i];
+            }
+            else if (!arg.empty() && arg[0] != '-')
+            {
+                options.sizes.push_back(std::atoi(arg.c_str()));
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if (options.sizes.empty())
+        {
+            options.sizes = {1000, 10000, 100000, 1000000};
+        }
+        return true;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse(argc, argv, options))
+    {
+        std::cerr << "usage: " << argv[0] << " [-t] [-l load] [-a alpha] [-b max burst] [-s seed] [-o prefix] [processes ...]" << std::endl;
+        return 2;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << (options.mode == SchedulingMode::TICK ? "TICK" : "EVENT") << " mode, load " << options.spec.load;
+    std::cout << ", bursts of " << options.spec.min_burst << " to " << options.spec.max_burst << " cycles (alpha ";
+    std::cout << options.spec.burst_alpha << "), seed " << options.spec.seed << std::endl;
+    std::cout << "  processes  algo      cycles         ms      cycles/s   peak MB" << std::endl;
+
+    try
+    {
+        for (int size: options.sizes)
+        {
+            options.spec.processes = size;
+            ProcessTrace trace = generate_workload(options.spec);
+            if (!options.prefix.empty())
+            {
+                trace.write_binary(options.prefix + std::to_string(size) + ".trace");
+            }
+
+            bench<FIFOAlgorithm>(trace, options.mode);
+            bench<SJFAlgorithm>(trace, options.mode);
+            bench<SRTAlgorithm>(trace, options.mode);
+            bench<MLFAlgorithm>(trace, options.mode);
+        }
+        span_report(std::cerr);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include "scheduling_algorithm.hpp"
 
 
 SchedulingAlgorithm::SchedulingAlgorithm()
+    : table{nullptr}
 {
 }
 
@@ -15,12 +17,28 @@ std::ostream& operator<<(std::ostream& os, const SchedulingAlgorithm& alg)
     return os;
 }
 
-Process& SchedulingAlgorithm::next_process()
+void SchedulingAlgorithm::set_process_table(const std::vector<Process>& processes)
 {
-    Process& next = get_next_process();
-    if (next.arrived())
+    table = &processes;
+}
+
+void SchedulingAlgorithm::process_ran(int)
+{
+}
+
+const Process& SchedulingAlgorithm::process(int pid) const
+{
+    return (*table)[pid];
+}
+
+std::vector<int> SchedulingAlgorithm::arrival_order(const std::vector<Process>& processes)
+{
+    std::vector<int> result;
+    for (const Process& process: processes)
     {
-        next.unblock();
+        result.push_back(process.id());
     }
-    return next;
-}
\ No newline at end of file
+    std::stable_sort(result.begin(), result.end(),
+                     [&processes](int a, int b){ return processes[a].arrival_time() < processes[b].arrival_time(); });
+    return result;
+}
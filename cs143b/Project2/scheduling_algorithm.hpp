@@ -9,6 +9,8 @@
 #include "algorithm_exception.hpp"
 
 
+// The interface BasicScheduler drives; Scheduler picks an algorithm at run time, through these virtual functions.
+// Each algorithm below is final, so a BasicScheduler of one calls it directly instead (see scheduler.hpp).
 class SchedulingAlgorithm
 {
 public:
@@ -17,23 +19,43 @@ public:
 
     friend std::ostream& operator<<(std::ostream& os, const SchedulingAlgorithm& alg);
 
-    /* Returns a reference to the next process to be run.
+    /* Gives the algorithm the table its processes live in; a pid indexes the table.
+     * Algorithms hold only pids, and read each process' state from the table (which the caller updates as it runs).
+     * Must be called before any process is added, and the table must outlive this algorithm's use of it.
      */
-    Process& next_process();
+    void set_process_table(const std::vector<Process>& processes);
 
-    /* Adds a process using this algorithm.
+    /* Returns the pid of the next process to be run.
      */
-    virtual void add_process(const Process& process) = 0;
+    virtual int next_process() = 0;
+
+    /* Adds the process with the given pid using this algorithm.
+     */
+    virtual void add_process(int pid) = 0;
+
+    /* Tells the algorithm that the process with the given pid has just run for 1 cycle,
+     * so that it can update where that process is ordered (does nothing by default).
+     */
+    virtual void process_ran(int pid);
 
     /* Removes the next process from the algorithm.
      * Returns the pid of the process that was removed.
      *   FIFO: std::deque::pop_front
      *   SJF:  std::priority_queue::pop
-     *   SRT:  std::priority_queue::pop
-     *   MLF:  MLFQueue::pop
+     *   SRT:  BinaryHeap::extract
+     *   MLF:  Queue::pop, on the first non-empty level
      */
     virtual int pop_next_process() = 0;
 
+    /* Removes a waiting process - never the one up next - so that another CPU can run it, and returns its pid;
+     * returns -1 if there is no such process.
+     *   FIFO: the back of the queue (the latest arrival)
+     *   SJF:  the shortest job, other than the one up next
+     *   SRT:  the last element of the heap (a leaf, so one of the longest remaining times)
+     *   MLF:  the back of the last non-empty level
+     */
+    virtual int steal_process() = 0;
+
     /* Returns true if there all processes have completed,
      * or false if not.
      */
@@ -43,9 +65,24 @@ public:
 
     virtual std::string to_string() const = 0;
 
+    /* Event-driven scheduling: runs processes (indexed by pid, none started) to completion under this algorithm,
+     * jumping straight from one arrival, completion or preemption to the next, instead of one cycle at a time.
+     * Returns the cycle each process finished at (indexed by pid); the schedule is the same as Scheduler's tick engine's.
+     * Does not use nor change the processes this algorithm holds.
+     */
+    virtual std::vector<int> completion_times(const std::vector<Process>& processes) const = 0;
+
 
 protected:
-    virtual Process& get_next_process() = 0;
+    /* Returns the process with the given pid, from the process table */
+    const Process& process(int pid) const;
+
+    /* Returns the pids of processes in the order the tick engine loads them: by arrival time, then by pid */
+    static std::vector<int> arrival_order(const std::vector<Process>& processes);
+
+
+private:
+    const std::vector<Process>* table;
 };
 
 #endif //PROJECT2_SCHEDULING_ALGORITHM_HPP
@@ -1,21 +1,21 @@
+#include <algorithm>
+#include <set>
+#include <utility>
 #include "sjf_algorithm.hpp"
 
 
 SJFAlgorithm::SJFAlgorithm()
-    : comparator{[](const Process& a, const Process& b){ return a.run_time() == b.run_time() ?
-                                                                a.id() > b.id() :
-                                                                a.run_time() > b.run_time(); }},
-      processes{comparator},
-      current_process{nullptr}
+    : processes{SJFComparator{&run_times}},
+      current_process{-1}
 {
 }
 
 bool SJFAlgorithm::empty() const
 {
-    return !current_process;
+    return current_process == -1;
 }
 
-Process& SJFAlgorithm::get_next_process()
+int SJFAlgorithm::next_process()
 {
     if (!processes.empty())
     {
@@ -23,29 +23,35 @@ Process& SJFAlgorithm::get_next_process()
         // and another process arrives AT THE SAME TIME with a SHORTER JOB TIME,
         // "swap" them (so that current_process becomes the newly arrived, shorter-time process,
         // and the original current_process is now up next at the top of the queue.
-        const Process& next = processes.top();
-        bool ready_to_start = current_process->remaining_time() == current_process->run_time();
-        if (ready_to_start && current_process->run_time() > next.run_time())
+        int next = processes.top();
+        const Process& current = process(current_process);
+        bool ready_to_start = current.remaining_time() == current.run_time();
+        if (ready_to_start && current.run_time() > process(next).run_time())
         {
-            Process copy{*current_process};
-            current_process = std::shared_ptr<Process>{new Process{next}};
             processes.pop();
-            processes.push(copy);
+            processes.push(current_process);
+            current_process = next;
         }
     }
 
-    return *current_process;
+    return current_process;
 }
 
-void SJFAlgorithm::add_process(const Process& process)
+void SJFAlgorithm::add_process(int pid)
 {
+    if (pid >= static_cast<int>(run_times.size()))
+    {
+        run_times.resize(pid + 1);
+    }
+    run_times[pid] = process(pid).run_time();
+
     if (empty())
     {
-        current_process = std::shared_ptr<Process>{new Process{process}};
+        current_process = pid;
     }
     else
     {
-        processes.push(process);
+        processes.push(pid);
     }
 }
 
@@ -56,19 +62,36 @@ int SJFAlgorithm::pop_next_process()
         throw AlgorithmException{"SJFAlgorithm::pop_next_process - empty"};
     }
 
-    int pid = current_process->id();
+    int pid = current_process;
     if (processes.empty())
     {
-        current_process = nullptr;
+        current_process = -1;
     }
     else
     {
-        current_process = std::shared_ptr<Process>{new Process{processes.top()}};
+        current_process = processes.top();
         processes.pop();
     }
     return pid;
 }
 
+int SJFAlgorithm::steal_process()
+{
+    if (processes.empty())
+    {
+        return -1;
+    }
+    int pid = processes.top();
+    processes.pop();
+    return pid;
+}
+
+bool SJFAlgorithm::SJFComparator::operator()(int a, int b) const
+{
+    const std::vector<int>& keys = *run_times;
+    return keys[a] == keys[b] ? a > b : keys[a] > keys[b];
+}
+
 std::string SJFAlgorithm::name() const
 {
     return "SJF";
@@ -80,14 +103,63 @@ std::string SJFAlgorithm::to_string() const
     buf << name() << "(";
     if (!empty())
     {
-        buf << *current_process;
+        buf << process(current_process);
         PriorityQueue copy{processes};
         while (!copy.empty())
         {
-            buf << ", " << copy.top();
+            buf << ", " << process(copy.top());
             copy.pop();
         }
     }
     buf << ")";
     return buf.str();
-}
\ No newline at end of file
+}
+
+std::vector<int> SJFAlgorithm::completion_times(const std::vector<Process>& processes) const
+{
+    // the waiting processes, shortest job (then lowest pid) first
+    std::set<std::pair<int, int>> waiting;     // {(run time, pid)}
+    std::vector<int> order = arrival_order(processes);
+    std::vector<int> result(processes.size());
+    std::size_t arrived = 0;
+    int clock = 0;
+    int candidate = -1;     // up next, as of the cycle before clock
+
+    auto load = [&](int until){
+        for (; arrived < order.size() && processes[order[arrived]].arrival_time() <= until; ++arrived)
+        {
+            waiting.insert(std::make_pair(processes[order[arrived]].run_time(), order[arrived]));
+        }
+    };
+
+    for (std::size_t finished = 0; finished < processes.size(); ++finished)
+    {
+        if (candidate == -1)
+        {
+            // idle: the first process (by pid) to arrive is up next
+            clock = std::max(clock, processes[order[arrived]].arrival_time());
+            candidate = order[arrived++];
+        }
+        load(clock);
+
+        // a process that arrives before the candidate starts takes its place only with a strictly shorter job
+        if (!waiting.empty() && waiting.begin()->first < processes[candidate].run_time())
+        {
+            waiting.insert(std::make_pair(processes[candidate].run_time(), candidate));
+            candidate = waiting.begin()->second;
+            waiting.erase(waiting.begin());
+        }
+
+        // non-preemptive; the next candidate is picked in the cycle candidate finishes in
+        clock += processes[candidate].run_time();
+        result[candidate] = clock;
+        load(clock - 1);
+        candidate = -1;
+        if (!waiting.empty())
+        {
+            candidate = waiting.begin()->second;
+            waiting.erase(waiting.begin());
+        }
+    }
+    return result;
+}
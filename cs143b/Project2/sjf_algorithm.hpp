@@ -1,37 +1,43 @@
 #ifndef PROJECT2_SJFALGORITHM_HPP
 #define PROJECT2_SJFALGORITHM_HPP
 
-#include <functional>
 #include <iostream>
-#include <memory>
 #include <queue>
 #include <vector>
 #include "scheduling_algorithm.hpp"
 
 
-class SJFAlgorithm : public SchedulingAlgorithm
+class SJFAlgorithm final : public SchedulingAlgorithm
 {
 public:
     SJFAlgorithm();
 
     virtual bool empty() const override;
-    virtual Process& get_next_process() override;
-    virtual void add_process(const Process& process) override;
+    virtual int next_process() override;
+    virtual void add_process(int pid) override;
     virtual int pop_next_process() override;
+    virtual int steal_process() override;
 
     virtual std::string name() const override;
     virtual std::string to_string() const override;
+    virtual std::vector<int> completion_times(const std::vector<Process>& processes) const override;
 
 
 protected:
-    typedef std::function<bool(const Process&, const Process&)> SJFComparator;
-    typedef std::priority_queue<Process, std::vector<Process>, SJFComparator> PriorityQueue;
-    SJFComparator comparator;
+    // Orders the priority queue's pids: returns true if a runs after b (a longer job, or as long with a higher pid)
+    struct SJFComparator
+    {
+        const std::vector<int>* run_times;
+
+        bool operator()(int a, int b) const;
+    };
+    typedef std::priority_queue<int, std::vector<int>, SJFComparator> PriorityQueue;     // of pids
+    std::vector<int> run_times;     // {pid: run time}, the queue's keys
     PriorityQueue processes;
 
 
 private:
-    std::shared_ptr<Process> current_process;
+    int current_process;    // pid, or -1 if there is none
 };
 
 #endif //PROJECT2_SJFALGORITHM_HPP
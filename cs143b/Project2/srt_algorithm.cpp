@@ -1,11 +1,12 @@
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <utility>
 #include "srt_algorithm.hpp"
 
 
 SRTAlgorithm::SRTAlgorithm()
-    : comparator{[](const Process& a, const Process& b){ return a.remaining_time() == b.remaining_time() ?
-                                                                  a.id() > b.id() :
-                                                                  a.remaining_time() > b.remaining_time(); }},
-      processes{comparator}
+    : processes{SRTComparator{&remaining}}
 {
 }
 
@@ -14,25 +15,53 @@ bool SRTAlgorithm::empty() const
     return processes.empty();
 }
 
-Process& SRTAlgorithm::get_next_process()
+int SRTAlgorithm::next_process()
 {
-    // std::priority_queue::top returns const reference,
-    // SchedulingAlgorithm::get_next_process() returns a non-const reference
-    return const_cast<Process&>(processes.top());
+    return processes.top();
 }
 
-void SRTAlgorithm::add_process(const Process& process)
+void SRTAlgorithm::add_process(int pid)
 {
-    processes.push(process);
+    if (pid >= static_cast<int>(handles.size()))
+    {
+        handles.resize(pid + 1);
+        remaining.resize(pid + 1);
+    }
+    remaining[pid] = process(pid).remaining_time();
+    handles[pid] = processes.push(pid);
+}
+
+void SRTAlgorithm::process_ran(int pid)
+{
+    // running only ever shortens a process' remaining time, so it can only move up
+    remaining[pid] = process(pid).remaining_time();
+    processes.decrease_key(handles[pid], pid);
 }
 
 int SRTAlgorithm::pop_next_process()
 {
-    int pid = processes.top().id();
-    processes.pop();
+    return processes.extract();
+}
+
+int SRTAlgorithm::steal_process()
+{
+    if (processes.size() < 2)
+    {
+        return -1;
+    }
+    // heap order ends at the top; the last element is never it
+    PriorityQueue::const_iterator last = processes.end();
+    int pid = *(--last);
+    processes.erase(handles[pid]);
     return pid;
 }
 
+bool SRTAlgorithm::SRTComparator::operator()(int a, int b) const
+{
+    const std::vector<int>& keys = *remaining;
+    return keys[a] == keys[b] ? a < b : keys[a] < keys[b];
+}
+
 std::string SRTAlgorithm::name() const
 {
     return "SRT";
@@ -45,15 +74,54 @@ std::string SRTAlgorithm::to_string() const
     PriorityQueue copy{processes};
     if (!copy.empty())
     {
-        buf << copy.top();
-        copy.pop();
+        buf << process(copy.extract());
 
         while (!copy.empty())
         {
-            buf << ", " << copy.top();
-            copy.pop();
+            buf << ", " << process(copy.extract());
         }
     }
     buf << ")";
     return buf.str();
-}
\ No newline at end of file
+}
+
+std::vector<int> SRTAlgorithm::completion_times(const std::vector<Process>& processes) const
+{
+    // the arrived processes, shortest remaining time (then lowest pid) first;
+    // the first runs until it finishes or the next process arrives, whichever is sooner
+    std::set<std::pair<int, int>> ready;     // {(remaining time, pid)}
+    std::vector<int> order = arrival_order(processes);
+    std::vector<int> result(processes.size());
+    std::size_t arrived = 0;
+    int clock = 0;
+
+    for (std::size_t finished = 0; finished < processes.size(); )
+    {
+        if (ready.empty())
+        {
+            clock = std::max(clock, processes[order[arrived]].arrival_time());
+        }
+        for (; arrived < order.size() && processes[order[arrived]].arrival_time() <= clock; ++arrived)
+        {
+            ready.insert(std::make_pair(processes[order[arrived]].run_time(), order[arrived]));
+        }
+
+        std::pair<int, int> running = *ready.begin();
+        ready.erase(ready.begin());
+        int next_arrival = arrived < order.size() ? processes[order[arrived]].arrival_time() : INT_MAX;
+        int cycles = std::min(running.first, next_arrival - clock);
+        clock += cycles;
+        running.first -= cycles;
+
+        if (running.first == 0)
+        {
+            result[running.second] = clock;
+            ++finished;
+        }
+        else
+        {
+            ready.insert(running);
+        }
+    }
+    return result;
+}
@@ -1,31 +1,43 @@
 #ifndef PROJECT2_SRT_ALGORITHM_HPP
 #define PROJECT2_SRT_ALGORITHM_HPP
 
-#include <functional>
-#include <queue>
 #include <vector>
+#include "data_structures/binary_heap.hpp"
 #include "scheduling_algorithm.hpp"
 
 
-class SRTAlgorithm : public SchedulingAlgorithm
+class SRTAlgorithm final : public SchedulingAlgorithm
 {
 public:
     SRTAlgorithm();
 
     virtual bool empty() const override;
-    virtual Process& get_next_process() override;
-    virtual void add_process(const Process& process) override;
+    virtual int next_process() override;
+    virtual void add_process(int pid) override;
+    virtual void process_ran(int pid) override;
     virtual int pop_next_process() override;
+    virtual int steal_process() override;
 
     virtual std::string name() const override;
     virtual std::string to_string() const override;
+    virtual std::vector<int> completion_times(const std::vector<Process>& processes) const override;
 
 
 private:
-    typedef std::function<bool(const Process&, const Process&)> SRTComparator;
-    typedef std::priority_queue<Process, std::vector<Process>, SRTComparator> PriorityQueue;
-    SRTComparator comparator;
+    // Orders the heap's pids: returns true if a runs before b (less time remaining, or as much with a lower pid)
+    struct SRTComparator
+    {
+        const std::vector<int>* remaining;
+
+        bool operator()(int a, int b) const;
+    };
+
+    // the ready processes' pids, shortest remaining time (then lowest pid) on top;
+    // the running process' key shrinks every cycle, so each keeps its heap handle to be re-sifted through
+    typedef BinaryHeap<int, SRTComparator> PriorityQueue;
+    std::vector<int> remaining;                     // {pid: remaining time}, the heap's keys
     PriorityQueue processes;
+    std::vector<PriorityQueue::Handle> handles;    // {pid: its handle in processes}
 };
 
 #endif //PROJECT2_SRT_ALGORITHM_HPP
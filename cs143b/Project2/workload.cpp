@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "workload.hpp"
+#include "algorithm_exception.hpp"
+
+
+namespace
+{
+    void check_spec(const WorkloadSpec& spec)
+    {
+        if (spec.processes < 1 || !(spec.load > 0) || !(spec.burst_alpha > 0) || spec.min_burst < 1 || spec.min_burst > spec.max_burst)
+        {
+            std::ostringstream buf;
+            buf << "generate_workload - bad spec: " << spec.processes << " processes, load " << spec.load;
+            buf << ", alpha " << spec.burst_alpha << ", bursts " << spec.min_burst << " to " << spec.max_burst;
+            throw AlgorithmException{buf.str()};
+        }
+    }
+
+    // the inverse of the bounded Pareto distribution's CDF, at u in [0, 1)
+    int pareto_burst(double u, const WorkloadSpec& spec)
+    {
+        double low = spec.min_burst;
+        double tail = 1 - std::pow(low / spec.max_burst, spec.burst_alpha);
+        double burst = low / std::pow(1 - u * tail, 1 / spec.burst_alpha);
+        return std::min(std::max(static_cast<int>(burst), spec.min_burst), spec.max_burst);
+    }
+}
+
+
+WorkloadSpec::WorkloadSpec()
+    : processes{1000},
+      load{0.9},
+      burst_alpha{1.5},
+      min_burst{1},
+      max_burst{10000},
+      seed{1}
+{
+}
+
+ProcessTrace generate_workload(const WorkloadSpec& spec)
+{
+    check_spec(spec);
+
+    std::mt19937_64 random{spec.seed};
+    std::uniform_real_distribution<double> uniform{0, 1};
+    std::vector<int32_t> values(2 * static_cast<std::size_t>(spec.processes));
+    double total_burst = 0;
+    for (int i = 0; i < spec.processes; ++i)
+    {
+        values[2 * i + 1] = pareto_burst(uniform(random), spec);
+        total_burst += values[2 * i + 1];
+    }
+
+    // exponential gaps between arrivals make them a Poisson process
+    std::exponential_distribution<double> gap{spec.load * spec.processes / total_burst};
+    double arrival = 0;
+    for (int i = 0; i < spec.processes; ++i)
+    {
+        if (arrival > INT_MAX)
+        {
+            std::ostringstream buf;
+            buf << "generate_workload - process " << i << " would arrive after cycle " << INT_MAX;
+            throw AlgorithmException{buf.str()};
+        }
+        values[2 * i] = static_cast<int32_t>(arrival);
+        arrival += gap(random);
+    }
+    return ProcessTrace::from_values(std::move(values));
+}
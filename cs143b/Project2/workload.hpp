@@ -0,0 +1,31 @@
+#ifndef PROJECT2_WORKLOAD_HPP
+#define PROJECT2_WORKLOAD_HPP
+
+#include <cstdint>
+#include "process_trace.hpp"
+
+
+// Describes a synthetic input: processes arrive as a Poisson process, and their run times (bursts) follow a
+// bounded Pareto distribution - mostly short, with a heavy tail of long ones.
+struct WorkloadSpec
+{
+    int processes;
+    double load;            // the fraction of cycles the CPU is expected to be busy (arrival rate * mean burst)
+    double burst_alpha;     // the Pareto shape; the smaller, the heavier the tail (1 to 2 is typical)
+    int min_burst;
+    int max_burst;
+    uint64_t seed;
+
+    /* 1000 processes at a load of 0.9, with bursts of 1 to 10000 cycles shaped by 1.5, and seed 1 */
+    WorkloadSpec();
+};
+
+
+/* Generates spec's processes, in arrival order; the first arrives at cycle 0.
+ * The arrival rate is spec.load over the mean of the bursts drawn, so the generated load is spec.load (up to rounding).
+ * The same spec always generates the same workload.
+ * Throws an AlgorithmException unless processes >= 1, load > 0, burst_alpha > 0 and 1 <= min_burst <= max_burst.
+ */
+ProcessTrace generate_workload(const WorkloadSpec& spec);
+
+#endif //PROJECT2_WORKLOAD_HPP
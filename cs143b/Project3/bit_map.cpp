@@ -1,24 +1,75 @@
+#include <bitset>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include "bit_map.hpp"
 #include "memory_exception.hpp"
 
 
+namespace
+{
+    const int WORD_BITS = 64;
+
+    inline int count_trailing_zeros(uint64_t word)     // word must not be 0
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int result = 0;
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    inline int population_count(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int result = 0;
+        for (; word != 0; word &= word - 1)
+        {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    // the bits of a word at or above position bit
+    inline uint64_t bits_from(int bit)
+    {
+        return ~0ull << bit;
+    }
+}
+
+
 int BitMap::BITMAP_CAP = 32;
 
 BitMap::BitMap(int cap)
-    : capacity{cap}, array{new std::bitset<32>[cap]}
+    : capacity{cap}, n_frames{cap * WIDTH},
+      words((n_frames + WORD_BITS - 1) / WORD_BITS), not_full((words.size() + WORD_BITS - 1) / WORD_BITS)
 {
     clear();
 }
 
+BitMap::BitMap()
+    : BitMap{BITMAP_CAP}
+{
+}
+
 std::ostream& operator<<(std::ostream& os, const BitMap& bm)
 {
     os << "BitMap(" << std::endl;
-    for (unsigned int i = 0; i < bm.size(); ++i)
+    for (int i = 0; i < bm.size(); ++i)
     {
-        os << "  " << std::setw(2) << i << ": " << bm.array[i] << std::endl;
+        int first = i * WIDTH;
+        uint64_t bits = bm.words[first / WORD_BITS] >> (first % WORD_BITS);
+        os << "  " << std::setw(2) << i << ": " << std::bitset<WIDTH>{bits} << std::endl;
     }
     os << ")";
     return os;
@@ -34,80 +85,194 @@ int BitMap::width() const
     return WIDTH;
 }
 
+int BitMap::frames() const
+{
+    return n_frames;
+}
+
+int BitMap::count() const
+{
+    int result = 0;
+    for (uint64_t word : words)
+    {
+        result += population_count(word);
+    }
+    return result - static_cast<int>(words.size() * WORD_BITS - n_frames);     // less the padding
+}
+
+bool BitMap::test(int frame) const
+{
+    check_frame(frame);
+    return (words[frame / WORD_BITS] >> (frame % WORD_BITS)) & 1;
+}
+
 void BitMap::clear()
 {
-    for (unsigned int i = 0; i < size(); ++i)
+    for (uint64_t& word : words)
+    {
+        word = 0;
+    }
+    // the bits past the last frame are kept set, so that searches never return them
+    if (n_frames % WORD_BITS != 0)
+    {
+        words.back() = bits_from(n_frames % WORD_BITS);
+    }
+
+    for (std::size_t i = 0; i < words.size(); ++i)
     {
-        array[i].reset();
+        update_summary(static_cast<int>(i));
     }
 }
 
 std::pair<int, int> BitMap::find_first_zero() const
 {
-    return find_zero_starting_from(0, 1);   // skip ST (0, 0)
+    int frame = find_zero(1, frames());   // skip ST (0, 0)
+    if (frame == frames())
+    {
+        throw MemoryException{"BitMap::find_first_zero - bitmap out of space"};
+    }
+    return std::make_pair(frame / WIDTH, frame % WIDTH);
 }
 
 std::pair<int, int> BitMap::find_consecutive_zeros() const
 {
-    int index = 0;
-    int bit = 1;
+    int frame = find_run(2, 1, frames());
+    if (frame == -1)
+    {
+        throw MemoryException{"BitMap::find_consecutive_zeros - bitmap out of space"};
+    }
+    return std::make_pair(frame / WIDTH, frame % WIDTH);
+}
 
-    while (index < size())
+int BitMap::find_zeros(int length, int cursor) const
+{
+    if (cursor < 0 || cursor > frames())
     {
-        std::pair<int, int> first_pair = find_zero_starting_from(index, bit);
-        int first = first_pair.first;
-        int second = first_pair.second + 1;
-        check_bounds(first, second);
+        cursor = 0;
+    }
 
-        if (!array[first].test(second))
-        {
-            return first_pair;
-        }
-        index = first;
-        bit = second + 1;
-        check_bounds(index, bit);
+    int frame = find_run(length, cursor, frames());
+    if (frame == -1)
+    {
+        frame = find_run(length, 0, cursor);
+    }
+    if (frame == -1)
+    {
+        std::ostringstream msg;
+        msg << "BitMap::find_zeros - no " << length << " consecutive free frames";
+        throw MemoryException{msg.str()};
     }
-    throw MemoryException{"BitMap::find_consecutive_zeros - bitmap out of space"};
+    return frame;
 }
 
 void BitMap::set(int index, int bit, bool value)
 {
-    check_bounds(index, bit);
-    array[index].set(bit, value);
+    set(index * WIDTH + bit, value);
 }
 
-std::pair<int, int> BitMap::find_zero_starting_from(int index, int bit) const
+void BitMap::set(int frame, bool value)
 {
-    if (index >= size())
-    {
-        std::ostringstream msg;
-        msg << "BitMap::find_zero_starting_from - " << index << " out of range";
-        throw std::out_of_range{msg.str()};
-    }
-    if (bit == width())
+    check_frame(frame);
+    int word = frame / WORD_BITS;
+    uint64_t mask = 1ull << (frame % WORD_BITS);
+    words[word] = value ? words[word] | mask : words[word] & ~mask;
+    update_summary(word);
+}
+
+int BitMap::find_zero(int from, int to) const
+{
+    if (from >= to)
     {
-        bit = 0;
+        return to;
     }
 
-    for (int i = index; i < size(); ++i)
+    int word = from / WORD_BITS;
+    uint64_t free = ~words[word] & bits_from(from % WORD_BITS);
+    while (free == 0)
     {
-        bool first_iteration = i == index;
-        for (int j = first_iteration ? bit : 0; j < width(); ++j)
+        // move to the next word with a free frame, skipping 64 full words per summary word
+        int next = word + 1;
+        int summary = next / WORD_BITS;
+        if (summary >= static_cast<int>(not_full.size()))
         {
-            if (!array[i].test(j))
+            return to;
+        }
+        uint64_t candidates = next % WORD_BITS == 0 ? not_full[summary] : not_full[summary] & bits_from(next % WORD_BITS);
+        while (candidates == 0)
+        {
+            if (++summary >= static_cast<int>(not_full.size()))
             {
-                return std::make_pair(i, j);
+                return to;
             }
+            candidates = not_full[summary];
+        }
+
+        word = summary * WORD_BITS + count_trailing_zeros(candidates);
+        if (word * WORD_BITS >= to)
+        {
+            return to;
+        }
+        free = ~words[word];
+    }
+
+    int frame = word * WORD_BITS + count_trailing_zeros(free);
+    return frame < to ? frame : to;
+}
+
+int BitMap::find_one(int from, int to) const
+{
+    if (from >= to)
+    {
+        return to;
+    }
+
+    int word = from / WORD_BITS;
+    uint64_t used = words[word] & bits_from(from % WORD_BITS);
+    while (used == 0)
+    {
+        if (++word * WORD_BITS >= to)
+        {
+            return to;
+        }
+        used = words[word];
+    }
+
+    int frame = word * WORD_BITS + count_trailing_zeros(used);
+    return frame < to ? frame : to;
+}
+
+int BitMap::find_run(int length, int from, int to) const
+{
+    for (int start = find_zero(from, to); start < to; )
+    {
+        if (start + length > frames())
+        {
+            return -1;
+        }
+
+        int end = find_one(start, start + length);
+        if (end == start + length)
+        {
+            return start;
         }
+        start = find_zero(end, to);
     }
-    throw MemoryException{"BitMap::find_zero_starting_from - bitmap out of space"};
+    return -1;
 }
 
-void BitMap::check_bounds(int& index, int& bit) const
+void BitMap::check_frame(int frame) const
 {
-    if (bit == width())
+    if (frame < 0 || frame >= frames())
     {
-        bit = 0;
-        ++index;
+        std::ostringstream msg;
+        msg << "BitMap - frame " << frame << " out of range";
+        throw std::out_of_range{msg.str()};
     }
-}
\ No newline at end of file
+}
+
+void BitMap::update_summary(int word)
+{
+    uint64_t mask = 1ull << (word % WORD_BITS);
+    uint64_t& summary = not_full[word / WORD_BITS];
+    summary = ~words[word] != 0 ? summary | mask : summary & ~mask;
+}
@@ -1,18 +1,27 @@
 #ifndef PROJECT3_BIT_MAP_HPP
 #define PROJECT3_BIT_MAP_HPP
 
-#include <bitset>
 #include <iostream>
-#include <memory>
 #include <utility>
+#include <vector>
+#include <cstdint>
 
 #define WIDTH 32
 
+// One bit per frame of physical memory; a set bit means the frame is in use.
+//
+// The bits are stored in 64-bit words, and a summary level keeps one bit per word, set while that word
+// still has a free frame, so searches skip full words 64 at a time and test each remaining word whole
+// (with count-trailing-zeros) instead of bit by bit.
+//
+// Frames are numbered from 0. For compatibility, a frame can also be addressed as (index, bit) of
+// WIDTH-bit words: frame = index * WIDTH + bit.
 class BitMap
 {
 public:
     static int BITMAP_CAP;
 
+    /* Makes a bitmap of cap WIDTH-bit words (cap * WIDTH frames), all free */
     explicit BitMap(int cap);
     BitMap();
 
@@ -20,18 +29,50 @@ public:
 
     int size() const;
     int width() const;
+    int frames() const;
+
+    /* Returns the number of frames in use */
+    int count() const;
+
+    bool test(int frame) const;
+
+    /* Returns the first free frame other than frame 0 (the segment table's) as (index, bit);
+     * throws a MemoryException if there is none
+     */
     std::pair<int, int> find_first_zero() const;
+
+    /* Returns the first of the first two consecutive free frames other than frame 0 as (index, bit);
+     * throws a MemoryException if there are none
+     */
     std::pair<int, int> find_consecutive_zeros() const;
 
+    /* Returns the first frame of the first run of length free frames found searching from frame cursor to the end,
+     * and then (next-fit) from frame 0 up to cursor; throws a MemoryException if there is no such run
+     */
+    int find_zeros(int length, int cursor) const;
+
+    /* Throw std::out_of_range if the frame is not in the bitmap */
     void set(int index, int bit, bool value);
+    void set(int frame, bool value);
     void clear();
 
 private:
     int capacity;
-    std::unique_ptr<std::bitset<32>[]> array;
+    int n_frames;
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> not_full;     // bit w % 64 of not_full[w / 64] is set iff words[w] has a free frame
+
+    /* Returns the first free frame in [from, to), or to if there is none */
+    int find_zero(int from, int to) const;
+
+    /* Returns the first used frame in [from, to), or to if there is none */
+    int find_one(int from, int to) const;
+
+    /* Returns the first frame of the first run of length free frames starting in [from, to), or -1 */
+    int find_run(int length, int from, int to) const;
 
-    std::pair<int, int> find_zero_starting_from(int index, int bit) const;
-    void check_bounds(int& index, int& bit) const;
+    void check_frame(int frame) const;
+    void update_summary(int word);
 };
 
 #endif //PROJECT3_BIT_MAP_HPP
@@ -1,84 +1,29 @@
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
-#include <cstdint>
+#include "tools/span_timer.hpp"
 #include "vm_system.hpp"
+#include "vm_trace.hpp"
 
 
 
-void process_page_table_line(std::ifstream& infile, VirtualMemorySystem& system)
+void start(const VirtualMemoryTrace& trace, VirtualMemorySystem& system, bool use_tlb)
 {
-    std::string line;
-    std::getline(infile, line);
-    std::istringstream processor{line};
-
-    while (processor)
-    {
-        int segment;
-        int address;
-        processor >> segment;
-        processor >> address;
-        processor.sync();
-
-        system.create_page_table(segment, address);
-    }
+    trace.initialize(system);
+    trace.run(system, use_tlb);
+    system.flush_results();
 }
 
-void process_page_line(std::ifstream& infile, VirtualMemorySystem& system)
+void report_timing(const std::string& name, const VirtualMemorySystem& system)
 {
-    std::string line;
-    std::getline(infile, line);
-    std::istringstream processor{line};
-
-    while (processor)
+    const AccessTiming& timing = system.get_timing();
+    std::cout << name << ": " << timing.accesses << " accesses, "
+              << timing.average_memory_access_time() << " cycles per access on average";
+    for (int level = 0; level < system.tlb_levels() && timing.tlb_cycles[level] > 0; ++level)
     {
-        int page;
-        int segment;
-        int address;
-        processor >> page;
-        processor >> segment;
-        processor >> address;
-        processor.sync();
-
-        system.create_page(page, segment, address);
+        std::cout << ", L" << level + 1 << " TLB hit rate " << system.get_tlb(level).hit_rate();
     }
-}
-
-void process_action_file(std::ifstream& infile, VirtualMemorySystem& system, bool tlb)
-{
-    std::string line;
-    std::getline(infile, line);
-    std::istringstream processor{line};
-
-    while (processor)
-    {
-        int action;
-        int32_t virtual_address;
-        processor >> action;
-        processor >> virtual_address;
-        processor.sync();
-
-        switch (action)
-        {
-            case 0:
-                system.read(virtual_address, tlb);
-                break;
-            case 1:
-                system.write(virtual_address, tlb);
-                break;
-            default:
-                break;
-        }
-        std::cout.flush();
-    }
-}
-
-void start(std::ifstream& memory_infile, std::ifstream& infile, VirtualMemorySystem& system, bool use_tlb)
-{
-    process_page_table_line(memory_infile, system);
-    process_page_line(memory_infile, system);
-    process_action_file(infile, system, use_tlb);
+    std::cout << std::endl;
 }
 
 
@@ -101,23 +46,23 @@ int main()
     std::ofstream outfile1{outfile1_path};
     std::ofstream outfile2{outfile2_path};
 
-    std::ifstream memory_infile{memory_infile_path};
-    std::ifstream infile{infile_path};
+    // parsed once, for both runs
+    VirtualMemoryTrace trace = VirtualMemoryTrace::from_text(memory_infile_path, infile_path);
 
     auto buf1 = std::cout.rdbuf(outfile1.rdbuf());
     VirtualMemorySystem system;
-    start(memory_infile, infile, system, false);
+    start(trace, system, false);
 
     std::cout.rdbuf(buf1);
-
-    memory_infile.seekg(0);
-    infile.seekg(0);
+    report_timing("no TLB", system);
 
     auto buf2 = std::cout.rdbuf(outfile2.rdbuf());
     system = VirtualMemorySystem{};
-    start(memory_infile, infile, system, true);
+    start(trace, system, true);
 
     std::cout.rdbuf(buf2);
+    report_timing("TLB", system);
+    span_report(std::cerr);
 
 
     return 0;
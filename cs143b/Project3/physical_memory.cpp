@@ -0,0 +1,134 @@
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <utility>
+#include "physical_memory.hpp"
+#include "memory_exception.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define PROJECT3_HAS_MMAP
+#endif
+
+#if defined(PROJECT3_HAS_MMAP) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#if defined(PROJECT3_HAS_MMAP) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+
+PhysicalMemory::PhysicalMemory(int frames, int frame_size)
+    : words{nullptr}, length{static_cast<std::size_t>(frames) * frame_size}, frame_size{frame_size},
+      mapped{false}, is_touched(frames, false)
+{
+#ifdef PROJECT3_HAS_MMAP
+    void* region = mmap(nullptr, length * sizeof(int), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region != MAP_FAILED)
+    {
+        words = static_cast<int*>(region);
+        mapped = true;
+    }
+#endif
+    if (words == nullptr)
+    {
+        words = static_cast<int*>(std::calloc(length, sizeof(int)));
+    }
+    if (words == nullptr)
+    {
+        std::ostringstream buf;
+        buf << "PhysicalMemory - cannot reserve " << frames << " frames of " << frame_size << " words";
+        throw MemoryException{buf.str()};
+    }
+}
+
+PhysicalMemory::PhysicalMemory(PhysicalMemory&& other)
+    : words{other.words}, length{other.length}, frame_size{other.frame_size}, mapped{other.mapped},
+      touched{std::move(other.touched)}, is_touched{std::move(other.is_touched)}
+{
+    other.words = nullptr;
+    other.length = 0;
+}
+
+PhysicalMemory& PhysicalMemory::operator=(PhysicalMemory&& other)
+{
+    if (this != &other)
+    {
+        release();
+        words = other.words;
+        length = other.length;
+        frame_size = other.frame_size;
+        mapped = other.mapped;
+        touched = std::move(other.touched);
+        is_touched = std::move(other.is_touched);
+        other.words = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+PhysicalMemory::~PhysicalMemory()
+{
+    release();
+}
+
+const int* PhysicalMemory::data() const
+{
+    return words;
+}
+
+std::size_t PhysicalMemory::size() const
+{
+    return length;
+}
+
+void PhysicalMemory::store(int address, int value)
+{
+    if (address < 0 || static_cast<std::size_t>(address) >= length)
+    {
+        std::ostringstream buf;
+        buf << "PhysicalMemory::store - address " << address << " out of range";
+        throw MemoryException{buf.str()};
+    }
+
+    int frame = address / frame_size;
+    if (!is_touched[frame])
+    {
+        is_touched[frame] = true;
+        touched.push_back(frame);
+    }
+    words[address] = value;
+}
+
+int PhysicalMemory::touched_frames() const
+{
+    return static_cast<int>(touched.size());
+}
+
+void PhysicalMemory::clear()
+{
+    for (int frame : touched)
+    {
+        std::memset(words + static_cast<std::size_t>(frame) * frame_size, 0, frame_size * sizeof(int));
+        is_touched[frame] = false;
+    }
+    touched.clear();
+}
+
+void PhysicalMemory::release()
+{
+    if (words == nullptr)
+    {
+        return;
+    }
+#ifdef PROJECT3_HAS_MMAP
+    if (mapped)
+    {
+        munmap(words, length * sizeof(int));
+        words = nullptr;
+        return;
+    }
+#endif
+    std::free(words);
+    words = nullptr;
+}
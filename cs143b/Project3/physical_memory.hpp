@@ -0,0 +1,55 @@
+#ifndef PROJECT3_PHYSICAL_MEMORY_HPP
+#define PROJECT3_PHYSICAL_MEMORY_HPP
+
+#include <cstddef>
+#include <vector>
+
+
+// The words of simulated physical memory, all 0 until stored to.
+//
+// The words are reserved, not committed: on POSIX systems they are an anonymous private mapping,
+// which the operating system only backs with (zeroed) pages as they are touched, so even a
+// multi-gigabyte memory is made instantly; elsewhere they come from calloc, which large allocations
+// get the same way from most allocators.
+// Every store records its frame, so clear() only zeroes the frames that were stored to.
+class PhysicalMemory
+{
+public:
+    /* Throws a MemoryException if the memory cannot be reserved */
+    PhysicalMemory(int frames, int frame_size);
+    PhysicalMemory(const PhysicalMemory& other) = delete;
+    PhysicalMemory& operator=(const PhysicalMemory& other) = delete;
+    PhysicalMemory(PhysicalMemory&& other);
+    PhysicalMemory& operator=(PhysicalMemory&& other);
+    ~PhysicalMemory();
+
+    /* Reads are not range checked */
+    int operator[](int address) const
+    {
+        return words[address];
+    }
+
+    const int* data() const;
+    std::size_t size() const;
+
+    /* Throws a MemoryException if address is out of range */
+    void store(int address, int value);
+
+    /* Returns the number of frames stored to since construction or the last clear() */
+    int touched_frames() const;
+
+    /* Zeroes every frame stored to */
+    void clear();
+
+private:
+    int* words;
+    std::size_t length;
+    int frame_size;
+    bool mapped;                    // words is a mapping (munmap) rather than an allocation (free)
+    std::vector<int> touched;       // every frame stored to, once each
+    std::vector<bool> is_touched;   // by frame
+
+    void release();
+};
+
+#endif //PROJECT3_PHYSICAL_MEMORY_HPP
@@ -0,0 +1,110 @@
+#include "result_sink.hpp"
+
+
+const std::size_t TextResultSink::BUFFER_SIZE = 1 << 16;
+
+TextResultSink::TextResultSink(std::ostream& os)
+    : out(os)
+{
+    buffer.reserve(BUFFER_SIZE);
+}
+
+TextResultSink::~TextResultSink()
+{
+    flush();
+}
+
+void TextResultSink::record(const AccessResult& result, bool use_tlb)
+{
+    if (use_tlb)
+    {
+        buffer.append(result.tlb_hit ? "h " : "m ");
+    }
+
+    switch (result.status)
+    {
+        case AccessStatus::ok:
+            append_int(result.physical_address);
+            break;
+        case AccessStatus::page_fault:
+            buffer.append("pf");
+            break;
+        case AccessStatus::error:
+            buffer.append("err");
+            break;
+    }
+    buffer.push_back(' ');
+
+    if (buffer.size() >= BUFFER_SIZE)
+    {
+        flush();
+    }
+}
+
+void TextResultSink::flush()
+{
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    out.flush();
+}
+
+void TextResultSink::append_int(int value)
+{
+    char digits[12];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+
+    do
+    {
+        *--start = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+    {
+        *--start = '-';
+    }
+    buffer.append(start, end);
+}
+
+void BinaryResultSink::record(const AccessResult& result, bool)
+{
+    recorded.push_back(result);
+}
+
+void BinaryResultSink::flush()
+{
+}
+
+const std::vector<AccessResult>& BinaryResultSink::results() const
+{
+    return recorded;
+}
+
+void BinaryResultSink::clear()
+{
+    recorded.clear();
+}
+
+NullResultSink::NullResultSink()
+    : recorded{0}
+{
+}
+
+void NullResultSink::record(const AccessResult&, bool)
+{
+    ++recorded;
+}
+
+void NullResultSink::flush()
+{
+}
+
+long long NullResultSink::count() const
+{
+    return recorded;
+}
@@ -0,0 +1,89 @@
+#ifndef PROJECT3_RESULT_SINK_HPP
+#define PROJECT3_RESULT_SINK_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+enum class AccessStatus : uint8_t
+{
+    ok,             // physical_address is valid
+    page_fault,     // "pf": the segment or page is not resident
+    error           // "err": the segment or page does not exist (reads only; writes create them)
+};
+
+struct AccessResult
+{
+    int physical_address;
+    AccessStatus status;
+    bool tlb_hit;       // always false when translated without the TLB
+};
+
+
+// Receives the outcome of every read/write a VirtualMemorySystem performs.
+// Sinks may buffer what they record until flush() is called.
+class ResultSink
+{
+public:
+    virtual ~ResultSink() = default;
+
+    /* Records result; use_tlb says whether the access went through the TLB */
+    virtual void record(const AccessResult& result, bool use_tlb) = 0;
+    virtual void flush() = 0;
+};
+
+
+// Formats results as the project's output expects ("pf", "err" or the physical address, after "h"/"m" with the TLB,
+// each followed by a space), into a buffer that is written to the stream only when it fills up, or on flush().
+class TextResultSink : public ResultSink
+{
+public:
+    static const std::size_t BUFFER_SIZE;
+
+    explicit TextResultSink(std::ostream& os);
+    ~TextResultSink() override;
+
+    void record(const AccessResult& result, bool use_tlb) override;
+    void flush() override;
+
+private:
+    std::ostream& out;
+    std::string buffer;
+
+    void append_int(int value);
+};
+
+
+// Keeps every result, in order, in memory
+class BinaryResultSink : public ResultSink
+{
+public:
+    void record(const AccessResult& result, bool use_tlb) override;
+    void flush() override;
+
+    const std::vector<AccessResult>& results() const;
+    void clear();
+
+private:
+    std::vector<AccessResult> recorded;
+};
+
+
+// Discards every result, only counting them; for measuring the simulation alone
+class NullResultSink : public ResultSink
+{
+public:
+    NullResultSink();
+
+    void record(const AccessResult& result, bool use_tlb) override;
+    void flush() override;
+
+    long long count() const;
+
+private:
+    long long recorded;
+};
+
+#endif //PROJECT3_RESULT_SINK_HPP
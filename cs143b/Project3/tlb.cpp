@@ -1,11 +1,28 @@
-#include <algorithm>
+#include <sstream>
 #include "tlb.hpp"
+#include "memory_exception.hpp"
 
 
+TranslationLookAsideBuffer::TranslationLookAsideBuffer(int entries, int ways, ReplacementPolicy policy)
+    : n_ways{ways}, n_sets{ways > 0 ? entries / ways : 0}, replacement{policy}, random{1},
+      hit_count{0}, miss_count{0}, eviction_count{0}
+{
+    if (entries <= 0 || ways <= 0 || entries % ways != 0)
+    {
+        std::ostringstream buf;
+        buf << "TranslationLookAsideBuffer - " << entries << " entries cannot be split into sets of " << ways << " ways";
+        throw MemoryException{buf.str()};
+    }
+
+    lines.resize(entries);
+    set_states.resize(n_sets);
+    index.reserve(entries);
+    clear();
+}
+
 TranslationLookAsideBuffer::TranslationLookAsideBuffer(int max_size)
-    : capacity{max_size}, cache{new Entry[capacity]}, length{0}
+    : TranslationLookAsideBuffer{max_size, max_size, ReplacementPolicy::LRU}
 {
-    init_cache();
 }
 
 TranslationLookAsideBuffer::TranslationLookAsideBuffer()
@@ -13,73 +30,191 @@ TranslationLookAsideBuffer::TranslationLookAsideBuffer()
 {
 }
 
-int TranslationLookAsideBuffer::hit_index(int sp) const
+int TranslationLookAsideBuffer::capacity() const
+{
+    return n_ways * n_sets;
+}
+
+int TranslationLookAsideBuffer::ways() const
+{
+    return n_ways;
+}
+
+int TranslationLookAsideBuffer::sets() const
+{
+    return n_sets;
+}
+
+ReplacementPolicy TranslationLookAsideBuffer::policy() const
+{
+    return replacement;
+}
+
+bool TranslationLookAsideBuffer::lookup(int sp, int& frame)
 {
-    for (unsigned int i = 0; i < capacity; ++i)
+    auto position = index.find(sp);
+    if (position == index.end())
     {
-        Entry& entry = cache[i];
-        if (cache[i].sp == sp)
-        {
-            return i;
-        }
+        ++miss_count;
+        return false;
     }
-    return -1;
+
+    ++hit_count;
+    int line = position.value();
+    touch(line / n_ways, line);
+    frame = lines[line].frame;
+    return true;
 }
 
-int TranslationLookAsideBuffer::max_lru_value() const
+void TranslationLookAsideBuffer::insert(int sp, int frame)
 {
-    return capacity - 1;
+    auto position = index.find(sp);
+    if (position != index.end())
+    {
+        int line = position.value();
+        lines[line].frame = frame;
+        touch(line / n_ways, line);
+        return;
+    }
+
+    int set = static_cast<int>(static_cast<unsigned int>(sp) % n_sets);
+    int line = claim_line(set);
+    lines[line].sp = sp;
+    lines[line].frame = frame;
+    lines[line].referenced = true;
+    if (replacement == ReplacementPolicy::LRU)
+    {
+        link_newest(set, line);
+    }
+    index.insert_or_assign(sp, line);
 }
 
-int TranslationLookAsideBuffer::do_hit(int sp, int line)
+void TranslationLookAsideBuffer::clear()
 {
-    Entry& hit = cache[line];
-    for (unsigned int i = 0; i < capacity; ++i)
+    for (Line& line : lines)
     {
-        Entry& current = cache[i];
-        if (current.lru_value < hit.lru_value)
-        {
-            --(current.lru_value);
-        }
+        line = Line{0, 0, -1, -1, false};
+    }
+    for (Set& set : set_states)
+    {
+        set = Set{0, -1, -1, 0};
     }
-    hit.lru_value = max_lru_value();
-    return hit.f;
+    index.clear();
+}
+
+long long TranslationLookAsideBuffer::hits() const
+{
+    return hit_count;
 }
 
-void TranslationLookAsideBuffer::do_miss(int sp, int frame)
+long long TranslationLookAsideBuffer::misses() const
 {
-    int lowest_lru_index = find_index_with_value(0);
-    Entry& entry = cache[lowest_lru_index];
-    entry.lru_value = max_lru_value();
-    entry.sp = sp;
-    entry.f = frame;
+    return miss_count;
+}
 
-    for (unsigned int i = 0; i < capacity; ++i)
+long long TranslationLookAsideBuffer::evictions() const
+{
+    return eviction_count;
+}
+
+double TranslationLookAsideBuffer::hit_rate() const
+{
+    long long lookups = hit_count + miss_count;
+    return lookups == 0 ? 0 : static_cast<double>(hit_count) / lookups;
+}
+
+void TranslationLookAsideBuffer::reset_statistics()
+{
+    hit_count = miss_count = eviction_count = 0;
+}
+
+void TranslationLookAsideBuffer::touch(int set, int line)
+{
+    if (replacement == ReplacementPolicy::LRU)
     {
-        if (i != lowest_lru_index)
+        if (set_states[set].newest != line)
         {
-            --(cache[i].lru_value);
+            unlink(set, line);
+            link_newest(set, line);
         }
     }
+    else
+    {
+        lines[line].referenced = true;
+    }
 }
 
-int TranslationLookAsideBuffer::find_index_with_value(int value) const
+int TranslationLookAsideBuffer::claim_line(int set)
 {
-    int i = 0;
-    for (; i < capacity; ++i)
+    Set& state = set_states[set];
+    int first = set * n_ways;
+    if (state.used < n_ways)
     {
-        if (cache[i].lru_value == value)
-        {
+        return first + state.used++;
+    }
+
+    int victim = first;
+    switch (replacement)
+    {
+        case ReplacementPolicy::LRU:
+            victim = state.oldest;
+            unlink(set, victim);
+            break;
+        case ReplacementPolicy::CLOCK:
+            // every line gets a second chance; after one full turn, some line is unreferenced
+            while (lines[first + state.hand].referenced)
+            {
+                lines[first + state.hand].referenced = false;
+                state.hand = (state.hand + 1) % n_ways;
+            }
+            victim = first + state.hand;
+            state.hand = (state.hand + 1) % n_ways;
+            break;
+        case ReplacementPolicy::RANDOM:
+            victim = first + static_cast<int>(random() % n_ways);
             break;
-        }
     }
-    return i;
+
+    index.erase(lines[victim].sp);
+    ++eviction_count;
+    return victim;
 }
 
-void TranslationLookAsideBuffer::init_cache()
+void TranslationLookAsideBuffer::unlink(int set, int line)
 {
-    for (unsigned int i = 0; i < capacity; ++i)
+    Line& unlinked = lines[line];
+    if (unlinked.newer == -1)
+    {
+        set_states[set].newest = unlinked.older;
+    }
+    else
+    {
+        lines[unlinked.newer].older = unlinked.older;
+    }
+
+    if (unlinked.older == -1)
+    {
+        set_states[set].oldest = unlinked.newer;
+    }
+    else
     {
-        cache[i] = Entry{0, -1, -1};
+        lines[unlinked.older].newer = unlinked.newer;
     }
-}
\ No newline at end of file
+    unlinked.newer = unlinked.older = -1;
+}
+
+void TranslationLookAsideBuffer::link_newest(int set, int line)
+{
+    Set& state = set_states[set];
+    lines[line].older = state.newest;
+    lines[line].newer = -1;
+    if (state.newest == -1)
+    {
+        state.oldest = line;
+    }
+    else
+    {
+        lines[state.newest].newer = line;
+    }
+    state.newest = line;
+}
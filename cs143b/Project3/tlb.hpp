@@ -1,35 +1,104 @@
 #ifndef PROJECT3_TLB_HPP
 #define PROJECT3_TLB_HPP
 
-#include <iostream>
-#include <memory>
+#include <random>
+#include <vector>
+#include "data_structures/flat_hash_map.hpp"
 
+
+enum class ReplacementPolicy
+{
+    LRU,        // the least-recently used line of the set; kept in an intrusive list per set, so O(1)
+    CLOCK,      // the first line of the set, from the clock hand, not referenced since the hand last passed it
+    RANDOM      // a uniformly random line of the set
+};
+
+
+// Caches the frame of recently translated segment/page (sp) numbers.
+//
+// The buffer holds entries lines, split into entries / ways sets of ways lines each; an sp can only be cached
+// in set sp % sets, and when that set is full, the policy picks which of its lines to replace.
+// With one set (ways == entries) the buffer is fully associative.
+// An index from sp to line makes lookups O(1) whatever the associativity.
+//
+// Lookups are counted as hits or misses, and replacements as evictions, until reset_statistics().
 class TranslationLookAsideBuffer
 {
 public:
+    /* Throws a MemoryException if entries or ways is not positive, or entries is not a multiple of ways */
+    TranslationLookAsideBuffer(int entries, int ways, ReplacementPolicy policy);
+
+    /* Fully associative and LRU */
     explicit TranslationLookAsideBuffer(int max_size);
     TranslationLookAsideBuffer();
 
-    int hit_index(int sp) const;
-    int max_lru_value() const;
+    int capacity() const;
+    int ways() const;
+    int sets() const;
+    ReplacementPolicy policy() const;
+
+    /* If sp is cached, marks it as used, stores its frame into frame, and returns true.
+     * Otherwise returns false.
+     */
+    bool lookup(int sp, int& frame);
+
+    /* Caches {sp: frame}, replacing a line of sp's set under the policy if the set is full.
+     * If sp is already cached, its frame is replaced and it is marked as used (without counting a hit).
+     */
+    void insert(int sp, int frame);
+
+    /* Empties the buffer; the statistics are kept */
+    void clear();
+
+    // Statistics
+    long long hits() const;
+    long long misses() const;
+    long long evictions() const;
+
+    /* Returns hits() / (hits() + misses()), or 0 if lookup() has never been called */
+    double hit_rate() const;
+
+    void reset_statistics();
 
-    int do_hit(int sp, int line);
-    void do_miss(int sp, int frame);
 
 private:
-    struct Entry
+    struct Line
     {
-        int lru_value;
         int sp;
-        int f;
+        int frame;
+        int newer;          // LRU only; the next more-recently used line of the set, or -1
+        int older;          // LRU only; the next less-recently used line of the set, or -1
+        bool referenced;    // CLOCK only
     };
 
-    int capacity;
-    std::unique_ptr<Entry[]> cache;
-    int length;
+    struct Set
+    {
+        int used;       // lines [0, used) of the set are filled
+        int newest;     // LRU only
+        int oldest;     // LRU only
+        int hand;       // CLOCK only; the next line the hand considers, relative to the set
+    };
+
+    int n_ways;
+    int n_sets;
+    ReplacementPolicy replacement;
+    std::vector<Line> lines;        // set s holds lines [s * ways, (s + 1) * ways)
+    std::vector<Set> set_states;
+    FlatHashMap<int, int> index;    // sp -> its line
+    std::minstd_rand random;        // RANDOM only
+
+    long long hit_count;
+    long long miss_count;
+    long long eviction_count;
+
+    /* Marks line (of set) as just used */
+    void touch(int set, int line);
+
+    /* Returns the line to fill in set: a free one, or the one the policy replaces (which is unlinked and unindexed) */
+    int claim_line(int set);
 
-    void init_cache();
-    int find_index_with_value(int value) const;
+    void unlink(int set, int line);
+    void link_newest(int set, int line);
 };
 
 #endif //PROJECT3_TLB_HPP
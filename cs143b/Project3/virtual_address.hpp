@@ -1,29 +1,76 @@
 #ifndef PROJECT3_VIRTUAL_ADDRESS_HPP
 #define PROJECT3_VIRTUAL_ADDRESS_HPP
 
-#include <bitset>
-#include <iostream>
-#include <memory>
+#include <cstddef>
 #include <cstdint>
 
 
-class VirtualAddress
+/* The widths, in bits, of the fields of a virtual address, from the most significant:
+ *   | ignored | segment (SegmentBits) | page (PageBits) | offset (OffsetBits) |
+ * Every field is extracted with one shift and one mask.
+ */
+template <int SegmentBits, int PageBits, int OffsetBits>
+struct AddressLayout
+{
+    static_assert(SegmentBits > 0 && PageBits > 0 && OffsetBits > 0, "every address field needs at least one bit");
+    static_assert(SegmentBits + PageBits + OffsetBits < 32, "an address layout must fit in 31 bits");
+
+    static constexpr int segment_bits() { return SegmentBits; }
+    static constexpr int page_bits() { return PageBits; }
+    static constexpr int offset_bits() { return OffsetBits; }
+
+    static constexpr int segment_number(uint32_t address) { return (address >> (OffsetBits + PageBits)) & ((1u << SegmentBits) - 1); }
+    static constexpr int page_number(uint32_t address) { return (address >> OffsetBits) & ((1u << PageBits) - 1); }
+    static constexpr int offset(uint32_t address) { return address & ((1u << OffsetBits) - 1); }
+    static constexpr int segment_and_page_number(uint32_t address) { return (address >> OffsetBits) & ((1u << (SegmentBits + PageBits)) - 1); }
+};
+
+// 4 ignored bits, a 9-bit segment number, a 10-bit page number, and a 9-bit offset
+typedef AddressLayout<9, 10, 9> DefaultAddressLayout;
+
+
+template <typename Layout = DefaultAddressLayout>
+class BasicVirtualAddress
 {
 public:
-    explicit VirtualAddress(int32_t addr);      // addr is a 32-bit int
+    constexpr explicit BasicVirtualAddress(int32_t addr) : raw_address{addr} {}     // addr is a 32-bit int
 
-    int32_t get_raw_address() const;
-    int segment_number() const;
-    int page_number() const;
-    int offset() const;
-    int segment_and_page_number() const;
+    constexpr int32_t get_raw_address() const { return raw_address; }
+    constexpr int segment_number() const { return Layout::segment_number(static_cast<uint32_t>(raw_address)); }
+    constexpr int page_number() const { return Layout::page_number(static_cast<uint32_t>(raw_address)); }
+    constexpr int offset() const { return Layout::offset(static_cast<uint32_t>(raw_address)); }
+    constexpr int segment_and_page_number() const { return Layout::segment_and_page_number(static_cast<uint32_t>(raw_address)); }
 
 private:
     int32_t raw_address;
-    std::bitset<32> address;
-    std::string discarded;
-
-    std::string discard_bits(unsigned int discard) const;
 };
 
+typedef BasicVirtualAddress<> VirtualAddress;
+
+
+/* Decodes addresses[0, count) into the parallel arrays segments, pages and offsets (each holding count ints).
+ * The loop has no branches, so the compiler can vectorize it.
+ */
+template <typename Layout = DefaultAddressLayout>
+void decode_addresses(const int32_t* addresses, std::size_t count, int* segments, int* pages, int* offsets)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        uint32_t address = static_cast<uint32_t>(addresses[i]);
+        segments[i] = Layout::segment_number(address);
+        pages[i] = Layout::page_number(address);
+        offsets[i] = Layout::offset(address);
+    }
+}
+
+/* Decodes the segment-and-page numbers (the TLB's keys) of addresses[0, count) into sps */
+template <typename Layout = DefaultAddressLayout>
+void decode_segment_and_page_numbers(const int32_t* addresses, std::size_t count, int* sps)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sps[i] = Layout::segment_and_page_number(static_cast<uint32_t>(addresses[i]));
+    }
+}
+
 #endif //PROJECT3_VIRTUAL_ADDRESS_HPP
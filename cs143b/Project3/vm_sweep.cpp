@@ -0,0 +1,132 @@
+#include <exception>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include "vm_sweep.hpp"
+#include "tools/ms_timer.hpp"
+
+
+namespace
+{
+    const char* policy_name(ReplacementPolicy policy)
+    {
+        switch (policy)
+        {
+            case ReplacementPolicy::LRU:
+                return "LRU";
+            case ReplacementPolicy::CLOCK:
+                return "CLOCK";
+            case ReplacementPolicy::RANDOM:
+                return "RANDOM";
+        }
+        return "?";
+    }
+
+    SweepResult run_configuration(const VirtualMemoryTrace& trace, const SweepConfiguration& configuration)
+    {
+        SweepResult result{configuration, true, "", 0, 0, 0, 0, 0, 0, 0};
+        ms_timer timer{true};
+        try
+        {
+            VirtualMemorySystem system{configuration.frames};
+            system.set_result_sink(std::make_shared<NullResultSink>());
+            if (configuration.use_tlb)
+            {
+                system.set_tlb(TranslationLookAsideBuffer{configuration.tlb_entries, configuration.tlb_ways, configuration.policy});
+            }
+
+            trace.initialize(system);
+            trace.translate(system, configuration.use_tlb, [&result](const AccessResult* results, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    result.page_faults += results[i].status == AccessStatus::page_fault;
+                    result.errors += results[i].status == AccessStatus::error;
+                    result.tlb_hits += results[i].tlb_hit;
+                }
+                result.accesses += count;
+            });
+
+            result.tlb_hit_rate = configuration.use_tlb ? system.get_tlb().hit_rate() : 0;
+            result.average_memory_access_time = system.get_timing().average_memory_access_time();
+        }
+        catch (const std::exception& e)
+        {
+            // e.g. the memory ran out of frames; the other configurations still run
+            result.completed = false;
+            result.error = e.what();
+        }
+        result.elapsed_ms = timer.read();
+        return result;
+    }
+}
+
+
+std::string SweepConfiguration::name() const
+{
+    std::ostringstream buf;
+    buf << frames << " frames, ";
+    if (use_tlb)
+    {
+        buf << "TLB " << tlb_entries << "x" << tlb_ways << " " << policy_name(policy);
+    }
+    else
+    {
+        buf << "no TLB";
+    }
+    return buf.str();
+}
+
+std::vector<SweepConfiguration> sweep_grid(const std::vector<int>& frame_counts,
+                                           const std::vector<std::pair<int, int>>& tlb_geometries,
+                                           const std::vector<ReplacementPolicy>& policies)
+{
+    std::vector<SweepConfiguration> result;
+    for (int frames : frame_counts)
+    {
+        result.push_back(SweepConfiguration{frames, false, 0, 0, ReplacementPolicy::LRU});
+        for (const std::pair<int, int>& geometry : tlb_geometries)
+        {
+            if (geometry.first <= 0 || geometry.second <= 0 || geometry.first % geometry.second != 0)
+            {
+                continue;
+            }
+            for (ReplacementPolicy policy : policies)
+            {
+                result.push_back(SweepConfiguration{frames, true, geometry.first, geometry.second, policy});
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<SweepResult> run_sweep(const VirtualMemoryTrace& trace, const std::vector<SweepConfiguration>& configurations,
+                                   TaskPool& pool)
+{
+    // every configuration gets its own system, so the runs share nothing but the (read-only) trace
+    std::vector<SweepResult> results(configurations.size());
+    pool.parallel_for(static_cast<int>(configurations.size()), [&](int i) {
+        results[i] = run_configuration(trace, configurations[i]);
+    });
+    return results;
+}
+
+void print_sweep_table(std::ostream& os, const std::vector<SweepResult>& results)
+{
+    os << std::left << std::setw(32) << "configuration" << std::right
+       << std::setw(12) << "accesses" << std::setw(12) << "faults" << std::setw(12) << "errors"
+       << std::setw(10) << "hit rate" << std::setw(10) << "AMAT" << std::setw(12) << "ms" << std::endl;
+
+    for (const SweepResult& result : results)
+    {
+        os << std::left << std::setw(32) << result.configuration.name() << std::right
+           << std::setw(12) << result.accesses << std::setw(12) << result.page_faults << std::setw(12) << result.errors
+           << std::fixed << std::setprecision(3)
+           << std::setw(10) << result.tlb_hit_rate << std::setw(10) << result.average_memory_access_time
+           << std::setw(12) << result.elapsed_ms << std::defaultfloat;
+        if (!result.completed)
+        {
+            os << "  failed: " << result.error;
+        }
+        os << std::endl;
+    }
+}
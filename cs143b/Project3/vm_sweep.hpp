@@ -0,0 +1,59 @@
+#ifndef PROJECT3_VM_SWEEP_HPP
+#define PROJECT3_VM_SWEEP_HPP
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "tools/task_pool.hpp"
+#include "tlb.hpp"
+#include "vm_trace.hpp"
+
+
+// One system to run a trace on
+struct SweepConfiguration
+{
+    int frames;                     // of physical memory
+    bool use_tlb;
+    int tlb_entries;                // the TLB's geometry and policy; unused without the TLB
+    int tlb_ways;
+    ReplacementPolicy policy;
+
+    /* Returns e.g. "1024 frames, TLB 16x4 LRU", or "1024 frames, no TLB" */
+    std::string name() const;
+};
+
+// What one configuration's run came to
+struct SweepResult
+{
+    SweepConfiguration configuration;
+    bool completed;                 // false if the run threw; error says why, and the counts are for the accesses before
+    std::string error;
+
+    long long accesses;
+    long long page_faults;
+    long long errors;               // accesses answered "err"
+    long long tlb_hits;
+    double tlb_hit_rate;
+    double average_memory_access_time;
+    double elapsed_ms;
+};
+
+
+/* Returns every combination of the given frame counts, with no TLB and with each TLB geometry (entries, ways)
+ * under each policy; a geometry whose entries are not a multiple of its ways is skipped
+ */
+std::vector<SweepConfiguration> sweep_grid(const std::vector<int>& frame_counts,
+                                           const std::vector<std::pair<int, int>>& tlb_geometries,
+                                           const std::vector<ReplacementPolicy>& policies);
+
+/* Runs trace on a fresh VirtualMemorySystem per configuration, spread over pool; the trace is shared, read-only.
+ * Returns the results in the order of configurations. Nothing is reported to a sink.
+ */
+std::vector<SweepResult> run_sweep(const VirtualMemoryTrace& trace, const std::vector<SweepConfiguration>& configurations,
+                                   TaskPool& pool = TaskPool::shared());
+
+/* Prints one row per result, under a header */
+void print_sweep_table(std::ostream& os, const std::vector<SweepResult>& results);
+
+#endif //PROJECT3_VM_SWEEP_HPP
@@ -0,0 +1,55 @@
+// Runs a trace on a grid of memory sizes, TLB geometries and replacement policies, one system per configuration,
+// in parallel, and prints one row per configuration:
+//   vm_sweep [-j threads] <init file> <action file>
+//   vm_sweep [-j threads] <binary trace>
+// threads defaults to one per hardware thread.
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "vm_sweep.hpp"
+#include "tools/ms_timer.hpp"
+
+
+int main(int argc, char** argv)
+{
+    int threads = 0;
+    int first = 1;
+    if (argc > 2 && std::string{argv[1]} == "-j")
+    {
+        threads = std::atoi(argv[2]);
+        first = 3;
+    }
+    if (argc - first != 1 && argc - first != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " [-j threads] (<init file> <action file> | <binary trace>)" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        VirtualMemoryTrace trace = argc - first == 2 ? VirtualMemoryTrace::from_text(argv[first], argv[first + 1])
+                                                     : VirtualMemoryTrace::from_binary(argv[first]);
+
+        std::vector<SweepConfiguration> configurations = sweep_grid(
+            {1024, 4096},
+            {{4, 4}, {16, 4}, {16, 16}, {64, 4}, {64, 64}, {256, 8}},
+            {ReplacementPolicy::LRU, ReplacementPolicy::CLOCK, ReplacementPolicy::RANDOM});
+
+        TaskPool pool{threads};
+        ms_timer timer{true};
+        std::vector<SweepResult> results = run_sweep(trace, configurations, pool);
+        timer.stop();
+
+        print_sweep_table(std::cout, results);
+        std::cout << configurations.size() << " configurations of " << trace.accesses() << " accesses on "
+                  << pool.threads() << " threads in " << timer.read() << " ms" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
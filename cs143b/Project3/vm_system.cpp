@@ -1,23 +1,70 @@
+#include <climits>
 #include <sstream>
+#include "tools/span_timer.hpp"
 #include "vm_system.hpp"
 #include "memory_exception.hpp"
 
 
-const int VirtualMemorySystem::FRAME_SIZE = 512;
+const int VirtualMemorySystem::FRAME_SIZE = 1 << DefaultAddressLayout::offset_bits();
 const int VirtualMemorySystem::N_FRAMES = 1024;
 const int VirtualMemorySystem::PM_SIZE = FRAME_SIZE * N_FRAMES;
-const int VirtualMemorySystem::ST_SIZE = FRAME_SIZE;
-const int VirtualMemorySystem::PT_SIZE = FRAME_SIZE * 2;
+const int VirtualMemorySystem::ST_SIZE = 1 << DefaultAddressLayout::segment_bits();
+const int VirtualMemorySystem::PT_SIZE = 1 << DefaultAddressLayout::page_bits();
 const int VirtualMemorySystem::PAGE_SIZE = FRAME_SIZE;
-const int VirtualMemorySystem::BM_SIZE = 32;
+const int VirtualMemorySystem::BM_SIZE = N_FRAMES / WIDTH;
 const int VirtualMemorySystem::READ_OP = 0;
 const int VirtualMemorySystem::WRITE_OP = 1;
+const int VirtualMemorySystem::PREFETCH_DISTANCE = 8;
+const int VirtualMemorySystem::TLB_LATENCY = 1;
+const int VirtualMemorySystem::MEMORY_LATENCY = 100;
+
+long long AccessTiming::total_cycles() const
+{
+    long long result = page_walk_cache_cycles + walk_cycles + data_cycles;
+    for (long long cycles : tlb_cycles)
+    {
+        result += cycles;
+    }
+    return result;
+}
+
+double AccessTiming::average_memory_access_time() const
+{
+    return accesses == 0 ? 0 : static_cast<double>(total_cycles()) / accesses;
+}
+
+namespace
+{
+    int checked_frames(int frames)
+    {
+        const int table_frames = (VirtualMemorySystem::ST_SIZE + VirtualMemorySystem::PT_SIZE) / VirtualMemorySystem::FRAME_SIZE;
+        if (frames % WIDTH != 0 || frames < table_frames || frames > INT_MAX / VirtualMemorySystem::FRAME_SIZE)
+        {
+            std::ostringstream buf;
+            buf << "VirtualMemorySystem - cannot make a physical memory of " << frames << " frames";
+            throw MemoryException{buf.str()};
+        }
+        return frames;
+    }
+}
+
+VirtualMemorySystem::VirtualMemorySystem(int frames)
+    : frame_count{checked_frames(frames)}, physical_memory{frame_count, FRAME_SIZE}, bit_map{frame_count / WIDTH},
+      page_walk_cache{nullptr}, page_walk_cache_latency{0},
+      memory_latency{MEMORY_LATENCY}, timing{0, {}, 0, 0, 0}, result_sink{std::make_shared<TextResultSink>(std::cout)}
+{
+    set_tlb(TranslationLookAsideBuffer{});
+    bit_map.set(0, true);       // ST resides in first frame
+}
 
 VirtualMemorySystem::VirtualMemorySystem()
-    : physical_memory{new int[PM_SIZE]}, bit_map{BM_SIZE}
+    : VirtualMemorySystem{N_FRAMES}
 {
-    init_physical_memory(0);
-    bit_map.set(0, 0, true);    // ST resides in first frame
+}
+
+int VirtualMemorySystem::frames() const
+{
+    return frame_count;
 }
 
 int VirtualMemorySystem::get_page_table(int segment, int page) const
@@ -29,14 +76,18 @@ int VirtualMemorySystem::get_page_table(int segment, int page) const
 void VirtualMemorySystem::create_page_table(int segment, int address)
 {
     // PM[s] -> start of PT
-    physical_memory[segment] = address;
+    physical_memory.store(segment, address);
+    if (page_walk_cache)
+    {
+        page_walk_cache->clear();
+    }
 
     // PT occupies 2 frames
     if (address != -1)
     {
-        std::pair<int, int> frame = get_frame_number(address);
-        bit_map.set(frame.first, frame.second, true);
-        bit_map.set(frame.first, frame.second + 1, true);
+        int frame = get_frame_number(address);
+        bit_map.set(frame, true);
+        bit_map.set(frame + 1, true);
     }
 }
 
@@ -44,74 +95,146 @@ void VirtualMemorySystem::create_page(int page, int segment, int address)
 {
     int page_table_address = physical_memory[segment];  // get index of PT start
     int page_start = page_table_address + page;         // PM[s] + p
-    physical_memory[page_start] = address;              // PM[PM[s] + p]
+    physical_memory.store(page_start, address);         // PM[PM[s] + p]
 
-    std::pair<int, int> frame = get_frame_number(address);
-    bit_map.set(frame.first, frame.second, true);
+    bit_map.set(get_frame_number(address), true);
 }
 
 void VirtualMemorySystem::read(int32_t address, bool use_tlb)
 {
-    VirtualAddress va{address};
-    if (use_tlb)
+    result_sink->record(access(VirtualAddress{address}, READ_OP, use_tlb), use_tlb);
+}
+
+void VirtualMemorySystem::write(int32_t address, bool use_tlb)
+{
+    result_sink->record(access(VirtualAddress{address}, WRITE_OP, use_tlb), use_tlb);
+}
+
+void VirtualMemorySystem::set_result_sink(std::shared_ptr<ResultSink> sink)
+{
+    result_sink = std::move(sink);
+}
+
+void VirtualMemorySystem::flush_results()
+{
+    result_sink->flush();
+}
+
+void VirtualMemorySystem::set_tlb(const TranslationLookAsideBuffer& buffer)
+{
+    tlb_chain.clear();
+    timing.tlb_cycles.clear();
+    add_tlb_level(buffer, TLB_LATENCY);
+}
+
+void VirtualMemorySystem::add_tlb_level(const TranslationLookAsideBuffer& buffer, int latency)
+{
+    tlb_chain.push_back(TranslationLevel{buffer, latency});
+    timing.tlb_cycles.push_back(0);
+}
+
+int VirtualMemorySystem::tlb_levels() const
+{
+    return static_cast<int>(tlb_chain.size());
+}
+
+const TranslationLookAsideBuffer& VirtualMemorySystem::get_tlb(int level) const
+{
+    if (level < 0 || level >= tlb_levels())
+    {
+        std::ostringstream buf;
+        buf << "VirtualMemorySystem::get_tlb - no TLB level " << level;
+        throw MemoryException{buf.str()};
+    }
+    return tlb_chain[level].buffer;
+}
+
+void VirtualMemorySystem::set_page_walk_cache(const TranslationLookAsideBuffer& buffer, int latency)
+{
+    page_walk_cache.reset(new TranslationLookAsideBuffer{buffer});
+    page_walk_cache_latency = latency;
+}
+
+const TranslationLookAsideBuffer* VirtualMemorySystem::get_page_walk_cache() const
+{
+    return page_walk_cache.get();
+}
+
+void VirtualMemorySystem::set_memory_latency(int latency)
+{
+    memory_latency = latency;
+}
+
+const AccessTiming& VirtualMemorySystem::get_timing() const
+{
+    return timing;
+}
+
+void VirtualMemorySystem::reset_statistics()
+{
+    timing.accesses = timing.page_walk_cache_cycles = timing.walk_cycles = timing.data_cycles = 0;
+    for (std::size_t level = 0; level < tlb_chain.size(); ++level)
     {
-        tlb_operation(va, READ_OP);
+        timing.tlb_cycles[level] = 0;
+        tlb_chain[level].buffer.reset_statistics();
     }
-    else
+    if (page_walk_cache)
     {
-        read_no_tlb(va);
+        page_walk_cache->reset_statistics();
     }
 }
 
-void VirtualMemorySystem::write(int32_t address, bool use_tlb)
+void VirtualMemorySystem::translate(const MemoryAccess* accesses, std::size_t count, AccessResult* results, bool use_tlb)
 {
-    VirtualAddress va{address};
-    if (use_tlb)
+    for (std::size_t i = 0; i < count; ++i)
     {
-        tlb_operation(va, WRITE_OP);
+        if (i + PREFETCH_DISTANCE < count)
+        {
+            prefetch_translation(VirtualAddress{accesses[i + PREFETCH_DISTANCE].address});
+        }
+        results[i] = access(VirtualAddress{accesses[i].address}, accesses[i].operation, use_tlb);
     }
-    else
+}
+
+AccessResult VirtualMemorySystem::access(const VirtualAddress& va, int operation, bool use_tlb)
+{
+    AccessResult result = use_tlb ? tlb_operation(va, operation) : operation == READ_OP ? read_no_tlb(va) : write_no_tlb(va);
+    ++timing.accesses;
+    if (result.status == AccessStatus::ok)
     {
-        write_no_tlb(va);
+        timing.data_cycles += memory_latency;
     }
+    return result;
 }
 
-bool VirtualMemorySystem::read_no_tlb(const VirtualAddress& va) const
+AccessResult VirtualMemorySystem::read_no_tlb(const VirtualAddress& va)
 {
     int s = va.segment_number();
     int p = va.page_number();
-    int segment_table = physical_memory[s];
-    int page_table = get_page_table(s, p);  // PM[PM[s] + p]
-    bool valid_address = false;
+    int segment_table = walk_segment_table(s);
+    int page_table = segment_table == -1 ? -1 : walk_page_table(segment_table, p);  // PM[PM[s] + p]
 
     if (segment_table == -1 || page_table == -1)
     {
-        std::cout << "pf";
+        return AccessResult{0, AccessStatus::page_fault, false};
     }
     else if (segment_table == 0 || page_table == 0)
     {
-        std::cout << "err";
-    }
-    else
-    {
-        valid_address = true;
-        std::cout << page_table + va.offset();
+        return AccessResult{0, AccessStatus::error, false};
     }
-    std::cout << " ";
-    return valid_address;
+    return AccessResult{page_table + va.offset(), AccessStatus::ok, false};
 }
 
-bool VirtualMemorySystem::write_no_tlb(const VirtualAddress& va)
+AccessResult VirtualMemorySystem::write_no_tlb(const VirtualAddress& va)
 {
     int s = va.segment_number();
     int p = va.page_number();
-    int segment_table_entry = physical_memory[s];
-    int page_table_entry = get_page_table(s, p);
-    bool valid_address = false;
+    int segment_table_entry = walk_segment_table(s);
+    int page_table_entry = segment_table_entry == -1 ? -1 : walk_page_table(segment_table_entry, p);
 
     if (segment_table_entry == -1 || page_table_entry == -1)
     {
-        std::cout << "pf";
+        return AccessResult{0, AccessStatus::page_fault, false};
     }
     else if (segment_table_entry == 0)
     {
@@ -125,65 +248,89 @@ bool VirtualMemorySystem::write_no_tlb(const VirtualAddress& va)
         allocate_new_page(s, p);
         return write_no_tlb(va);
     }
-    else
-    {
-        valid_address = true;
-        std::cout << page_table_entry + va.offset();
-    }
-    std::cout << " ";
-    return valid_address;
+    return AccessResult{page_table_entry + va.offset(), AccessStatus::ok, false};
 }
 
-void VirtualMemorySystem::tlb_operation(const VirtualAddress& va, int operation)
+AccessResult VirtualMemorySystem::tlb_operation(const VirtualAddress& va, int operation)
 {
+    TIMED_SPAN("VirtualMemorySystem::tlb_operation");
     int sp = va.segment_and_page_number();
-    int hit_index = tlb.hit_index(sp);
+    int f = 0;
 
-    if (hit_index == -1)
+    for (std::size_t level = 0; level < tlb_chain.size(); ++level)
     {
-        // miss
-        std::cout << "m ";
-        bool valid_address = operation == READ_OP ? read_no_tlb(va) : write_no_tlb(va);
-        if (valid_address)
+        timing.tlb_cycles[level] += tlb_chain[level].latency;
+        if (tlb_chain[level].buffer.lookup(sp, f))
         {
-            int s = va.segment_number();
-            int p = va.page_number();
-            int frame = physical_memory[physical_memory[s] + p];
-            tlb.do_miss(sp, frame);
+            for (std::size_t upper = 0; upper < level; ++upper)
+            {
+                tlb_chain[upper].buffer.insert(sp, f);
+            }
+            return AccessResult{f + va.offset(), AccessStatus::ok, true};
         }
     }
-    else
+
+    AccessResult result = operation == READ_OP ? read_no_tlb(va) : write_no_tlb(va);
+    if (result.status == AccessStatus::ok)
     {
-        // hit
-        std::cout << "h ";
-        int f = tlb.do_hit(sp, hit_index);
-        std::cout << f + va.offset() << " ";
+        for (TranslationLevel& level : tlb_chain)
+        {
+            level.buffer.insert(sp, result.physical_address - va.offset());
+        }
     }
+    return result;
 }
 
-void VirtualMemorySystem::init_physical_memory(int fill_value)
+int VirtualMemorySystem::walk_segment_table(int segment)
 {
-    for (unsigned int i = 0; i < PM_SIZE; ++i)
+    int entry = 0;
+    if (page_walk_cache)
     {
-        physical_memory[i] = fill_value;
+        timing.page_walk_cache_cycles += page_walk_cache_latency;
+        if (page_walk_cache->lookup(segment, entry))
+        {
+            return entry;
+        }
     }
+
+    timing.walk_cycles += memory_latency;
+    entry = physical_memory[segment];
+    if (page_walk_cache && entry > 0)
+    {
+        // only resident page tables are cached; allocating one changes an entry from 0, which is never cached
+        page_walk_cache->insert(segment, entry);
+    }
+    return entry;
 }
 
-std::pair<int, int> VirtualMemorySystem::get_frame_number(int physical_address) const
+int VirtualMemorySystem::walk_page_table(int segment_table, int page)
 {
-    const int index_capacity = FRAME_SIZE * bit_map.size();
+    timing.walk_cycles += memory_latency;
+    return physical_memory[segment_table + page];
+}
 
-    int frame = physical_address / index_capacity;
-    int bit =  physical_address / FRAME_SIZE % bit_map.width();
+void VirtualMemorySystem::prefetch_translation(const VirtualAddress& va) const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    // the segment table is one frame, and stays cached; the page tables it points to are what miss
+    int segment_table = physical_memory[va.segment_number()];
+    if (segment_table > 0)
+    {
+        __builtin_prefetch(physical_memory.data() + segment_table + va.page_number());
+    }
+#endif
+}
 
-    return std::make_pair(frame, bit);
+int VirtualMemorySystem::get_frame_number(int physical_address) const
+{
+    return physical_address / FRAME_SIZE;
 }
 
 void VirtualMemorySystem::allocate_new_page_table(int segment)
 {
     std::pair<int, int> location = bit_map.find_consecutive_zeros();
-    const int index_capacity = FRAME_SIZE * bit_map.size();
-    int page_table_address = location.first * index_capacity + location.second * FRAME_SIZE;
+    int frame = location.first * bit_map.width() + location.second;
+    int page_table_address = frame * FRAME_SIZE;
 
     if (physical_memory[segment] != 0)
     {
@@ -193,29 +340,37 @@ void VirtualMemorySystem::allocate_new_page_table(int segment)
         throw MemoryException{buf.str()};
     }
 
-    physical_memory[segment] = page_table_address;
+    physical_memory.store(segment, page_table_address);
     if (page_table_address != -1)
     {
-        bit_map.set(location.first, location.second, true);
-        bit_map.set(location.first, location.second + 1, true);
+        bit_map.set(frame, true);
+        bit_map.set(frame + 1, true);
     }
 }
 
 void VirtualMemorySystem::allocate_new_page(int segment, int page)
 {
     std::pair<int, int> location = bit_map.find_first_zero();
-    const int index_capacity = FRAME_SIZE * bit_map.size();
-    int next_free_address = location.first * index_capacity + location.second * FRAME_SIZE;
+    int frame = location.first * bit_map.width() + location.second;
+    int next_free_address = frame * FRAME_SIZE;
 
     int page_table_address = physical_memory[segment];
     int page_start = page_table_address + page;
 
-    physical_memory[page_start] = next_free_address;
-    bit_map.set(location.first, location.second, true);
+    physical_memory.store(page_start, next_free_address);
+    bit_map.set(frame, true);
 }
 
 void VirtualMemorySystem::clear()
 {
-    init_physical_memory(0);
+    physical_memory.clear();
     bit_map.clear();
+    for (TranslationLevel& level : tlb_chain)
+    {
+        level.buffer.clear();
+    }
+    if (page_walk_cache)
+    {
+        page_walk_cache->clear();
+    }
 }
\ No newline at end of file
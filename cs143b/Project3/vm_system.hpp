@@ -4,18 +4,44 @@
 #include <iostream>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <cstddef>
 #include <cstdint>
 #include "virtual_address.hpp"
 #include "bit_map.hpp"
 #include "tlb.hpp"
+#include "result_sink.hpp"
+#include "physical_memory.hpp"
 
 
+// One memory reference of a trace: operation is VirtualMemorySystem::READ_OP or WRITE_OP
+struct MemoryAccess
+{
+    int operation;
+    int32_t address;
+};
+
+// The cycles spent on memory references so far, by where they were spent
+struct AccessTiming
+{
+    long long accesses;
+    std::vector<long long> tlb_cycles;      // probing each level of the TLB chain
+    long long page_walk_cache_cycles;       // probing the page-walk cache
+    long long walk_cycles;                  // reading segment- and page-table entries from memory
+    long long data_cycles;                  // the references themselves (only those that translate)
+
+    long long total_cycles() const;
+
+    /* Returns total_cycles() / accesses, or 0 before the first access */
+    double average_memory_access_time() const;
+};
+
 class VirtualMemorySystem
 {
 public:
     // -------------------------
-    static const int FRAME_SIZE;
-    static const int N_FRAMES;
+    static const int FRAME_SIZE;            // a page, as wide as an address's offset
+    static const int N_FRAMES;              // the default number of frames
     static const int PM_SIZE;
     static const int ST_SIZE;
     static const int PT_SIZE;
@@ -24,10 +50,21 @@ public:
     static const int BM_INDEX_CAP;
     static const int READ_OP;
     static const int WRITE_OP;
+    static const int PREFETCH_DISTANCE;     // accesses ahead of the current one whose page-table words translate() prefetches
+    static const int TLB_LATENCY;           // default cycles per probe of a TLB level
+    static const int MEMORY_LATENCY;        // default cycles per read of physical memory
     // -------------------------
 
+    /* Makes a physical memory of frames frames (of FRAME_SIZE words each), reserved but not committed,
+     * and reports results as text to std::cout, buffered until flush_results().
+     * Throws a MemoryException unless frames is a multiple of the bitmap's width, holds the segment table and a page table,
+     * and can be addressed with an int.
+     */
+    explicit VirtualMemorySystem(int frames);
     VirtualMemorySystem();
 
+    int frames() const;
+
     int get_page_table(int segment, int page) const;
 
     void create_page_table(int segment, int address);
@@ -36,23 +73,76 @@ public:
     void read(int32_t address, bool use_tlb);
     void write(int32_t address, bool use_tlb);
 
+    /* read and write report their results to sink from now on */
+    void set_result_sink(std::shared_ptr<ResultSink> sink);
+    void flush_results();
+
+    /* Replaces the chain of TLBs with buffer alone, probed in TLB_LATENCY cycles */
+    void set_tlb(const TranslationLookAsideBuffer& buffer);
+
+    /* Appends buffer to the chain of TLBs, probed in latency cycles after every level before it misses.
+     * A hit in one level fills every level before it; a walk fills every level.
+     */
+    void add_tlb_level(const TranslationLookAsideBuffer& buffer, int latency);
+    int tlb_levels() const;
+    const TranslationLookAsideBuffer& get_tlb(int level = 0) const;
+
+    /* Caches resident segment-table entries (keyed by segment), probed in latency cycles before a walk reads PM[s];
+     * there is none until this is called
+     */
+    void set_page_walk_cache(const TranslationLookAsideBuffer& buffer, int latency);
+    const TranslationLookAsideBuffer* get_page_walk_cache() const;
+
+    void set_memory_latency(int latency);
+    const AccessTiming& get_timing() const;
+
+    /* Zeroes the timing, and the statistics of every TLB level and the page-walk cache */
+    void reset_statistics();
+
+    /* Translates accesses[0, count) in order, storing the outcome of accesses[i] into results[i];
+     * has the same effect on memory and the TLB as the equivalent calls to read/write, but reports nothing to the sink.
+     */
+    void translate(const MemoryAccess* accesses, std::size_t count, AccessResult* results, bool use_tlb);
+
+    /* Empties memory (zeroing only the frames written to), every TLB level and the page-walk cache */
     void clear();
 
 
 private:
     // --- Private Members ---
-    std::unique_ptr<int[]> physical_memory;
+    int frame_count;
+    PhysicalMemory physical_memory;
     BitMap bit_map;
-    TranslationLookAsideBuffer tlb;
+    struct TranslationLevel
+    {
+        TranslationLookAsideBuffer buffer;
+        int latency;
+    };
+
+    std::vector<TranslationLevel> tlb_chain;
+    std::unique_ptr<TranslationLookAsideBuffer> page_walk_cache;
+    int page_walk_cache_latency;
+    int memory_latency;
+    AccessTiming timing;
+    std::shared_ptr<ResultSink> result_sink;
     // -----------------------
 
     // --- Private Helper Functions ---
-    void init_physical_memory(int fill_value);
-    std::pair<int, int> get_frame_number(int physical_address) const;
+    int get_frame_number(int physical_address) const;
+
+    AccessResult read_no_tlb(const VirtualAddress& va);
+    AccessResult write_no_tlb(const VirtualAddress& va);
+    AccessResult tlb_operation(const VirtualAddress& va, int operation);
+    AccessResult access(const VirtualAddress& va, int operation, bool use_tlb);
+
+    /* Returns PM[segment], from the page-walk cache if it holds it; charges the cycles either way */
+    int walk_segment_table(int segment);
+
+    /* Returns PM[segment_table + page]; charges the memory read */
+    int walk_page_table(int segment_table, int page);
 
-    bool read_no_tlb(const VirtualAddress& va) const;
-    bool write_no_tlb(const VirtualAddress& va);
-    void tlb_operation(const VirtualAddress& va, int operation);
+    /* Hints the processor to load the page-table word va translates through */
+    void prefetch_translation(const VirtualAddress& va) const;
 
     void allocate_new_page_table(int segment);
     void allocate_new_page(int segment, int page);
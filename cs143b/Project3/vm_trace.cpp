@@ -0,0 +1,153 @@
+#include <sstream>
+#include "vm_trace.hpp"
+#include "memory_exception.hpp"
+
+
+namespace
+{
+    // the ints in one record of each array
+    const std::size_t GROUP_SIZES[3] = {2, 3, 2};
+
+    /* Appends the ints of the line starting at first to values, less an incomplete group at its end;
+     * returns the start of the next line
+     */
+    const char* parse_line(const char* first, const char* last, std::size_t group_size, std::vector<int32_t>& values)
+    {
+        std::size_t start = values.size();
+        parse_ints(first, last, values);
+        values.resize(start + (values.size() - start) / group_size * group_size);
+        return next_line(first, last);
+    }
+}
+
+
+const uint32_t VirtualMemoryTrace::PAGE_TABLES = 1;
+const uint32_t VirtualMemoryTrace::PAGES = 2;
+const uint32_t VirtualMemoryTrace::ACCESSES = 3;
+const std::size_t VirtualMemoryTrace::TRANSLATE_CHUNK = 4096;
+
+VirtualMemoryTrace::VirtualMemoryTrace()
+    : views{{PAGE_TABLES, nullptr, 0}, {PAGES, nullptr, 0}, {ACCESSES, nullptr, 0}}
+{
+}
+
+VirtualMemoryTrace VirtualMemoryTrace::from_text(const std::string& init_path, const std::string& actions_path)
+{
+    MappedFile init{init_path};
+    MappedFile actions{actions_path};
+
+    auto values = std::make_shared<std::vector<int32_t>>();
+    std::size_t ends[3];
+    const char* line = parse_line(init.begin(), init.end(), GROUP_SIZES[0], *values);
+    ends[0] = values->size();
+    parse_line(line, init.end(), GROUP_SIZES[1], *values);
+    ends[1] = values->size();
+    parse_line(actions.begin(), actions.end(), GROUP_SIZES[2], *values);
+    ends[2] = values->size();
+
+    VirtualMemoryTrace trace;
+    for (int i = 0; i < 3; ++i)
+    {
+        std::size_t start = i == 0 ? 0 : ends[i - 1];
+        trace.views[i].data = values->data() + start;
+        trace.views[i].size = ends[i] - start;
+    }
+    trace.parsed = values;
+    return trace;
+}
+
+VirtualMemoryTrace VirtualMemoryTrace::from_binary(const std::string& path)
+{
+    auto reader = std::make_shared<const TraceReader>(path);
+
+    VirtualMemoryTrace trace;
+    for (int i = 0; i < 3; ++i)
+    {
+        const TraceSection* section = reader->find(trace.views[i].kind);
+        if (section == nullptr || section->size % GROUP_SIZES[i] != 0)
+        {
+            std::ostringstream buf;
+            buf << "VirtualMemoryTrace::from_binary - " << path << " has no well-formed section of kind " << trace.views[i].kind;
+            throw MemoryException{buf.str()};
+        }
+        trace.views[i] = *section;
+    }
+    trace.mapped = reader;
+    return trace;
+}
+
+void VirtualMemoryTrace::write_binary(const std::string& path) const
+{
+    TraceWriter writer;
+    for (const TraceSection& view : views)
+    {
+        writer.add_section(view.kind, view.data, view.size);
+    }
+    writer.write(path);
+}
+
+std::size_t VirtualMemoryTrace::page_tables() const
+{
+    return views[0].size / GROUP_SIZES[0];
+}
+
+std::size_t VirtualMemoryTrace::pages() const
+{
+    return views[1].size / GROUP_SIZES[1];
+}
+
+std::size_t VirtualMemoryTrace::accesses() const
+{
+    return views[2].size / GROUP_SIZES[2];
+}
+
+void VirtualMemoryTrace::initialize(VirtualMemorySystem& system) const
+{
+    for (const int32_t* entry = views[0].begin(); entry != views[0].end(); entry += GROUP_SIZES[0])
+    {
+        system.create_page_table(entry[0], entry[1]);
+    }
+    for (const int32_t* entry = views[1].begin(); entry != views[1].end(); entry += GROUP_SIZES[1])
+    {
+        system.create_page(entry[0], entry[1], entry[2]);
+    }
+}
+
+void VirtualMemoryTrace::run(VirtualMemorySystem& system, bool use_tlb) const
+{
+    for (const int32_t* entry = views[2].begin(); entry != views[2].end(); entry += GROUP_SIZES[2])
+    {
+        if (entry[0] == VirtualMemorySystem::READ_OP)
+        {
+            system.read(entry[1], use_tlb);
+        }
+        else if (entry[0] == VirtualMemorySystem::WRITE_OP)
+        {
+            system.write(entry[1], use_tlb);
+        }
+    }
+}
+
+void VirtualMemoryTrace::translate(VirtualMemorySystem& system, bool use_tlb,
+                                   const std::function<void(const AccessResult*, std::size_t)>& on_results) const
+{
+    std::vector<MemoryAccess> chunk;
+    std::vector<AccessResult> results(TRANSLATE_CHUNK);
+    chunk.reserve(TRANSLATE_CHUNK);
+
+    const int32_t* entry = views[2].begin();
+    while (entry != views[2].end())
+    {
+        chunk.clear();
+        for (; entry != views[2].end() && chunk.size() < TRANSLATE_CHUNK; entry += GROUP_SIZES[2])
+        {
+            if (entry[0] == VirtualMemorySystem::READ_OP || entry[0] == VirtualMemorySystem::WRITE_OP)
+            {
+                chunk.push_back(MemoryAccess{entry[0], entry[1]});
+            }
+        }
+
+        system.translate(chunk.data(), chunk.size(), results.data(), use_tlb);
+        on_results(results.data(), chunk.size());
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef PROJECT3_VM_TRACE_HPP
+#define PROJECT3_VM_TRACE_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "tools/trace_file.hpp"
+#include "vm_system.hpp"
+
+
+// The inputs of one run, each kept as a flat array of ints:
+//   page tables - (segment, address) pairs, pages - (page, segment, address) triples   (the init file)
+//   accesses    - (operation, address) pairs                                           (the action file)
+//
+// A trace is parsed once from the text files (one line per array), or mapped from a binary trace (see
+// tools/trace_file.hpp), whose sections are then used in place; write_binary() converts the former into the latter.
+// Either way it can be run any number of times.
+class VirtualMemoryTrace
+{
+public:
+    // The kinds of a binary trace's sections
+    static const uint32_t PAGE_TABLES;
+    static const uint32_t PAGES;
+    static const uint32_t ACCESSES;
+
+    static const std::size_t TRANSLATE_CHUNK;     // the accesses translate() hands to the system at a time
+
+    /* An incomplete group at the end of a line is ignored; throws a TraceError if a file cannot be opened */
+    static VirtualMemoryTrace from_text(const std::string& init_path, const std::string& actions_path);
+
+    /* Throws a TraceError if the file is not a trace, or a MemoryException if a section is missing or malformed */
+    static VirtualMemoryTrace from_binary(const std::string& path);
+
+    void write_binary(const std::string& path) const;
+
+    std::size_t page_tables() const;
+    std::size_t pages() const;
+    std::size_t accesses() const;
+
+    /* Creates the page tables, then the pages, in system */
+    void initialize(VirtualMemorySystem& system) const;
+
+    /* Reads or writes every access, in order; an access that is neither is skipped */
+    void run(VirtualMemorySystem& system, bool use_tlb) const;
+
+    /* Like run(), but through system.translate(), so nothing is reported to system's sink:
+     * calls on_results(results, count) with the outcomes of every chunk of (at most TRANSLATE_CHUNK) reads and writes
+     */
+    void translate(VirtualMemorySystem& system, bool use_tlb,
+                   const std::function<void(const AccessResult*, std::size_t)>& on_results) const;
+
+
+private:
+    // the views point into one of these, which copies of the trace share
+    std::shared_ptr<const TraceReader> mapped;              // a binary trace
+    std::shared_ptr<const std::vector<int32_t>> parsed;     // a text trace: the three arrays, one after the other
+    TraceSection views[3];
+
+    VirtualMemoryTrace();
+};
+
+#endif //PROJECT3_VM_TRACE_HPP
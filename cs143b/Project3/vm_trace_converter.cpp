@@ -0,0 +1,30 @@
+// Converts a text trace (an init file and an action file) into a binary trace, which loads without parsing:
+//   vm_trace_converter <init file> <action file> <binary trace>
+#include <exception>
+#include <iostream>
+#include "vm_trace.hpp"
+
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::cerr << "usage: " << argv[0] << " <init file> <action file> <binary trace>" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        VirtualMemoryTrace trace = VirtualMemoryTrace::from_text(argv[1], argv[2]);
+        trace.write_binary(argv[3]);
+        std::cout << trace.page_tables() << " page tables, " << trace.pages() << " pages, "
+                  << trace.accesses() << " accesses" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
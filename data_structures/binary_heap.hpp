@@ -11,6 +11,15 @@
  *   as modifying the heap requires the invariant to be restored.
  * Checking if an element is contained, or erasing an arbitrary item incur O(n) time.
  *
+ * The heap's Arity (2 by default) is the number of children per node; a 4- or 8-ary heap is shallower,
+ * and the children compared at each level of a sift-down sit next to each other in memory.
+ * Sifts move a "hole" up or down the tree, and write the sifted element once at its final position.
+ *
+ * push() additionally returns a Handle, which names its element until the element is extracted or erased.
+ * The first call to push() starts a position index (handle -> index into the heap, and back),
+ * through which update(), decrease_key() and erase() reach an element in O(log n) time.
+ * Heaps that never call push() do not maintain the index.
+ *
  * Iterators produce items in no particular order;
  * the only way to produce items in order is to extract (retrieve and erase) every element.
  * Additionally, only const_iterators are supported, as modifying items would require the invariant be restored.
@@ -28,6 +37,7 @@
 #define DATA_STRUCTURES_BINARY_HEAP_HPP
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <stdexcept>
@@ -38,20 +48,28 @@
 #include <cmath>
 
 
-template <typename T, typename Comparator = std::greater<T>>
+template <typename T, typename Comparator = std::greater<T>, int Arity = 2>
 class BinaryHeap
 {
+    static_assert(Arity >= 2, "BinaryHeap - Arity must be at least 2");
+
 public:
+    typedef int Handle;
+
     BinaryHeap();
 
+    /* Orders elements with comparator, e.g. a lambda that looks each element's key up elsewhere.
+     */
+    explicit BinaryHeap(const Comparator& comparator);
+
     /* Converts elements produced from InputIterator into an ordered heap.
      * O(n) optimized (inserts all items linearly, then heapifies itself).
      */
     template <typename InputIterator>
     BinaryHeap(InputIterator first, InputIterator last);
 
-    template <typename E, typename C>
-    friend std::ostream& operator<<(std::ostream& os, const BinaryHeap<E, C>& h);
+    template <typename E, typename C, int A>
+    friend std::ostream& operator<<(std::ostream& os, const BinaryHeap<E, C, A>& h);
 
     /* Returns the number of elements in the heap.
      * Θ(1) time.
@@ -82,6 +100,61 @@ public:
      * O(log n) time.
      */
     void insert(const T& element);
+    void insert(T&& element);
+
+    /* Constructs T{args...} in place at the bottom of the heap, then restores the invariant.
+     * O(log n) time.
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /* Inserts every element produced from InputIterator.
+     * Sifts each one up if there are few of them, or re-heapifies the whole heap in O(n) if there are many.
+     */
+    template <typename InputIterator>
+    void push_range(InputIterator first, InputIterator last);
+
+    /* Allocates room for n elements, so that the next n - size() insertions do not reallocate.
+     */
+    void reserve(int n);
+
+
+    // Handles
+    /* Inserts element into the heap, and returns its handle.
+     * O(log n) time.
+     */
+    Handle push(const T& element);
+    Handle push(T&& element);
+
+    /* Returns true if handle names an element still in the heap.
+     * Θ(1) time.
+     */
+    bool valid(Handle handle) const;
+
+    /* Returns a const-reference to the element named by handle.
+     * Throws std::invalid_argument if handle is not valid.
+     * Θ(1) time.
+     */
+    const T& value(Handle handle) const;
+
+    /* Replaces the element named by handle with element, which may move it either way.
+     * Throws std::invalid_argument if handle is not valid.
+     * O(log n) time.
+     */
+    void update(Handle handle, const T& element);
+
+    /* Replaces the element named by handle with element, which must not order after it under Comparator
+     * (e.g., must not be smaller, in a max heap); the element can then only move towards the top.
+     * Throws std::invalid_argument if handle is not valid, or if element would have to move down.
+     * O(log n) time.
+     */
+    void decrease_key(Handle handle, const T& element);
+
+    /* Erases the element named by handle.
+     * Throws std::invalid_argument if handle is not valid.
+     * O(log n) time.
+     */
+    void erase(Handle handle);
 
 
 protected:
@@ -94,29 +167,54 @@ protected:
      */
     bool in_heap(int i) const;
 
-    static int left_child(int i);
-    static int right_child(int i);
+    /* The children of index i are [first_child(i), first_child(i) + Arity)
+     */
+    static int first_child(int i);
     static int parent_of(int i);
 
 private:
     std::vector<T> heap;
     Comparator comp;
 
+    // The position index; empty until the first push().
+    // handles[i] is the handle of heap[i], and positions[handle] is its index in heap (or -1 once it is gone).
+    bool indexed;
+    std::vector<Handle> handles;
+    std::vector<int> positions;
+    std::vector<Handle> free_handles;
+
     /* Restores heap invariant to the underlying std::vector.
      * O(n) optimized.
      */
     void heapify();
 
-    /* Recursively swaps the element at index i with its parent until the immediate heap invariant is restored.
+    /* Moves the element at index i up past every parent it should precede, until the heap invariant is restored.
+     * Returns true if the element moved.
      * O(log n) time.
      */
-    void sift_up(int i);
+    bool sift_up(int i);
 
-    /* Recursively swaps the element at index i with its larger child until the immediate heap invariant is restored.
+    /* Moves the element at index i down past its topmost child, until the heap invariant is restored.
      * O(log n) time.
      */
     void sift_down(int i);
 
+    /* Stores element (with handle, if the heap is indexed) at index i of the heap
+     */
+    void place(int i, T&& element, Handle handle);
+
+    /* Starts the position index, giving handles to every element already in the heap
+     */
+    void start_index();
+
+    /* Gives a handle to the element just appended to the heap, and returns it
+     */
+    Handle new_handle();
+
+    /* Returns the index of the element named by handle, or throws std::invalid_argument
+     */
+    int position_of(Handle handle, const std::string& function_name) const;
+
     /* Throws std::runtime_error if the heap is empty.
      */
     void check_empty(const std::string& function_name) const;
@@ -127,7 +225,7 @@ private:
     class iterator_type : public std::iterator<std::bidirectional_iterator_tag, UnqualifiedT, std::ptrdiff_t, T*, T&>
     {
     public:
-        iterator_type(const BinaryHeap<T, Comparator>* over, unsigned int index);
+        iterator_type(const BinaryHeap<T, Comparator, Arity>* over, unsigned int index);
 
         /* Complexity:
 		 *   All iterator operations incur O(1) time.
@@ -142,7 +240,7 @@ private:
         T* operator->();
 
     private:
-        const BinaryHeap<T, Comparator>* ref;	// raw pointer (instead of smart pointer) because no dynamic allocation or modifying operations are used
+        const BinaryHeap<T, Comparator, Arity>* ref;	// raw pointer (instead of smart pointer) because no dynamic allocation or modifying operations are used
         unsigned int traversed;
 
         /* If the iterator is already past the end, throws std::runtime_error{message}.
@@ -165,14 +263,22 @@ public:
 };
 
 
-template <typename T, typename Comparator>
-BinaryHeap<T, Comparator>::BinaryHeap()
+template <typename T, typename Comparator, int Arity>
+BinaryHeap<T, Comparator, Arity>::BinaryHeap()
+    : indexed{false}
+{
+}
+
+template <typename T, typename Comparator, int Arity>
+BinaryHeap<T, Comparator, Arity>::BinaryHeap(const Comparator& comparator)
+    : comp{comparator}, indexed{false}
 {
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename InputIterator>
-BinaryHeap<T, Comparator>::BinaryHeap(InputIterator first, InputIterator last)
+BinaryHeap<T, Comparator, Arity>::BinaryHeap(InputIterator first, InputIterator last)
+    : indexed{false}
 {
     while (first != last)
     {
@@ -181,11 +287,11 @@ BinaryHeap<T, Comparator>::BinaryHeap(InputIterator first, InputIterator last)
     heapify();
 }
 
-template <typename T, typename Comparator>
-std::ostream& operator<<(std::ostream& os, const BinaryHeap<T, Comparator>& bh)
+template <typename T, typename Comparator, int Arity>
+std::ostream& operator<<(std::ostream& os, const BinaryHeap<T, Comparator, Arity>& bh)
 {
     os << "BinaryHeap(";
-    BinaryHeap<T, Comparator> copy{bh};
+    BinaryHeap<T, Comparator, Arity> copy{bh};
     if (!copy.empty())
     {
         os << copy.extract();
@@ -198,134 +304,334 @@ std::ostream& operator<<(std::ostream& os, const BinaryHeap<T, Comparator>& bh)
     return os;
 }
 
-template <typename T, typename Comparator>
-int BinaryHeap<T, Comparator>::size() const
+template <typename T, typename Comparator, int Arity>
+int BinaryHeap<T, Comparator, Arity>::size() const
 {
     return heap.size();
 }
 
-template <typename T, typename Comparator>
-bool BinaryHeap<T, Comparator>::empty() const
+template <typename T, typename Comparator, int Arity>
+bool BinaryHeap<T, Comparator, Arity>::empty() const
 {
     return size() == 0;
 }
 
-template <typename T, typename Comparator>
-bool BinaryHeap<T, Comparator>::contains(const T& element) const
+template <typename T, typename Comparator, int Arity>
+bool BinaryHeap<T, Comparator, Arity>::contains(const T& element) const
 {
     return std::find(heap.begin(), heap.end(), element) != heap.end();
 }
 
-template <typename T, typename Comparator>
-const T& BinaryHeap<T, Comparator>::top() const
+template <typename T, typename Comparator, int Arity>
+const T& BinaryHeap<T, Comparator, Arity>::top() const
 {
     check_empty("empty");
     return heap.front();
 }
 
-template <typename T, typename Comparator>
-void BinaryHeap<T, Comparator>::insert(const T& element)
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::insert(const T& element)
 {
     heap.push_back(element);
+    if (indexed)
+    {
+        new_handle();
+    }
+    sift_up(size() - 1);
+}
+
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::insert(T&& element)
+{
+    heap.push_back(std::move(element));
+    if (indexed)
+    {
+        new_handle();
+    }
+    sift_up(size() - 1);
+}
+
+template <typename T, typename Comparator, int Arity>
+template <typename... Args>
+void BinaryHeap<T, Comparator, Arity>::emplace(Args&&... args)
+{
+    heap.emplace_back(std::forward<Args>(args)...);
+    if (indexed)
+    {
+        new_handle();
+    }
+    sift_up(size() - 1);
+}
+
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::reserve(int n)
+{
+    heap.reserve(n);
+    if (indexed)
+    {
+        handles.reserve(n);
+        positions.reserve(n);
+    }
+}
+
+template <typename T, typename Comparator, int Arity>
+template <typename InputIterator>
+void BinaryHeap<T, Comparator, Arity>::push_range(InputIterator first, InputIterator last)
+{
+    int previous_size = size();
+    while (first != last)
+    {
+        heap.push_back(*(first++));
+        if (indexed)
+        {
+            new_handle();
+        }
+    }
+
+    // k sift-ups cost about k log(n) comparisons, against about 2n for heapifying everything
+    int added = size() - previous_size;
+    if (added * std::log2(size() + 1) > 2 * size())
+    {
+        heapify();
+    }
+    else
+    {
+        for (int i = previous_size; i < size(); ++i)
+        {
+            sift_up(i);
+        }
+    }
+}
+
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::push(const T& element) -> Handle
+{
+    T copy{element};
+    return push(std::move(copy));
+}
+
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::push(T&& element) -> Handle
+{
+    if (!indexed)
+    {
+        start_index();
+    }
+    heap.push_back(std::move(element));
+    Handle handle = new_handle();
     sift_up(size() - 1);
+    return handle;
+}
+
+template <typename T, typename Comparator, int Arity>
+bool BinaryHeap<T, Comparator, Arity>::valid(Handle handle) const
+{
+    return indexed && handle >= 0 && handle < static_cast<int>(positions.size()) && positions[handle] >= 0;
+}
+
+template <typename T, typename Comparator, int Arity>
+const T& BinaryHeap<T, Comparator, Arity>::value(Handle handle) const
+{
+    return heap[position_of(handle, "value")];
+}
+
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::update(Handle handle, const T& element)
+{
+    int i = position_of(handle, "update");
+    heap[i] = element;
+    if (!sift_up(i))
+    {
+        sift_down(i);
+    }
 }
 
-template <typename T, typename Comparator>
-T BinaryHeap<T, Comparator>::extract()
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::decrease_key(Handle handle, const T& element)
+{
+    int i = position_of(handle, "decrease_key");
+    if (comp(heap[i], element))
+    {
+        throw std::invalid_argument{"BinaryHeap::decrease_key - element would move away from the top"};
+    }
+    heap[i] = element;
+    sift_up(i);
+}
+
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::erase(Handle handle)
+{
+    erase_at(position_of(handle, "erase"));
+}
+
+template <typename T, typename Comparator, int Arity>
+T BinaryHeap<T, Comparator, Arity>::extract()
 {
     check_empty("extract");
-    T result = top();
+    T result = std::move(heap.front());
     erase_at(0);
     return result;
 }
 
-template <typename T, typename Comparator>
-void BinaryHeap<T, Comparator>::erase_at(int i)
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::erase_at(int i)
 {
     check_empty("erase_at");
     if (!in_heap(i))
     {
         throw std::runtime_error{"BinaryHeap::erase_at - index i out of bounds"};
     }
-    heap[i] = heap.back();
+    if (indexed)
+    {
+        positions[handles[i]] = -1;
+        free_handles.push_back(handles[i]);
+    }
+
+    int last = size() - 1;
+    if (i != last)
+    {
+        place(i, std::move(heap.back()), indexed ? handles[last] : 0);
+    }
     heap.pop_back();
-    sift_up(i);
-    sift_down(i);
+    if (indexed)
+    {
+        handles.pop_back();
+    }
+
+    if (i != last && !sift_up(i))
+    {
+        sift_down(i);
+    }
 }
 
-template <typename T, typename Comparator>
-bool BinaryHeap<T, Comparator>::in_heap(int i) const
+template <typename T, typename Comparator, int Arity>
+bool BinaryHeap<T, Comparator, Arity>::in_heap(int i) const
 {
     return i >= 0 && i < size();
 }
 
-template <typename T, typename Comparator>
-int BinaryHeap<T, Comparator>::left_child(int i)
+template <typename T, typename Comparator, int Arity>
+int BinaryHeap<T, Comparator, Arity>::first_child(int i)
 {
-    return 2 * i + 1;
+    return Arity * i + 1;
 }
 
-template <typename T, typename Comparator>
-int BinaryHeap<T, Comparator>::right_child(int i)
+template <typename T, typename Comparator, int Arity>
+int BinaryHeap<T, Comparator, Arity>::parent_of(int i)
 {
-    return 2 * i + 2;
+    return (i - 1) / Arity;
 }
 
-template <typename T, typename Comparator>
-int BinaryHeap<T, Comparator>::parent_of(int i)
+template <typename T, typename Comparator, int Arity>
+bool BinaryHeap<T, Comparator, Arity>::sift_up(int i)
 {
-    return std::floor((i - 1) / 2);
+    int start = i;
+    T moving = std::move(heap[i]);
+    Handle handle = indexed ? handles[i] : 0;
+    while (i > 0)
+    {
+        int parent = parent_of(i);
+        if (!comp(moving, heap[parent]))
+        {
+            break;
+        }
+        place(i, std::move(heap[parent]), indexed ? handles[parent] : 0);
+        i = parent;
+    }
+    place(i, std::move(moving), handle);
+    return i != start;
 }
 
-template <typename T, typename Comparator>
-void BinaryHeap<T, Comparator>::sift_up(int i)
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::sift_down(int i)
 {
-    int parent = parent_of(i);
-    if (in_heap(i) && in_heap(parent) && comp(heap[i], heap[parent]))
+    T moving = std::move(heap[i]);
+    Handle handle = indexed ? handles[i] : 0;
+    for (int child = first_child(i); child < size(); child = first_child(i))
     {
-        std::swap(heap[parent], heap[i]);
-        sift_up(parent);
+        int top = child;
+        for (int last = std::min(child + Arity, size()); ++child < last;)
+        {
+            if (comp(heap[child], heap[top]))
+            {
+                top = child;
+            }
+        }
+
+        if (!comp(heap[top], moving))
+        {
+            break;
+        }
+        place(i, std::move(heap[top]), indexed ? handles[top] : 0);
+        i = top;
     }
+    place(i, std::move(moving), handle);
 }
 
-template <typename T, typename Comparator>
-void BinaryHeap<T, Comparator>::sift_down(int i)
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::place(int i, T&& element, Handle handle)
 {
-    int left = left_child(i);
-    int right = right_child(i);
-    int larger;
+    heap[i] = std::move(element);
+    if (indexed)
+    {
+        handles[i] = handle;
+        positions[handle] = i;
+    }
+}
 
-    if (in_heap(right) && comp(heap[right], heap[left]))
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::start_index()
+{
+    indexed = true;
+    handles.resize(size());
+    positions.resize(size());
+    for (int i = 0; i < size(); ++i)
     {
-        larger = right;
+        handles[i] = positions[i] = i;
     }
-    else if (in_heap(left))
+}
+
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::new_handle() -> Handle
+{
+    Handle handle;
+    if (free_handles.empty())
     {
-        larger = left;
+        handle = positions.size();
+        positions.push_back(size() - 1);
     }
     else
     {
-        return;
+        handle = free_handles.back();
+        free_handles.pop_back();
+        positions[handle] = size() - 1;
     }
+    handles.push_back(handle);
+    return handle;
+}
 
-    if (comp(heap[larger], heap[i]))
+template <typename T, typename Comparator, int Arity>
+int BinaryHeap<T, Comparator, Arity>::position_of(Handle handle, const std::string& function_name) const
+{
+    if (!valid(handle))
     {
-        std::swap(heap[larger], heap[i]);
-        sift_down(larger);
+        std::string message = "BinaryHeap::" + function_name + " - invalid handle";
+        throw std::invalid_argument{message};
     }
+    return positions[handle];
 }
 
-template <typename T, typename Comparator>
-void BinaryHeap<T, Comparator>::heapify()
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::heapify()
 {
-    for (int i = parent_of(size()); i >= 0; --i)
+    for (int i = parent_of(size() - 1); i >= 0 && size() > 1; --i)
     {
         sift_down(i);
     }
 }
 
-template <typename T, typename Comparator>
-void BinaryHeap<T, Comparator>::check_empty(const std::string& function_name) const
+template <typename T, typename Comparator, int Arity>
+void BinaryHeap<T, Comparator, Arity>::check_empty(const std::string& function_name) const
 {
     if (empty())
     {
@@ -334,85 +640,85 @@ void BinaryHeap<T, Comparator>::check_empty(const std::string& function_name) co
     }
 }
 
-template <typename T, typename Comparator>
-auto BinaryHeap<T, Comparator>::cbegin() const -> const_iterator
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::cbegin() const -> const_iterator
 {
     return const_iterator{this, 0};
 }
 
-template <typename T, typename Comparator>
-auto BinaryHeap<T, Comparator>::cend() const -> const_iterator
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::cend() const -> const_iterator
 {
     unsigned int sz = size();		// silence g++ warning about conflicting types (unsigned int vs. int)
     return const_iterator{this, sz};
 }
 
-template <typename T, typename Comparator>
-auto BinaryHeap<T, Comparator>::begin() const -> iterator
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::begin() const -> iterator
 {
     return cbegin();
 }
 
-template <typename T, typename Comparator>
-auto BinaryHeap<T, Comparator>::end() const -> iterator
+template <typename T, typename Comparator, int Arity>
+auto BinaryHeap<T, Comparator, Arity>::end() const -> iterator
 {
     return cend();
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::iterator_type(const BinaryHeap<T, Comparator> *over, unsigned int index)
+BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::iterator_type(const BinaryHeap<T, Comparator, Arity> *over, unsigned int index)
     : ref{over}, traversed{index}
 {
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-void BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::bound_check(const std::string& message) const
+void BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::bound_check(const std::string& message) const
 {
-    if (traversed < 0 || traversed >= ref->size())
+    if (traversed >= static_cast<unsigned int>(ref->size()))
     {
         throw std::runtime_error{message};
     }
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-bool BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator==(const iterator_type& other) const
+bool BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator==(const iterator_type& other) const
 {
     return ref == other.ref && traversed == other.traversed;
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-bool BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator!=(const iterator_type& other) const
+bool BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator!=(const iterator_type& other) const
 {
     return !operator==(other);
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-auto BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator++() -> iterator_type<UnqualifiedT>&
+auto BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator++() -> iterator_type<UnqualifiedT>&
 {
-    if (traversed < ref->size())
+    if (traversed < static_cast<unsigned int>(ref->size()))
     {
         ++traversed;
     }
     return *this;
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-auto BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator++(int) -> iterator_type<UnqualifiedT>
+auto BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator++(int) -> iterator_type<UnqualifiedT>
 {
     iterator_type<UnqualifiedT> state{*this};
     operator++();
     return state;
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-auto BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator--() -> iterator_type<UnqualifiedT>&
+auto BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator--() -> iterator_type<UnqualifiedT>&
 {
     if (traversed > 0)
     {
@@ -421,26 +727,26 @@ auto BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator--() -> ite
     return *this;
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-auto BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator--(int) -> iterator_type<UnqualifiedT>
+auto BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator--(int) -> iterator_type<UnqualifiedT>
 {
     iterator_type<UnqualifiedT> state{*this};
     operator--();
     return state;
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-UnqualifiedT& BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator*()
+UnqualifiedT& BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator*()
 {
     bound_check("BinaryHeap::iterator_type::operator*");
     return ref->heap[traversed];
 }
 
-template <typename T, typename Comparator>
+template <typename T, typename Comparator, int Arity>
 template <typename UnqualifiedT>
-T* BinaryHeap<T, Comparator>::iterator_type<UnqualifiedT>::operator->()
+T* BinaryHeap<T, Comparator, Arity>::iterator_type<UnqualifiedT>::operator->()
 {
     bound_check("BinaryHeap::iterator_type::operator->");
     return &(ref->heap[traversed]);
@@ -2,6 +2,15 @@
 // Lookup, insertion, and removal operations are done in O(logN) time
 // (or, more accurately, O(height) time).
 //
+// The tree is kept balanced as an AVL tree: every node records the height of its subtree,
+// and insertion and removal rotate the nodes on the way back up wherever the heights of two siblings differ by more than 1.
+// The height therefore stays below 1.44 log2(N) whatever order the items arrive in (sorted input included),
+// and both size() and height() are Θ(1).
+//
+// Every node also records the size of its subtree, which makes the tree an order-statistic tree:
+// select(k) and rank(item) are O(log N), as are lower_bound and upper_bound.
+// Iteration is in order, and range(lo, hi) walks just the items in [lo, hi) in O(log N + k) for k items.
+//
 // Public member functions provide a high-level interface for using this class
 // as the underlying data structure implementation for a data type such as an ordered map or set.
 //
@@ -10,6 +19,9 @@
 // it defaults to T::operator< for internal ordering and comparisons.
 // Regardless, T::operator== must be implemented for internal 'contains' functionality.
 //
+// Nodes (together with their reference counts) are allocated from Allocator with std::allocate_shared;
+// see pool_allocator.hpp for allocators that recycle nodes instead of returning them to the heap.
+//
 // Developed and tested on Apple LLVM version 7.3.0 (clang-703.0.31), C++14
 //
 // Author: Geoffrey Ko (2017)
@@ -27,7 +39,7 @@
 #include <utility>
 
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class BinarySearchTree
 {
 private:
@@ -39,15 +51,25 @@ public:
     //   Comparator is a binary function with parameters a, b
     //   which returns true if a is equivocally less than b in the tree's ordering.
     explicit BinarySearchTree(const LessThanComparator& less_than_comparator);
+    BinarySearchTree(const LessThanComparator& less_than_comparator, const Allocator& the_allocator);
     BinarySearchTree();
 
     template <typename InputIterator>
     BinarySearchTree(InputIterator first, InputIterator last, const LessThanComparator& less_than_comparator);
     template <typename InputIterator>
     BinarySearchTree(InputIterator first, InputIterator last);
+
+    /* Copies every node of right; the copy shares no nodes with right */
+    BinarySearchTree(const BinarySearchTree<T, Allocator>& right);
+
+    /* Takes right's nodes without copying them; right is left empty */
+    BinarySearchTree(BinarySearchTree<T, Allocator>&& right);
     // -------------
 
     // Operators
+    BinarySearchTree<T, Allocator>& operator=(const BinarySearchTree<T, Allocator>& right);
+    BinarySearchTree<T, Allocator>& operator=(BinarySearchTree<T, Allocator>&& right);
+
     // /* Returns true if this is not empty, or false if empty */
     operator bool() const;
     // ---------
@@ -56,7 +78,9 @@ public:
     /* Returns the number of items in this */
     int size() const;
 
-    /* Calculates and returns the height of the tree */
+    /* Returns the height of the tree (-1 if it is empty).
+     * Θ(1).
+     */
     int height() const;
 
     /* Returns true if there are no elements in this */
@@ -65,7 +89,7 @@ public:
     /* Returns true if 'item' is in this */
     bool contains(const T& item) const;
 
-    /* Returns the root value of the tree */
+    /* Returns the root value of the tree (which is moved by rebalancing) */
     const T& top() const;
 
     /* Returns a side-rotated representation string of this */
@@ -77,6 +101,13 @@ public:
      * Does nothing if item is already contained.
      */
     void push(const T& item);
+    void push(T&& item);
+
+    /* Constructs T{args...} and adds it to this.
+     * Does nothing if an equal item is already contained.
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
 
     /* Remove 'item' from this.
      * Throws std::runtime_error if 'item' is not in this.
@@ -95,90 +126,164 @@ protected:
 
     struct Node
     {
+        template <typename U>
+        Node(U&& the_value, Node* the_parent);
+
         T value;
         NodePointer left = nullptr;
         NodePointer right = nullptr;
-        NodePointer parent = nullptr;
+        Node* parent = nullptr;     // not owning; an owning pointer would form a cycle with the parent's child pointer
+        int height = 0;             // of the subtree rooted at this node
+        int size = 1;               // of the subtree rooted at this node
 
         /* Returns the number of children this node has. e.g., [0, 2] */
         int children() const;
     };
 
-    int calculate_size(NodePointer start) const;
 
-
-    //  -- ITERATORS UNDER CONSTRUCTION --
+    // Iterators
+    // Items are produced in order; an iterator is invalidated by any modification of the tree.
 public:
-    // Iterator Accessors
     class const_iterator;
+    class Range;
     auto begin() const -> const_iterator;
     auto end() const -> const_iterator;
 
-    class const_iterator : public std::iterator<std::forward_iterator_tag, T>
+    /* Returns the k-th smallest item (counting from 0).
+     * Throws std::out_of_range if k is not in [0, size()).
+     * O(log N).
+     */
+    const T& select(int k) const;
+
+    /* Returns the number of items less than item (which need not be in the tree).
+     * O(log N).
+     */
+    int rank(const T& item) const;
+
+    /* Returns an iterator to the first item not less than (lower_bound) or greater than (upper_bound) item,
+     * or end() if there is none.
+     * O(log N).
+     */
+    auto lower_bound(const T& item) const -> const_iterator;
+    auto upper_bound(const T& item) const -> const_iterator;
+
+    /* Returns the items in [lo, hi), in order; nothing is copied, and the items are visited as the range is iterated.
+     * O(log N) to construct, and O(1) amortized per item visited.
+     */
+    auto range(const T& lo, const T& hi) const -> Range;
+
+    class const_iterator : public std::iterator<std::forward_iterator_tag, T, std::ptrdiff_t, const T*, const T&>
     {
     public:
-        const_iterator(NodePointer start, NodePointer now, int so_far, int length_of);
-        const_iterator(NodePointer start, NodePointer now, int length_of);
+        const_iterator();
 
         auto operator++() -> const_iterator&;
         auto operator++(int) -> const_iterator;
         bool operator==(const const_iterator& other) const;
         bool operator!=(const const_iterator& other) const;
         const T& operator*() const;
-        const NodePointer operator->() const;
+        const T* operator->() const;
 
     private:
-        bool done() const;
-        NodePointer seek_min(NodePointer start);
-        void advance(bool recur_up);
-
-        NodePointer ref;
-        NodePointer current;
-        NodePointer last_seen;
-        int traversed;
-        int cap;
+        friend class BinarySearchTree<T, Allocator>;
+        explicit const_iterator(const Node* now);
+
+        const Node* current;    // nullptr past the end
+    };
+
+    class Range
+    {
+    public:
+        Range(const_iterator the_first, const_iterator the_last);
+        auto begin() const -> const_iterator;
+        auto end() const -> const_iterator;
+
+    private:
+        const_iterator first;
+        const_iterator last;
     };
 
 
 
 private:
     LessThanComparator comparator;
+    Allocator allocator;
     NodePointer root;
     int length;
 
     void print_rotated(std::ostringstream& buf, NodePointer current, const std::string& indent) const;
-    int height_of(NodePointer current) const;
+
+    /* Return the height (or size) stored in current, or -1 (or 0) for an empty subtree */
+    static int height_of(const NodePointer& current);
+    static int size_of(const NodePointer& current);
 
     NodePointer locate_node(NodePointer current, const T& item) const;
-    NodePointer insert_node(NodePointer current, NodePointer current_parent, const T& item);
-
-    void remove_internal_node_one_child(NodePointer node);
-    void remove_internal_node_two_children(NodePointer node);
-    void remove_internal_node_of_two_children(NodePointer node, NodePointer which_child);
-    void remove_root();
-    void remove_this_child(NodePointer parent, NodePointer child);
-    NodePointer find_minimum_of(NodePointer node);
-    NodePointer find_maximum_of(NodePointer node);
+
+    /* Inserts item into the subtree rooted at current unless it is already there (setting inserted accordingly).
+     * Returns the root of the subtree, which may have changed by rebalancing.
+     */
+    template <typename U>
+    NodePointer insert_node(NodePointer current, Node* current_parent, U&& item, bool& inserted);
+
+    /* Removes item from the subtree rooted at current if it is there (setting removed accordingly).
+     * Returns the root of the subtree, which may have changed by rebalancing.
+     */
+    NodePointer erase_node(NodePointer current, const T& item, bool& removed);
+
+    /* Removes the minimum of the subtree rooted at current, and returns the root of the rebalanced subtree */
+    NodePointer erase_minimum(NodePointer current);
+
+    /* Shared body of the const T& and T&& overloads of push */
+    template <typename U>
+    void push_item(U&& item);
+
+    template <typename U>
+    NodePointer make_node(U&& item, Node* parent) const;
+
+    /* Returns a deep copy of the subtree rooted at current, whose root's parent is set to parent */
+    NodePointer clone_node(NodePointer current, Node* parent) const;
+
+    // AVL rebalancing
+    /* Recomputes node's height and size from its children's */
+    static void update_node(const NodePointer& node);
+
+    /* Returns height_of(node->left) - height_of(node->right) */
+    static int balance_factor(const NodePointer& node);
+
+    /* Restores the AVL invariant at node, whose subtrees are both balanced, and returns the subtree's new root */
+    static NodePointer rebalance(NodePointer node);
+
+    /* Rotates node's left (or right) child into its place, and returns that child */
+    static NodePointer rotate_right(NodePointer node);
+    static NodePointer rotate_left(NodePointer node);
+
+    static NodePointer find_minimum_of(NodePointer node);
 };
 
 
-template <typename T>
-BinarySearchTree<T>::BinarySearchTree(const std::function<bool(const T&, const T&)>& less_than_comparator)
-    : comparator{less_than_comparator}, root{nullptr}, length{0}
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::BinarySearchTree(const std::function<bool(const T&, const T&)>& less_than_comparator)
+    : BinarySearchTree<T, Allocator>{less_than_comparator, Allocator{}}
 {
 }
 
-template <typename T>
-BinarySearchTree<T>::BinarySearchTree()
-    : BinarySearchTree<T>{std::less<T>()}
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::BinarySearchTree(const LessThanComparator& less_than_comparator, const Allocator& the_allocator)
+    : comparator{less_than_comparator}, allocator{the_allocator}, root{nullptr}, length{0}
 {
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::BinarySearchTree()
+    : BinarySearchTree<T, Allocator>{std::less<T>()}
+{
+}
+
+template <typename T, typename Allocator>
 template <typename InputIterator>
-BinarySearchTree<T>::BinarySearchTree(InputIterator first, InputIterator last,
+BinarySearchTree<T, Allocator>::BinarySearchTree(InputIterator first, InputIterator last,
                                       const LessThanComparator& less_than_comparator)
-    : BinarySearchTree<T>{less_than_comparator}
+    : BinarySearchTree<T, Allocator>{less_than_comparator}
 {
     for (; first != last; ++first)
     {
@@ -186,10 +291,10 @@ BinarySearchTree<T>::BinarySearchTree(InputIterator first, InputIterator last,
     }
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <typename InputIterator>
-BinarySearchTree<T>::BinarySearchTree(InputIterator first, InputIterator last)
-    : BinarySearchTree<T>{}
+BinarySearchTree<T, Allocator>::BinarySearchTree(InputIterator first, InputIterator last)
+    : BinarySearchTree<T, Allocator>{}
 {
     for (; first != last; ++first)
     {
@@ -197,38 +302,79 @@ BinarySearchTree<T>::BinarySearchTree(InputIterator first, InputIterator last)
     }
 }
 
-template <typename T>
-BinarySearchTree<T>::operator bool() const
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::BinarySearchTree(const BinarySearchTree<T, Allocator>& right)
+    : comparator{right.comparator},
+      allocator{std::allocator_traits<Allocator>::select_on_container_copy_construction(right.allocator)},
+      root{clone_node(right.root, nullptr)}, length{right.length}
+{
+}
+
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::BinarySearchTree(BinarySearchTree<T, Allocator>&& right)
+    : comparator{right.comparator}, allocator{right.allocator}, root{std::move(right.root)}, length{right.length}
+{
+    right.root = nullptr;
+    right.length = 0;
+}
+
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>& BinarySearchTree<T, Allocator>::operator=(const BinarySearchTree<T, Allocator>& right)
+{
+    if (this != &right)
+    {
+        comparator = right.comparator;
+        root = clone_node(right.root, nullptr);
+        length = right.length;
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>& BinarySearchTree<T, Allocator>::operator=(BinarySearchTree<T, Allocator>&& right)
+{
+    if (this != &right)
+    {
+        std::swap(comparator, right.comparator);
+        std::swap(allocator, right.allocator);
+        std::swap(root, right.root);
+        std::swap(length, right.length);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::operator bool() const
 {
     return !empty();
 }
 
-template <typename T>
-int BinarySearchTree<T>::size() const
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::size() const
 {
     return length;
 }
 
-template <typename T>
-int BinarySearchTree<T>::height() const
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::height() const
 {
     return height_of(root);
 }
 
-template <typename T>
-bool BinarySearchTree<T>::empty() const
+template <typename T, typename Allocator>
+bool BinarySearchTree<T, Allocator>::empty() const
 {
     return size() == 0;
 }
 
-template <typename T>
-bool BinarySearchTree<T>::contains(const T& item) const
+template <typename T, typename Allocator>
+bool BinarySearchTree<T, Allocator>::contains(const T& item) const
 {
     return static_cast<bool>(locate_node(root, item));
 }
 
-template <typename T>
-const T& BinarySearchTree<T>::top() const
+template <typename T, typename Allocator>
+const T& BinarySearchTree<T, Allocator>::top() const
 {
     if (*this)
     {
@@ -237,56 +383,52 @@ const T& BinarySearchTree<T>::top() const
     throw std::runtime_error{"BinarySearchTree::top - tree is empty"};
 }
 
-template <typename T>
-std::string BinarySearchTree<T>::to_string() const
+template <typename T, typename Allocator>
+std::string BinarySearchTree<T, Allocator>::to_string() const
 {
     std::ostringstream buf;
     print_rotated(buf, root, "");
     return buf.str();
 }
 
-template <typename T>
-void BinarySearchTree<T>::push(const T& item)
+template <typename T, typename Allocator>
+void BinarySearchTree<T, Allocator>::push(const T& item)
+{
+    push_item(item);
+}
+
+template <typename T, typename Allocator>
+void BinarySearchTree<T, Allocator>::push(T&& item)
 {
-    if (!contains(item))
+    push_item(std::move(item));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void BinarySearchTree<T, Allocator>::emplace(Args&&... args)
+{
+    push_item(T(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Allocator>
+template <typename U>
+void BinarySearchTree<T, Allocator>::push_item(U&& item)
+{
+    bool inserted = false;
+    root = insert_node(root, nullptr, std::forward<U>(item), inserted);
+    if (inserted)
     {
-        if (empty())
-        {
-            root = NodePointer{new Node{item}};
-        }
-        else
-        {
-            root = insert_node(root, nullptr, item);
-        }
         ++length;
     }
 }
 
-template <typename T>
-void BinarySearchTree<T>::erase(const T& item)
+template <typename T, typename Allocator>
+void BinarySearchTree<T, Allocator>::erase(const T& item)
 {
-    auto found = locate_node(root, item);
-    if (found)
+    bool removed = false;
+    root = erase_node(root, item, removed);
+    if (removed)
     {
-        if (found == root)
-        {
-            remove_root();
-        }
-        else
-        {
-            int n_children = found->children();
-            switch (n_children)
-            {
-                case 0:
-                    remove_this_child(found->parent, found);
-                    break;
-                case 1:
-                    remove_internal_node_one_child(found);
-                    break;
-                case 2:
-                    remove_internal_node_two_children(found);
-            }
-        }
         --length;
     }
     else
@@ -297,15 +439,15 @@ void BinarySearchTree<T>::erase(const T& item)
     }
 }
 
-template <typename T>
-void BinarySearchTree<T>::clear()
+template <typename T, typename Allocator>
+void BinarySearchTree<T, Allocator>::clear()
 {
     root.reset();
     length = 0;
 }
 
-template <typename T>
-typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::locate_node(NodePointer current, const T& item) const
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::locate_node(NodePointer current, const T& item) const
 {
     while (current)
     {
@@ -318,208 +460,236 @@ typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::locate_node(NodeP
     return NodePointer{};
 }
 
-template <typename T>
-typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::insert_node(NodePointer current,
-                                                                           NodePointer current_parent,
-                                                                           const T& item)
+template <typename T, typename Allocator>
+template <typename U>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::insert_node(NodePointer current,
+                                                                           Node* current_parent,
+                                                                           U&& item,
+                                                                           bool& inserted)
 {
     if (current)
     {
         if (current->value == item)
         {
-            // pass; BST holds unique values
+            return current;     // BST holds unique values
         }
         else if (comparator(item, current->value))
         {
-            current->left = insert_node(current->left, current, item);
+            current->left = insert_node(current->left, current.get(), std::forward<U>(item), inserted);
         }
         else
         {
-            current->right = insert_node(current->right, current, item);
+            current->right = insert_node(current->right, current.get(), std::forward<U>(item), inserted);
         }
-        return current;
+        return inserted ? rebalance(current) : current;
     }
     else
     {
-        return NodePointer{new Node{item, nullptr, nullptr, current_parent}};
+        inserted = true;
+        return make_node(std::forward<U>(item), current_parent);
     }
 }
 
-template <typename T>
-void BinarySearchTree<T>::print_rotated(std::ostringstream& buf, NodePointer current, const std::string& indent) const
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::erase_node(NodePointer current,
+                                                                          const T& item,
+                                                                          bool& removed)
 {
-    if (current)
+    if (!current)
     {
-        print_rotated(buf, current->right, indent + "..");
-        buf << indent << current->value << std::endl;
-        print_rotated(buf, current->left, indent + "..");
+        return current;
     }
-}
 
-template <typename T>
-int BinarySearchTree<T>::height_of(NodePointer current) const
-{
-    if (current)
+    if (current->value == item)
+    {
+        removed = true;
+        if (!current->left || !current->right)
+        {
+            NodePointer child = current->left ? current->left : current->right;
+            if (child)
+            {
+                child->parent = current->parent;
+            }
+            return child;
+        }
+
+        // two children: current takes over the value of its in-order successor, which is removed instead
+        current->value = std::move(find_minimum_of(current->right)->value);
+        current->right = erase_minimum(current->right);
+    }
+    else if (comparator(item, current->value))
     {
-        int left = height_of(current->left);
-        int right = height_of(current->right);
-        return 1 + std::max(left, right);
+        current->left = erase_node(current->left, item, removed);
     }
     else
     {
-        return -1;
+        current->right = erase_node(current->right, item, removed);
     }
+    return removed ? rebalance(current) : current;
 }
 
-template <typename T>
-int BinarySearchTree<T>::calculate_size(NodePointer start) const
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::erase_minimum(NodePointer current)
 {
-    if (start)
+    if (!current->left)
     {
-        return 1 + calculate_size(start->left) + calculate_size(start->right);
-    }
-    else
-    {
-        return 0;
+        if (current->right)
+        {
+            current->right->parent = current->parent;
+        }
+        return current->right;
     }
+    current->left = erase_minimum(current->left);
+    return rebalance(current);
 }
 
-template <typename T>
-int BinarySearchTree<T>::Node::children() const
+template <typename T, typename Allocator>
+void BinarySearchTree<T, Allocator>::update_node(const NodePointer& node)
 {
-    if (left && right)
-    {
-        return 2;
-    }
-    else if (left || right)
-    {
-        return 1;
-    }
-    else
-    {
-        return 0;
-    }
+    node->height = 1 + std::max(height_of(node->left), height_of(node->right));
+    node->size = 1 + size_of(node->left) + size_of(node->right);
 }
 
-template <typename T>
-void BinarySearchTree<T>::remove_internal_node_one_child(BinarySearchTree<T>::NodePointer node)
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::balance_factor(const NodePointer& node)
 {
-    auto child = node->left ? node->left : node->right;
-    auto parent = node->parent;
-    if (parent->left == node)
+    return height_of(node->left) - height_of(node->right);
+}
+
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::rebalance(NodePointer node)
+{
+    update_node(node);
+    int balance = balance_factor(node);
+    if (balance > 1)
     {
-        parent->left.swap(child);
-        if (parent->left)
+        if (balance_factor(node->left) < 0)
         {
-            parent->left->parent = parent;
+            node->left = rotate_left(node->left);
         }
+        return rotate_right(node);
     }
-    else
+    else if (balance < -1)
     {
-        parent->right.swap(child);
-        if (parent->right)
+        if (balance_factor(node->right) > 0)
         {
-            parent->right->parent = parent;
+            node->right = rotate_right(node->right);
         }
+        return rotate_left(node);
     }
-    node.reset();
+    return node;
 }
 
-template <typename T>
-void BinarySearchTree<T>::remove_internal_node_two_children(BinarySearchTree<T>::NodePointer node)
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::rotate_right(NodePointer node)
 {
-    auto minimum_of_right = find_minimum_of(node->right);
-    if (minimum_of_right)
+    NodePointer pivot = node->left;
+    node->left = pivot->right;
+    if (node->left)
     {
-        remove_internal_node_of_two_children(node, minimum_of_right);
-    }
-    else
-    {
-        auto maximum_of_left = find_maximum_of(node->left);
-        remove_internal_node_of_two_children(node, maximum_of_left);
+        node->left->parent = node.get();
     }
+    pivot->right = node;
+    pivot->parent = node->parent;
+    node->parent = pivot.get();
+
+    update_node(node);
+    update_node(pivot);
+    return pivot;
 }
 
-template <typename T>
-void BinarySearchTree<T>::remove_internal_node_of_two_children(NodePointer node, NodePointer which_child)
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::rotate_left(NodePointer node)
 {
-    T value = which_child->value;
-    int children = which_child->children();
-    switch (children)
+    NodePointer pivot = node->right;
+    node->right = pivot->left;
+    if (node->right)
     {
-        case 0:
-            remove_this_child(which_child->parent, which_child);
-            break;
-        case 1:
-            remove_internal_node_one_child(which_child);
-            break;
-        default:
-            std::ostringstream buf;
-            buf << "BinarySearchTree::remove_internal_node_of_two_children - ";
-            buf << " removal of node " << node << " with child " << which_child << " has " << children << " children";
-            throw std::logic_error{buf.str()};
+        node->right->parent = node.get();
     }
-    node->value = value;
+    pivot->left = node;
+    pivot->parent = node->parent;
+    node->parent = pivot.get();
+
+    update_node(node);
+    update_node(pivot);
+    return pivot;
+}
+
+template <typename T, typename Allocator>
+template <typename U>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::make_node(U&& item, Node* parent) const
+{
+    return std::allocate_shared<Node>(allocator, std::forward<U>(item), parent);
 }
 
-template <typename T>
-void BinarySearchTree<T>::remove_root()
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::clone_node(NodePointer current, Node* parent) const
 {
-    if (size() == 1)
+    if (current)
     {
-        root.reset();
+        NodePointer copy = make_node(current->value, parent);
+        copy->left = clone_node(current->left, copy.get());
+        copy->right = clone_node(current->right, copy.get());
+        copy->height = current->height;
+        copy->size = current->size;
+        return copy;
     }
     else
     {
-        auto minimum_of_right = find_minimum_of(root->right);
-        T value;
-        if (minimum_of_right)
-        {
-            value = std::move(minimum_of_right->value);
-            remove_internal_node_one_child(minimum_of_right);
-        }
-        else
-        {
-            auto maximum_of_left = find_maximum_of(root->left);
-            if (maximum_of_left)
-            {
-                value = std::move(maximum_of_left->value);
-                remove_internal_node_one_child(maximum_of_left);
-            }
-            else
-            {
-                std::ostringstream buf;
-                buf << "BinarySearchTree::remove_root - failed to find smallest larger value, or largest smaller value";
-                throw std::logic_error{buf.str()};
-            }
-        }
-        root->value = value;
+        return NodePointer{};
     }
 }
 
-template <typename T>
-void BinarySearchTree<T>::remove_this_child(BinarySearchTree<T>::NodePointer parent,
-                                            BinarySearchTree<T>::NodePointer child)
+template <typename T, typename Allocator>
+void BinarySearchTree<T, Allocator>::print_rotated(std::ostringstream& buf, NodePointer current, const std::string& indent) const
+{
+    if (current)
+    {
+        print_rotated(buf, current->right, indent + "..");
+        buf << indent << current->value << std::endl;
+        print_rotated(buf, current->left, indent + "..");
+    }
+}
+
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::height_of(const NodePointer& current)
+{
+    return current ? current->height : -1;
+}
+
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::size_of(const NodePointer& current)
+{
+    return current ? current->size : 0;
+}
+
+template <typename T, typename Allocator>
+template <typename U>
+BinarySearchTree<T, Allocator>::Node::Node(U&& the_value, Node* the_parent)
+    : value(std::forward<U>(the_value)), parent{the_parent}
 {
-    if (parent->left == child)
+}
+
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::Node::children() const
+{
+    if (left && right)
     {
-        parent->left.reset();
+        return 2;
     }
-    else if (parent->right == child)
+    else if (left || right)
     {
-        parent->right.reset();
+        return 1;
     }
     else
     {
-        std::ostringstream buf;
-        buf << "BinarySearchTree::remove_this_child - node (value: " << child->value << ")";
-        buf << " is not a child of parent (value: " << parent->value << ")";
-        throw std::logic_error{buf.str()};
+        return 0;
     }
 }
 
-template <typename T>
-typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::find_minimum_of(BinarySearchTree<T>::NodePointer node)
+template <typename T, typename Allocator>
+typename BinarySearchTree<T, Allocator>::NodePointer BinarySearchTree<T, Allocator>::find_minimum_of(BinarySearchTree<T, Allocator>::NodePointer node)
 {
     if (node)
     {
@@ -536,188 +706,216 @@ typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::find_minimum_of(B
     }
 }
 
-template <typename T>
-typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::find_maximum_of(NodePointer node)
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::begin() const -> const_iterator
 {
-    if (node)
+    return const_iterator{root ? find_minimum_of(root).get() : nullptr};
+}
+
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::end() const -> const_iterator
+{
+    return const_iterator{};
+}
+
+template <typename T, typename Allocator>
+const T& BinarySearchTree<T, Allocator>::select(int k) const
+{
+    if (k < 0 || k >= size())
     {
-        auto current = node;
-        while (current->right)
+        std::ostringstream buf;
+        buf << "BinarySearchTree::select - " << k << " is out of range for a tree of size " << size();
+        throw std::out_of_range{buf.str()};
+    }
+
+    const Node* current = root.get();
+    while (true)
+    {
+        int left = size_of(current->left);
+        if (k < left)
         {
-            current = current->right;
+            current = current->left.get();
+        }
+        else if (k == left)
+        {
+            return current->value;
+        }
+        else
+        {
+            k -= left + 1;
+            current = current->right.get();
         }
-        return current;
     }
-    else
+}
+
+template <typename T, typename Allocator>
+int BinarySearchTree<T, Allocator>::rank(const T& item) const
+{
+    int less = 0;
+    const Node* current = root.get();
+    while (current)
     {
-        return NodePointer{nullptr};
+        if (comparator(current->value, item))
+        {
+            less += size_of(current->left) + 1;
+            current = current->right.get();
+        }
+        else
+        {
+            current = current->left.get();
+        }
     }
+    return less;
 }
 
-template <typename T>
-auto BinarySearchTree<T>::begin() const -> const_iterator
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::lower_bound(const T& item) const -> const_iterator
 {
-    return const_iterator{root, nullptr, size()};
+    const Node* found = nullptr;
+    const Node* current = root.get();
+    while (current)
+    {
+        if (comparator(current->value, item))
+        {
+            current = current->right.get();
+        }
+        else
+        {
+            found = current;
+            current = current->left.get();
+        }
+    }
+    return const_iterator{found};
 }
 
-template <typename T>
-auto BinarySearchTree<T>::end() const -> const_iterator
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::upper_bound(const T& item) const -> const_iterator
 {
-    return const_iterator{root, nullptr, size() + 1, size()};
+    const Node* found = nullptr;
+    const Node* current = root.get();
+    while (current)
+    {
+        if (comparator(item, current->value))
+        {
+            found = current;
+            current = current->left.get();
+        }
+        else
+        {
+            current = current->right.get();
+        }
+    }
+    return const_iterator{found};
 }
 
-template <typename T>
-BinarySearchTree<T>::const_iterator::const_iterator(NodePointer start, NodePointer now, int so_far, int length_of)
-    : ref{start}, current{now}, traversed{so_far}, cap{length_of}
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::range(const T& lo, const T& hi) const -> Range
 {
+    if (!comparator(lo, hi))
+    {
+        return Range{end(), end()};
+    }
+    return Range{lower_bound(lo), lower_bound(hi)};
 }
 
-template <typename T>
-BinarySearchTree<T>::const_iterator::const_iterator(NodePointer start, NodePointer now, int length_of)
-    : const_iterator{start, now, 0, length_of}
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::const_iterator::const_iterator()
+    : current{nullptr}
 {
-    current = seek_min(start);
-    ++traversed;
 }
 
-template <typename T>
-bool BinarySearchTree<T>::const_iterator::done() const
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::const_iterator::const_iterator(const Node* now)
+    : current{now}
 {
-    return traversed > cap;
 }
 
-template <typename T>
-typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::const_iterator::seek_min(BinarySearchTree<T>::NodePointer start)
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::const_iterator::operator++() -> const_iterator&
 {
-    auto c = start;
-    while (c && c->left)
+    if (current == nullptr)
     {
-        c = c->left;
+        return *this;
     }
-    return c;
-}
 
-template <typename T>
-void BinarySearchTree<T>::const_iterator::advance(bool recur_up)
-{
-    if (last_seen)
+    if (current->right)
     {
-        if (last_seen->left)
+        current = current->right.get();
+        while (current->left)
         {
+            current = current->left.get();
         }
-        if (last_seen->right)
+    }
+    else
+    {
+        // climb until coming up from a left child; running out of parents means current was the maximum
+        const Node* child = current;
+        current = current->parent;
+        while (current && current->right.get() == child)
         {
-
+            child = current;
+            current = current->parent;
         }
     }
-    else    // first iteration of depth n of the tree
-    {
-        last_seen = current;
-    }
-    ++traversed;
-
-
-//    if (traversed == 0)
-//    {
-//        current = seek_min(ref);
-//    }
-//    else
-//    {
-//        auto parent = current->parent;
-//        if (parent)
-//        {
-//            if (current->right && !recur_up)
-//            {
-//                if (!last_seen)
-//                {
-//                    last_seen = current;
-//                }
-//                current = seek_min(current->right);
-//            }
-//            else
-//            {
-//                current = parent;
-//                if (!recur_up && last_seen)
-//                {
-//                    while (current != last_seen)
-//                    {
-//                        current = current->parent;
-//                    }
-//                    advance(true);
-//                    last_seen = nullptr;
-//                    return;
-//                }
-////                if (current == last_seen)
-////                {
-////                    advance();
-////                    last_seen = nullptr;
-////                    return;
-////                }
-//            }
-//        }
-//        else    // current is the root
-//        {
-//            current = seek_min(ref->right);
-//        }
-//    }
-//    ++traversed;
-}
-
-template <typename T>
-auto BinarySearchTree<T>::const_iterator::operator++() -> const_iterator&
-{
-    if (!done())
-    {
-        advance(false);
-    }
     return *this;
 }
 
-template <typename T>
-auto BinarySearchTree<T>::const_iterator::operator++(int) -> const_iterator
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::const_iterator::operator++(int) -> const_iterator
 {
+    const_iterator state{*this};
+    operator++();
+    return state;
 }
 
-template <typename T>
-bool BinarySearchTree<T>::const_iterator::operator==(const const_iterator& other) const
+template <typename T, typename Allocator>
+bool BinarySearchTree<T, Allocator>::const_iterator::operator==(const const_iterator& other) const
 {
-    return ref == other.ref && traversed == other.traversed;
+    return current == other.current;
 }
 
-template <typename T>
-bool BinarySearchTree<T>::const_iterator::operator!=(const const_iterator& other) const
+template <typename T, typename Allocator>
+bool BinarySearchTree<T, Allocator>::const_iterator::operator!=(const const_iterator& other) const
 {
     return !operator==(other);
 }
 
-template <typename T>
-const T& BinarySearchTree<T>::const_iterator::operator*() const
+template <typename T, typename Allocator>
+const T& BinarySearchTree<T, Allocator>::const_iterator::operator*() const
 {
-    if (done())
+    if (current == nullptr)
     {
-        std::ostringstream buf;
-        buf << "BinarySearchTree::iterator::operator* - iterator past end";
-        throw std::out_of_range{buf.str()};
-    }
-    else
-    {
-        return current->value;
+        throw std::out_of_range{"BinarySearchTree::iterator::operator* - iterator past end"};
     }
+    return current->value;
 }
 
-template <typename T>
-const typename BinarySearchTree<T>::NodePointer BinarySearchTree<T>::const_iterator::operator->() const
+template <typename T, typename Allocator>
+const T* BinarySearchTree<T, Allocator>::const_iterator::operator->() const
 {
-    if (done())
+    if (current == nullptr)
     {
-        std::ostringstream buf;
-        buf << "BinarySearchTree::iterator::operator-> - iterator past end";
-        throw std::out_of_range{buf.str()};
-    }
-    else
-    {
-        return current;
+        throw std::out_of_range{"BinarySearchTree::iterator::operator-> - iterator past end"};
     }
+    return &current->value;
+}
+
+template <typename T, typename Allocator>
+BinarySearchTree<T, Allocator>::Range::Range(const_iterator the_first, const_iterator the_last)
+    : first{the_first}, last{the_last}
+{
+}
+
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::Range::begin() const -> const_iterator
+{
+    return first;
+}
+
+template <typename T, typename Allocator>
+auto BinarySearchTree<T, Allocator>::Range::end() const -> const_iterator
+{
+    return last;
 }
 
 #endif // DATA_STRUCTURES_BINARY_SEARCH_TREE_HPP
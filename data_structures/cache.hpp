@@ -0,0 +1,378 @@
+#ifndef DATA_STRUCTURES_CACHE_HPP
+#define DATA_STRUCTURES_CACHE_HPP
+
+// This templated header file defines Cache - a bounded map from Key to T,
+// which evicts an entry whenever an insertion would exceed its capacity.
+//
+// The entries are kept in LinkedHashMaps ordered from least- to most-recently used;
+// a hit relinks its entry at the back (LinkedHashMap::touch), so promotion never erases, copies or reallocates.
+// Which entry is evicted depends on the CachePolicy chosen at construction:
+//   LRU            - the least-recently used entry.
+//   LFU            - the least-frequently used entry (the least-recently used one among ties).
+//                    Keys are also grouped into one insertion-ordered LinkedHashSet per use count,
+//                    so both promotion and eviction are O(1).
+//   SEGMENTED_LRU  - new entries start in a probationary segment, and move into a protected segment
+//                    (about 80% of the capacity) when they are hit again; entries pushed out of the protected
+//                    segment drop back to probation. Eviction takes the least-recently used probationary entry,
+//                    so a scan of one-off keys cannot flush the entries that are actually reused.
+//
+// Lookups through find() are counted as hits or misses, and evictions are counted as well.
+
+#include "hash_map.hpp"
+#include "linked_hash_map.hpp"
+#include "linked_hash_set.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+
+enum class CachePolicy
+{
+	LRU,
+	LFU,
+	SEGMENTED_LRU
+};
+
+
+template <typename Key,
+          typename T,
+          typename Hash = std::hash<Key>,
+          typename Predicate = std::equal_to<Key>>
+class Cache
+{
+public:
+	/* Throws std::invalid_argument if capacity is not positive */
+	explicit Cache(int capacity, CachePolicy policy = CachePolicy::LRU);
+
+	/* Returns the number of entries in the cache.
+	 * Complexity:
+	 *   Θ(1)
+	 */
+	int size() const;
+	bool empty() const;
+	int capacity() const;
+	CachePolicy policy() const;
+
+	/* Returns true if key is cached; this neither promotes key nor counts as a hit or miss.
+	 * Complexity:
+	 *   Average case: O(1)
+	 */
+	bool contains(const Key& key) const;
+
+	/* Returns a pointer to the value cached for key (a hit, which promotes key under the cache's policy),
+	 * or nullptr if key is not cached (a miss).
+	 * The pointer remains valid until the next modifying operation.
+	 * Complexity:
+	 *   Average case: O(1)
+	 */
+	T* find(const Key& key);
+
+	/* Caches value for key. If key is already cached, its value is replaced and key is promoted (without counting a hit);
+	 * otherwise, if the cache is full, an entry is evicted first.
+	 * Complexity:
+	 *   Average case: O(1)
+	 */
+	void put(const Key& key, const T& value);
+
+	/* Removes key from the cache. If key is not cached, throws std::runtime_error.
+	 * Complexity:
+	 *   Average case: O(1); O(F) under LFU, where F is the number of distinct use counts.
+	 */
+	void erase(const Key& key);
+
+	/* Removes every entry; the statistics are kept */
+	void clear();
+
+	// Statistics
+	long long hits() const;
+	long long misses() const;
+	long long evictions() const;
+
+	/* Returns hits() / (hits() + misses()), or 0 if find() has never been called */
+	double hit_rate() const;
+
+	void reset_statistics();
+
+
+private:
+	struct Entry
+	{
+		T value;
+		int uses;
+	};
+
+	typedef LinkedHashMap<Key, Entry, Hash, Predicate> Segment;
+
+	int max_size;
+	int protected_capacity;
+	CachePolicy cache_policy;
+
+	Segment segment;				// every entry (LRU, LFU), or the probationary entries (SEGMENTED_LRU)
+	Segment protected_segment;		// SEGMENTED_LRU only
+	HashMap<int, LinkedHashSet<Key, Hash, Predicate>> keys_by_uses;	// LFU only
+	int min_uses;					// LFU only; the smallest key of keys_by_uses
+
+	long long hit_count;
+	long long miss_count;
+	long long eviction_count;
+
+	/* Promotes key under the cache's policy, and returns its entry; returns nullptr if key is not cached */
+	Entry* promote(const Key& key);
+
+	/* Removes the entry selected by the cache's policy */
+	void evict();
+
+	/* Moves key from the LFU group for entry's use count into the next one */
+	void add_use(const Key& key, Entry& entry);
+
+	/* Removes key from the LFU group for uses, dropping the group if it is left empty */
+	void remove_use(const Key& key, int uses);
+};
+
+
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+Cache<Key, T, Hash, Predicate>::Cache(int capacity, CachePolicy policy)
+	: max_size{capacity}, protected_capacity{capacity * 4 / 5}, cache_policy{policy},
+	  min_uses{0}, hit_count{0}, miss_count{0}, eviction_count{0}
+{
+	if (capacity <= 0)
+	{
+		throw std::invalid_argument{"Cache capacity must be positive"};
+	}
+	segment.reserve(capacity);
+	if (policy == CachePolicy::SEGMENTED_LRU)
+	{
+		protected_segment.reserve(protected_capacity);
+	}
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+int Cache<Key, T, Hash, Predicate>::size() const
+{
+	return segment.size() + protected_segment.size();
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+bool Cache<Key, T, Hash, Predicate>::empty() const
+{
+	return size() == 0;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+int Cache<Key, T, Hash, Predicate>::capacity() const
+{
+	return max_size;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+CachePolicy Cache<Key, T, Hash, Predicate>::policy() const
+{
+	return cache_policy;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+bool Cache<Key, T, Hash, Predicate>::contains(const Key& key) const
+{
+	return segment.contains(key) || protected_segment.contains(key);
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+T* Cache<Key, T, Hash, Predicate>::find(const Key& key)
+{
+	Entry* entry = promote(key);
+	if (entry == nullptr)
+	{
+		++miss_count;
+		return nullptr;
+	}
+	++hit_count;
+	return &entry->value;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::put(const Key& key, const T& value)
+{
+	Entry* entry = promote(key);
+	if (entry != nullptr)
+	{
+		entry->value = value;
+		return;
+	}
+
+	if (size() >= max_size)
+	{
+		evict();
+	}
+	segment.insert(key, Entry{value, 1});
+	if (cache_policy == CachePolicy::LFU)
+	{
+		keys_by_uses[1].insert(key);
+		min_uses = 1;
+	}
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::erase(const Key& key)
+{
+	if (protected_segment.contains(key))
+	{
+		protected_segment.erase(key);
+		return;
+	}
+
+	if (cache_policy == CachePolicy::LFU && segment.contains(key))
+	{
+		remove_use(key, segment.touch(key)->uses);
+		if (!keys_by_uses.contains(min_uses))
+		{
+			std::vector<int> counts = keys_by_uses.keys();
+			min_uses = counts.empty() ? 0 : *std::min_element(counts.begin(), counts.end());
+		}
+	}
+	segment.erase(key);
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::clear()
+{
+	segment.clear();
+	protected_segment.clear();
+	keys_by_uses.clear();
+	min_uses = 0;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+long long Cache<Key, T, Hash, Predicate>::hits() const
+{
+	return hit_count;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+long long Cache<Key, T, Hash, Predicate>::misses() const
+{
+	return miss_count;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+long long Cache<Key, T, Hash, Predicate>::evictions() const
+{
+	return eviction_count;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+double Cache<Key, T, Hash, Predicate>::hit_rate() const
+{
+	long long lookups = hit_count + miss_count;
+	return lookups == 0 ? 0.0 : static_cast<double>(hit_count) / lookups;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::reset_statistics()
+{
+	hit_count = 0;
+	miss_count = 0;
+	eviction_count = 0;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+typename Cache<Key, T, Hash, Predicate>::Entry* Cache<Key, T, Hash, Predicate>::promote(const Key& key)
+{
+	switch (cache_policy)
+	{
+	case CachePolicy::LRU:
+		return segment.touch(key);
+
+	case CachePolicy::LFU:
+	{
+		Entry* entry = segment.touch(key);
+		if (entry != nullptr)
+		{
+			add_use(key, *entry);
+		}
+		return entry;
+	}
+
+	case CachePolicy::SEGMENTED_LRU:
+	{
+		Entry* entry = protected_segment.touch(key);
+		if (entry != nullptr || !segment.contains(key))
+		{
+			return entry;
+		}
+
+		// a second use: move key from probation into the protected segment,
+		// demoting the protected segment's least-recently used entry if it is now over capacity
+		protected_segment.insert(key, *segment.touch(key));
+		segment.erase(key);
+		if (protected_segment.size() > protected_capacity)
+		{
+			auto demoted = protected_segment.pop_front();
+			segment.insert(demoted.first, demoted.second);
+		}
+		return protected_segment.contains(key) ? protected_segment.touch(key) : segment.touch(key);
+	}
+	}
+	return nullptr;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::evict()
+{
+	switch (cache_policy)
+	{
+	case CachePolicy::LRU:
+		segment.pop_front();
+		break;
+
+	case CachePolicy::LFU:
+	{
+		LinkedHashSet<Key, Hash, Predicate>& least_used = keys_by_uses[min_uses];
+		Key victim = least_used.pop_front();
+		if (least_used.empty())
+		{
+			keys_by_uses.erase(min_uses);
+		}
+		segment.erase(victim);
+		break;
+	}
+
+	case CachePolicy::SEGMENTED_LRU:
+		if (!segment.empty())
+		{
+			segment.pop_front();
+		}
+		else
+		{
+			protected_segment.pop_front();
+		}
+		break;
+	}
+	++eviction_count;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::add_use(const Key& key, Entry& entry)
+{
+	remove_use(key, entry.uses);
+	if (min_uses == entry.uses && !keys_by_uses.contains(entry.uses))
+	{
+		++min_uses;
+	}
+	++entry.uses;
+	keys_by_uses[entry.uses].insert(key);
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate>
+void Cache<Key, T, Hash, Predicate>::remove_use(const Key& key, int uses)
+{
+	LinkedHashSet<Key, Hash, Predicate>& group = keys_by_uses[uses];
+	group.erase(key);
+	if (group.empty())
+	{
+		keys_by_uses.erase(uses);
+	}
+}
+
+#endif // DATA_STRUCTURES_CACHE_HPP
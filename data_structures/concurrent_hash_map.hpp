@@ -0,0 +1,435 @@
+// A ConcurrentHashMap is a map that may be shared between threads without an outside lock.
+//
+// Its keys are partitioned between a fixed number of shards (a power of two), each an ordinary HashMap
+// (see hash_map.hpp) with a reader-writer lock of its own:
+// lookups take their shard's lock shared, so any number of them run together, and modifications take it
+// exclusively, so they only wait for threads working on the same shard.
+// A key's shard is chosen from the high bits of its (mixed) hash, and its bin within the shard from the low bits,
+// so the two choices stay independent even for weak hash functions such as std::hash<int>.
+// Shards are padded apart, so that locking one never invalidates the cache line of another's lock.
+//
+// Every operation on a single key is atomic.
+// Values are returned by copy: a reference into the map could be invalidated by another thread at any time.
+// size(), empty() and iteration are weakly consistent: they visit the shards one at a time, so they see every
+// modification completed before they began, and may or may not see those made while they run.
+#ifndef DATA_STRUCTURES_CONCURRENT_HASH_MAP_HPP
+#define DATA_STRUCTURES_CONCURRENT_HASH_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "hash_map.hpp"
+#include "hasher.hpp"
+
+
+namespace
+{
+    int _CONCURRENT_HASH_MAP_SHARDS_PER_THREAD = 4;     // default shards per hardware thread
+    int _CONCURRENT_HASH_MAP_MINIMUM_SHARDS = 16;
+    const int _CONCURRENT_HASH_MAP_CACHE_LINE_SIZE = 64;
+}
+
+
+
+template <typename KEY, typename VALUE, typename Hash = std::hash<KEY>>
+class ConcurrentHashMap
+{
+private:
+    typedef std::pair<KEY, VALUE> Entry;
+
+public:
+    /* Makes _CONCURRENT_HASH_MAP_SHARDS_PER_THREAD shards per hardware thread, and at least _CONCURRENT_HASH_MAP_MINIMUM_SHARDS */
+    ConcurrentHashMap();
+
+    /* Makes at least shards shards (rounded up to a power of two); throws std::invalid_argument if shards is not positive */
+    explicit ConcurrentHashMap(int shards, const Hash& hasher = Hash{});
+    ConcurrentHashMap(const ConcurrentHashMap& right) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap& right) = delete;
+
+
+    // Member Functions
+    int shards() const;
+    int size() const;
+    bool empty() const;
+    bool contains(const KEY& key) const;
+
+    /* Returns (a copy of) the value associated with key; throws std::invalid_argument if key is not in the map */
+    VALUE get(const KEY& key) const;
+
+    /* Copies the value associated with key into value and returns true, or returns false if key is not in the map */
+    bool find(const KEY& key, VALUE& value) const;
+
+    /* Calls visit(key, value) on every entry, holding each shard's lock shared while its entries are visited;
+     * visit must not modify this map.
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) const;
+
+    // Modifying Member Functions
+    /* Inserts {key: value}, or assigns value to key if key is already in the map.
+     * Returns true if an insertion took place.
+     */
+    template <typename V>
+    bool insert_or_assign(const KEY& key, V&& value);
+
+    /* Inserts {key: VALUE{args...}} if key is not already in the map; otherwise leaves the map unchanged.
+     * Returns true if an insertion took place.
+     */
+    template <typename... Args>
+    bool try_emplace(const KEY& key, Args&&... args);
+
+    /* If key is not in the map, inserts {key: compute(key)}; compute is called at most once,
+     * while key's shard is locked, so it must not use this map. If compute throws, nothing is inserted.
+     * Returns (a copy of) the value associated with key afterwards.
+     */
+    template <typename Function>
+    VALUE compute_if_absent(const KEY& key, Function compute);
+
+    /* Removes key from the map; returns false if key was not in the map */
+    bool erase(const KEY& key);
+
+    /* Empties the map, one shard at a time */
+    void clear();
+
+    /* Grows every shard so that n entries (spread over the shards) fit without triggering a rehash */
+    void reserve(int n);
+
+
+    /* Iteration produces the map's entries, one shard at a time:
+     * on entering a shard, the iterator copies its entries while holding its lock shared, and then releases it,
+     * so iterating never blocks other threads for longer than that copy, and never observes a torn entry.
+     */
+    class iterator : public std::iterator<std::forward_iterator_tag, Entry, std::ptrdiff_t, const Entry*, const Entry&>
+    {
+    public:
+        iterator();
+
+        auto operator++() -> iterator&;
+        auto operator++(int) -> iterator;
+        bool operator==(const iterator& right) const;
+        bool operator!=(const iterator& right) const;
+        const Entry& operator*() const;
+        const Entry* operator->() const;
+
+        friend class ConcurrentHashMap<KEY, VALUE, Hash>;
+
+    private:
+        iterator(const ConcurrentHashMap<KEY, VALUE, Hash>* it, int shard);
+
+        /* Copies the entries of the next shard that has any, or moves to the end */
+        void advance_shard();
+
+        const ConcurrentHashMap<KEY, VALUE, Hash>* ref;
+        int current_shard;
+        std::size_t current;
+        std::shared_ptr<const std::vector<Entry>> snapshot;     // shared between copies of the iterator
+    };
+
+    auto begin() const -> iterator;
+    auto end() const -> iterator;
+
+
+private:
+    struct Shard
+    {
+        char before[_CONCURRENT_HASH_MAP_CACHE_LINE_SIZE];
+        mutable std::shared_timed_mutex lock;
+        HashMap<KEY, VALUE, Hash> map;
+    };
+
+    typedef std::shared_lock<std::shared_timed_mutex> ReadLock;
+    typedef std::unique_lock<std::shared_timed_mutex> WriteLock;
+
+    Hasher<KEY, Hash> hash;
+    int shard_bits;
+    std::unique_ptr<Shard[]> table;
+
+    static int default_shards();
+    Shard& shard_of(const KEY& key) const;
+};
+
+
+template <typename KEY, typename VALUE, typename Hash>
+ConcurrentHashMap<KEY, VALUE, Hash>::ConcurrentHashMap() : ConcurrentHashMap(default_shards())
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+ConcurrentHashMap<KEY, VALUE, Hash>::ConcurrentHashMap(int shards, const Hash& hasher)
+        : hash{hasher}, shard_bits{0}, table{nullptr}
+{
+    if (shards <= 0)
+        throw std::invalid_argument{"ConcurrentHashMap needs at least one shard"};
+
+    while ((1 << shard_bits) < shards)
+        ++shard_bits;
+    table.reset(new Shard[1 << shard_bits]);
+    for (int i = 0; i < (1 << shard_bits); ++i)
+        table[i].map = HashMap<KEY, VALUE, Hash>{hasher};
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int ConcurrentHashMap<KEY, VALUE, Hash>::shards() const
+{
+    return 1 << shard_bits;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int ConcurrentHashMap<KEY, VALUE, Hash>::size() const
+{
+    int result = 0;
+    for (int i = 0; i < shards(); ++i)
+    {
+        ReadLock guard{table[i].lock};
+        result += table[i].map.size();
+    }
+    return result;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::empty() const
+{
+    for (int i = 0; i < shards(); ++i)
+    {
+        ReadLock guard{table[i].lock};
+        if (!table[i].map.empty())
+            return false;
+    }
+    return true;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::contains(const KEY& key) const
+{
+    Shard& shard = shard_of(key);
+    ReadLock guard{shard.lock};
+    return shard.map.contains(key);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+VALUE ConcurrentHashMap<KEY, VALUE, Hash>::get(const KEY& key) const
+{
+    Shard& shard = shard_of(key);
+    ReadLock guard{shard.lock};
+    auto position = shard.map.find(key);
+    if (position == shard.map.end())
+        throw std::invalid_argument{"key not in map"};
+
+    return position.value();
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::find(const KEY& key, VALUE& value) const
+{
+    Shard& shard = shard_of(key);
+    ReadLock guard{shard.lock};
+    auto position = shard.map.find(key);
+    if (position == shard.map.end())
+        return false;
+
+    value = position.value();
+    return true;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename Visitor>
+void ConcurrentHashMap<KEY, VALUE, Hash>::for_each(Visitor visit) const
+{
+    for (int i = 0; i < shards(); ++i)
+    {
+        ReadLock guard{table[i].lock};
+        for (auto position = table[i].map.begin(); position != table[i].map.end(); ++position)
+            visit(*position, const_cast<const VALUE&>(position.value()));
+    }
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename V>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::insert_or_assign(const KEY& key, V&& value)
+{
+    Shard& shard = shard_of(key);
+    WriteLock guard{shard.lock};
+    return shard.map.insert_or_assign(key, std::forward<V>(value)).second;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename... Args>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::try_emplace(const KEY& key, Args&&... args)
+{
+    Shard& shard = shard_of(key);
+    WriteLock guard{shard.lock};
+    return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename Function>
+VALUE ConcurrentHashMap<KEY, VALUE, Hash>::compute_if_absent(const KEY& key, Function compute)
+{
+    Shard& shard = shard_of(key);
+    {
+        // most calls find the key already there; those only need the lock shared
+        ReadLock guard{shard.lock};
+        auto position = shard.map.find(key);
+        if (position != shard.map.end())
+            return position.value();
+    }
+
+    WriteLock guard{shard.lock};
+    auto position = shard.map.find(key);
+    if (position != shard.map.end())
+        return position.value();
+
+    return shard.map.try_emplace(key, compute(key)).first.value();
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::erase(const KEY& key)
+{
+    Shard& shard = shard_of(key);
+    WriteLock guard{shard.lock};
+    if (!shard.map.contains(key))
+        return false;
+
+    shard.map.erase(key);
+    return true;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void ConcurrentHashMap<KEY, VALUE, Hash>::clear()
+{
+    for (int i = 0; i < shards(); ++i)
+    {
+        WriteLock guard{table[i].lock};
+        table[i].map.clear();
+    }
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void ConcurrentHashMap<KEY, VALUE, Hash>::reserve(int n)
+{
+    int per_shard = (n + shards() - 1) / shards();
+    for (int i = 0; i < shards(); ++i)
+    {
+        WriteLock guard{table[i].lock};
+        table[i].map.reserve(per_shard);
+    }
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int ConcurrentHashMap<KEY, VALUE, Hash>::default_shards()
+{
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(_CONCURRENT_HASH_MAP_MINIMUM_SHARDS, threads * _CONCURRENT_HASH_MAP_SHARDS_PER_THREAD);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+typename ConcurrentHashMap<KEY, VALUE, Hash>::Shard& ConcurrentHashMap<KEY, VALUE, Hash>::shard_of(const KEY& key) const
+{
+    if (shard_bits == 0)
+        return table[0];
+
+    // Fibonacci hashing spreads the key over the high bits, which the shard's own bins (masked from the low bits) do not use
+    std::uint64_t mixed = static_cast<std::uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ull;
+    return table[static_cast<std::size_t>(mixed >> (64 - shard_bits))];
+}
+
+// iterator implementation
+template <typename KEY, typename VALUE, typename Hash>
+auto ConcurrentHashMap<KEY, VALUE, Hash>::begin() const -> ConcurrentHashMap<KEY, VALUE, Hash>::iterator
+{
+    iterator first{this, -1};
+    first.advance_shard();
+    return first;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto ConcurrentHashMap<KEY, VALUE, Hash>::end() const -> ConcurrentHashMap<KEY, VALUE, Hash>::iterator
+{
+    return iterator{this, shards()};
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+ConcurrentHashMap<KEY, VALUE, Hash>::iterator::iterator(const ConcurrentHashMap<KEY, VALUE, Hash>* it, int shard)
+        : ref{it}, current_shard{shard}, current{0}, snapshot{nullptr}
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+ConcurrentHashMap<KEY, VALUE, Hash>::iterator::iterator() : iterator(nullptr, 0)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void ConcurrentHashMap<KEY, VALUE, Hash>::iterator::advance_shard()
+{
+    current = 0;
+    snapshot = nullptr;
+    while (++current_shard < ref->shards())
+    {
+        const Shard& shard = ref->table[current_shard];
+        ReadLock guard{shard.lock};
+        if (!shard.map.empty())
+        {
+            snapshot = std::make_shared<const std::vector<Entry>>(shard.map.items());
+            return;
+        }
+    }
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto ConcurrentHashMap<KEY, VALUE, Hash>::iterator::operator++() -> ConcurrentHashMap<KEY, VALUE, Hash>::iterator&
+{
+    if (snapshot == nullptr)
+        throw std::out_of_range{"iterator out of range"};
+
+    if (++current == snapshot->size())
+        advance_shard();
+    return *this;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto ConcurrentHashMap<KEY, VALUE, Hash>::iterator::operator++(int) -> ConcurrentHashMap<KEY, VALUE, Hash>::iterator
+{
+    iterator copy{*this};
+    ++(*this);
+    return copy;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::iterator::operator==(const iterator& right) const
+{
+    return ref == right.ref && current_shard == right.current_shard && current == right.current;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool ConcurrentHashMap<KEY, VALUE, Hash>::iterator::operator!=(const iterator& right) const
+{
+    return !operator==(right);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto ConcurrentHashMap<KEY, VALUE, Hash>::iterator::operator*() const -> const Entry&
+{
+    if (snapshot == nullptr)
+        throw std::out_of_range{"iterator out of range"};
+
+    return (*snapshot)[current];
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto ConcurrentHashMap<KEY, VALUE, Hash>::iterator::operator->() const -> const Entry*
+{
+    return &operator*();
+}
+
+
+#endif // DATA_STRUCTURES_CONCURRENT_HASH_MAP_HPP
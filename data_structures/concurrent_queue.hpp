@@ -0,0 +1,570 @@
+#ifndef DATA_STRUCTURES_CONCURRENT_QUEUE_HPP
+#define DATA_STRUCTURES_CONCURRENT_QUEUE_HPP
+
+// This templated header file defines two bounded queues that may be shared between threads without a lock,
+// with the same interface as a bounded Queue (see queue.hpp), less front/back and iteration:
+//
+//   SPSCQueue - for exactly one producer thread and one consumer thread.
+//               Wait-free: every operation finishes in a bounded number of steps, whatever the other thread does.
+//               Each side caches the other's position, and only rereads it when the cached value says the ring is
+//               full (producer) or empty (consumer), so the two mostly touch only their own cache lines.
+//   MPMCQueue - for any number of producer and consumer threads.
+//               Lock-free, after Dmitry Vyukov's bounded MPMC queue: every slot carries a sequence number
+//               saying whose turn it is (the producer of lap n, or the consumer of lap n), so a thread claims
+//               a slot with one compare-and-swap on the shared position and hands it over with one store.
+//               Its capacity is rounded up to a power of 2, except that a capacity of 1 is kept as 1:
+//               a one-slot ring cannot tell a full slot from a free one, so it gets two slots, and a limit.
+//
+// The positions each side writes are kept on cache lines of their own, so that producers and consumers
+// do not invalidate each other's lines (false sharing) on every operation.
+//
+// size(), empty() and full() are only snapshots when other threads are pushing or popping.
+// push and emplace throw std::overflow_error when the queue is full (like a bounded Queue's);
+// concurrent callers will usually want try_push, and retry or back off themselves.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace
+{
+    const int _CACHE_LINE_SIZE = 64;
+
+    /* A value padded to a cache line of its own, whatever the alignment of the object holding it */
+    template <typename T>
+    struct CachePadded
+    {
+        char before[_CACHE_LINE_SIZE];
+        T value;
+        char after[_CACHE_LINE_SIZE > sizeof(T) ? _CACHE_LINE_SIZE - sizeof(T) : 1];
+    };
+
+    inline std::size_t ring_slots_for(std::size_t n)
+    {
+        std::size_t result = 1;
+        while (result < n)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+}
+
+
+template <typename T>
+class SPSCQueue
+{
+public:
+    /* Throws std::invalid_argument if capacity is not positive */
+    explicit SPSCQueue(int capacity);
+    SPSCQueue(const SPSCQueue<T>& other) = delete;
+    SPSCQueue<T>& operator=(const SPSCQueue<T>& other) = delete;
+    ~SPSCQueue();
+
+    int size() const;
+    bool empty() const;
+    bool full() const;
+    bool bounded() const;
+    int capacity() const;
+
+    // Producer thread only
+    void push(const T& item);
+    void push(T&& item);
+
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    bool try_push(const T& item);
+    bool try_push(T&& item);
+
+    /* Enqueues as many items of [first, last) as fit, publishing them to the consumer all at once;
+     * returns how many were enqueued.
+     */
+    template <typename InputIterator>
+    int push_range(InputIterator first, InputIterator last);
+
+    // Consumer thread only
+    bool try_pop(T& item);
+
+    /* Moves up to n items into out and dequeues them, releasing their slots to the producer all at once;
+     * returns how many were dequeued.
+     */
+    template <typename OutputIterator>
+    int pop_n(int n, OutputIterator out);
+
+
+private:
+    T* slots;
+    std::size_t mask;       // the number of slots, a power of 2 no smaller than limit, less 1
+    std::size_t limit;
+
+    // head and tail count every item ever popped and pushed; the slot of position p is p & mask
+    CachePadded<std::atomic<std::size_t>> head;    // written by the consumer
+    CachePadded<std::atomic<std::size_t>> tail;    // written by the producer
+    CachePadded<std::size_t> cached_head;          // the producer's last reading of head
+    CachePadded<std::size_t> cached_tail;          // the consumer's last reading of tail
+
+    /* Returns the number of free slots the producer may fill from position,
+     * rereading head only if the cached value shows fewer than wanted
+     */
+    std::size_t free_slots(std::size_t position, std::size_t wanted);
+
+    /* Returns the number of items the consumer may take from position,
+     * rereading tail only if the cached value shows fewer than wanted
+     */
+    std::size_t ready_items(std::size_t position, std::size_t wanted);
+};
+
+
+template <typename T>
+class MPMCQueue
+{
+public:
+    /* Rounds capacity (if above 1) up to a power of 2; throws std::invalid_argument if capacity is not positive */
+    explicit MPMCQueue(int capacity);
+    MPMCQueue(const MPMCQueue<T>& other) = delete;
+    MPMCQueue<T>& operator=(const MPMCQueue<T>& other) = delete;
+    ~MPMCQueue();
+
+    int size() const;
+    bool empty() const;
+    bool full() const;
+    bool bounded() const;
+    int capacity() const;
+
+    void push(const T& item);
+    void push(T&& item);
+
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    bool try_push(const T& item);
+    bool try_push(T&& item);
+
+    /* Constructs T{args...} in place and enqueues it, returning true, or returns false if the queue is full */
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+
+    /* Enqueues items of [first, last) until the queue is full; returns how many were enqueued */
+    template <typename InputIterator>
+    int push_range(InputIterator first, InputIterator last);
+
+    bool try_pop(T& item);
+
+    /* Moves up to n items into out and dequeues them, until the queue is empty; returns how many were dequeued.
+     * Items other consumers dequeue meanwhile may interleave with them.
+     */
+    template <typename OutputIterator>
+    int pop_n(int n, OutputIterator out);
+
+
+private:
+    struct Slot
+    {
+        // position if the slot is free for the producer of that position,
+        // position + 1 if it holds the item of that position, ready for its consumer
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    Slot* slots;
+    std::size_t mask;       // the number of slots, a power of 2 no smaller than 2, less 1
+    std::size_t limit;      // the capacity: mask + 1, unless that is more than was asked for
+
+    CachePadded<std::atomic<std::size_t>> enqueue_position;    // contended by the producers
+    CachePadded<std::atomic<std::size_t>> dequeue_position;    // contended by the consumers
+};
+
+
+
+template <typename T>
+SPSCQueue<T>::SPSCQueue(int capacity)
+    : slots{nullptr}, mask{0}, limit{0}
+{
+    if (capacity <= 0)
+    {
+        throw std::invalid_argument{"SPSCQueue - capacity must be positive"};
+    }
+    limit = capacity;
+    mask = ring_slots_for(limit) - 1;
+    slots = std::allocator<T>{}.allocate(mask + 1);
+    head.value.store(0, std::memory_order_relaxed);
+    tail.value.store(0, std::memory_order_relaxed);
+    cached_head.value = 0;
+    cached_tail.value = 0;
+}
+
+template <typename T>
+SPSCQueue<T>::~SPSCQueue()
+{
+    for (std::size_t p = head.value.load(std::memory_order_relaxed), end = tail.value.load(std::memory_order_relaxed); p != end; ++p)
+    {
+        slots[p & mask].~T();
+    }
+    std::allocator<T>{}.deallocate(slots, mask + 1);
+}
+
+template <typename T>
+int SPSCQueue<T>::size() const
+{
+    // head first, so that the difference never underflows
+    std::size_t popped = head.value.load(std::memory_order_acquire);
+    return static_cast<int>(tail.value.load(std::memory_order_acquire) - popped);
+}
+
+template <typename T>
+bool SPSCQueue<T>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+bool SPSCQueue<T>::full() const
+{
+    return size() == capacity();
+}
+
+template <typename T>
+bool SPSCQueue<T>::bounded() const
+{
+    return true;
+}
+
+template <typename T>
+int SPSCQueue<T>::capacity() const
+{
+    return static_cast<int>(limit);
+}
+
+template <typename T>
+void SPSCQueue<T>::push(const T& item)
+{
+    emplace(item);
+}
+
+template <typename T>
+void SPSCQueue<T>::push(T&& item)
+{
+    emplace(std::move(item));
+}
+
+template <typename T>
+template <typename... Args>
+void SPSCQueue<T>::emplace(Args&&... args)
+{
+    std::size_t position = tail.value.load(std::memory_order_relaxed);
+    if (free_slots(position, 1) == 0)
+    {
+        throw std::overflow_error{"SPSCQueue::push - full"};
+    }
+    new (slots + (position & mask)) T(std::forward<Args>(args)...);
+    tail.value.store(position + 1, std::memory_order_release);
+}
+
+template <typename T>
+bool SPSCQueue<T>::try_push(const T& item)
+{
+    std::size_t position = tail.value.load(std::memory_order_relaxed);
+    if (free_slots(position, 1) == 0)
+    {
+        return false;
+    }
+    new (slots + (position & mask)) T(item);
+    tail.value.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool SPSCQueue<T>::try_push(T&& item)
+{
+    std::size_t position = tail.value.load(std::memory_order_relaxed);
+    if (free_slots(position, 1) == 0)
+    {
+        return false;
+    }
+    new (slots + (position & mask)) T(std::move(item));
+    tail.value.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+template <typename InputIterator>
+int SPSCQueue<T>::push_range(InputIterator first, InputIterator last)
+{
+    std::size_t start = tail.value.load(std::memory_order_relaxed);
+    std::size_t position = start;
+    for (std::size_t available = free_slots(position, limit); first != last && available > 0; ++first, --available)
+    {
+        new (slots + (position & mask)) T(*first);
+        ++position;
+    }
+    tail.value.store(position, std::memory_order_release);
+    return static_cast<int>(position - start);
+}
+
+template <typename T>
+bool SPSCQueue<T>::try_pop(T& item)
+{
+    std::size_t position = head.value.load(std::memory_order_relaxed);
+    if (ready_items(position, 1) == 0)
+    {
+        return false;
+    }
+    T* slot = slots + (position & mask);
+    item = std::move(*slot);
+    slot->~T();
+    head.value.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+template <typename OutputIterator>
+int SPSCQueue<T>::pop_n(int n, OutputIterator out)
+{
+    std::size_t start = head.value.load(std::memory_order_relaxed);
+    std::size_t position = start;
+    for (std::size_t ready = n > 0 ? ready_items(position, n) : 0; ready > 0 && position - start < static_cast<std::size_t>(n); --ready)
+    {
+        T* slot = slots + (position & mask);
+        *out = std::move(*slot);
+        ++out;
+        slot->~T();
+        ++position;
+    }
+    head.value.store(position, std::memory_order_release);
+    return static_cast<int>(position - start);
+}
+
+template <typename T>
+std::size_t SPSCQueue<T>::free_slots(std::size_t position, std::size_t wanted)
+{
+    std::size_t available = limit - (position - cached_head.value);
+    if (available < wanted)
+    {
+        cached_head.value = head.value.load(std::memory_order_acquire);
+        available = limit - (position - cached_head.value);
+    }
+    return available;
+}
+
+template <typename T>
+std::size_t SPSCQueue<T>::ready_items(std::size_t position, std::size_t wanted)
+{
+    std::size_t ready = cached_tail.value - position;
+    if (ready < wanted)
+    {
+        cached_tail.value = tail.value.load(std::memory_order_acquire);
+        ready = cached_tail.value - position;
+    }
+    return ready;
+}
+
+
+
+template <typename T>
+MPMCQueue<T>::MPMCQueue(int capacity)
+    : slots{nullptr}, mask{0}, limit{0}
+{
+    if (capacity <= 0)
+    {
+        throw std::invalid_argument{"MPMCQueue - capacity must be positive"};
+    }
+    // in a one-slot ring, a full slot's sequence is the next producer's position, which reads as free
+    mask = ring_slots_for(std::max<std::size_t>(capacity, 2)) - 1;
+    limit = std::min<std::size_t>(capacity, mask + 1);
+    slots = new Slot[mask + 1];
+    for (std::size_t i = 0; i <= mask; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_position.value.store(0, std::memory_order_relaxed);
+    dequeue_position.value.store(0, std::memory_order_relaxed);
+}
+
+template <typename T>
+MPMCQueue<T>::~MPMCQueue()
+{
+    for (std::size_t p = dequeue_position.value.load(std::memory_order_relaxed), end = enqueue_position.value.load(std::memory_order_relaxed); p != end; ++p)
+    {
+        reinterpret_cast<T*>(&slots[p & mask].storage)->~T();
+    }
+    delete[] slots;
+}
+
+template <typename T>
+int MPMCQueue<T>::size() const
+{
+    std::size_t popped = dequeue_position.value.load(std::memory_order_acquire);
+    std::size_t pushed = enqueue_position.value.load(std::memory_order_acquire);
+    return pushed > popped ? static_cast<int>(pushed - popped) : 0;
+}
+
+template <typename T>
+bool MPMCQueue<T>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+bool MPMCQueue<T>::full() const
+{
+    return size() >= capacity();
+}
+
+template <typename T>
+bool MPMCQueue<T>::bounded() const
+{
+    return true;
+}
+
+template <typename T>
+int MPMCQueue<T>::capacity() const
+{
+    return static_cast<int>(limit);
+}
+
+template <typename T>
+void MPMCQueue<T>::push(const T& item)
+{
+    emplace(item);
+}
+
+template <typename T>
+void MPMCQueue<T>::push(T&& item)
+{
+    emplace(std::move(item));
+}
+
+template <typename T>
+template <typename... Args>
+void MPMCQueue<T>::emplace(Args&&... args)
+{
+    if (!try_emplace(std::forward<Args>(args)...))
+    {
+        throw std::overflow_error{"MPMCQueue::push - full"};
+    }
+}
+
+template <typename T>
+bool MPMCQueue<T>::try_push(const T& item)
+{
+    return try_emplace(item);
+}
+
+template <typename T>
+bool MPMCQueue<T>::try_push(T&& item)
+{
+    return try_emplace(std::move(item));
+}
+
+template <typename T>
+template <typename... Args>
+bool MPMCQueue<T>::try_emplace(Args&&... args)
+{
+    std::size_t position = enqueue_position.value.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+        slot = &slots[position & mask];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::intptr_t lag = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (lag == 0 && limit <= mask && position - dequeue_position.value.load(std::memory_order_acquire) >= limit)
+        {
+            // the ring has room, but the queue is at its limit (the consumers' position only grows,
+            // so a stale read of it can only make the queue look fuller than it is)
+            return false;
+        }
+        else if (lag == 0)
+        {
+            // the slot is free for this position; claim the position (on failure, position is reloaded)
+            if (enqueue_position.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            // the slot still holds the item of the previous lap
+            return false;
+        }
+        else
+        {
+            // another producer claimed this position
+            position = enqueue_position.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&slot->storage) T(std::forward<Args>(args)...);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+template <typename InputIterator>
+int MPMCQueue<T>::push_range(InputIterator first, InputIterator last)
+{
+    int pushed = 0;
+    for (; first != last && try_emplace(*first); ++first)
+    {
+        ++pushed;
+    }
+    return pushed;
+}
+
+template <typename T>
+bool MPMCQueue<T>::try_pop(T& item)
+{
+    std::size_t position = dequeue_position.value.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+        slot = &slots[position & mask];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::intptr_t lag = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+        if (lag == 0)
+        {
+            if (dequeue_position.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            // the item of this position has not been pushed yet
+            return false;
+        }
+        else
+        {
+            position = dequeue_position.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    T* stored = reinterpret_cast<T*>(&slot->storage);
+    item = std::move(*stored);
+    stored->~T();
+    slot->sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+template <typename OutputIterator>
+int MPMCQueue<T>::pop_n(int n, OutputIterator out)
+{
+    int popped = 0;
+    T item;
+    for (; popped < n && try_pop(item); ++popped)
+    {
+        *out = std::move(item);
+        ++out;
+    }
+    return popped;
+}
+
+#endif // DATA_STRUCTURES_CONCURRENT_QUEUE_HPP
@@ -0,0 +1,888 @@
+// A map is a data type that associates a collection of key-value pairs.
+// FlatHashMap implements the same interface as HashMap, but stores its entries
+// in one contiguous array of slots using open addressing with Robin Hood probing,
+// instead of allocating a LinkedList node per entry.
+//
+// Every slot has a matching probe distance (0 for an empty slot, otherwise 1 + the number of
+// slots between the entry and its home bin), kept in a separate small array so that probing
+// stays within a couple of cache lines. Insertion displaces entries that are closer to their home
+// bin than the incoming one ("robbing the rich"), which keeps probe sequences short and lets
+// lookups stop as soon as they pass a slot whose entry is closer to home than the key would be.
+// Erasure shifts the following entries back by one slot, so no tombstones are ever left behind.
+//
+// The number of bins is always a power of two, and the hasher's result is scrambled with
+// Fibonacci hashing before being reduced to a bin, so even low-quality hashers (e.g. identity on ints)
+// spread out across the table.
+#ifndef DATA_STRUCTURES_FLAT_HASH_MAP_HPP
+#define DATA_STRUCTURES_FLAT_HASH_MAP_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include "hasher.hpp"
+
+
+namespace
+{
+    double _FLAT_HASH_MAP_LOAD_FACTOR_THRESHOLD = 0.875;
+    int _FLAT_HASH_MAP_INITIAL_SIZE = 8;
+}
+
+
+
+template <typename KEY, typename VALUE, typename Hash = std::hash<KEY>>
+class FlatHashMap
+{
+private:
+    typedef std::pair<KEY, VALUE> Entry;
+    typedef typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type Slot;
+    typedef std::uint16_t Distance;
+
+public:
+    /* the_load_factor must be in the range (0, 1);
+     * an open-addressed table always needs at least one empty slot to terminate its probes.
+     */
+    FlatHashMap();
+    FlatHashMap(const Hash& hasher, double the_load_factor);
+    explicit FlatHashMap(const Hash& hasher);
+
+    /* Adapts a run-time hash function; hashing then goes through a std::function call */
+    FlatHashMap(std::function<int(const KEY&)> hasher, double the_load_factor);
+    explicit FlatHashMap(std::function<int(const KEY&)> hasher);
+    FlatHashMap(const FlatHashMap& right);
+
+    /* Takes right's slots without moving any entries; right is left empty */
+    FlatHashMap(FlatHashMap&& right);
+    ~FlatHashMap();
+
+
+    // Operators
+    FlatHashMap<KEY, VALUE, Hash>& operator=(const FlatHashMap<KEY, VALUE, Hash>& right);
+    FlatHashMap<KEY, VALUE, Hash>& operator=(FlatHashMap<KEY, VALUE, Hash>&& right);
+    const VALUE& operator[](const KEY& key) const;
+    VALUE& operator[](const KEY& key);
+    VALUE& operator[](KEY&& key);
+
+    /* Two flat_hash_maps are == if they have the same keys with the same values associated with those keys.
+     * Two flat_hash_maps do not have to have the same hash function to be ==.
+     */
+    bool operator==(const FlatHashMap<KEY, VALUE, Hash>& right) const;
+    bool operator!=(const FlatHashMap<KEY, VALUE, Hash>& right) const;
+
+    template <typename K, typename V, typename H>
+    friend std::ostream& operator<<(std::ostream& os, const FlatHashMap<K, V, H>& hm);
+
+    // Member Functions
+    int size() const;
+    bool empty() const;
+    bool contains(const KEY& key) const;
+    std::string str() const;
+
+    /* Returns a std::vector of all keys/values in the map */
+    std::vector<KEY> keys() const;
+    std::vector<VALUE> values() const;
+    std::vector<Entry> items() const;
+
+    // Modifying Member Functions
+    /* Inserts (key, value) into the map.
+     * If the key is already in the map,
+     * the existing value associated with it is replaced with this value.
+     */
+    void push_back(const KEY& key, const VALUE& value);
+    void push_back(KEY&& key, VALUE&& value);
+    void push_back(const Entry& pair);
+    void push_back(Entry&& pair);
+
+    /* Removes the {key: value} association from the map */
+    void erase(const KEY& key);
+
+    /* Empties the map */
+    void clear();
+
+    /* Grows the table so that n entries fit without triggering a rehash */
+    void reserve(int n);
+
+    /* Redistributes the entries over at least n slots (rounded up to a power of two),
+     * or over as many slots as size() needs under the load factor, whichever is larger.
+     */
+    void rehash(int n);
+
+
+    class iterator;
+    auto begin() const -> iterator;
+    auto end() const -> iterator;
+
+    /* Returns an iterator to key, or end() if key is not in the map.
+     * Hashes key once and probes once.
+     */
+    auto find(const KEY& key) const -> iterator;
+
+    /* Inserts {key: VALUE{args...}} if key is not already in the map; otherwise leaves the map unchanged.
+     * Returns an iterator to key, and true if an insertion took place.
+     * Hashes key once; the probe that fails to find key also finds the slot key is placed in.
+     */
+    template <typename... Args>
+    auto try_emplace(const KEY& key, Args&&... args) -> std::pair<iterator, bool>;
+
+    template <typename... Args>
+    auto try_emplace(KEY&& key, Args&&... args) -> std::pair<iterator, bool>;
+
+    /* Inserts {key: value}, or assigns value to key if key is already in the map.
+     * Returns an iterator to key, and true if an insertion took place.
+     */
+    template <typename V>
+    auto insert_or_assign(const KEY& key, V&& value) -> std::pair<iterator, bool>;
+
+    template <typename V>
+    auto insert_or_assign(KEY&& key, V&& value) -> std::pair<iterator, bool>;
+
+    /* Constructs an entry from args (as std::pair<KEY, VALUE>{args...}),
+     * and moves it into the map if its key is not already in the map; otherwise the entry is discarded.
+     * Returns an iterator to the entry's key, and true if an insertion took place.
+     */
+    template <typename... Args>
+    auto emplace(Args&&... args) -> std::pair<iterator, bool>;
+
+    /* Iteration through a map produces its keys, in slot order.
+     * Values can be accessed through iteration by using operator[].
+     * If both keys and values are instantly needed, iterate through flat_hash_map::items().
+     */
+    class iterator
+    {
+    public:
+        iterator();
+
+        auto operator++() -> iterator&;
+        auto operator++(int) -> iterator;
+        bool operator==(const iterator& right) const;
+        bool operator!=(const iterator& right) const;
+        KEY& operator*() const;
+        KEY* operator->() const;
+
+        /* Returns the value associated with the key under the cursor */
+        VALUE& value() const;
+
+        friend class FlatHashMap<KEY, VALUE, Hash>;
+
+    private:
+        iterator(FlatHashMap<KEY, VALUE, Hash>* it, int slot);
+
+        bool done() const;
+        void advance_slot();
+
+        FlatHashMap<KEY, VALUE, Hash>* ref;
+        int current_slot_index;
+    };
+
+
+protected:
+    Hasher<KEY, Hash> hash;
+    int bins;
+    Distance* distances;    // distances[i] == 0 iff slots[i] is empty
+    Slot* slots;
+
+
+private:
+    double lft;
+    unsigned int length;
+    int shift;              // 64 - log2(bins); used to take the top bits of the scrambled hash
+
+    void _allocate(int number_of_bins);
+    void _deallocate();
+    void _rehash();
+    void _rehash(int new_bins);
+    double load_factor() const;
+    int get_bin(const KEY& key) const;
+    int next_slot(int i) const;
+    Entry& entry_at(int i) const;
+
+    /* Returns the slot index holding key, or -1 if key is not in the map */
+    int _locate(const KEY& key) const;
+
+    /* Probes for key once.
+     * Returns the slot index holding key and true, or, if key is not in the map,
+     * the slot index (with its probe distance) where key would be inserted and false.
+     */
+    std::pair<int, bool> _probe(const KEY& key, Distance& distance) const;
+
+    /* Places entry (whose key must not already be in the map) using Robin Hood probing.
+     * Does not check the load factor.
+     * Returns the slot index that entry ended up in.
+     */
+    int _insert(Entry&& entry);
+
+    /* Places entry at slot i, which is at the given probe distance from entry's home bin.
+     * Any resident of slot i is carried onward with Robin Hood probing.
+     */
+    void _insert_at(int i, Distance distance, Entry&& entry);
+
+    /* Shared body of try_emplace and insert_or_assign for a key that is not in the map */
+    int _place(int i, Distance distance, Entry&& entry);
+
+    /* Shared bodies of the const KEY& and KEY&& overloads */
+    template <typename K, typename... Args>
+    auto _try_emplace(K&& key, Args&&... args) -> std::pair<iterator, bool>;
+
+    template <typename K, typename V>
+    auto _insert_or_assign(K&& key, V&& value) -> std::pair<iterator, bool>;
+};
+
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap() : FlatHashMap(Hash{}, _FLAT_HASH_MAP_LOAD_FACTOR_THRESHOLD)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap(const Hash& hasher, double the_load_factor)
+        : hash{hasher}, bins{0}, distances{nullptr}, slots{nullptr}, lft{the_load_factor}, length{0}, shift{0}
+{
+    if (!(lft > 0 && lft < 1))
+        throw std::invalid_argument{"flat_hash_map -- load factor must be in the range (0, 1)"};
+
+    _allocate(_FLAT_HASH_MAP_INITIAL_SIZE);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap(const Hash& hasher) : FlatHashMap(hasher, _FLAT_HASH_MAP_LOAD_FACTOR_THRESHOLD)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap(std::function<int(const KEY&)> hasher, double the_load_factor)
+        : hash{std::move(hasher)}, bins{0}, distances{nullptr}, slots{nullptr}, lft{the_load_factor}, length{0}, shift{0}
+{
+    if (!(lft > 0 && lft < 1))
+        throw std::invalid_argument{"flat_hash_map -- load factor must be in the range (0, 1)"};
+
+    _allocate(_FLAT_HASH_MAP_INITIAL_SIZE);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap(std::function<int(const KEY&)> hasher) : FlatHashMap(std::move(hasher), _FLAT_HASH_MAP_LOAD_FACTOR_THRESHOLD)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap(const FlatHashMap<KEY, VALUE, Hash>& right)
+        : hash{right.hash}, bins{0}, distances{nullptr}, slots{nullptr}, lft{right.lft}, length{0}, shift{0}
+{
+    _allocate(right.bins);
+    for (int i = 0; i < bins; ++i)
+    {
+        if (right.distances[i] != 0)
+        {
+            new (&slots[i]) Entry{right.entry_at(i)};
+            distances[i] = right.distances[i];
+        }
+    }
+    length = right.length;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::FlatHashMap(FlatHashMap<KEY, VALUE, Hash>&& right)
+        : hash{right.hash}, bins{right.bins}, distances{right.distances}, slots{right.slots},
+          lft{right.lft}, length{right.length}, shift{right.shift}
+{
+    right._allocate(_FLAT_HASH_MAP_INITIAL_SIZE);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::~FlatHashMap()
+{
+    _deallocate();
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>& FlatHashMap<KEY, VALUE, Hash>::operator=(const FlatHashMap<KEY, VALUE, Hash>& right)
+{
+    if (this != &right)
+    {
+        _deallocate();
+        hash = right.hash;
+        lft = right.lft;
+        _allocate(right.bins);
+
+        for (int i = 0; i < bins; ++i)
+        {
+            if (right.distances[i] != 0)
+            {
+                new (&slots[i]) Entry{right.entry_at(i)};
+                distances[i] = right.distances[i];
+            }
+        }
+        length = right.length;
+    }
+    return *this;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>& FlatHashMap<KEY, VALUE, Hash>::operator=(FlatHashMap<KEY, VALUE, Hash>&& right)
+{
+    if (this != &right)
+    {
+        std::swap(hash, right.hash);
+        std::swap(bins, right.bins);
+        std::swap(distances, right.distances);
+        std::swap(slots, right.slots);
+        std::swap(lft, right.lft);
+        std::swap(length, right.length);
+        std::swap(shift, right.shift);
+    }
+    return *this;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+const VALUE& FlatHashMap<KEY, VALUE, Hash>::operator[](const KEY& key) const
+{
+    int i = _locate(key);
+    if (i == -1)
+        throw std::invalid_argument{"key not in map"};
+
+    return entry_at(i).second;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+VALUE& FlatHashMap<KEY, VALUE, Hash>::operator[](const KEY& key)
+{
+    return try_emplace(key).first.value();
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+VALUE& FlatHashMap<KEY, VALUE, Hash>::operator[](KEY&& key)
+{
+    return try_emplace(std::move(key)).first.value();
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::operator==(const FlatHashMap<KEY, VALUE, Hash>& right) const
+{
+    if (this == &right)
+        return true;
+    if (size() != right.size())
+        return false;
+
+    for (int i = 0; i < right.bins; ++i)
+    {
+        if (right.distances[i] != 0)
+        {
+            const Entry& entry = right.entry_at(i);
+            int found = _locate(entry.first);
+            if (!(found != -1 && entry.second == entry_at(found).second))
+                return false;
+        }
+    }
+    return true;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::operator!=(const FlatHashMap<KEY, VALUE, Hash>& right) const
+{
+    return !operator==(right);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+std::ostream& operator<<(std::ostream& os, const FlatHashMap<KEY, VALUE, Hash>& hm)
+{
+    os << "flat_hash_map(";
+    unsigned int c = 0;
+    for (int i = 0; i < hm.bins; ++i)
+    {
+        if (hm.distances[i] != 0)
+        {
+            const auto& entry = hm.entry_at(i);
+            os << entry.first << ": " << entry.second << (c++ < hm.size() - 1 ? ", " : "");
+        }
+    }
+    os << ")";
+
+    return os;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int FlatHashMap<KEY, VALUE, Hash>::size() const
+{
+    return length;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::contains(const KEY& key) const
+{
+    return _locate(key) != -1;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+std::string FlatHashMap<KEY, VALUE, Hash>::str() const
+{
+    std::ostringstream result;
+    result << "flat_hash_map(" << std::endl;
+    for (int i = 0; i < bins; ++i)
+    {
+        result << "  " << i << ": ";
+        if (distances[i] != 0)
+            result << entry_at(i).first << ": " << entry_at(i).second << " (probe " << distances[i] - 1 << ")";
+        else
+            result << "-";
+        result << std::endl;
+    }
+
+    result << ")";
+    return result.str();
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+std::vector<KEY> FlatHashMap<KEY, VALUE, Hash>::keys() const
+{
+    std::vector<KEY> result;
+    result.reserve(length);
+    for (int i = 0; i < bins; ++i)
+    {
+        if (distances[i] != 0)
+            result.push_back(entry_at(i).first);
+    }
+    return result;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+std::vector<VALUE> FlatHashMap<KEY, VALUE, Hash>::values() const
+{
+    std::vector<VALUE> result;
+    result.reserve(length);
+    for (int i = 0; i < bins; ++i)
+    {
+        if (distances[i] != 0)
+            result.push_back(entry_at(i).second);
+    }
+    return result;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+std::vector<typename FlatHashMap<KEY, VALUE, Hash>::Entry> FlatHashMap<KEY, VALUE, Hash>::items() const
+{
+    std::vector<Entry> result;
+    result.reserve(length);
+    for (int i = 0; i < bins; ++i)
+    {
+        if (distances[i] != 0)
+            result.push_back(entry_at(i));
+    }
+    return result;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::push_back(const KEY& key, const VALUE& value)
+{
+    insert_or_assign(key, value);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::push_back(KEY&& key, VALUE&& value)
+{
+    insert_or_assign(std::move(key), std::move(value));
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::push_back(const typename FlatHashMap<KEY, VALUE, Hash>::Entry& pair)
+{
+    push_back(pair.first, pair.second);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::push_back(typename FlatHashMap<KEY, VALUE, Hash>::Entry&& pair)
+{
+    push_back(std::move(pair.first), std::move(pair.second));
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::erase(const KEY& key)
+{
+    int i = _locate(key);
+    if (i == -1)
+        throw std::invalid_argument{"key is not in map"};
+
+    // backward-shift deletion: pull every following displaced entry one slot closer to its home bin
+    entry_at(i).~Entry();
+    for (int next = next_slot(i); distances[next] > 1; i = next, next = next_slot(next))
+    {
+        new (&slots[i]) Entry{std::move(entry_at(next))};
+        entry_at(next).~Entry();
+        distances[i] = distances[next] - 1;
+    }
+    distances[i] = 0;
+    --length;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::clear()
+{
+    _deallocate();
+    _allocate(_FLAT_HASH_MAP_INITIAL_SIZE);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::reserve(int n)
+{
+    // strictly more than n / lft slots, since _place grows the table once the load factor reaches lft
+    rehash(static_cast<int>(n / lft) + 1);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::rehash(int n)
+{
+    int needed = std::max(n, static_cast<int>(size() / lft) + 1);
+    int new_bins = bins;
+    while (new_bins < needed)
+        new_bins *= 2;
+
+    if (new_bins != bins)
+        _rehash(new_bins);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+double FlatHashMap<KEY, VALUE, Hash>::load_factor() const
+{
+    return size() / static_cast<double>(bins);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::_allocate(int number_of_bins)
+{
+    bins = number_of_bins;
+    distances = new Distance[bins]();
+    slots = new Slot[bins];
+    length = 0;
+
+    shift = 64;
+    for (int b = bins; b > 1; b >>= 1)
+        --shift;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::_deallocate()
+{
+    for (int i = 0; i < bins; ++i)
+    {
+        if (distances[i] != 0)
+            entry_at(i).~Entry();
+    }
+    delete[] distances;
+    delete[] slots;
+    distances = nullptr;
+    slots = nullptr;
+    length = 0;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::_rehash()
+{
+    _rehash(bins * 2);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::_rehash(int new_bins)
+{
+    int old_bins = bins;
+    Distance* old_distances = distances;
+    Slot* old_slots = slots;
+    unsigned int old_length = length;
+
+    _allocate(new_bins);
+    for (int i = 0; i < old_bins; ++i)
+    {
+        if (old_distances[i] != 0)
+        {
+            Entry& entry = *reinterpret_cast<Entry*>(&old_slots[i]);
+            _insert(std::move(entry));
+            entry.~Entry();
+        }
+    }
+    length = old_length;
+
+    delete[] old_distances;
+    delete[] old_slots;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int FlatHashMap<KEY, VALUE, Hash>::get_bin(const KEY& key) const
+{
+    // Fibonacci hashing: multiply by 2^64 / golden ratio, keep the top log2(bins) bits
+    std::uint64_t scrambled = static_cast<std::uint64_t>(hash(key)) * 11400714819323198485ull;
+    return static_cast<int>(scrambled >> shift);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int FlatHashMap<KEY, VALUE, Hash>::next_slot(int i) const
+{
+    return (i + 1) & (bins - 1);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+typename FlatHashMap<KEY, VALUE, Hash>::Entry& FlatHashMap<KEY, VALUE, Hash>::entry_at(int i) const
+{
+    return *reinterpret_cast<Entry*>(&slots[i]);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int FlatHashMap<KEY, VALUE, Hash>::_locate(const KEY& key) const
+{
+    Distance distance;
+    std::pair<int, bool> probed = _probe(key, distance);
+    return probed.second ? probed.first : -1;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+std::pair<int, bool> FlatHashMap<KEY, VALUE, Hash>::_probe(const KEY& key, Distance& distance) const
+{
+    distance = 1;
+    int i = get_bin(key);
+    for (; distances[i] >= distance; i = next_slot(i), ++distance)
+    {
+        // an entry stored at exactly this probe distance shares key's home bin
+        if (distances[i] == distance && entry_at(i).first == key)
+            return std::make_pair(i, true);
+    }
+    return std::make_pair(i, false);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int FlatHashMap<KEY, VALUE, Hash>::_insert(Entry&& entry)
+{
+    Distance distance = 1;
+    int i = get_bin(entry.first);
+    for (; distances[i] >= distance; i = next_slot(i), ++distance)
+    { /* skip residents that are at least as far from home as entry would be */ }
+
+    _insert_at(i, distance, std::move(entry));
+    return i;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::_insert_at(int i, Distance distance, Entry&& entry)
+{
+    Entry carried{std::move(entry)};
+    for (; ; i = next_slot(i), ++distance)
+    {
+        if (distance == 0)
+            throw std::length_error{"flat_hash_map::_insert_at -- probe sequence too long; hasher is degenerate"};
+
+        if (distances[i] == 0)
+        {
+            new (&slots[i]) Entry{std::move(carried)};
+            distances[i] = distance;
+            return;
+        }
+        if (distances[i] < distance)
+        {
+            // the resident is closer to its home bin than the carried entry; take its slot and carry it onward
+            std::swap(carried, entry_at(i));
+            std::swap(distance, distances[i]);
+        }
+    }
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+int FlatHashMap<KEY, VALUE, Hash>::_place(int i, Distance distance, Entry&& entry)
+{
+    if (load_factor() >= lft)
+    {
+        // the probe position is stale once the table grows
+        _rehash();
+        i = _insert(std::move(entry));
+    }
+    else
+    {
+        _insert_at(i, distance, std::move(entry));
+    }
+    ++length;
+    return i;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto FlatHashMap<KEY, VALUE, Hash>::find(const KEY& key) const -> FlatHashMap<KEY, VALUE, Hash>::iterator
+{
+    int i = _locate(key);
+    return iterator{const_cast<FlatHashMap<KEY, VALUE, Hash>*>(this), i == -1 ? bins : i};
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename... Args>
+auto FlatHashMap<KEY, VALUE, Hash>::try_emplace(const KEY& key, Args&&... args) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    return _try_emplace(key, std::forward<Args>(args)...);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename... Args>
+auto FlatHashMap<KEY, VALUE, Hash>::try_emplace(KEY&& key, Args&&... args) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    return _try_emplace(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename V>
+auto FlatHashMap<KEY, VALUE, Hash>::insert_or_assign(const KEY& key, V&& value) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    return _insert_or_assign(key, std::forward<V>(value));
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename V>
+auto FlatHashMap<KEY, VALUE, Hash>::insert_or_assign(KEY&& key, V&& value) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    return _insert_or_assign(std::move(key), std::forward<V>(value));
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename... Args>
+auto FlatHashMap<KEY, VALUE, Hash>::emplace(Args&&... args) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    Entry entry(std::forward<Args>(args)...);
+    Distance distance;
+    std::pair<int, bool> probed = _probe(entry.first, distance);
+    if (probed.second)
+        return std::make_pair(iterator{this, probed.first}, false);
+
+    return std::make_pair(iterator{this, _place(probed.first, distance, std::move(entry))}, true);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename K, typename... Args>
+auto FlatHashMap<KEY, VALUE, Hash>::_try_emplace(K&& key, Args&&... args) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    Distance distance;
+    std::pair<int, bool> probed = _probe(key, distance);
+    if (probed.second)
+        return std::make_pair(iterator{this, probed.first}, false);
+
+    Entry entry{std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...)};
+    return std::make_pair(iterator{this, _place(probed.first, distance, std::move(entry))}, true);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+template <typename K, typename V>
+auto FlatHashMap<KEY, VALUE, Hash>::_insert_or_assign(K&& key, V&& value) -> std::pair<FlatHashMap<KEY, VALUE, Hash>::iterator, bool>
+{
+    Distance distance;
+    std::pair<int, bool> probed = _probe(key, distance);
+    if (probed.second)
+    {
+        entry_at(probed.first).second = std::forward<V>(value);
+        return std::make_pair(iterator{this, probed.first}, false);
+    }
+
+    return std::make_pair(iterator{this, _place(probed.first, distance, Entry{std::forward<K>(key), std::forward<V>(value)})}, true);
+}
+
+// iterator implementation
+template <typename KEY, typename VALUE, typename Hash>
+auto FlatHashMap<KEY, VALUE, Hash>::begin() const -> FlatHashMap<KEY, VALUE, Hash>::iterator
+{
+    iterator first{const_cast<FlatHashMap<KEY, VALUE, Hash>*>(this), -1};
+    first.advance_slot();
+    return first;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto FlatHashMap<KEY, VALUE, Hash>::end() const -> FlatHashMap<KEY, VALUE, Hash>::iterator
+{
+    return iterator{const_cast<FlatHashMap<KEY, VALUE, Hash>*>(this), bins};
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::iterator::iterator(FlatHashMap<KEY, VALUE, Hash>* it, int slot)
+        : ref{it}, current_slot_index{slot}
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+FlatHashMap<KEY, VALUE, Hash>::iterator::iterator() : iterator(nullptr, 0)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::iterator::done() const
+{
+    return ref == nullptr || current_slot_index >= ref->bins;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+void FlatHashMap<KEY, VALUE, Hash>::iterator::advance_slot()
+{
+    for (++current_slot_index; current_slot_index < ref->bins && ref->distances[current_slot_index] == 0; ++current_slot_index)
+    { /* advance current_slot_index to next occupied slot */ }
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto FlatHashMap<KEY, VALUE, Hash>::iterator::operator++() -> FlatHashMap<KEY, VALUE, Hash>::iterator&
+{
+    if (!done())
+        advance_slot();
+
+    return *this;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+auto FlatHashMap<KEY, VALUE, Hash>::iterator::operator++(int) -> FlatHashMap<KEY, VALUE, Hash>::iterator
+{
+    iterator to_return{*this};
+    operator++();
+
+    return to_return;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::iterator::operator==(const FlatHashMap<KEY, VALUE, Hash>::iterator& right) const
+{
+    return ref == right.ref && current_slot_index == right.current_slot_index;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+bool FlatHashMap<KEY, VALUE, Hash>::iterator::operator!=(const FlatHashMap<KEY, VALUE, Hash>::iterator& right) const
+{
+    return !operator==(right);
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+KEY& FlatHashMap<KEY, VALUE, Hash>::iterator::operator*() const
+{
+    if (done())
+        throw std::out_of_range{"flat_hash_map::iterator::operator* -- cursor past end"};
+
+    return ref->entry_at(current_slot_index).first;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+KEY* FlatHashMap<KEY, VALUE, Hash>::iterator::operator->() const
+{
+    if (done())
+        throw std::out_of_range{"flat_hash_map::iterator::operator-> -- cursor past end"};
+
+    return &ref->entry_at(current_slot_index).first;
+}
+
+template <typename KEY, typename VALUE, typename Hash>
+VALUE& FlatHashMap<KEY, VALUE, Hash>::iterator::value() const
+{
+    if (done())
+        throw std::out_of_range{"flat_hash_map::iterator::value -- cursor past end"};
+
+    return ref->entry_at(current_slot_index).second;
+}
+
+
+#endif // DATA_STRUCTURES_FLAT_HASH_MAP_HPP
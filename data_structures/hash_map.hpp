@@ -4,55 +4,90 @@
 //
 // The hash table is composed of a calculated number of LinkedList objects,
 // which adds more as necessary.
+// The number of LinkedLists is always a power of two, so a key's bin is selected by masking its hash.
+// Every LinkedList allocates its nodes from the map's Allocator (see pool_allocator.hpp).
+//
+// Growing the table normally relinks every entry in one call.
+// With incremental rehashing enabled, the old bins are kept alongside the new ones instead,
+// and every modifying operation migrates a few of them; a key whose old bin has not been
+// migrated yet is still found (and inserted) there, so lookups and iteration stay correct
+// throughout, and no single insertion pays for the whole resize.
+//
+// write_snapshot() saves the map bin by bin, and read_snapshot() reloads it into a table allocated
+// at its final size in one pass (see snapshot.hpp).
 #ifndef DATA_STRUCTURES_HASH_MAP_HPP
 #define DATA_STRUCTURES_HASH_MAP_HPP
 
+#include <algorithm>
+#include <climits>
 #include <iostream>
 #include <functional>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
-#include <cstdlib>
-#include "linked_list_old.hpp"
-#include "pair.hpp"
+#include <cmath>
+#include <cstddef>
+#include "hasher.hpp"
+#include "linked_list.hpp"
+#include "snapshot.hpp"
+#include "../tools/span_timer.hpp"
 
 
 namespace
 {
     double _HASH_MAP_LOAD_FACTOR_THRESHOLD = 1.0;
-    int _HASH_MAP_INITIAL_SIZE = 5;
+    int _HASH_MAP_INITIAL_SIZE = 8;     // must be a power of two
+    int _HASH_MAP_MIGRATION_STEP = 4;   // old bins migrated per modifying operation during an incremental rehash
 }
 
 
 
-template <typename KEY, typename VALUE>
+template <typename KEY, typename VALUE, typename Hash = std::hash<KEY>, typename Allocator = std::allocator<std::pair<KEY, VALUE>>>
 class HashMap
 {
 private:
-    typedef pair<KEY, VALUE> Entry;
+    typedef std::pair<KEY, VALUE> Entry;
+    typedef LinkedList<Entry, Allocator> Bucket;
 
 public:
+    HashMap();
+    HashMap(const Hash& hasher, double the_load_factor, const Allocator& the_allocator = Allocator{});
+    explicit HashMap(const Hash& hasher);
+
+    /* Every bucket's nodes are obtained from (a copy of) the_allocator */
+    explicit HashMap(const Allocator& the_allocator);
+
+    /* Adapts a run-time hash function; hashing then goes through a std::function call */
     HashMap(std::function<int(const KEY&)> hasher, double the_load_factor);
     explicit HashMap(std::function<int(const KEY&)> hasher);
     HashMap(const HashMap& right);
+
+    /* Takes right's table without copying any entries; right is left empty */
+    HashMap(HashMap&& right);
     ~HashMap();
 
 
     // Operators
-    HashMap<KEY, VALUE>& operator=(const HashMap<KEY, VALUE>& right);
+    /* Reuses this's table if it already has as many bins as right */
+    HashMap<KEY, VALUE, Hash, Allocator>& operator=(const HashMap<KEY, VALUE, Hash, Allocator>& right);
+    HashMap<KEY, VALUE, Hash, Allocator>& operator=(HashMap<KEY, VALUE, Hash, Allocator>&& right);
     const VALUE& operator[](const KEY& key) const;
     VALUE& operator[](const KEY& key);
+    VALUE& operator[](KEY&& key);
 
     /* Two hash_maps are == if they have the same keys with the same values associated with those keys.
      * Two hash_maps do not have to have the same hash function to be ==.
      */
-    bool operator==(const HashMap<KEY, VALUE>& right) const;
-    bool operator!=(const HashMap<KEY, VALUE>& right) const;
+    bool operator==(const HashMap<KEY, VALUE, Hash, Allocator>& right) const;
+    bool operator!=(const HashMap<KEY, VALUE, Hash, Allocator>& right) const;
 
-    template <typename K, typename V>
-    friend std::ostream& operator<<(std::ostream& os, const HashMap<K, V>& hm);
+    template <typename K, typename V, typename H, typename A>
+    friend std::ostream& operator<<(std::ostream& os, const HashMap<K, V, H, A>& hm);
 
     // Member Functions
     int size() const;
@@ -71,7 +106,9 @@ public:
      * the existing value associated with it is replaced with this value.
      */
     void push_back(const KEY& key, const VALUE& value);
+    void push_back(KEY&& key, VALUE&& value);
     void push_back(const Entry& pair);
+    void push_back(Entry&& pair);
 
     /* Removes the {key: value} association from the map */
     void erase(const KEY& key);
@@ -79,11 +116,71 @@ public:
     /* Empties the map */
     void clear();
 
+    /* Grows the table so that n entries fit without triggering a rehash */
+    void reserve(int n);
+
+    /* Redistributes the entries over at least n bins (rounded up to a power of two),
+     * or over as many bins as size() needs under the load factor, whichever is larger.
+     * Nodes are relinked into their new bins; no entries are copied.
+     * Completes any incremental rehash in progress.
+     */
+    void rehash(int n);
+
+    /* If enabled, growing the table (when the load factor reaches its threshold) is spread
+     * over subsequent modifying operations instead of being done by the insertion that triggers it.
+     * Disabling it completes any incremental rehash in progress.
+     */
+    void set_incremental_rehash(bool enabled);
+
+    /* Writes every entry to path, bin by bin, with its key's hash and the number of bins (see snapshot.hpp).
+     * Keys and values are encoded by SnapshotCodec; throws a SnapshotError if path cannot be written.
+     */
+    void write_snapshot(const std::string& path) const;
+
+    /* Replaces the contents with the snapshot at path. The bins are allocated once, at their final number,
+     * and every entry's node is appended to its bin by its stored hash, without lookups or rehashing.
+     * Throws a SnapshotError (leaving the map unchanged) if path is not a well-formed snapshot of this type of map,
+     * or was written with another hash function.
+     */
+    void read_snapshot(const std::string& path);
+
 
     class iterator;
     auto begin() const -> iterator;
     auto end() const -> iterator;
 
+    /* Returns an iterator to key, or end() if key is not in the map.
+     * Hashes key once and walks its bucket once.
+     */
+    auto find(const KEY& key) const -> iterator;
+
+    /* Inserts {key: VALUE{args...}} if key is not already in the map; otherwise leaves the map unchanged.
+     * Returns an iterator to key, and true if an insertion took place.
+     * Hashes key once and walks its bucket once.
+     */
+    template <typename... Args>
+    auto try_emplace(const KEY& key, Args&&... args) -> std::pair<iterator, bool>;
+
+    template <typename... Args>
+    auto try_emplace(KEY&& key, Args&&... args) -> std::pair<iterator, bool>;
+
+    /* Inserts {key: value}, or assigns value to key if key is already in the map.
+     * Returns an iterator to key, and true if an insertion took place.
+     * Hashes key once and walks its bucket once.
+     */
+    template <typename V>
+    auto insert_or_assign(const KEY& key, V&& value) -> std::pair<iterator, bool>;
+
+    template <typename V>
+    auto insert_or_assign(KEY&& key, V&& value) -> std::pair<iterator, bool>;
+
+    /* Constructs an entry in place from args (as std::pair<KEY, VALUE>{args...}),
+     * and links it into the map if its key is not already in the map; otherwise the entry is discarded.
+     * Returns an iterator to the entry's key, and true if an insertion took place.
+     */
+    template <typename... Args>
+    auto emplace(Args&&... args) -> std::pair<iterator, bool>;
+
     /* Iteration through a map produces its keys.
      * Values can be accessed through iteration by using operator[].
      * If both keys and values are instantly needed, iterate through hash_map::items().
@@ -100,112 +197,217 @@ public:
         KEY& operator*() const;
         KEY* operator->() const;
 
-        friend iterator HashMap<KEY, VALUE>::begin() const;
-        friend iterator HashMap<KEY, VALUE>::end() const;
+        /* Returns the value associated with the key under the cursor */
+        VALUE& value() const;
+
+        friend class HashMap<KEY, VALUE, Hash, Allocator>;
 
     private:
-        iterator(HashMap<KEY, VALUE>* it, int already);
+        iterator(HashMap<KEY, VALUE, Hash, Allocator>* it, int bin, typename Bucket::iterator at);
 
         bool done() const;
         void advance_bin();
-        void next();
 
-        HashMap<KEY, VALUE>* ref;
-        int traversed;
-        typename LinkedList<Entry>::iterator current;
+        HashMap<KEY, VALUE, Hash, Allocator>* ref;
         int current_bin_index;
+        typename Bucket::iterator current;
     };
 
 
 protected:
-    std::function<int(const KEY&)> hash;
-    int bins;
-    LinkedList<Entry>* table;
+    Allocator allocator;
+    Hasher<KEY, Hash> hash;
+    int bins;           // always a power of two
+    Bucket* table;
+
+    // While an incremental rehash is in progress, old_table holds the previous generation of bins;
+    // old_table[i] for i < migrated have already been emptied into table.
+    Bucket* old_table;
+    int old_bins;
+    int migrated;
 
 
 private:
     double lft;
     unsigned int length;
+    bool incremental;
 
     void _rehash();
+    void _rehash(int new_bins);
     double load_factor() const;
     int get_bin(const KEY& key) const;
+
+    /* Returns the bucket holding (or that would hold) hashed.
+     * Buckets [0, bins) are table; buckets [bins, bins + old_bins) are old_table during an incremental rehash.
+     */
+    int bin_of(std::size_t hashed) const;
+    Bucket& bucket(int i) const;
+    int buckets() const;
+
+    /* Incremental rehashing helpers */
+    void _begin_migration();
+    void _migrate(int step);
+    void _finish_migration();
+    void _copy_migration(const HashMap<KEY, VALUE, Hash, Allocator>& right);
+
+    /* Bucket arrays are allocated raw, so that every bucket can be constructed with allocator */
+    Bucket* _new_table(int n) const;
+    static void _delete_table(Bucket* to_delete, int n);
     Entry* _locate(const KEY& key) const;
+
+    /* Returns the position of key within bin, or that bin's end() */
+    typename Bucket::iterator _seek(int bin, const KEY& key) const;
+
+    /* Shared bodies of the const KEY& and KEY&& overloads */
+    template <typename K, typename... Args>
+    auto _try_emplace(K&& key, Args&&... args) -> std::pair<iterator, bool>;
+
+    template <typename K, typename V>
+    auto _insert_or_assign(K&& key, V&& value) -> std::pair<iterator, bool>;
 };
 
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>::HashMap(std::function<int(const KEY&)> hasher, double the_load_factor)
-        : hash{hasher}, bins{_HASH_MAP_INITIAL_SIZE}, table{new LinkedList<Entry>[bins]}, lft{the_load_factor}, length{0}
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap() : HashMap(Hash{}, _HASH_MAP_LOAD_FACTOR_THRESHOLD)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(const Hash& hasher, double the_load_factor, const Allocator& the_allocator)
+        : allocator{the_allocator}, hash{hasher}, bins{_HASH_MAP_INITIAL_SIZE}, table{_new_table(bins)},
+          old_table{nullptr}, old_bins{0}, migrated{0}, lft{the_load_factor}, length{0}, incremental{false}
 {
 }
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>::HashMap(std::function<int(const KEY&)> hasher) : HashMap(hasher, _HASH_MAP_LOAD_FACTOR_THRESHOLD)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(const Hash& hasher) : HashMap(hasher, _HASH_MAP_LOAD_FACTOR_THRESHOLD)
 {
 }
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>::HashMap(const HashMap<KEY, VALUE>& right)
-        : hash{right.hash}, bins{right.bins}, table{new LinkedList<Entry>[bins]}, lft{right.lft}, length{right.length}
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(const Allocator& the_allocator) : HashMap(Hash{}, _HASH_MAP_LOAD_FACTOR_THRESHOLD, the_allocator)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(std::function<int(const KEY&)> hasher, double the_load_factor)
+        : allocator{}, hash{std::move(hasher)}, bins{_HASH_MAP_INITIAL_SIZE}, table{_new_table(bins)},
+          old_table{nullptr}, old_bins{0}, migrated{0}, lft{the_load_factor}, length{0}, incremental{false}
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(std::function<int(const KEY&)> hasher) : HashMap(std::move(hasher), _HASH_MAP_LOAD_FACTOR_THRESHOLD)
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(const HashMap<KEY, VALUE, Hash, Allocator>& right)
+        : allocator{std::allocator_traits<Allocator>::select_on_container_copy_construction(right.allocator)},
+          hash{right.hash}, bins{right.bins}, table{_new_table(bins)},
+          old_table{nullptr}, old_bins{0}, migrated{0}, lft{right.lft}, length{right.length}, incremental{right.incremental}
 {
     for (unsigned int i = 0; i < right.bins; ++i)
         table[i] = right.table[i];
+    _copy_migration(right);
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::HashMap(HashMap<KEY, VALUE, Hash, Allocator>&& right)
+        : allocator{right.allocator}, hash{right.hash}, bins{right.bins}, table{right.table},
+          old_table{right.old_table}, old_bins{right.old_bins}, migrated{right.migrated},
+          lft{right.lft}, length{right.length}, incremental{right.incremental}
+{
+    right.bins = _HASH_MAP_INITIAL_SIZE;
+    right.table = right._new_table(right.bins);
+    right.old_table = nullptr;
+    right.old_bins = right.migrated = 0;
+    right.length = 0;
 }
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>::~HashMap()
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::~HashMap()
 {
-    delete[] table;
+    _delete_table(table, bins);
+    _delete_table(old_table, old_bins);
 }
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>& HashMap<KEY, VALUE>::operator=(const HashMap<KEY, VALUE>& right)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>& HashMap<KEY, VALUE, Hash, Allocator>::operator=(const HashMap<KEY, VALUE, Hash, Allocator>& right)
 {
     if (this != &right)
     {
-        delete[] table;
+        if (bins != right.bins)
+        {
+            _delete_table(table, bins);
+            bins = right.bins;
+            table = _new_table(bins);
+        }
         hash = right.hash;
-        bins = right.bins;
         lft = right.lft;
         length = right.length;
-        table = new LinkedList<Entry>[bins];
+        incremental = right.incremental;
 
-        for (unsigned int i = 0; i < bins; ++i)
+        // LinkedList::operator= reuses the nodes already in each bin
+        for (int i = 0; i < bins; ++i)
             table[i] = right.table[i];
+        _copy_migration(right);
     }
     return *this;
 }
 
-template <typename KEY, typename VALUE>
-const VALUE& HashMap<KEY, VALUE>::operator[](const KEY& key) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>& HashMap<KEY, VALUE, Hash, Allocator>::operator=(HashMap<KEY, VALUE, Hash, Allocator>&& right)
 {
-    if (!contains(key))
+    if (this != &right)
+    {
+        std::swap(allocator, right.allocator);
+        std::swap(hash, right.hash);
+        std::swap(bins, right.bins);
+        std::swap(table, right.table);
+        std::swap(old_table, right.old_table);
+        std::swap(old_bins, right.old_bins);
+        std::swap(migrated, right.migrated);
+        std::swap(lft, right.lft);
+        std::swap(length, right.length);
+        std::swap(incremental, right.incremental);
+    }
+    return *this;
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+const VALUE& HashMap<KEY, VALUE, Hash, Allocator>::operator[](const KEY& key) const
+{
+    Entry* entry = _locate(key);
+    if (entry == nullptr)
         throw std::invalid_argument{"key not in map"};
 
-    return _locate(key)->second;
+    return entry->second;
 }
 
-template <typename KEY, typename VALUE>
-VALUE& HashMap<KEY, VALUE>::operator[](const KEY& key)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+VALUE& HashMap<KEY, VALUE, Hash, Allocator>::operator[](const KEY& key)
 {
-    if (!contains(key))
-        push_back(key, VALUE{});
+    return try_emplace(key).first.value();
+}
 
-    return _locate(key)->second;
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+VALUE& HashMap<KEY, VALUE, Hash, Allocator>::operator[](KEY&& key)
+{
+    return try_emplace(std::move(key)).first.value();
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::operator==(const HashMap<KEY, VALUE>& right) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::operator==(const HashMap<KEY, VALUE, Hash, Allocator>& right) const
 {
     if (this == &right)
         return true;
     if (size() != right.size())
         return false;
 
-    for (unsigned int i = 0; i < right.bins; ++i)
+    for (int i = 0; i < right.buckets(); ++i)
     {
-        for (const auto& entry : right.table[i])
+        for (const auto& entry : right.bucket(i))
         {
             if (!(contains(entry.first) && entry.second == operator[](entry.first)))
                 return false;
@@ -214,20 +416,20 @@ bool HashMap<KEY, VALUE>::operator==(const HashMap<KEY, VALUE>& right) const
     return true;
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::operator!=(const HashMap<KEY, VALUE>& right) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::operator!=(const HashMap<KEY, VALUE, Hash, Allocator>& right) const
 {
     return !operator==(right);
 }
 
-template <typename KEY, typename VALUE>
-std::ostream& operator<<(std::ostream& os, const HashMap<KEY, VALUE>& hm)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const HashMap<KEY, VALUE, Hash, Allocator>& hm)
 {
     os << "hash_map(";
     unsigned int c = 0;
-    for (unsigned int i = 0; i < hm.bins; ++i)
+    for (int i = 0; i < hm.buckets(); ++i)
     {
-        for (const auto& entry : hm.table[i])
+        for (const auto& entry : hm.bucket(i))
             os << entry.first << ": " << entry.second << (c++ < hm.size() - 1 ? ", " : "");
     }
     os << ")";
@@ -235,216 +437,532 @@ std::ostream& operator<<(std::ostream& os, const HashMap<KEY, VALUE>& hm)
     return os;
 }
 
-template <typename KEY, typename VALUE>
-int HashMap<KEY, VALUE>::size() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+int HashMap<KEY, VALUE, Hash, Allocator>::size() const
 {
     return length;
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::empty() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::empty() const
 {
     return size() == 0;
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::contains(const KEY& key) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::contains(const KEY& key) const
 {
     return _locate(key) != nullptr;
 }
 
-template <typename KEY, typename VALUE>
-std::string HashMap<KEY, VALUE>::str() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+std::string HashMap<KEY, VALUE, Hash, Allocator>::str() const
 {
     std::ostringstream result;
     result << "hash_map(" << std::endl;
-    for (unsigned int i = 0; i < bins; ++i)
-        result << "  " << i << ": " << table[i] << std::endl;
+    for (int i = 0; i < buckets(); ++i)
+        result << "  " << (i < bins ? "" : "old ") << (i < bins ? i : i - bins) << ": " << bucket(i) << std::endl;
 
     result << ")";
     return result.str();
 }
 
-template <typename KEY, typename VALUE>
-std::vector<KEY> HashMap<KEY, VALUE>::keys() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+std::vector<KEY> HashMap<KEY, VALUE, Hash, Allocator>::keys() const
 {
     std::vector<KEY> result;
-    for (unsigned int i = 0; i < bins; ++i)
+    result.reserve(length);
+    for (int i = 0; i < buckets(); ++i)
     {
-        for (const auto& entry : table[i])
+        for (const auto& entry : bucket(i))
             result.push_back(entry.first);
     }
     return result;
 }
 
-template <typename KEY, typename VALUE>
-std::vector<VALUE> HashMap<KEY, VALUE>::values() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+std::vector<VALUE> HashMap<KEY, VALUE, Hash, Allocator>::values() const
 {
     std::vector<VALUE> result;
-    for (unsigned int i = 0; i < bins; ++i)
+    result.reserve(length);
+    for (int i = 0; i < buckets(); ++i)
     {
-        for (const auto& entry : table[i])
+        for (const auto& entry : bucket(i))
             result.push_back(entry.second);
     }
     return result;
 }
 
-template <typename KEY, typename VALUE>
-std::vector<typename HashMap<KEY, VALUE>::Entry> HashMap<KEY, VALUE>::items() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+std::vector<typename HashMap<KEY, VALUE, Hash, Allocator>::Entry> HashMap<KEY, VALUE, Hash, Allocator>::items() const
 {
     std::vector<Entry> result;
-    for (unsigned int i = 0; i < bins; ++i)
+    result.reserve(length);
+    for (int i = 0; i < buckets(); ++i)
     {
-        for (const auto& entry : table[i])
+        for (const auto& entry : bucket(i))
             result.push_back(entry);
     }
     return result;
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::push_back(const KEY& key, const VALUE& value)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::push_back(const KEY& key, const VALUE& value)
 {
-    if (contains(key))
-        erase(key);
-    if (load_factor() >= lft)
-        _rehash();
+    insert_or_assign(key, value);
+}
 
-    table[get_bin(key)].push_front(Entry{key, value});
-    ++length;
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::push_back(KEY&& key, VALUE&& value)
+{
+    insert_or_assign(std::move(key), std::move(value));
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::push_back(const typename HashMap<KEY, VALUE>::Entry& pair)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::push_back(const typename HashMap<KEY, VALUE, Hash, Allocator>::Entry& pair)
 {
     push_back(pair.first, pair.second);
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::erase(const KEY& key)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::push_back(typename HashMap<KEY, VALUE, Hash, Allocator>::Entry&& pair)
+{
+    push_back(std::move(pair.first), std::move(pair.second));
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::erase(const KEY& key)
 {
-    if (!contains(key))
+    _migrate(_HASH_MAP_MIGRATION_STEP);
+    int bin = get_bin(key);
+    auto position = _seek(bin, key);
+    if (position == bucket(bin).end())
         throw std::invalid_argument{"key is not in map"};
 
-    table[get_bin(key)].erase(Entry{key, operator[](key)});
+    bucket(bin).erase(*position);
     --length;
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::clear()
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::clear()
 {
-    delete[] table;
+    _delete_table(table, bins);
+    _delete_table(old_table, old_bins);
     length = 0;
     bins = _HASH_MAP_INITIAL_SIZE;
-    table = new LinkedList<Entry>[bins];
+    table = _new_table(bins);
+    old_table = nullptr;
+    old_bins = migrated = 0;
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::reserve(int n)
+{
+    rehash(static_cast<int>(std::ceil(n / lft)));
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::rehash(int n)
+{
+    _finish_migration();
+    int needed = std::max(n, static_cast<int>(std::ceil(size() / lft)));
+    int new_bins = bins;
+    while (new_bins < needed)
+        new_bins *= 2;
+
+    if (new_bins != bins)
+        _rehash(new_bins);
 }
 
-template <typename KEY, typename VALUE>
-double HashMap<KEY, VALUE>::load_factor() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::set_incremental_rehash(bool enabled)
+{
+    incremental = enabled;
+    if (!incremental)
+        _finish_migration();
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::write_snapshot(const std::string& path) const
+{
+    SnapshotWriter out{path, _SNAPSHOT_HASH_MAP, SnapshotCodec<KEY>::size, SnapshotCodec<VALUE>::size, length, static_cast<uint64_t>(bins)};
+    for (int i = 0; i < buckets(); ++i)
+    {
+        for (const auto& entry : bucket(i))
+        {
+            out.write<uint64_t>(hash(entry.first));
+            SnapshotCodec<KEY>::write(out, entry.first);
+            SnapshotCodec<VALUE>::write(out, entry.second);
+        }
+    }
+    out.close();
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::read_snapshot(const std::string& path)
+{
+    SnapshotReader in{path, _SNAPSHOT_HASH_MAP, SnapshotCodec<KEY>::size, SnapshotCodec<VALUE>::size};
+    uint64_t geometry = in.geometry();
+    if (in.count() > INT_MAX / 2 || geometry > INT_MAX / 2 + 1 || geometry == 0 || (geometry & (geometry - 1)) != 0)
+        throw SnapshotError{"HashMap::read_snapshot - " + path + " has an impossible size or number of bins"};
+
+    int count = static_cast<int>(in.count());
+    int new_bins = static_cast<int>(geometry);
+    while (new_bins < std::ceil(count / lft))
+        new_bins *= 2;
+
+    Bucket* loaded = _new_table(new_bins);
+    try
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            std::size_t hashed = static_cast<std::size_t>(in.read<uint64_t>());
+            KEY key = SnapshotCodec<KEY>::read(in);
+            VALUE value = SnapshotCodec<VALUE>::read(in);
+            if (i % _SNAPSHOT_CHECK_STRIDE == 0 && hash(key) != hashed)
+                throw SnapshotError{"HashMap::read_snapshot - " + path + " was written with another hash function"};
+
+            loaded[hashed & static_cast<std::size_t>(new_bins - 1)].emplace_back(std::move(key), std::move(value));
+        }
+    }
+    catch (...)
+    {
+        _delete_table(loaded, new_bins);
+        throw;
+    }
+
+    _delete_table(table, bins);
+    _delete_table(old_table, old_bins);
+    table = loaded;
+    bins = new_bins;
+    old_table = nullptr;
+    old_bins = migrated = 0;
+    length = count;
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+double HashMap<KEY, VALUE, Hash, Allocator>::load_factor() const
 {
     return size() / static_cast<double>(bins);
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::_rehash()
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_rehash()
 {
-    int old_bins = bins;
-    bins *= 2;
-    LinkedList<Entry>* reallocated = new LinkedList<Entry>[bins];
-    for (unsigned int i = 0; i < old_bins; ++i)
+    if (incremental)
+        _begin_migration();
+    else
+        _rehash(bins * 2);
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_rehash(int new_bins)
+{
+    TIMED_SPAN("HashMap::_rehash");
+    _finish_migration();
+    int previous_bins = bins;
+    bins = new_bins;
+    Bucket* reallocated = _new_table(bins);
+    for (int i = 0; i < previous_bins; ++i)
     {
-        for (const auto& entry : table[i])
-            reallocated[get_bin(entry.first)].push_back(entry);
+        while (!table[i].empty())
+            reallocated[get_bin(table[i].first().first)].splice_front(table[i]);
     }
 
-    delete[] table;
+    _delete_table(table, previous_bins);
     table = reallocated;
 }
 
-template <typename KEY, typename VALUE>
-int HashMap<KEY, VALUE>::get_bin(const KEY& key) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_begin_migration()
 {
-    return std::abs(hash(key)) % bins;
+    // the previous generation is normally long gone by now; if not, it must be emptied before being replaced
+    _finish_migration();
+    old_table = table;
+    old_bins = bins;
+    migrated = 0;
+    bins *= 2;
+    table = _new_table(bins);
 }
 
-template <typename KEY, typename VALUE>
-typename HashMap<KEY, VALUE>::Entry* HashMap<KEY, VALUE>::_locate(const KEY& key) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_migrate(int step)
 {
-    for (auto& entry : table[get_bin(key)])
+    if (old_table == nullptr)
+        return;
+
+    for (int last = std::min(old_bins, migrated + step); migrated < last; ++migrated)
+    {
+        Bucket& old = old_table[migrated];
+        while (!old.empty())
+            table[hash(old.first().first) & static_cast<std::size_t>(bins - 1)].splice_front(old);
+    }
+
+    if (migrated == old_bins)
     {
-        if (entry.first == key)
-            return &entry;
+        _delete_table(old_table, old_bins);
+        old_table = nullptr;
+        old_bins = migrated = 0;
     }
-    return nullptr;
 }
 
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_finish_migration()
+{
+    _migrate(old_bins);
+}
 
-// iterator implementation
-template <typename KEY, typename VALUE>
-auto HashMap<KEY, VALUE>::begin() const -> HashMap<KEY, VALUE>::iterator
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_copy_migration(const HashMap<KEY, VALUE, Hash, Allocator>& right)
 {
-    return iterator{const_cast<HashMap<KEY, VALUE>*>(this), 0};
+    _delete_table(old_table, old_bins);
+    old_table = nullptr;
+    old_bins = right.old_bins;
+    migrated = right.migrated;
+    if (right.old_table != nullptr)
+    {
+        old_table = _new_table(old_bins);
+        for (int i = migrated; i < old_bins; ++i)
+            old_table[i] = right.old_table[i];
+    }
 }
 
-template <typename KEY, typename VALUE>
-auto HashMap<KEY, VALUE>::end() const -> HashMap<KEY, VALUE>::iterator
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+typename HashMap<KEY, VALUE, Hash, Allocator>::Bucket* HashMap<KEY, VALUE, Hash, Allocator>::_new_table(int n) const
 {
-    return iterator{const_cast<HashMap<KEY, VALUE>*>(this), size()};
+    Bucket* created = static_cast<Bucket*>(::operator new(n * sizeof(Bucket)));
+    for (int i = 0; i < n; ++i)
+        new (&created[i]) Bucket{allocator};
+    return created;
 }
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>::iterator::iterator(HashMap<KEY, VALUE>* it, int already)
-        : ref{it}, traversed{already}, current_bin_index{-1}
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::_delete_table(Bucket* to_delete, int n)
 {
-    advance_bin();
+    if (to_delete == nullptr)
+        return;
+
+    for (int i = 0; i < n; ++i)
+        to_delete[i].~Bucket();
+    ::operator delete(to_delete);
 }
 
-template <typename KEY, typename VALUE>
-HashMap<KEY, VALUE>::iterator::iterator() : iterator(nullptr, 0)
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+int HashMap<KEY, VALUE, Hash, Allocator>::get_bin(const KEY& key) const
 {
+    return bin_of(hash(key));
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::iterator::done() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+int HashMap<KEY, VALUE, Hash, Allocator>::bin_of(std::size_t hashed) const
 {
-    return traversed >= ref->size();
+    if (old_table != nullptr)
+    {
+        int old = static_cast<int>(hashed & static_cast<std::size_t>(old_bins - 1));
+        if (old >= migrated)
+            return bins + old;
+    }
+    return static_cast<int>(hashed & static_cast<std::size_t>(bins - 1));
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::iterator::advance_bin()
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+typename HashMap<KEY, VALUE, Hash, Allocator>::Bucket& HashMap<KEY, VALUE, Hash, Allocator>::bucket(int i) const
 {
-    for (++current_bin_index; current_bin_index < ref->bins && ref->table[current_bin_index].empty(); ++current_bin_index)
-    { /* advance current_bin_index to next non-empty bin */ }
-    current = ref->table[current_bin_index].begin();
+    return i < bins ? table[i] : old_table[i - bins];
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+int HashMap<KEY, VALUE, Hash, Allocator>::buckets() const
+{
+    return old_table == nullptr ? bins : bins + old_bins;
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+typename HashMap<KEY, VALUE, Hash, Allocator>::Entry* HashMap<KEY, VALUE, Hash, Allocator>::_locate(const KEY& key) const
+{
+    int bin = get_bin(key);
+    auto position = _seek(bin, key);
+    return position == bucket(bin).end() ? nullptr : &(*position);
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+typename HashMap<KEY, VALUE, Hash, Allocator>::Bucket::iterator HashMap<KEY, VALUE, Hash, Allocator>::_seek(int bin, const KEY& key) const
+{
+    auto position = bucket(bin).begin();
+    for (auto end = bucket(bin).end(); position != end && !(position->first == key); ++position)
+    { /* walk the bucket until key is found */ }
+    return position;
 }
 
-template <typename KEY, typename VALUE>
-void HashMap<KEY, VALUE>::iterator::next()
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+auto HashMap<KEY, VALUE, Hash, Allocator>::find(const KEY& key) const -> HashMap<KEY, VALUE, Hash, Allocator>::iterator
 {
-    if (!done())
+    int bin = get_bin(key);
+    auto position = _seek(bin, key);
+    if (position == bucket(bin).end())
+        return end();
+
+    return iterator{const_cast<HashMap<KEY, VALUE, Hash, Allocator>*>(this), bin, position};
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename... Args>
+auto HashMap<KEY, VALUE, Hash, Allocator>::try_emplace(const KEY& key, Args&&... args) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
+{
+    return _try_emplace(key, std::forward<Args>(args)...);
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename... Args>
+auto HashMap<KEY, VALUE, Hash, Allocator>::try_emplace(KEY&& key, Args&&... args) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
+{
+    return _try_emplace(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename V>
+auto HashMap<KEY, VALUE, Hash, Allocator>::insert_or_assign(const KEY& key, V&& value) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
+{
+    return _insert_or_assign(key, std::forward<V>(value));
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename V>
+auto HashMap<KEY, VALUE, Hash, Allocator>::insert_or_assign(KEY&& key, V&& value) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
+{
+    return _insert_or_assign(std::move(key), std::forward<V>(value));
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename... Args>
+auto HashMap<KEY, VALUE, Hash, Allocator>::emplace(Args&&... args) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
+{
+    // build the node off to the side, so it can be linked into its bin without moving the entry
+    Bucket staged{allocator};
+    staged.emplace_front(std::forward<Args>(args)...);
+    _migrate(_HASH_MAP_MIGRATION_STEP);
+
+    const KEY& key = staged.first().first;
+    std::size_t hashed = hash(key);
+    int bin = bin_of(hashed);
+    auto position = _seek(bin, key);
+    if (position != bucket(bin).end())
+        return std::make_pair(iterator{this, bin, position}, false);
+
+    if (load_factor() >= lft)
     {
-        try
-        {
-            *(++current);
-        }
-        catch (std::out_of_range& e)
-        {
-            advance_bin();
-        }
-        ++traversed;
+        _rehash();
+        bin = bin_of(hashed);
     }
+
+    bucket(bin).splice_front(staged);
+    ++length;
+    return std::make_pair(iterator{this, bin, bucket(bin).begin()}, true);
 }
 
-template <typename KEY, typename VALUE>
-auto HashMap<KEY, VALUE>::iterator::operator++() -> HashMap<KEY, VALUE>::iterator&
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename K, typename... Args>
+auto HashMap<KEY, VALUE, Hash, Allocator>::_try_emplace(K&& key, Args&&... args) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
 {
-    if (!done())
-        next();
+    _migrate(_HASH_MAP_MIGRATION_STEP);
+    std::size_t hashed = hash(key);
+    int bin = bin_of(hashed);
+    auto position = _seek(bin, key);
+    if (position != bucket(bin).end())
+        return std::make_pair(iterator{this, bin, position}, false);
+
+    if (load_factor() >= lft)
+    {
+        _rehash();
+        bin = bin_of(hashed);
+    }
+
+    bucket(bin).emplace_front(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+    ++length;
+    return std::make_pair(iterator{this, bin, bucket(bin).begin()}, true);
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+template <typename K, typename V>
+auto HashMap<KEY, VALUE, Hash, Allocator>::_insert_or_assign(K&& key, V&& value) -> std::pair<HashMap<KEY, VALUE, Hash, Allocator>::iterator, bool>
+{
+    _migrate(_HASH_MAP_MIGRATION_STEP);
+    std::size_t hashed = hash(key);
+    int bin = bin_of(hashed);
+    auto position = _seek(bin, key);
+    if (position != bucket(bin).end())
+    {
+        position->second = std::forward<V>(value);
+        return std::make_pair(iterator{this, bin, position}, false);
+    }
+
+    if (load_factor() >= lft)
+    {
+        _rehash();
+        bin = bin_of(hashed);
+    }
+
+    bucket(bin).emplace_front(std::forward<K>(key), std::forward<V>(value));
+    ++length;
+    return std::make_pair(iterator{this, bin, bucket(bin).begin()}, true);
+}
+
+// iterator implementation
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+auto HashMap<KEY, VALUE, Hash, Allocator>::begin() const -> HashMap<KEY, VALUE, Hash, Allocator>::iterator
+{
+    iterator first{const_cast<HashMap<KEY, VALUE, Hash, Allocator>*>(this), -1, typename Bucket::iterator{}};
+    first.advance_bin();
+    return first;
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+auto HashMap<KEY, VALUE, Hash, Allocator>::end() const -> HashMap<KEY, VALUE, Hash, Allocator>::iterator
+{
+    return iterator{const_cast<HashMap<KEY, VALUE, Hash, Allocator>*>(this), buckets(), typename Bucket::iterator{}};
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::iterator::iterator(HashMap<KEY, VALUE, Hash, Allocator>* it, int bin, typename Bucket::iterator at)
+        : ref{it}, current_bin_index{bin}, current{at}
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+HashMap<KEY, VALUE, Hash, Allocator>::iterator::iterator() : iterator(nullptr, 0, typename Bucket::iterator{})
+{
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::iterator::done() const
+{
+    return ref == nullptr || current_bin_index >= ref->buckets();
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+void HashMap<KEY, VALUE, Hash, Allocator>::iterator::advance_bin()
+{
+    int last = ref->buckets();
+    for (++current_bin_index; current_bin_index < last && ref->bucket(current_bin_index).empty(); ++current_bin_index)
+    { /* advance current_bin_index to next non-empty bin */ }
+
+    if (current_bin_index < last)
+        current = ref->bucket(current_bin_index).begin();
+    else
+        current = typename Bucket::iterator{};
+}
+
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+auto HashMap<KEY, VALUE, Hash, Allocator>::iterator::operator++() -> HashMap<KEY, VALUE, Hash, Allocator>::iterator&
+{
+    if (!done() && ++current == ref->bucket(current_bin_index).end())
+        advance_bin();
 
     return *this;
 }
 
-template <typename KEY, typename VALUE>
-auto HashMap<KEY, VALUE>::iterator::operator++(int) -> HashMap<KEY, VALUE>::iterator
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+auto HashMap<KEY, VALUE, Hash, Allocator>::iterator::operator++(int) -> HashMap<KEY, VALUE, Hash, Allocator>::iterator
 {
     iterator to_return{*this};
     operator++();
@@ -452,20 +970,20 @@ auto HashMap<KEY, VALUE>::iterator::operator++(int) -> HashMap<KEY, VALUE>::iter
     return to_return;
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::iterator::operator==(const HashMap<KEY, VALUE>::iterator& right) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::iterator::operator==(const HashMap<KEY, VALUE, Hash, Allocator>::iterator& right) const
 {
-    return ref == right.ref && traversed == right.traversed;
+    return ref == right.ref && current_bin_index == right.current_bin_index && current == right.current;
 }
 
-template <typename KEY, typename VALUE>
-bool HashMap<KEY, VALUE>::iterator::operator!=(const HashMap<KEY, VALUE>::iterator& right) const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+bool HashMap<KEY, VALUE, Hash, Allocator>::iterator::operator!=(const HashMap<KEY, VALUE, Hash, Allocator>::iterator& right) const
 {
     return !operator==(right);
 }
 
-template <typename KEY, typename VALUE>
-KEY& HashMap<KEY, VALUE>::iterator::operator*() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+KEY& HashMap<KEY, VALUE, Hash, Allocator>::iterator::operator*() const
 {
     if (done())
         throw std::out_of_range{"hash_map::iterator::operator* -- cursor past end"};
@@ -473,8 +991,8 @@ KEY& HashMap<KEY, VALUE>::iterator::operator*() const
     return current->first;
 }
 
-template <typename KEY, typename VALUE>
-KEY* HashMap<KEY, VALUE>::iterator::operator->() const
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+KEY* HashMap<KEY, VALUE, Hash, Allocator>::iterator::operator->() const
 {
     if (done())
         throw std::out_of_range{"hash_map::iterator::operator-> -- cursor past end"};
@@ -482,5 +1000,14 @@ KEY* HashMap<KEY, VALUE>::iterator::operator->() const
     return &current->first;
 }
 
+template <typename KEY, typename VALUE, typename Hash, typename Allocator>
+VALUE& HashMap<KEY, VALUE, Hash, Allocator>::iterator::value() const
+{
+    if (done())
+        throw std::out_of_range{"hash_map::iterator::value -- cursor past end"};
+
+    return current->second;
+}
+
 
 #endif // DATA_STRUCTURES_HASH_MAP_HPP
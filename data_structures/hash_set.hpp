@@ -7,35 +7,69 @@
 //   * a single LinkedList::iterator cursor representing the current position
 //   * a count of the number of items already traversed
 // But, performance is not optimal because advancement relies on exception handling.
+//
+// With incremental rehashing enabled, growing the table keeps the old bins alongside the new ones,
+// and every modifying operation migrates a few of them (see HashMap).
+//
+// The set algebra (union, intersection, difference, symmetric difference and the subset tests) first looks up
+// every item of one operand in the other, then sizes the result exactly and links the items it keeps in one pass;
+// the in-place forms unlink nodes directly, and never copy the set.
+// With set_parallelism(threads), the lookups into the other operand are split over bucket ranges and run concurrently
+// for large sets; nodes are still only allocated and freed by the calling thread, so any Allocator can be used.
 #ifndef HASH_SET_HPP
 #define HASH_SET_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <functional>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <sstream>
 #include <string>
-#include <cstdlib>
+#include <utility>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include "hasher.hpp"
 #include "linked_list.hpp"
 
 
 namespace
 {
 	double _HASH_SET_LOAD_FACTOR_THRESHOLD = 1.0;
-	int _HASH_SET_INITIAL_SIZE = 5;
+	int _HASH_SET_INITIAL_SIZE = 8;		// must be a power of two
+	int _HASH_SET_MIGRATION_STEP = 4;	// old bins migrated per modifying operation during an incremental rehash
+	int _HASH_SET_PARALLEL_MINIMUM = 1 << 16;	// smaller sets are never split over threads
 }
 
 
 
-template <typename T>
+template <typename T, typename Hash = std::hash<T>, typename Allocator = std::allocator<T>>
 class HashSet
 {
+private:
+	typedef LinkedList<T, Allocator> Bucket;
+
 public:
+	HashSet();
+	HashSet(const Hash& hasher, double the_load_factor, const Allocator& the_allocator = Allocator{});
+	explicit HashSet(const Hash& hasher);
+
+	/* Every bucket's nodes are obtained from (a copy of) the_allocator */
+	explicit HashSet(const Allocator& the_allocator);
+
+	/* Adapts a run-time hash function; hashing then goes through a std::function call */
 	HashSet(const std::function<int(const T&)>& hasher, double the_load_factor);
 	explicit HashSet(const std::function<int(const T&)>& hasher);
 	HashSet(const HashSet& right);
 
+	/* Takes right's table without copying any items; right is left empty */
+	HashSet(HashSet&& right);
+
 	template <typename Container>
 	HashSet(const Container& iterable, const std::function<int(const T&)>& hasher);
 
@@ -43,30 +77,43 @@ public:
 
 
 	// Operators
-	HashSet<T>& operator=(const HashSet<T>& right);
+	/* Reuses this's table if it already has as many bins as right */
+	HashSet<T, Hash, Allocator>& operator=(const HashSet<T, Hash, Allocator>& right);
+	HashSet<T, Hash, Allocator>& operator=(HashSet<T, Hash, Allocator>&& right);
 
 	/* Two hash_sets are == if they have the same elements within them.
 	 * hash_sets do not have to have the same order, or same hash function to be ==.
+	 * The subset tests (<, <=, >, >=) look up each item of the (necessarily) smaller side in the other.
 	 */
-	bool operator==(const HashSet<T>& right) const;
-	bool operator!=(const HashSet<T>& right) const;
-	bool operator<(const HashSet<T>& other) const;
-	bool operator<=(const HashSet<T>& other) const;
-	bool operator>(const HashSet<T>& other) const;
-	bool operator>=(const HashSet<T>& other) const;
+	bool operator==(const HashSet<T, Hash, Allocator>& right) const;
+	bool operator!=(const HashSet<T, Hash, Allocator>& right) const;
+	bool operator<(const HashSet<T, Hash, Allocator>& other) const;
+	bool operator<=(const HashSet<T, Hash, Allocator>& other) const;
+	bool operator>(const HashSet<T, Hash, Allocator>& other) const;
+	bool operator>=(const HashSet<T, Hash, Allocator>& other) const;
 
 	/* Returns a new hash_set containing all items in both this and right;
 	 * non-modifying version of hash_set::combine
 	 */
-	HashSet<T> operator+(const HashSet<T>& right) const;
+	HashSet<T, Hash, Allocator> operator+(const HashSet<T, Hash, Allocator>& right) const;
 
 	/* Returns a new hash_set containing all elements in this that are NOT in right;
 	 * e.g., non-modifying version of hash_set::difference
 	 */
-	HashSet<T> operator-(const HashSet<T>& right) const;
+	HashSet<T, Hash, Allocator> operator-(const HashSet<T, Hash, Allocator>& right) const;
 
-	template <typename T2>
-	friend std::ostream& operator<<(std::ostream& os, const HashSet<T2>& hm);
+	/* Returns a new hash_set containing the elements in both this and right;
+	 * non-modifying version of hash_set::intersect. Iterates the smaller of the two.
+	 */
+	HashSet<T, Hash, Allocator> operator&(const HashSet<T, Hash, Allocator>& right) const;
+
+	/* Returns a new hash_set containing the elements in exactly one of this and right;
+	 * non-modifying version of hash_set::symmetric_difference
+	 */
+	HashSet<T, Hash, Allocator> operator^(const HashSet<T, Hash, Allocator>& right) const;
+
+	template <typename T2, typename H, typename A>
+	friend std::ostream& operator<<(std::ostream& os, const HashSet<T2, H, A>& hm);
 
 	// Non-Modifying Member Functions
 	int size() const;
@@ -78,19 +125,61 @@ public:
 	// Modifying Member Functions
 	/* Inserts item into the set.
 	 * If item is already in the set, replaces the existing one with parameter item.
+	 * Hashes item once and walks its bucket once.
 	 */
 	void insert(const T& item);
+	void insert(T&& item);
+
+	/* Constructs T{args...} in place, and links it into the set unless an equal item is already there
+	 * (in which case the existing item is kept and the new one discarded).
+	 * Returns true if an insertion took place.
+	 */
+	template <typename... Args>
+	bool emplace(Args&&... args);
 
 	/* Removes item from the map.
 	 * Throws std::invalid_argument if item is not in the set
 	 */
 	void erase(const T& item);
 
-	/* Removes all items in this that are NOT in other */
-	void difference(const HashSet<T>& other);
+	/* Removes all items in this that are also in other.
+	 * Iterates whichever of the two is smaller.
+	 */
+	void difference(const HashSet<T, Hash, Allocator>& other);
 
-	/* Combines this with other; duplicates are not overwritten */
-	void combine(const HashSet<T>& other);
+	/* Removes all items in this that are NOT in other.
+	 * If other is the smaller, the result is built from other's items instead.
+	 */
+	void intersect(const HashSet<T, Hash, Allocator>& other);
+
+	/* Removes the items this shares with other, and adds those only other has */
+	void symmetric_difference(const HashSet<T, Hash, Allocator>& other);
+
+	/* Combines this with other; duplicates are not overwritten.
+	 * The table is grown once, up front, to hold every item of other this is missing.
+	 */
+	void combine(const HashSet<T, Hash, Allocator>& other);
+
+	/* Grows the table so that n items fit without triggering a rehash */
+	void reserve(int n);
+
+	/* Redistributes the items over at least n bins (rounded up to a power of two),
+	 * or over as many bins as size() needs under the load factor, whichever is larger.
+	 * Nodes are relinked into their new bins; no items are copied.
+	 * Completes any incremental rehash in progress.
+	 */
+	void rehash(int n);
+
+	/* If enabled, growing the table (when the load factor reaches its threshold) is spread
+	 * over subsequent modifying operations instead of being done by the insertion that triggers it.
+	 * Disabling it completes any incremental rehash in progress.
+	 */
+	void set_incremental_rehash(bool enabled);
+
+	/* The set algebra above looks up items on up to threads threads, once the set being iterated
+	 * holds at least _HASH_SET_PARALLEL_MINIMUM items; 1 (the default) keeps everything on the calling thread.
+	 */
+	void set_parallelism(int threads);
 
 
 
@@ -111,19 +200,19 @@ public:
 		T& operator*() const;
 		T* operator->() const;
 
-		friend iterator HashSet<T>::begin() const;
-		friend iterator HashSet<T>::end() const;
+		friend iterator HashSet<T, Hash, Allocator>::begin() const;
+		friend iterator HashSet<T, Hash, Allocator>::end() const;
 
 	private:
-		iterator(HashSet<T>* it, int already);
+		iterator(HashSet<T, Hash, Allocator>* it, int already);
 
 		bool done() const;
 		void advance_bin();
 		void next();
 
-		HashSet<T>* ref;
+		HashSet<T, Hash, Allocator>* ref;
 		int traversed;
-		typename LinkedList<T>::iterator current;
+		typename Bucket::iterator current;
 		int current_bin_index;
 	};
 
@@ -131,164 +220,308 @@ public:
 
 
 protected:
-	std::function<int(const T&)> hash;
-	int bins;
-	LinkedList<T>* table;
+	Allocator allocator;
+	Hasher<T, Hash> hash;
+	int bins;			// always a power of two
+	Bucket* table;
+
+	// While an incremental rehash is in progress, old_table holds the previous generation of bins;
+	// old_table[i] for i < migrated have already been emptied into table.
+	Bucket* old_table;
+	int old_bins;
+	int migrated;
 
 
 private:
 	double lft;
 	unsigned int length;
+	bool incremental;
+	int parallelism;
+
+	HashSet(const Hasher<T, Hash>& hasher, double the_load_factor, const Allocator& the_allocator, int);
 
 	void _rehash();
+	void _rehash(int new_bins);
 	double load_factor() const;
 	int get_bin(const T& item) const;
+
+	/* Returns the bucket holding (or that would hold) hashed.
+	 * Buckets [0, bins) are table; buckets [bins, bins + old_bins) are old_table during an incremental rehash.
+	 */
+	int bin_of(std::size_t hashed) const;
+	Bucket& bucket(int i) const;
+	int buckets() const;
+
+	/* Incremental rehashing helpers */
+	void _begin_migration();
+	void _migrate(int step);
+	void _finish_migration();
+	void _copy_migration(const HashSet<T, Hash, Allocator>& right);
+
+	/* Bucket arrays are allocated raw, so that every bucket can be constructed with allocator */
+	Bucket* _new_table(int n) const;
+	static void _delete_table(Bucket* to_delete, int n);
+
+	/* Shared body of the const T& and T&& overloads of insert */
+	template <typename U>
+	void _insert(U&& item);
+
+	/* Set algebra helpers.
+	 * Positions number the items in bucket order: bucket(0)'s items first, then bucket(1)'s, and so on.
+	 */
+	/* Calls f(first, last, position) over consecutive ranges [first, last) of buckets covering all of them,
+	 * where position is that of the first item in bucket(first); the ranges run concurrently in parallel mode.
+	 */
+	template <typename Function>
+	void _for_bucket_ranges(Function f) const;
+
+	/* Returns, for the item at every position, whether other contains it */
+	std::vector<char> _membership(const HashSet<T, Hash, Allocator>& other) const;
+
+	/* Returns an empty set with this's hash function, load factor, allocator and modes */
+	HashSet<T, Hash, Allocator> _empty_copy() const;
+
+	/* Returns a set configured like this, holding the items of source whose membership in against is wanted */
+	HashSet<T, Hash, Allocator> _filtered(const HashSet<T, Hash, Allocator>& source,
+	                                      const HashSet<T, Hash, Allocator>& against, bool wanted) const;
+
+	/* Links every item of source whose position satisfies select, without checking for duplicates or the load factor */
+	template <typename Select>
+	void _link_if(const HashSet<T, Hash, Allocator>& source, Select select);
+
+	/* Unlinks every item whose position satisfies select */
+	template <typename Select>
+	void _erase_if(Select select);
+
+	/* Unlinks item if it is in the set */
+	void _erase_if_present(const T& item);
 };
 
 
-template <typename T>
-HashSet<T>::HashSet(const std::function<int(const T&)>& hasher, double the_load_factor)
-	: hash{hasher}, bins{_HASH_SET_INITIAL_SIZE}, table{new LinkedList<T>[bins]}, lft{the_load_factor}, length{0}
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet() : HashSet{Hash{}, _HASH_SET_LOAD_FACTOR_THRESHOLD}
 {
 }
 
-template <typename T>
-HashSet<T>::HashSet(const std::function<int(const T&)>& hasher) : HashSet{hasher, _HASH_SET_LOAD_FACTOR_THRESHOLD}
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const Hash& hasher, double the_load_factor, const Allocator& the_allocator)
+	: HashSet{Hasher<T, Hash>{hasher}, the_load_factor, the_allocator, 0}
 {
 }
 
-template <typename T>
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const Hash& hasher) : HashSet{hasher, _HASH_SET_LOAD_FACTOR_THRESHOLD}
+{
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const Allocator& the_allocator) : HashSet{Hash{}, _HASH_SET_LOAD_FACTOR_THRESHOLD, the_allocator}
+{
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const std::function<int(const T&)>& hasher, double the_load_factor)
+	: HashSet{Hasher<T, Hash>{hasher}, the_load_factor, Allocator{}, 0}
+{
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const Hasher<T, Hash>& hasher, double the_load_factor, const Allocator& the_allocator, int)
+	: allocator{the_allocator}, hash{hasher}, bins{_HASH_SET_INITIAL_SIZE}, table{_new_table(bins)},
+	  old_table{nullptr}, old_bins{0}, migrated{0}, lft{the_load_factor}, length{0}, incremental{false}, parallelism{1}
+{
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const std::function<int(const T&)>& hasher) : HashSet{hasher, _HASH_SET_LOAD_FACTOR_THRESHOLD}
+{
+}
+
+template <typename T, typename Hash, typename Allocator>
 template <typename Container>
-HashSet<T>::HashSet(const Container& iterable, const std::function<int(const T&)>& hasher) : HashSet{hasher}
+HashSet<T, Hash, Allocator>::HashSet(const Container& iterable, const std::function<int(const T&)>& hasher) : HashSet{hasher}
 {
 	for (const auto& item : iterable)
 		insert(item);
 }
 
-template <typename T>
-HashSet<T>::HashSet(const HashSet<T>& right)
-	: hash{right.hash}, bins{right.bins}, table{new LinkedList<T>[bins]}, lft{right.lft}, length{right.length}
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(const HashSet<T, Hash, Allocator>& right)
+	: allocator{std::allocator_traits<Allocator>::select_on_container_copy_construction(right.allocator)},
+	  hash{right.hash}, bins{right.bins}, table{_new_table(bins)},
+	  old_table{nullptr}, old_bins{0}, migrated{0}, lft{right.lft}, length{right.length}, incremental{right.incremental},
+	  parallelism{right.parallelism}
 {
 	for (unsigned int i = 0; i < right.bins; ++i)
 		table[i] = right.table[i];
+	_copy_migration(right);
 }
 
-template <typename T>
-HashSet<T>::~HashSet()
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::HashSet(HashSet<T, Hash, Allocator>&& right)
+	: allocator{right.allocator}, hash{right.hash}, bins{right.bins}, table{right.table},
+	  old_table{right.old_table}, old_bins{right.old_bins}, migrated{right.migrated},
+	  lft{right.lft}, length{right.length}, incremental{right.incremental}, parallelism{right.parallelism}
 {
-	delete[] table;
+	right.bins = _HASH_SET_INITIAL_SIZE;
+	right.table = right._new_table(right.bins);
+	right.old_table = nullptr;
+	right.old_bins = right.migrated = 0;
+	right.length = 0;
 }
 
-template <typename T>
-HashSet<T>& HashSet<T>::operator=(const HashSet<T>& right)
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::~HashSet()
+{
+	_delete_table(table, bins);
+	_delete_table(old_table, old_bins);
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>& HashSet<T, Hash, Allocator>::operator=(const HashSet<T, Hash, Allocator>& right)
 {
 	if (this != &right)
 	{
-		delete[] table;
+		if (bins != right.bins)
+		{
+			_delete_table(table, bins);
+			bins = right.bins;
+			table = _new_table(bins);
+		}
 		hash = right.hash;
-		bins = right.bins;
 		lft = right.lft;
 		length = right.length;
-		table = new LinkedList<T>[bins];
+		incremental = right.incremental;
+		parallelism = right.parallelism;
 
-		for (unsigned int i = 0; i < bins; ++i)
+		// LinkedList::operator= reuses the nodes already in each bin
+		for (int i = 0; i < bins; ++i)
 			table[i] = right.table[i];
+		_copy_migration(right);
 	}
 	return *this;
 }
 
-template <typename T>
-bool HashSet<T>::operator==(const HashSet<T>& right) const
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>& HashSet<T, Hash, Allocator>::operator=(HashSet<T, Hash, Allocator>&& right)
 {
-	if (this == &right)
-		return true;
-	if (size() != right.size())
-		return false;
-
-	for (unsigned int i = 0; i < right.bins; ++i)
+	if (this != &right)
 	{
-		for (const auto& item : right.table[i])
-		{
-			if (!contains(item))
-				return false;
-		}
+		std::swap(allocator, right.allocator);
+		std::swap(hash, right.hash);
+		std::swap(bins, right.bins);
+		std::swap(table, right.table);
+		std::swap(old_table, right.old_table);
+		std::swap(old_bins, right.old_bins);
+		std::swap(migrated, right.migrated);
+		std::swap(lft, right.lft);
+		std::swap(length, right.length);
+		std::swap(incremental, right.incremental);
+		std::swap(parallelism, right.parallelism);
 	}
-	return true;
+	return *this;
 }
 
-template <typename T>
-bool HashSet<T>::operator!=(const HashSet<T>& right) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::operator==(const HashSet<T, Hash, Allocator>& right) const
+{
+	return this == &right || (size() == right.size() && operator<=(right));
+}
+
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::operator!=(const HashSet<T, Hash, Allocator>& right) const
 {
 	return !operator==(right);
 }
 
-template <typename T>
-bool HashSet<T>::operator<(const HashSet<T>& other) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::operator<(const HashSet<T, Hash, Allocator>& other) const
 {
-	return operator<=(other) && operator!=(other);
+	return size() < other.size() && operator<=(other);
 }
 
-template <typename T>
-bool HashSet<T>::operator<=(const HashSet<T>& other) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::operator<=(const HashSet<T, Hash, Allocator>& other) const
 {
+	if (this == &other)
+		return true;
 	if (size() > other.size())
 		return false;
 
-	for (unsigned int i = 0; i < bins; ++i)
-	{
-		for (const auto& item : table[i])
+	std::atomic<bool> missing{false};
+	_for_bucket_ranges([&](int first, int last, int) {
+		for (int i = first; i < last && !missing; ++i)
 		{
-			if (!other.contains(item))
-				return false;
+			for (const auto& item : bucket(i))
+			{
+				if (!other.contains(item))
+				{
+					missing = true;
+					break;
+				}
+			}
 		}
-	}
-	return true;
+	});
+	return !missing;
 }
 
-template <typename T>
-bool HashSet<T>::operator>(const HashSet<T>& other) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::operator>(const HashSet<T, Hash, Allocator>& other) const
 {
 	return other < *this;
 }
 
-template <typename T>
-bool HashSet<T>::operator>=(const HashSet<T>& other) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::operator>=(const HashSet<T, Hash, Allocator>& other) const
 {
-	return !operator<(other);
+	return other <= *this;
 }
 
-template <typename T>
-HashSet<T> HashSet<T>::operator+(const HashSet<T>& right) const
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator> HashSet<T, Hash, Allocator>::operator+(const HashSet<T, Hash, Allocator>& right) const
 {
-	HashSet<T> result{*this};
-	result.combine(right);
+	std::vector<char> present = right._membership(*this);
+	HashSet<T, Hash, Allocator> result = _empty_copy();
+	result.reserve(size() + static_cast<int>(std::count(present.begin(), present.end(), 0)));
 
+	result._link_if(*this, [](int) { return true; });
+	result._link_if(right, [&](int position) { return !present[position]; });
 	return result;
 }
 
-template <typename T>
-HashSet<T> HashSet<T>::operator-(const HashSet<T>& right) const
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator> HashSet<T, Hash, Allocator>::operator-(const HashSet<T, Hash, Allocator>& right) const
 {
-	HashSet<T> result{hash};
-	for (unsigned int i = 0; i < bins; ++i)
-	{
-		for (const auto& item : table[i])
-		{
-			if (!right.contains(item))
-				result.insert(item);
-		}
-	}
+	return _filtered(*this, right, false);
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator> HashSet<T, Hash, Allocator>::operator&(const HashSet<T, Hash, Allocator>& right) const
+{
+	return size() <= right.size() ? _filtered(*this, right, true) : _filtered(right, *this, true);
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator> HashSet<T, Hash, Allocator>::operator^(const HashSet<T, Hash, Allocator>& right) const
+{
+	std::vector<char> in_right = _membership(right);
+	std::vector<char> in_this = right._membership(*this);
+	HashSet<T, Hash, Allocator> result = _empty_copy();
+	result.reserve(static_cast<int>(std::count(in_right.begin(), in_right.end(), 0) + std::count(in_this.begin(), in_this.end(), 0)));
+
+	result._link_if(*this, [&](int position) { return !in_right[position]; });
+	result._link_if(right, [&](int position) { return !in_this[position]; });
 	return result;
 }
 
-template <typename T>
-std::ostream& operator<<(std::ostream& os, const HashSet<T>& set)
+template <typename T, typename Hash, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const HashSet<T, Hash, Allocator>& set)
 {
 	os << "hash_set(";
 	unsigned int c = 0;
-	for (unsigned int i = 0; i < set.bins; ++i)
+	for (int i = 0; i < set.buckets(); ++i)
 	{
-		for (const auto& item : set.table[i])
+		for (const auto& item : set.bucket(i))
 			os << item << (c++ < set.size() - 1 ? ", " : "");
 	}
 	os << ")";
@@ -296,160 +529,483 @@ std::ostream& operator<<(std::ostream& os, const HashSet<T>& set)
 	return os;
 }
 
-template <typename T>
-int HashSet<T>::size() const
+template <typename T, typename Hash, typename Allocator>
+int HashSet<T, Hash, Allocator>::size() const
 {
 	return length;
 }
 
-template <typename T>
-bool HashSet<T>::empty() const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::empty() const
 {
 	return size() == 0;
 }
 
-template <typename T>
-bool HashSet<T>::contains(const T& item) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::contains(const T& item) const
 {
-	return table[get_bin(item)].contains(item);
+	return bucket(get_bin(item)).contains(item);
 }
 
-template <typename T>
-std::string HashSet<T>::str() const
+template <typename T, typename Hash, typename Allocator>
+std::string HashSet<T, Hash, Allocator>::str() const
 {
 	std::ostringstream result;
 	result << "hash_set(" << std::endl;
-	for (unsigned int i = 0; i < bins; ++i)
-		result << "  " << i << ": " << table[i] << std::endl;
+	for (int i = 0; i < buckets(); ++i)
+		result << "  " << (i < bins ? "" : "old ") << (i < bins ? i : i - bins) << ": " << bucket(i) << std::endl;
 
 	result << ")";
 	return result.str();
 }
 
-template <typename T>
-void HashSet<T>::insert(const T& item)
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::insert(const T& item)
+{
+	_insert(item);
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::insert(T&& item)
+{
+	_insert(std::move(item));
+}
+
+template <typename T, typename Hash, typename Allocator>
+template <typename U>
+void HashSet<T, Hash, Allocator>::_insert(U&& item)
+{
+	_migrate(_HASH_SET_MIGRATION_STEP);
+	std::size_t hashed = hash(item);
+	for (auto& existing : bucket(bin_of(hashed)))
+	{
+		if (existing == item)
+		{
+			existing = std::forward<U>(item);
+			return;
+		}
+	}
+	if (load_factor() >= lft)
+		_rehash();
+
+	bucket(bin_of(hashed)).push_front(std::forward<U>(item));
+	++length;
+}
+
+template <typename T, typename Hash, typename Allocator>
+template <typename... Args>
+bool HashSet<T, Hash, Allocator>::emplace(Args&&... args)
 {
-	if (contains(item))
-		erase(item);
+	// build the node off to the side, so it can be linked into its bin without moving the item
+	Bucket staged{allocator};
+	staged.emplace_front(std::forward<Args>(args)...);
+	_migrate(_HASH_SET_MIGRATION_STEP);
+
+	std::size_t hashed = hash(staged.first());
+	if (bucket(bin_of(hashed)).contains(staged.first()))
+		return false;
+
 	if (load_factor() >= lft)
 		_rehash();
 
-	table[get_bin(item)].push_front(item);
+	bucket(bin_of(hashed)).splice_front(staged);
 	++length;
+	return true;
 }
 
-template <typename T>
-void HashSet<T>::erase(const T& item)
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::erase(const T& item)
 {
+	_migrate(_HASH_SET_MIGRATION_STEP);
 	if (!contains(item))
 		throw std::invalid_argument{"key is not in map"};
 
-	table[get_bin(item)].erase(item);
+	bucket(get_bin(item)).erase(item);
 	--length;
 }
 
-template <typename T>
-void HashSet<T>::difference(const HashSet<T>& other)
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::difference(const HashSet<T, Hash, Allocator>& other)
 {
-	LinkedList<T> to_remove;
-	for (unsigned int i = 0; i < bins; ++i)
+	if (this == &other)
 	{
-		for (const auto& item : table[i])
+		_erase_if([](int) { return true; });
+		return;
+	}
+
+	if (other.size() < size())
+	{
+		for (int i = 0; i < other.buckets(); ++i)
 		{
-			if (other.contains(item))
-				to_remove.push_front(item);
+			for (const auto& item : other.bucket(i))
+				_erase_if_present(item);
 		}
 	}
-	for (const auto& item : to_remove)
-		erase(item);
+	else
+	{
+		std::vector<char> present = _membership(other);
+		_erase_if([&](int position) { return present[position]; });
+	}
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::intersect(const HashSet<T, Hash, Allocator>& other)
+{
+	if (this == &other)
+		return;
+
+	if (other.size() < size())
+		*this = _filtered(other, *this, true);
+	else
+	{
+		std::vector<char> present = _membership(other);
+		_erase_if([&](int position) { return !present[position]; });
+	}
 }
 
-template <typename T>
-void HashSet<T>::combine(const HashSet<T>& other)
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::symmetric_difference(const HashSet<T, Hash, Allocator>& other)
 {
-	for (unsigned int i = 0; i < other.bins; ++i)
+	if (this == &other)
 	{
-		for (const auto& item : other.table[i])
+		_erase_if([](int) { return true; });
+		return;
+	}
+
+	std::vector<char> present = other._membership(*this);
+	reserve(size() + static_cast<int>(std::count(present.begin(), present.end(), 0)));
+
+	// the shared items are unlinked as other is walked; _link_if only links the rest
+	_link_if(other, [&](int position) { return !present[position]; });
+	int position = 0;
+	for (int i = 0; i < other.buckets(); ++i)
+	{
+		for (const auto& item : other.bucket(i))
 		{
-			if (!contains(item))
-				insert(item);
+			if (present[position++])
+				_erase_if_present(item);
 		}
 	}
 }
 
-template <typename T>
-double HashSet<T>::load_factor() const
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::combine(const HashSet<T, Hash, Allocator>& other)
+{
+	if (this == &other)
+		return;
+
+	std::vector<char> present = other._membership(*this);
+	reserve(size() + static_cast<int>(std::count(present.begin(), present.end(), 0)));
+	_link_if(other, [&](int position) { return !present[position]; });
+}
+
+template <typename T, typename Hash, typename Allocator>
+double HashSet<T, Hash, Allocator>::load_factor() const
 {
 	return size() / static_cast<double>(bins);
 }
 
-template <typename T>
-void HashSet<T>::_rehash()
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::reserve(int n)
 {
-	int old_bins = bins;
-	bins *= 2;
-	LinkedList<T>* reallocated = new LinkedList<T>[bins];
-	for (unsigned int i = 0; i < old_bins; ++i)
+	rehash(static_cast<int>(std::ceil(n / lft)));
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::rehash(int n)
+{
+	_finish_migration();
+	int needed = std::max(n, static_cast<int>(std::ceil(size() / lft)));
+	int new_bins = bins;
+	while (new_bins < needed)
+		new_bins *= 2;
+
+	if (new_bins != bins)
+		_rehash(new_bins);
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::set_incremental_rehash(bool enabled)
+{
+	incremental = enabled;
+	if (!incremental)
+		_finish_migration();
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::set_parallelism(int threads)
+{
+	parallelism = std::max(1, threads);
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_rehash()
+{
+	if (incremental)
+		_begin_migration();
+	else
+		_rehash(bins * 2);
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_rehash(int new_bins)
+{
+	_finish_migration();
+	int previous_bins = bins;
+	bins = new_bins;
+	Bucket* reallocated = _new_table(bins);
+	for (int i = 0; i < previous_bins; ++i)
 	{
-		for (const auto& item : table[i])
-			reallocated[get_bin(item)].push_back(item);
+		while (!table[i].empty())
+			reallocated[get_bin(table[i].first())].splice_front(table[i]);
 	}
 
-	delete[] table;
+	_delete_table(table, previous_bins);
 	table = reallocated;
 }
 
-template <typename T>
-int HashSet<T>::get_bin(const T& item) const
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_begin_migration()
+{
+	// the previous generation is normally long gone by now; if not, it must be emptied before being replaced
+	_finish_migration();
+	old_table = table;
+	old_bins = bins;
+	migrated = 0;
+	bins *= 2;
+	table = _new_table(bins);
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_migrate(int step)
+{
+	if (old_table == nullptr)
+		return;
+
+	for (int last = std::min(old_bins, migrated + step); migrated < last; ++migrated)
+	{
+		Bucket& old = old_table[migrated];
+		while (!old.empty())
+			table[hash(old.first()) & static_cast<std::size_t>(bins - 1)].splice_front(old);
+	}
+
+	if (migrated == old_bins)
+	{
+		_delete_table(old_table, old_bins);
+		old_table = nullptr;
+		old_bins = migrated = 0;
+	}
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_finish_migration()
+{
+	_migrate(old_bins);
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_copy_migration(const HashSet<T, Hash, Allocator>& right)
+{
+	_delete_table(old_table, old_bins);
+	old_table = nullptr;
+	old_bins = right.old_bins;
+	migrated = right.migrated;
+	if (right.old_table != nullptr)
+	{
+		old_table = _new_table(old_bins);
+		for (int i = migrated; i < old_bins; ++i)
+			old_table[i] = right.old_table[i];
+	}
+}
+
+template <typename T, typename Hash, typename Allocator>
+template <typename Function>
+void HashSet<T, Hash, Allocator>::_for_bucket_ranges(Function f) const
+{
+	int parts = size() < _HASH_SET_PARALLEL_MINIMUM ? 1 : std::min(parallelism, buckets());
+	if (parts <= 1)
+	{
+		f(0, buckets(), 0);
+		return;
+	}
+
+	int per_part = (buckets() + parts - 1) / parts;
+	int position = 0;
+	std::vector<std::future<void>> parts_done;
+	for (int first = 0; first < buckets(); first += per_part)
+	{
+		int last = std::min(buckets(), first + per_part);
+		parts_done.push_back(std::async(std::launch::async, f, first, last, position));
+		for (int i = first; i < last; ++i)
+			position += bucket(i).size();
+	}
+	for (auto& part : parts_done)
+		part.get();
+}
+
+template <typename T, typename Hash, typename Allocator>
+std::vector<char> HashSet<T, Hash, Allocator>::_membership(const HashSet<T, Hash, Allocator>& other) const
+{
+	std::vector<char> present(size());
+	_for_bucket_ranges([&](int first, int last, int position) {
+		for (int i = first; i < last; ++i)
+		{
+			for (const auto& item : bucket(i))
+				present[position++] = other.contains(item);
+		}
+	});
+	return present;
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator> HashSet<T, Hash, Allocator>::_empty_copy() const
+{
+	HashSet<T, Hash, Allocator> result{hash, lft, allocator, 0};
+	result.incremental = incremental;
+	result.parallelism = parallelism;
+	return result;
+}
+
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator> HashSet<T, Hash, Allocator>::_filtered(const HashSet<T, Hash, Allocator>& source,
+                                                                   const HashSet<T, Hash, Allocator>& against, bool wanted) const
+{
+	std::vector<char> present = source._membership(against);
+	HashSet<T, Hash, Allocator> result = _empty_copy();
+	result.reserve(static_cast<int>(std::count(present.begin(), present.end(), wanted)));
+	result._link_if(source, [&](int position) { return static_cast<bool>(present[position]) == wanted; });
+	return result;
+}
+
+template <typename T, typename Hash, typename Allocator>
+template <typename Select>
+void HashSet<T, Hash, Allocator>::_link_if(const HashSet<T, Hash, Allocator>& source, Select select)
+{
+	int position = 0;
+	for (int i = 0; i < source.buckets(); ++i)
+	{
+		for (const auto& item : source.bucket(i))
+		{
+			if (select(position++))
+			{
+				bucket(get_bin(item)).push_front(item);
+				++length;
+			}
+		}
+	}
+}
+
+template <typename T, typename Hash, typename Allocator>
+template <typename Select>
+void HashSet<T, Hash, Allocator>::_erase_if(Select select)
+{
+	int position = 0;
+	for (int i = 0; i < buckets(); ++i)
+		length -= bucket(i).remove_if([&](const T&) { return select(position++); });
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_erase_if_present(const T& item)
+{
+	length -= bucket(get_bin(item)).remove_if([&](const T& existing) { return existing == item; });
+}
+
+template <typename T, typename Hash, typename Allocator>
+typename HashSet<T, Hash, Allocator>::Bucket* HashSet<T, Hash, Allocator>::_new_table(int n) const
+{
+	Bucket* created = static_cast<Bucket*>(::operator new(n * sizeof(Bucket)));
+	for (int i = 0; i < n; ++i)
+		new (&created[i]) Bucket{allocator};
+	return created;
+}
+
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::_delete_table(Bucket* to_delete, int n)
+{
+	if (to_delete == nullptr)
+		return;
+
+	for (int i = 0; i < n; ++i)
+		to_delete[i].~Bucket();
+	::operator delete(to_delete);
+}
+
+template <typename T, typename Hash, typename Allocator>
+int HashSet<T, Hash, Allocator>::get_bin(const T& item) const
+{
+	return bin_of(hash(item));
+}
+
+template <typename T, typename Hash, typename Allocator>
+int HashSet<T, Hash, Allocator>::bin_of(std::size_t hashed) const
+{
+	if (old_table != nullptr)
+	{
+		int old = static_cast<int>(hashed & static_cast<std::size_t>(old_bins - 1));
+		if (old >= migrated)
+			return bins + old;
+	}
+	return static_cast<int>(hashed & static_cast<std::size_t>(bins - 1));
+}
+
+template <typename T, typename Hash, typename Allocator>
+typename HashSet<T, Hash, Allocator>::Bucket& HashSet<T, Hash, Allocator>::bucket(int i) const
+{
+	return i < bins ? table[i] : old_table[i - bins];
+}
+
+template <typename T, typename Hash, typename Allocator>
+int HashSet<T, Hash, Allocator>::buckets() const
 {
-	return std::abs(hash(item)) % bins;
+	return old_table == nullptr ? bins : bins + old_bins;
 }
 
 
 // iterator implementation
-template <typename T>
-auto HashSet<T>::begin() const -> HashSet<T>::iterator
+template <typename T, typename Hash, typename Allocator>
+auto HashSet<T, Hash, Allocator>::begin() const -> HashSet<T, Hash, Allocator>::iterator
 {
-	return iterator{const_cast<HashSet<T>*>(this), 0};
+	return iterator{const_cast<HashSet<T, Hash, Allocator>*>(this), 0};
 }
 
-template <typename T>
-auto HashSet<T>::end() const -> HashSet<T>::iterator
+template <typename T, typename Hash, typename Allocator>
+auto HashSet<T, Hash, Allocator>::end() const -> HashSet<T, Hash, Allocator>::iterator
 {
-	return iterator{const_cast<HashSet<T>*>(this), size()};
+	return iterator{const_cast<HashSet<T, Hash, Allocator>*>(this), size()};
 }
 
-template <typename T>
-HashSet<T>::iterator::iterator(HashSet<T>* it, int already)
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::iterator::iterator(HashSet<T, Hash, Allocator>* it, int already)
 	: ref{it}, traversed{already}, current_bin_index{-1}
 {
 	advance_bin();
 }
 
-template <typename T>
-HashSet<T>::iterator::iterator() : iterator{nullptr, 0}
+template <typename T, typename Hash, typename Allocator>
+HashSet<T, Hash, Allocator>::iterator::iterator() : iterator{nullptr, 0}
 {
 }
 
-template <typename T>
-bool HashSet<T>::iterator::done() const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::iterator::done() const
 {
 	return traversed >= ref->size();
 }
 
-template <typename T>
-void HashSet<T>::iterator::advance_bin()
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::iterator::advance_bin()
 {
-	if (current_bin_index >= ref->bins)
+	int last = ref->buckets();
+	if (current_bin_index >= last)
 		throw std::out_of_range{"hash_set::iterator::advance_bin() -- cursor past end"};
 
-	for (++current_bin_index; current_bin_index < ref->bins && ref->table[current_bin_index].empty(); ++current_bin_index)
+	for (++current_bin_index; current_bin_index < last && ref->bucket(current_bin_index).empty(); ++current_bin_index)
 	{ /* advance current_bin_index to next non-empty bin */ }
-	current = ref->table[current_bin_index].begin();
+	current = current_bin_index < last ? ref->bucket(current_bin_index).begin() : typename Bucket::iterator{};
 }
 
-template <typename T>
-void HashSet<T>::iterator::next()
+template <typename T, typename Hash, typename Allocator>
+void HashSet<T, Hash, Allocator>::iterator::next()
 {
 	try
 	{
@@ -462,8 +1018,8 @@ void HashSet<T>::iterator::next()
 	++traversed;
 }
 
-template <typename T>
-auto HashSet<T>::iterator::operator++() -> HashSet<T>::iterator&
+template <typename T, typename Hash, typename Allocator>
+auto HashSet<T, Hash, Allocator>::iterator::operator++() -> HashSet<T, Hash, Allocator>::iterator&
 {
 	if (!done())
 		next();
@@ -471,8 +1027,8 @@ auto HashSet<T>::iterator::operator++() -> HashSet<T>::iterator&
 	return *this;
 }
 
-template <typename T>
-auto HashSet<T>::iterator::operator++(int) -> HashSet<T>::iterator
+template <typename T, typename Hash, typename Allocator>
+auto HashSet<T, Hash, Allocator>::iterator::operator++(int) -> HashSet<T, Hash, Allocator>::iterator
 {
 	iterator to_return{*this};
 	operator++();
@@ -480,20 +1036,20 @@ auto HashSet<T>::iterator::operator++(int) -> HashSet<T>::iterator
 	return to_return;
 }
 
-template <typename T>
-bool HashSet<T>::iterator::operator==(const HashSet<T>::iterator& right) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::iterator::operator==(const HashSet<T, Hash, Allocator>::iterator& right) const
 {
 	return ref == right.ref && traversed == right.traversed;
 }
 
-template <typename T>
-bool HashSet<T>::iterator::operator!=(const HashSet<T>::iterator& right) const
+template <typename T, typename Hash, typename Allocator>
+bool HashSet<T, Hash, Allocator>::iterator::operator!=(const HashSet<T, Hash, Allocator>::iterator& right) const
 {
 	return !operator==(right);
 }
 
-template <typename T>
-T& HashSet<T>::iterator::operator*() const
+template <typename T, typename Hash, typename Allocator>
+T& HashSet<T, Hash, Allocator>::iterator::operator*() const
 {
 	if (done())
 		throw std::out_of_range{"hash_set::iterator::operator* -- cursor past end"};
@@ -501,8 +1057,8 @@ T& HashSet<T>::iterator::operator*() const
 	return *current;
 }
 
-template <typename T>
-T* HashSet<T>::iterator::operator->() const
+template <typename T, typename Hash, typename Allocator>
+T* HashSet<T, Hash, Allocator>::iterator::operator->() const
 {
 	if (done())
 		throw std::out_of_range{"hash_set::iterator::operator-> -- cursor past end"};
@@ -0,0 +1,65 @@
+// This header defines the hasher stored by HashMap, HashSet and FlatHashMap.
+//
+// Tables are templated on a Hash function object (defaulting to std::hash, as in LinkedHashMap),
+// so hashing is a direct, inlinable call.
+// For compatibility with the original interface, a Hasher can instead be built from a
+// std::function<int(const KEY&)>; that function is shared (not copied) between copies of a table,
+// and is only consulted when it was supplied.
+#ifndef DATA_STRUCTURES_HASHER_HPP
+#define DATA_STRUCTURES_HASHER_HPP
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+
+
+template <typename KEY, typename Hash>
+class Hasher
+{
+public:
+    typedef std::function<int(const KEY&)> FunctionType;
+
+    Hasher();
+    explicit Hasher(const Hash& hasher);
+    explicit Hasher(FunctionType hasher);
+
+    /* Returns the hash of key as an unsigned value */
+    std::size_t operator()(const KEY& key) const;
+
+private:
+    Hash hash;
+    std::shared_ptr<const FunctionType> function;    // only set by the std::function adapter
+};
+
+
+template <typename KEY, typename Hash>
+Hasher<KEY, Hash>::Hasher()
+    : hash{}, function{nullptr}
+{
+}
+
+template <typename KEY, typename Hash>
+Hasher<KEY, Hash>::Hasher(const Hash& hasher)
+    : hash{hasher}, function{nullptr}
+{
+}
+
+template <typename KEY, typename Hash>
+Hasher<KEY, Hash>::Hasher(FunctionType hasher)
+    : hash{}, function{std::make_shared<const FunctionType>(std::move(hasher))}
+{
+}
+
+template <typename KEY, typename Hash>
+inline std::size_t Hasher<KEY, Hash>::operator()(const KEY& key) const
+{
+    if (function)
+        return static_cast<std::size_t>((*function)(key));
+
+    return static_cast<std::size_t>(hash(key));
+}
+
+
+#endif // DATA_STRUCTURES_HASHER_HPP
@@ -5,9 +5,13 @@
 // a map, which retains the time complexity properties of a standard hash table,
 // while also maintaining the order in which objects are added.
 // 
-// This implementation uses a hash table (std::unordered_map) as its underlying data structure.
-// Each item contains a pointer to the previous and next items in the set, conceptually representing a doubly-linked list.
-// Bidirectional iterators are implemented simply by following each link to its next/previous neighbor.
+// This implementation stores its {key: value} pairs in a LinkedHashTable (see linked_hash_table.hpp):
+// a dense array of slots, each holding one pair plus the 32-bit indices of the previous and next pairs,
+// conceptually representing a doubly-linked list; erased slots are recycled through a free list.
+// Bidirectional iterators are implemented simply by following each index to its next/previous neighbor.
+// Both the slot array and the lookup index are allocated from Allocator (see pool_allocator.hpp).
+// write_snapshot() saves the map in insertion order, and read_snapshot() reloads it into a table
+// reserved at its final capacity in one pass (see snapshot.hpp).
 //
 // The comment-descriptions nested within the member function declarations go into further detail regarding time complexity.
 // 
@@ -16,15 +20,15 @@
 //   compiler: g++ (GCC) 5.4.0
 //   flags: -std=c++14 -ggdb
 
-#include <algorithm>
+#include "linked_hash_table.hpp"
+#include "snapshot.hpp"
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <string>
-#include <type_traits>
-#include <unordered_map>
+#include <tuple>
 #include <utility>
 #include <cstddef>
 
@@ -32,31 +36,33 @@
 template <typename Key,
           typename T, 
           typename Hash = std::hash<Key>, 
-          typename Predicate = std::equal_to<Key>>
+          typename Predicate = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
 class LinkedHashMap
 {
 private:
 	typedef std::pair<const Key, T> PairType;
-	typedef std::shared_ptr<Key> LinkType;
-	struct LinkEntry
+	struct KeyOfPair
 	{
-		LinkType previous;
-		LinkType next;
+		const Key& operator()(const PairType& pair) const
+		{
+			return pair.first;
+		}
 	};
 
-	struct ValueEntry
-	{
-		T value;
-		LinkEntry link;
-	};
+	typedef LinkedHashTable<PairType, Key, KeyOfPair, Hash, Predicate, Allocator> Table;
+	typedef typename Table::Index Index;
 
 public:
 	// Constructors
 	LinkedHashMap();
 
+	/* Constructs an empty map whose slots and index are allocated from allocator */
+	explicit LinkedHashMap(const Allocator& allocator);
+
 	// Operators
-	template <typename KeyT, typename TT, typename HashT, typename PredicateT>
-	friend std::ostream& operator<<(std::ostream& os, const LinkedHashMap<KeyT, TT, HashT, PredicateT>& obj);
+	template <typename KeyT, typename TT, typename HashT, typename PredicateT, typename AllocatorT>
+	friend std::ostream& operator<<(std::ostream& os, const LinkedHashMap<KeyT, TT, HashT, PredicateT, AllocatorT>& obj);
 
 	/* Returns true if the map is NOT empty, or false if it is.
 	 * Complexity:
@@ -69,8 +75,8 @@ public:
 	 *   Average case: O(n)
 	 *   Best case: Ω(1) when sizes are different
 	 */
-	bool operator==(const LinkedHashMap<Key, T, Hash, Predicate>& other) const;
-	bool operator!=(const LinkedHashMap<Key, T, Hash, Predicate>& other) const;
+	bool operator==(const LinkedHashMap<Key, T, Hash, Predicate, Allocator>& other) const;
+	bool operator!=(const LinkedHashMap<Key, T, Hash, Predicate, Allocator>& other) const;
 
 	/* Returns a reference to the value associated with key.
 	 * Can be used to insert {key: value} pairs into the map
@@ -151,27 +157,66 @@ public:
 	 */
 	PairType pop_back();
 
+	/* Moves key to the front/back of the ordering, without reallocating or copying its {key: value} pair.
+	 * If key is not in the map, throws std::runtime_error.
+	 * Complexity:
+	 *   Average case: O(1)
+	 *   Worst (and improbable) case: O(n) if every item in the map hashed into the same bucket.
+	 */
+	void move_to_front(const Key& key);
+	void move_to_back(const Key& key);
+
+	/* Moves key to the back of the ordering (i.e., marks it as most-recently used),
+	 * and returns a pointer to its associated value; returns nullptr and does nothing if key is not in the map.
+	 * The pointer remains valid until key is erased, or a later insert grows the map.
+	 * Complexity:
+	 *   (see LinkedHashMap::move_to_back)
+	 */
+	T* touch(const Key& key);
+
 	/* Removes all items from the map.
 	 * Complexity:
 	 *   Θ(N)
 	 */
 	void clear();
 
+	/* Allocates room for n {key: value} pairs, so that inserting them does not grow the map.
+	 * Complexity:
+	 *   O(N + n)
+	 */
+	void reserve(int n);
+
+	/* Writes every {key: value} pair to path in insertion order, with its key's cached hash
+	 * and the map's capacity (see snapshot.hpp); keys and values are encoded by SnapshotCodec.
+	 * Throws a SnapshotError if path cannot be written.
+	 * Complexity:
+	 *   Θ(N)
+	 */
+	void write_snapshot(const std::string& path) const;
+
+	/* Replaces the contents with the snapshot at path, keeping its insertion order.
+	 * Capacity is reserved once, and every pair is appended with its stored hash, without lookups or rehashing.
+	 * Throws a SnapshotError (leaving the map unchanged) if path is not a well-formed snapshot of this type of map,
+	 * or was written with another hash function.
+	 * Complexity:
+	 *   Θ(n), for the n pairs in the snapshot
+	 */
+	void read_snapshot(const std::string& path);
+
 
 private:
-	std::unordered_map<Key, ValueEntry, Hash, Predicate> table;
-	LinkType head;
-	LinkType last;
+	Table table;
 
 	// Iterator Implementation
 	// By templating the iterator_type class with typename UnqualifiedT,
 	// code duplication is virtually eliminated between implementing regular- and const- iterators;
-	// adding 2 public typedefs alias iterator_type<T> as 'iterator', and iterator_type<const T> as 'const_iterator'.
-	template <typename UnqualifiedT = typename std::remove_const<T>::type>
-	class iterator_type : public std::iterator<std::bidirectional_iterator_tag, UnqualifiedT, std::ptrdiff_t, T*, T&>
+	// adding 2 public typedefs alias iterator_type<Key> as 'iterator', and iterator_type<const Key> as 'const_iterator'.
+	// Iterators visit the keys of the map.
+	template <typename UnqualifiedT = typename std::remove_const<Key>::type>
+	class iterator_type : public std::iterator<std::bidirectional_iterator_tag, UnqualifiedT, std::ptrdiff_t, UnqualifiedT*, UnqualifiedT&>
 	{
 	public:
-		iterator_type(const LinkedHashMap<Key, T, Hash, Predicate>* lmap, LinkType start, unsigned int visited);
+		iterator_type(const LinkedHashMap<Key, T, Hash, Predicate, Allocator>* lmap, Index start);
 
 		/* Complexity:
 		 *   All iterator operations incur O(1) time.
@@ -183,23 +228,21 @@ private:
 		auto operator--() -> iterator_type&;
 		auto operator--(int) -> iterator_type;
 		UnqualifiedT& operator*();
-		const LinkType operator->() const;
+		UnqualifiedT* operator->() const;
 
 	private:
-		const LinkedHashMap<Key, T, Hash, Predicate>* ref;	// raw pointer (instead of smart pointer) because no dynamic allocation or modifying operations are used
-		LinkType current;
-		unsigned int traversed;	// store a value representing the current "index"
-								// to allow Θ(1) iterator equality comparisons.
+		const LinkedHashMap<Key, T, Hash, Predicate, Allocator>* ref;	// raw pointer (instead of smart pointer) because no dynamic allocation or modifying operations are used
+		Index current;		// Table::NONE when past the end
 
 		/* If the iterator is already past the end, throws std::runtime_error{message}.
 		 * Helper member function for operator* and operator->.
 		 */
-		void bound_check(const std::string& message) const;
+		void bound_check(const char* message) const;
 	};
 
 	
 public:
-	typedef iterator_type<const T> const_iterator;
+	typedef iterator_type<const Key> const_iterator;
 	typedef const_iterator iterator;
 
 	auto cbegin() const -> const_iterator;
@@ -212,14 +255,20 @@ public:
 };
 
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-LinkedHashMap<Key, T, Hash, Predicate>::LinkedHashMap()
-	: head{nullptr}, last{nullptr}
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+LinkedHashMap<Key, T, Hash, Predicate, Allocator>::LinkedHashMap()
+	: table{}
+{
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+LinkedHashMap<Key, T, Hash, Predicate, Allocator>::LinkedHashMap(const Allocator& allocator)
+	: table{allocator}
 {
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-std::ostream& operator<<(std::ostream& os, const LinkedHashMap<Key, T, Hash, Predicate>& obj)
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const LinkedHashMap<Key, T, Hash, Predicate, Allocator>& obj)
 {
 	os << "LinkedHashMap(";
 	auto i = obj.begin();
@@ -237,262 +286,329 @@ std::ostream& operator<<(std::ostream& os, const LinkedHashMap<Key, T, Hash, Pre
 	return os;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-LinkedHashMap<Key, T, Hash, Predicate>::operator bool() const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+LinkedHashMap<Key, T, Hash, Predicate, Allocator>::operator bool() const
 {
 	return !empty();
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-bool LinkedHashMap<Key, T, Hash, Predicate>::operator==(const LinkedHashMap<Key, T, Hash, Predicate>& other) const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashMap<Key, T, Hash, Predicate, Allocator>::operator==(const LinkedHashMap<Key, T, Hash, Predicate, Allocator>& other) const
 {
-	return table == other.table;
+	if (size() != other.size())
+	{
+		return false;
+	}
+	for (Index i = table.front(), j = other.table.front(); i != Table::NONE; i = table.next(i), j = other.table.next(j))
+	{
+		if (!(table.value(i) == other.table.value(j)))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-bool LinkedHashMap<Key, T, Hash, Predicate>::operator!=(const LinkedHashMap<Key, T, Hash, Predicate>& other) const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashMap<Key, T, Hash, Predicate, Allocator>::operator!=(const LinkedHashMap<Key, T, Hash, Predicate, Allocator>& other) const
 {
 	return !operator==(other);
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-T& LinkedHashMap<Key, T, Hash, Predicate>::operator[](const Key& key)
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+T& LinkedHashMap<Key, T, Hash, Predicate, Allocator>::operator[](const Key& key)
 {
-	if (!contains(key))
-	{
-		insert(key, T{});
-	}
-	return table[key].value;
+	Index slot = table.emplace_back(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first;
+	return table.value(slot).second;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-const T& LinkedHashMap<Key, T, Hash, Predicate>::operator[](const Key& key) const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+const T& LinkedHashMap<Key, T, Hash, Predicate, Allocator>::operator[](const Key& key) const
 {
-	if (!contains(key))
+	Index slot = table.find(key);
+	if (slot == Table::NONE)
 	{
 		throw std::runtime_error{"key does not exist"};
 	}
-	return table.at(key).value;
+	return table.value(slot).second;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-int LinkedHashMap<Key, T, Hash, Predicate>::size() const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+int LinkedHashMap<Key, T, Hash, Predicate, Allocator>::size() const
 {
 	return table.size();
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-bool LinkedHashMap<Key, T, Hash, Predicate>::empty() const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashMap<Key, T, Hash, Predicate, Allocator>::empty() const
 {
 	return size() == 0;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-bool LinkedHashMap<Key, T, Hash, Predicate>::contains(const Key& key) const
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashMap<Key, T, Hash, Predicate, Allocator>::contains(const Key& key) const
 {
-	return table.find(key) != table.end();
+	return table.find(key) != Table::NONE;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-void LinkedHashMap<Key, T, Hash, Predicate>::insert(const Key& key, const T& value)
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+const Key& LinkedHashMap<Key, T, Hash, Predicate, Allocator>::front() const
 {
-	if (!contains(key))
+	if (empty())
 	{
-		LinkType link{new Key{key}};
-		if (!head)
-		{
-			head = link;
-		}
-		if (last)
-		{
-			table[*last].link.next = link;	// link the most-recently inserted item to the about-to-be inserted item
-		}
-		LinkEntry link_entry;
-		link_entry.previous = last;
-		link_entry.next = LinkType{nullptr};
-
-		ValueEntry value_entry;
-		value_entry.value = value;
-		value_entry.link = link_entry;
+		throw std::runtime_error{"map is empty"};
+	}
+	return table.value(table.front()).first;
+}
 
-		table[*link] = value_entry;
-		last = link;
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+const Key& LinkedHashMap<Key, T, Hash, Predicate, Allocator>::back() const
+{
+	if (empty())
+	{
+		throw std::runtime_error{"map is empty"};
 	}
+	return table.value(table.back()).first;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::insert(const Key& key, const T& value)
+{
+	table.emplace_back(key, key, value);
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-void LinkedHashMap<Key, T, Hash, Predicate>::erase(const Key& key)
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::erase(const Key& key)
 {
-	if (!contains(key))
+	Index slot = table.find(key);
+	if (slot == Table::NONE)
 	{
 		throw std::runtime_error{"key does not exist"};
 	}
-	ValueEntry entry = table.at(key);
-	LinkEntry link = entry.link;
-	auto previous = link.previous;
-	auto next = link.next;
-	table.erase(key);
+	table.erase(slot);
+}
 
-	if (previous)	// if there was a node before 'key', then fix the broken link
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+typename LinkedHashMap<Key, T, Hash, Predicate, Allocator>::PairType LinkedHashMap<Key, T, Hash, Predicate, Allocator>::pop_front()
+{
+	if (empty())
 	{
-		table[*previous].link.next = next;
+		throw std::runtime_error{"map is empty"};
 	}
-	else			// otherwise, the head (first key) was just deleted
+	Index slot = table.front();
+	PairType result{std::move(table.value(slot))};
+	table.erase(slot);
+	return result;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+typename LinkedHashMap<Key, T, Hash, Predicate, Allocator>::PairType LinkedHashMap<Key, T, Hash, Predicate, Allocator>::pop_back()
+{
+	if (empty())
 	{
-		head = next;
+		throw std::runtime_error{"map is empty"};
 	}
-	if (next)		// if there was a node after 'key', then fix that broken link
+	Index slot = table.back();
+	PairType result{std::move(table.value(slot))};
+	table.erase(slot);
+	return result;
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::move_to_front(const Key& key)
+{
+	Index slot = table.find(key);
+	if (slot == Table::NONE)
 	{
-		table[*next].link.previous = previous;
+		throw std::runtime_error{"key does not exist"};
 	}
-	else			// otherwise, the tail (last key) was just deleted
+	table.move_to_front(slot);
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::move_to_back(const Key& key)
+{
+	Index slot = table.find(key);
+	if (slot == Table::NONE)
 	{
-		last = previous;
+		throw std::runtime_error{"key does not exist"};
 	}
+	table.move_to_back(slot);
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-typename LinkedHashMap<Key, T, Hash, Predicate>::PairType LinkedHashMap<Key, T, Hash, Predicate>::pop_front()
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+T* LinkedHashMap<Key, T, Hash, Predicate, Allocator>::touch(const Key& key)
 {
-	Key key = *head;
-	PairType result{key, operator[](key)};
-	erase(key);
-	return result;
+	Index slot = table.find(key);
+	if (slot == Table::NONE)
+	{
+		return nullptr;
+	}
+	table.move_to_back(slot);
+	return &table.value(slot).second;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-typename LinkedHashMap<Key, T, Hash, Predicate>::PairType LinkedHashMap<Key, T, Hash, Predicate>::pop_back()
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::clear()
 {
-	Key key = *last;
-	PairType result{key, operator[](key)};
-	erase(key);
-	return result;
+	table.clear();
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-void LinkedHashMap<Key, T, Hash, Predicate>::clear()
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::reserve(int n)
 {
-	if (!empty())
+	table.reserve(n);
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::write_snapshot(const std::string& path) const
+{
+	SnapshotWriter out{path, _SNAPSHOT_LINKED_HASH_MAP, SnapshotCodec<Key>::size, SnapshotCodec<T>::size,
+	                   static_cast<uint64_t>(size()), static_cast<uint64_t>(table.capacity())};
+	for (Index slot = table.front(); slot != Table::NONE; slot = table.next(slot))
 	{
-		head.reset();
-		last.reset();
-		table.clear();
+		out.write(table.hash_of(slot));
+		SnapshotCodec<Key>::write(out, table.value(slot).first);
+		SnapshotCodec<T>::write(out, table.value(slot).second);
+	}
+	out.close();
+}
+
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::read_snapshot(const std::string& path)
+{
+	SnapshotReader in{path, _SNAPSHOT_LINKED_HASH_MAP, SnapshotCodec<Key>::size, SnapshotCodec<T>::size};
+	if (in.count() > in.geometry() || in.geometry() >= Table::NONE / 2)
+	{
+		throw SnapshotError{"LinkedHashMap::read_snapshot - " + path + " has an impossible size or capacity"};
+	}
+
+	Table loaded{table.get_allocator()};
+	loaded.reserve(static_cast<int>(in.geometry()));
+	for (uint64_t i = 0; i < in.count(); ++i)
+	{
+		Index hashed = in.read<Index>();
+		Key key = SnapshotCodec<Key>::read(in);
+		T value = SnapshotCodec<T>::read(in);
+		if (i % _SNAPSHOT_CHECK_STRIDE == 0 && loaded.hash_key(key) != hashed)
+		{
+			throw SnapshotError{"LinkedHashMap::read_snapshot - " + path + " was written with another hash function"};
+		}
+		loaded.append_unchecked(hashed, std::move(key), std::move(value));
 	}
+	table.swap(loaded);
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-auto LinkedHashMap<Key, T, Hash, Predicate>::cbegin() const -> const_iterator
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::cbegin() const -> const_iterator
 {
-	return const_iterator{this, head, 0};
+	return const_iterator{this, table.front()};
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-auto LinkedHashMap<Key, T, Hash, Predicate>::cend() const -> const_iterator
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::cend() const -> const_iterator
 {
-	unsigned int sz = size();		// silence g++ warning about conflicting types (unsigned int vs. int)
-	return const_iterator{this, LinkType{nullptr}, sz};
+	return const_iterator{this, Table::NONE};
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-auto LinkedHashMap<Key, T, Hash, Predicate>::begin() const -> iterator
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::begin() const -> iterator
 {
 	return cbegin();
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
-auto LinkedHashMap<Key, T, Hash, Predicate>::end() const -> iterator
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::end() const -> iterator
 {
 	return cend();
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::iterator_type(const LinkedHashMap<Key, T, Hash, Predicate>* lmap, LinkType start, unsigned int visited)
-	: ref{lmap}, current{start}, traversed{visited}
+LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::iterator_type(const LinkedHashMap<Key, T, Hash, Predicate, Allocator>* lmap, Index start)
+	: ref{lmap}, current{start}
 {
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-bool LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator==(const iterator_type<UnqualifiedT>& other) const
+bool LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator==(const iterator_type<UnqualifiedT>& other) const
 {
-	return ref == other.ref && traversed == other.traversed;
+	return ref == other.ref && current == other.current;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-bool LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator!=(const iterator_type<UnqualifiedT>& other) const
+bool LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator!=(const iterator_type<UnqualifiedT>& other) const
 {
 	return !operator==(other);
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator++() -> iterator_type<UnqualifiedT>&
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator++() -> iterator_type<UnqualifiedT>&
 {
-	if (current && traversed < ref->size())
+	if (current != Table::NONE)
 	{
-		current = ref->table.at(*current).link.next;
-		++traversed;
+		current = ref->table.next(current);
 	}
 	return *this;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator++(int) -> iterator_type<UnqualifiedT>
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator++(int) -> iterator_type<UnqualifiedT>
 {
 	iterator_type state{*this};		// invoke implicit copy constructor
 	operator++();
 	return state;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator--() -> iterator_type<UnqualifiedT>&
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator--() -> iterator_type<UnqualifiedT>&
 {
-	if (!current)	// past end
+	if (current == Table::NONE)	// past end
 	{
-		current = ref->last;
+		current = ref->table.back();
 	}
-	if (current && traversed >= 0)
+	else if (ref->table.previous(current) != Table::NONE)
 	{
-		current = ref->table.at(*current).link.previous;
-		--traversed;
+		current = ref->table.previous(current);
 	}
 	return *this;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator--(int) -> iterator_type<UnqualifiedT>
+auto LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator--(int) -> iterator_type<UnqualifiedT>
 {
 	iterator_type state{*this};
 	operator--();
 	return state;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-UnqualifiedT& LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator*()
+UnqualifiedT& LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator*()
 {
 	bound_check("LinkedHashMap::iterator_type::operator* - iterator past end");
-	return *current;
+	return ref->table.value(current).first;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-const typename LinkedHashMap<Key, T, Hash, Predicate>::LinkType LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator->() const
+UnqualifiedT* LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator->() const
 {
 	bound_check("LinkedHashMap::iterator_type::operator-> iterator past end");
-	return current;
+	return &ref->table.value(current).first;
 }
 
-template <typename Key, typename T, typename Hash, typename Predicate>
+template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-void LinkedHashMap<Key, T, Hash, Predicate>::iterator_type<UnqualifiedT>::bound_check(const std::string& message) const
+void LinkedHashMap<Key, T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::bound_check(const char* message) const
 {
-	if (!current)
+	if (current == Table::NONE)
 	{
 		throw std::runtime_error{message};
 	}
@@ -5,9 +5,11 @@
 // a set, which retains the time complexity properties of a standard hash table,
 // while also maintaining the order in which objects are added.
 // 
-// This implementation uses a hash table (std::unordered_map) as its underlying data structure.
-// Each item contains a pointer to the previous and next items in the set, conceptually representing a doubly-linked list.
-// Bidirectional iterators are implemented simply by following each link to its next/previous neighbor.
+// This implementation stores its items in a LinkedHashTable (see linked_hash_table.hpp):
+// a dense array of slots, each holding one item plus the 32-bit indices of the previous and next items,
+// conceptually representing a doubly-linked list; erased slots are recycled through a free list.
+// Bidirectional iterators are implemented simply by following each index to its next/previous neighbor.
+// Both the slot array and the lookup index are allocated from Allocator (see pool_allocator.hpp).
 //
 // The comment-descriptions nested within the member function declarations go into further detail regarding time complexity.
 // 
@@ -16,7 +18,7 @@
 //   compiler: g++ (GCC) 5.4.0
 //   flags: -std=c++14 -ggdb
 
-#include <algorithm>
+#include "linked_hash_table.hpp"
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -24,28 +26,35 @@
 #include <stdexcept>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 #include <cstddef>
 
 
 template <typename T, 
           typename Hash = std::hash<T>, 
-          typename Predicate = std::equal_to<T>>
+          typename Predicate = std::equal_to<T>,
+          typename Allocator = std::allocator<T>>
 class LinkedHashSet
 {
 private:
-	typedef std::shared_ptr<T> LinkType;
-	struct LinkEntry
+	struct Identity
 	{
-		LinkType previous;
-		LinkType next;
+		const T& operator()(const T& item) const
+		{
+			return item;
+		}
 	};
 
+	typedef LinkedHashTable<T, T, Identity, Hash, Predicate, Allocator> Table;
+	typedef typename Table::Index Index;
+
 public:
 	// Constructors
 	LinkedHashSet();
 
+	/* Constructs an empty set whose slots and index are allocated from allocator */
+	explicit LinkedHashSet(const Allocator& allocator);
+
 	/* Range constructor - populates set with elements [first, last).
 	 * Maintains the order produced by InputIterator::operator++().
 	 */
@@ -53,8 +62,8 @@ public:
 	LinkedHashSet(InputIterator first, InputIterator last);
 
 	// Operators
-	template <typename TT, typename HashT, typename PredicateT>
-	friend std::ostream& operator<<(std::ostream& os, const LinkedHashSet<TT, HashT, PredicateT>& obj);
+	template <typename TT, typename HashT, typename PredicateT, typename AllocatorT>
+	friend std::ostream& operator<<(std::ostream& os, const LinkedHashSet<TT, HashT, PredicateT, AllocatorT>& obj);
 
 	/* Returns true if the set is NOT empty, or false if it is.
 	 * Complexity:
@@ -67,24 +76,24 @@ public:
 	 *   Average case: O(N)
 	 *   Best case: Ω(1) when sizes are different
 	 */
-	bool operator==(const LinkedHashSet<T, Hash, Predicate>& other) const;
-	bool operator!=(const LinkedHashSet<T, Hash, Predicate>& other) const;
+	bool operator==(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const;
+	bool operator!=(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const;
 
-	/* The complexity of each of the following relational operators is Θ(min(N, K)), 
-	 * where K is the number of elements in 'other'
+	/* The complexity of each of the following relational operators is O(K),
+	 * where K is the number of elements in 'other' (or Θ(1) when the sizes alone decide the answer)
 	 */
 
 	/* Returns true if this is a proper subset of other */
-	bool operator<(const LinkedHashSet<T, Hash, Predicate>& other) const;
+	bool operator<(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const;
 
 	/* Returns true if this is a subset of other */
-	bool operator<=(const LinkedHashSet<T, Hash, Predicate>& other) const;
+	bool operator<=(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const;
 
 	/* Returns true if this is a proper superset of other */
-	bool operator>(const LinkedHashSet<T, Hash, Predicate>& other) const;
+	bool operator>(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const;
 
 	/* Returns true if this is a superset of other */
-	bool operator>=(const LinkedHashSet<T, Hash, Predicate>& other) const;
+	bool operator>=(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const;
 
 
 
@@ -154,21 +163,25 @@ public:
 	 */
 	void clear();
 
+	/* Allocates room for n items, so that inserting them does not grow the set.
+	 * Complexity:
+	 *   O(N + n)
+	 */
+	void reserve(int n);
+
 
 private:
-	std::unordered_map<T, LinkEntry, Hash, Predicate> table;
-	LinkType head;
-	LinkType last;
+	Table table;
 
 	// Iterator Implementation
 	// By templating the iterator_type class with typename UnqualifiedT,
 	// code duplication is virtually eliminated between implementing regular- and const- iterators;
 	// adding 2 public typedefs alias iterator_type<T> as 'iterator', and iterator_type<const T> as 'const_iterator'.
 	template <typename UnqualifiedT = typename std::remove_const<T>::type>
-	class iterator_type : public std::iterator<std::bidirectional_iterator_tag, UnqualifiedT, std::ptrdiff_t, T*, T&>
+	class iterator_type : public std::iterator<std::bidirectional_iterator_tag, UnqualifiedT, std::ptrdiff_t, UnqualifiedT*, UnqualifiedT&>
 	{
 	public:
-		iterator_type(const LinkedHashSet<T, Hash, Predicate>* set, LinkType start, unsigned int visited);
+		iterator_type(const LinkedHashSet<T, Hash, Predicate, Allocator>* set, Index start);
 
 		/* Complexity:
 		 *   All iterator operations incur O(1) time.
@@ -180,18 +193,16 @@ private:
 		auto operator--() -> iterator_type&;
 		auto operator--(int) -> iterator_type;
 		UnqualifiedT& operator*();
-		const LinkType operator->() const;
+		UnqualifiedT* operator->() const;
 
 	private:
-		const LinkedHashSet<T, Hash, Predicate>* ref;	// raw pointer (instead of smart pointer) because no dynamic allocation or modifying operations are used
-		LinkType current;
-		unsigned int traversed;	// store a value representing the current "index"
-								// to allow Θ(1) iterator equality comparisons.
+		const LinkedHashSet<T, Hash, Predicate, Allocator>* ref;	// raw pointer (instead of smart pointer) because no dynamic allocation or modifying operations are used
+		Index current;		// Table::NONE when past the end
 
 		/* If the iterator is already past the end, throws std::runtime_error{message}.
 		 * Helper member function for operator* and operator->.
 		 */
-		void bound_check(const std::string& message) const;
+		void bound_check(const char* message) const;
 	};
 
 	
@@ -209,15 +220,21 @@ public:
 };
 
 
-template <typename T, typename Hash, typename Predicate>
-LinkedHashSet<T, Hash, Predicate>::LinkedHashSet()
-	: head{nullptr}, last{nullptr}
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+LinkedHashSet<T, Hash, Predicate, Allocator>::LinkedHashSet()
+	: table{}
+{
+}
+
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+LinkedHashSet<T, Hash, Predicate, Allocator>::LinkedHashSet(const Allocator& allocator)
+	: table{allocator}
 {
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename InputIterator>
-LinkedHashSet<T, Hash, Predicate>::LinkedHashSet(InputIterator first, InputIterator last) : LinkedHashSet<T, Hash, Predicate>{}
+LinkedHashSet<T, Hash, Predicate, Allocator>::LinkedHashSet(InputIterator first, InputIterator last) : LinkedHashSet<T, Hash, Predicate, Allocator>{}
 {
 	while (first != last)
 	{
@@ -225,8 +242,8 @@ LinkedHashSet<T, Hash, Predicate>::LinkedHashSet(InputIterator first, InputItera
 	}
 }
 
-template <typename T, typename Hash, typename Predicate>
-std::ostream& operator<<(std::ostream& os, const LinkedHashSet<T, Hash, Predicate>& obj)
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const LinkedHashSet<T, Hash, Predicate, Allocator>& obj)
 {
 	os << "LinkedHashSet(";
 	auto i = obj.begin();
@@ -242,259 +259,273 @@ std::ostream& operator<<(std::ostream& os, const LinkedHashSet<T, Hash, Predicat
 	return os;
 }
 
-template <typename T, typename Hash, typename Predicate>
-LinkedHashSet<T, Hash, Predicate>::operator bool() const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+LinkedHashSet<T, Hash, Predicate, Allocator>::operator bool() const
 {
 	return !empty();
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::operator==(const LinkedHashSet<T, Hash, Predicate>& other) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::operator==(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const
 {
-	return table == other.table;
+	if (size() != other.size())
+	{
+		return false;
+	}
+	for (Index i = table.front(), j = other.table.front(); i != Table::NONE; i = table.next(i), j = other.table.next(j))
+	{
+		if (!(table.value(i) == other.table.value(j)))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::operator!=(const LinkedHashSet<T, Hash, Predicate>& other) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::operator!=(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const
 {
 	return !operator==(other);
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::operator<(const LinkedHashSet<T, Hash, Predicate>& other) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::operator<(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const
 {
 	return other > *this;
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::operator<=(const LinkedHashSet<T, Hash, Predicate>& other) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::operator<=(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const
 {
-	return !(other < *this);
+	return other >= *this;
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::operator>(const LinkedHashSet<T, Hash, Predicate>& other) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::operator>(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const
 {
 	return size() > other.size() && *this >= other;
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::operator>=(const LinkedHashSet<T, Hash, Predicate>& other) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::operator>=(const LinkedHashSet<T, Hash, Predicate, Allocator>& other) const
 {
-	return std::includes(begin(), end(), other.begin(), other.end());
+	if (size() < other.size())
+	{
+		return false;
+	}
+	for (Index slot = other.table.front(); slot != Table::NONE; slot = other.table.next(slot))
+	{
+		if (!contains(other.table.value(slot)))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
-template <typename T, typename Hash, typename Predicate>
-int LinkedHashSet<T, Hash, Predicate>::size() const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+int LinkedHashSet<T, Hash, Predicate, Allocator>::size() const
 {
 	return table.size();
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::empty() const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::empty() const
 {
 	return size() == 0;
 }
 
-template <typename T, typename Hash, typename Predicate>
-bool LinkedHashSet<T, Hash, Predicate>::contains(const T& item) const
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::contains(const T& item) const
 {
-	return table.find(item) != table.end();
+	return table.find(item) != Table::NONE;
 }
 
-template <typename T, typename Hash, typename Predicate>
-void LinkedHashSet<T, Hash, Predicate>::insert(const T& item)
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+const T& LinkedHashSet<T, Hash, Predicate, Allocator>::front() const
 {
-	if (!contains(item))
+	if (empty())
 	{
-		LinkType link{new T{item}};
-		if (!head)
-		{
-			head = link;
-		}
-		if (last)
-		{
-			table[*last].next = link;	// link the most-recently inserted item to the about-to-be inserted item
-		}
-		LinkEntry entry;
-		entry.previous = last;
-		entry.next = LinkType{nullptr};
-
-		table[*link] = std::move(entry);
-		last = link;
+		throw std::runtime_error{"set is empty"};
 	}
+	return table.value(table.front());
 }
 
-template <typename T, typename Hash, typename Predicate>
-void LinkedHashSet<T, Hash, Predicate>::erase(const T& item)
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+const T& LinkedHashSet<T, Hash, Predicate, Allocator>::back() const
 {
-	if (!contains(item))
+	if (empty())
 	{
-		throw std::runtime_error{"item does not exist"};
+		throw std::runtime_error{"set is empty"};
 	}
-	LinkEntry link = table.at(item);
-	auto previous = link.previous;
-	auto next = link.next;
-	table.erase(item);
+	return table.value(table.back());
+}
 
-	if (previous)	// if there was a node before 'item', then fix the broken link
-	{
-		table[*previous].next = next;
-	}
-	else			// otherwise, the head (first item) was just deleted
-	{
-		head = next;
-	}
-	if (next)		// if there was a node after 'item', then fix that broken link
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashSet<T, Hash, Predicate, Allocator>::insert(const T& item)
+{
+	table.emplace_back(item, item);
+}
+
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashSet<T, Hash, Predicate, Allocator>::erase(const T& item)
+{
+	Index slot = table.find(item);
+	if (slot == Table::NONE)
 	{
-		table[*next].previous = previous;
+		throw std::runtime_error{"item does not exist"};
 	}
-	else			// otherwise, the tail (last item) was just deleted
+	table.erase(slot);
+}
+
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+T LinkedHashSet<T, Hash, Predicate, Allocator>::pop_front()
+{
+	if (empty())
 	{
-		last = previous;
+		throw std::runtime_error{"set is empty"};
 	}
+	Index slot = table.front();
+	T value{std::move(table.value(slot))};
+	table.erase(slot);
+	return value;
 }
 
-template <typename T, typename Hash, typename Predicate>
-T LinkedHashSet<T, Hash, Predicate>::pop_front()
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+T LinkedHashSet<T, Hash, Predicate, Allocator>::pop_back()
 {
-	T value = *head;
-	erase(value);
+	if (empty())
+	{
+		throw std::runtime_error{"set is empty"};
+	}
+	Index slot = table.back();
+	T value{std::move(table.value(slot))};
+	table.erase(slot);
 	return value;
 }
 
-template <typename T, typename Hash, typename Predicate>
-T LinkedHashSet<T, Hash, Predicate>::pop_back()
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashSet<T, Hash, Predicate, Allocator>::clear()
 {
-	T value = *last;
-	erase(value);
-	return value;
+	table.clear();
 }
 
-template <typename T, typename Hash, typename Predicate>
-void LinkedHashSet<T, Hash, Predicate>::clear()
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashSet<T, Hash, Predicate, Allocator>::reserve(int n)
 {
-	if (!empty())
-	{
-		head.reset();
-		last.reset();
-		table.clear();
-	}
+	table.reserve(n);
 }
 
-template <typename T, typename Hash, typename Predicate>
-auto LinkedHashSet<T, Hash, Predicate>::cbegin() const -> const_iterator
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::cbegin() const -> const_iterator
 {
-	return const_iterator{this, head, 0};
+	return const_iterator{this, table.front()};
 }
 
-template <typename T, typename Hash, typename Predicate>
-auto LinkedHashSet<T, Hash, Predicate>::cend() const -> const_iterator
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::cend() const -> const_iterator
 {
-	unsigned int sz = size();		// silence g++ warning about conflicting types (unsigned int vs. int)
-	return const_iterator{this, LinkType{nullptr}, sz};
+	return const_iterator{this, Table::NONE};
 }
 
-template <typename T, typename Hash, typename Predicate>
-auto LinkedHashSet<T, Hash, Predicate>::begin() const -> iterator
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::begin() const -> iterator
 {
 	return cbegin();
 }
 
-template <typename T, typename Hash, typename Predicate>
-auto LinkedHashSet<T, Hash, Predicate>::end() const -> iterator
+template <typename T, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::end() const -> iterator
 {
 	return cend();
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::iterator_type(const LinkedHashSet<T, Hash, Predicate>* set, LinkType start, unsigned int visited)
-	: ref{set}, current{start}, traversed{visited}
+LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::iterator_type(const LinkedHashSet<T, Hash, Predicate, Allocator>* set, Index start)
+	: ref{set}, current{start}
 {
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-bool LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator==(const iterator_type<UnqualifiedT>& other) const
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator==(const iterator_type<UnqualifiedT>& other) const
 {
-	return ref == other.ref && traversed == other.traversed;
+	return ref == other.ref && current == other.current;
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-bool LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator!=(const iterator_type<UnqualifiedT>& other) const
+bool LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator!=(const iterator_type<UnqualifiedT>& other) const
 {
 	return !operator==(other);
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator++() -> iterator_type<UnqualifiedT>&
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator++() -> iterator_type<UnqualifiedT>&
 {
-	if (current && traversed < ref->size())
+	if (current != Table::NONE)
 	{
-		current = ref->table.at(*current).next;
-		++traversed;
+		current = ref->table.next(current);
 	}
 	return *this;
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator++(int) -> iterator_type<UnqualifiedT>
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator++(int) -> iterator_type<UnqualifiedT>
 {
 	iterator_type state{*this};		// invoke implicit copy constructor
 	operator++();
 	return state;
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator--() -> iterator_type<UnqualifiedT>&
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator--() -> iterator_type<UnqualifiedT>&
 {
-	if (!current)	// past end
+	if (current == Table::NONE)	// past end
 	{
-		current = ref->last;
+		current = ref->table.back();
 	}
-	if (current && traversed >= 0)
+	else if (ref->table.previous(current) != Table::NONE)
 	{
-		current = ref->table.at(*current).previous;
-		--traversed;
+		current = ref->table.previous(current);
 	}
 	return *this;
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-auto LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator--(int) -> iterator_type<UnqualifiedT>
+auto LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator--(int) -> iterator_type<UnqualifiedT>
 {
 	iterator_type state{*this};
 	operator--();
 	return state;
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-UnqualifiedT& LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator*()
+UnqualifiedT& LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator*()
 {
 	bound_check("LinkedHashSet::iterator_type::operator* - iterator past end");
-	return *current;
+	return ref->table.value(current);
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-const typename LinkedHashSet<T, Hash, Predicate>::LinkType LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::operator->() const
+UnqualifiedT* LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::operator->() const
 {
 	bound_check("LinkedHashSet::iterator_type::operator-> iterator past end");
-	return current;
+	return &ref->table.value(current);
 }
 
-template <typename T, typename Hash, typename Predicate>
+template <typename T, typename Hash, typename Predicate, typename Allocator>
 template <typename UnqualifiedT>
-void LinkedHashSet<T, Hash, Predicate>::iterator_type<UnqualifiedT>::bound_check(const std::string& message) const
+void LinkedHashSet<T, Hash, Predicate, Allocator>::iterator_type<UnqualifiedT>::bound_check(const char* message) const
 {
-	if (!current)
+	if (current == Table::NONE)
 	{
 		throw std::runtime_error{message};
 	}
@@ -0,0 +1,624 @@
+#ifndef DATA_STRUCTURES_LINKED_HASH_TABLE_HPP
+#define DATA_STRUCTURES_LINKED_HASH_TABLE_HPP
+
+// This templated header file defines LinkedHashTable - the storage shared by LinkedHashMap and LinkedHashSet.
+//
+// Values live in one dense array of slots. Each slot holds a value together with the 32-bit indices
+// of the previous and next values in the ordering (insertion order, unless a value is relinked with
+// move_to_front/move_to_back), so the ordering is a doubly-linked list threaded through the array itself:
+// following or relinking it allocates nothing and performs no lookups.
+// Erased slots are chained onto a free list (through their 'next' index) and handed out again by later inserts;
+// whenever the array has to grow, the surviving values are compacted into insertion order.
+//
+// Lookups go through a separate open-addressing index (linear probing, kept at most half full)
+// whose buckets hold nothing but slot indices. Each slot caches 32 bits of its key's hash,
+// so probing rarely invokes Predicate on a mismatched key, and rebuilding the index never rehashes a key.
+//
+// Growing the slot array moves every value, so (as with std::vector) an insert beyond capacity()
+// invalidates references to values; erasing a value only invalidates references to that value.
+// KeyOf is a function object that returns the key of a stored value.
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace
+{
+	std::uint32_t _LINKED_HASH_TABLE_INITIAL_CAPACITY = 8;
+}
+
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+class LinkedHashTable
+{
+public:
+	typedef std::uint32_t Index;
+	static const Index NONE = 0xffffffff;		// the "null" slot index; also marks an empty index bucket
+
+	explicit LinkedHashTable(const Allocator& the_allocator = Allocator{});
+	LinkedHashTable(const LinkedHashTable& right);
+	LinkedHashTable(LinkedHashTable&& right);
+	~LinkedHashTable();
+
+	LinkedHashTable& operator=(const LinkedHashTable& right);
+	LinkedHashTable& operator=(LinkedHashTable&& right);
+
+	int size() const;
+	int capacity() const;
+
+	/* Returns the slot of the first/last value in insertion order, or NONE if the table is empty */
+	Index front() const;
+	Index back() const;
+
+	/* Returns the slot after/before slot in insertion order, or NONE */
+	Index next(Index slot) const;
+	Index previous(Index slot) const;
+
+	Value& value(Index slot);
+	const Value& value(Index slot) const;
+
+	/* Returns the slot holding key, or NONE if it is not in the table */
+	Index find(const Key& key) const;
+
+	/* If key is not in the table, constructs a value from args (whose key must be key)
+	 * and links it at the back of the ordering.
+	 * Returns {the slot holding key, whether a value was constructed}; a single probe sequence is used either way.
+	 */
+	template <typename... Args>
+	std::pair<Index, bool> emplace_back(const Key& key, Args&&... args);
+
+	/* Constructs a value from args and links it at the back of the ordering, as emplace_back does,
+	 * but takes its key's hash (as hash_of() returns it) instead of hashing the key,
+	 * and does not check whether the key is already in the table: the caller must know it is not.
+	 * Returns the value's slot. Reloading a snapshot uses this to fill a reserved table without a single lookup.
+	 */
+	template <typename... Args>
+	Index append_unchecked(Index hashed, Args&&... args);
+
+	/* Returns the hash cached for the value in slot; hash_key returns the same for a key */
+	Index hash_of(Index slot) const;
+	Index hash_key(const Key& key) const;
+
+	/* Destroys the value in slot, unlinks it, and puts the slot on the free list */
+	void erase(Index slot);
+
+	/* Relinks slot at the front/back of the ordering; the value itself does not move */
+	void move_to_front(Index slot);
+	void move_to_back(Index slot);
+
+	/* Destroys every value; capacity is kept */
+	void clear();
+
+	/* Grows capacity so that n values fit without another allocation */
+	void reserve(int n);
+
+	void swap(LinkedHashTable& right);
+
+	Allocator get_allocator() const;
+
+private:
+	struct Slot
+	{
+		typename std::aligned_storage<sizeof(Value), alignof(Value)>::type storage;
+		Index previous;
+		Index next;
+		Index hash;
+	};
+
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Value> ValueAllocator;
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Slot> SlotAllocator;
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Index> IndexAllocator;
+	typedef std::allocator_traits<ValueAllocator> ValueTraits;
+	typedef std::allocator_traits<SlotAllocator> SlotTraits;
+	typedef std::allocator_traits<IndexAllocator> IndexTraits;
+
+	ValueAllocator allocator;
+	Hash hash;
+	Predicate equal;
+
+	Slot* slots;
+	Index slot_capacity;
+	Index used;				// slots [0, used) have been handed out at least once
+	Index count;
+	Index head;
+	Index tail;
+	Index free_list;
+
+	Index* index;
+	std::size_t index_size;	// 0, or a power of two at least twice slot_capacity
+	int index_shift;		// 32 - log2(index_size)
+
+	static Index hash32(std::size_t hashed);
+	std::size_t home(Index hashed) const;
+	std::size_t next_bucket(std::size_t bucket) const;
+
+	/* Returns the first empty bucket in the probe sequence for hashed */
+	std::size_t probe_empty(Index hashed) const;
+
+	/* Constructs a value from args in a free slot (which must exist), links it at the back of the ordering,
+	 * and records it in the empty index bucket
+	 */
+	template <typename... Args>
+	Index link_back(Index hashed, std::size_t bucket, Args&&... args);
+
+	Value* pointer(Index slot);
+
+	/* Removes slot from the ordering, leaving its own links stale */
+	void unlink(Index slot);
+
+	/* Moves every value into a new slot array of new_capacity (compacting them into insertion order),
+	 * and rebuilds the index for it.
+	 */
+	void grow(Index new_capacity);
+
+	void destroy_values();
+	void release();
+};
+
+
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+const typename LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::Index LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::NONE;
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::LinkedHashTable(const Allocator& the_allocator)
+	: allocator{the_allocator}, hash{}, equal{},
+	  slots{nullptr}, slot_capacity{0}, used{0}, count{0}, head{NONE}, tail{NONE}, free_list{NONE},
+	  index{nullptr}, index_size{0}, index_shift{32}
+{
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::LinkedHashTable(const LinkedHashTable& right)
+	: LinkedHashTable{Allocator{std::allocator_traits<ValueAllocator>::select_on_container_copy_construction(right.allocator)}}
+{
+	hash = right.hash;
+	equal = right.equal;
+	reserve(right.size());
+	for (Index slot = right.head; slot != NONE; slot = right.slots[slot].next)
+	{
+		const Value& item = right.value(slot);
+		emplace_back(KeyOf{}(item), item);
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::LinkedHashTable(LinkedHashTable&& right)
+	: LinkedHashTable{Allocator{right.allocator}}
+{
+	swap(right);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::~LinkedHashTable()
+{
+	release();
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>& LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::operator=(const LinkedHashTable& right)
+{
+	if (this != &right)
+	{
+		LinkedHashTable copy{right};
+		swap(copy);
+	}
+	return *this;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>& LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::operator=(LinkedHashTable&& right)
+{
+	swap(right);
+	return *this;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+int LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::size() const
+{
+	return count;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+int LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::capacity() const
+{
+	return slot_capacity;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::front() const -> Index
+{
+	return head;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::back() const -> Index
+{
+	return tail;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::next(Index slot) const -> Index
+{
+	return slots[slot].next;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::previous(Index slot) const -> Index
+{
+	return slots[slot].previous;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline Value& LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::value(Index slot)
+{
+	return *pointer(slot);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline const Value& LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::value(Index slot) const
+{
+	return *reinterpret_cast<const Value*>(&slots[slot].storage);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::find(const Key& key) const -> Index
+{
+	if (count == 0)
+	{
+		return NONE;
+	}
+
+	Index hashed = hash32(hash(key));
+	for (std::size_t bucket = home(hashed); index[bucket] != NONE; bucket = next_bucket(bucket))
+	{
+		Index slot = index[bucket];
+		if (slots[slot].hash == hashed && equal(KeyOf{}(value(slot)), key))
+		{
+			return slot;
+		}
+	}
+	return NONE;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+template <typename... Args>
+auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::emplace_back(const Key& key, Args&&... args) -> std::pair<Index, bool>
+{
+	Index hashed = hash32(hash(key));
+	std::size_t bucket = 0;
+	if (index_size > 0)
+	{
+		for (bucket = home(hashed); index[bucket] != NONE; bucket = next_bucket(bucket))
+		{
+			Index slot = index[bucket];
+			if (slots[slot].hash == hashed && equal(KeyOf{}(value(slot)), key))
+			{
+				return std::make_pair(slot, false);
+			}
+		}
+	}
+
+	if (count == slot_capacity)
+	{
+		grow(std::max(_LINKED_HASH_TABLE_INITIAL_CAPACITY, slot_capacity * 2));
+		bucket = probe_empty(hashed);
+	}
+	return std::make_pair(link_back(hashed, bucket, std::forward<Args>(args)...), true);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+template <typename... Args>
+auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::append_unchecked(Index hashed, Args&&... args) -> Index
+{
+	if (count == slot_capacity)
+	{
+		grow(std::max(_LINKED_HASH_TABLE_INITIAL_CAPACITY, slot_capacity * 2));
+	}
+	return link_back(hashed, probe_empty(hashed), std::forward<Args>(args)...);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::hash_of(Index slot) const -> Index
+{
+	return slots[slot].hash;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::hash_key(const Key& key) const -> Index
+{
+	return hash32(hash(key));
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+template <typename... Args>
+auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::link_back(Index hashed, std::size_t bucket, Args&&... args) -> Index
+{
+	Index slot = free_list != NONE ? free_list : used;
+	ValueTraits::construct(allocator, pointer(slot), std::forward<Args>(args)...);
+	if (slot == free_list)
+	{
+		free_list = slots[slot].next;
+	}
+	else
+	{
+		++used;
+	}
+
+	slots[slot].hash = hashed;
+	slots[slot].previous = tail;
+	slots[slot].next = NONE;
+	if (tail != NONE)
+	{
+		slots[tail].next = slot;
+	}
+	else
+	{
+		head = slot;
+	}
+	tail = slot;
+	index[bucket] = slot;
+	++count;
+	return slot;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::erase(Index slot)
+{
+	// remove slot from the index, then shift each following entry of the probe run back into the hole
+	// if that does not move it before its home bucket (so no tombstones are needed)
+	std::size_t hole = home(slots[slot].hash);
+	while (index[hole] != slot)
+	{
+		hole = next_bucket(hole);
+	}
+	for (std::size_t bucket = next_bucket(hole); index[bucket] != NONE; bucket = next_bucket(bucket))
+	{
+		std::size_t wanted = home(slots[index[bucket]].hash);
+		if (((bucket - wanted) & (index_size - 1)) >= ((bucket - hole) & (index_size - 1)))
+		{
+			index[hole] = index[bucket];
+			hole = bucket;
+		}
+	}
+	index[hole] = NONE;
+
+	unlink(slot);
+	ValueTraits::destroy(allocator, pointer(slot));
+	slots[slot].next = free_list;
+	free_list = slot;
+	--count;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::move_to_front(Index slot)
+{
+	if (slot != head)
+	{
+		unlink(slot);
+		slots[slot].previous = NONE;
+		slots[slot].next = head;
+		slots[head].previous = slot;	// (head exists, as slot was not it)
+		head = slot;
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::move_to_back(Index slot)
+{
+	if (slot != tail)
+	{
+		unlink(slot);
+		slots[slot].previous = tail;
+		slots[slot].next = NONE;
+		slots[tail].next = slot;
+		tail = slot;
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::clear()
+{
+	destroy_values();
+	std::fill(index, index + index_size, NONE);
+	used = 0;
+	count = 0;
+	head = NONE;
+	tail = NONE;
+	free_list = NONE;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::reserve(int n)
+{
+	if (n > 0 && static_cast<Index>(n) > slot_capacity)
+	{
+		grow(n);
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::swap(LinkedHashTable& right)
+{
+	std::swap(allocator, right.allocator);
+	std::swap(hash, right.hash);
+	std::swap(equal, right.equal);
+	std::swap(slots, right.slots);
+	std::swap(slot_capacity, right.slot_capacity);
+	std::swap(used, right.used);
+	std::swap(count, right.count);
+	std::swap(head, right.head);
+	std::swap(tail, right.tail);
+	std::swap(free_list, right.free_list);
+	std::swap(index, right.index);
+	std::swap(index_size, right.index_size);
+	std::swap(index_shift, right.index_shift);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+Allocator LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::get_allocator() const
+{
+	return Allocator{allocator};
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline auto LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::hash32(std::size_t hashed) -> Index
+{
+	return static_cast<Index>(hashed ^ (hashed >> 16 >> 16));	// (two shifts, as size_t may be 32 bits wide)
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline std::size_t LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::home(Index hashed) const
+{
+	// Fibonacci hashing spreads sequential hashes (e.g., std::hash<int>) across the whole index
+	return static_cast<Index>(hashed * 2654435769u) >> index_shift;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline std::size_t LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::next_bucket(std::size_t bucket) const
+{
+	return (bucket + 1) & (index_size - 1);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+std::size_t LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::probe_empty(Index hashed) const
+{
+	std::size_t bucket = home(hashed);
+	while (index[bucket] != NONE)
+	{
+		bucket = next_bucket(bucket);
+	}
+	return bucket;
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+inline Value* LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::pointer(Index slot)
+{
+	return reinterpret_cast<Value*>(&slots[slot].storage);
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::unlink(Index slot)
+{
+	Slot& entry = slots[slot];
+	if (entry.previous != NONE)
+	{
+		slots[entry.previous].next = entry.next;
+	}
+	else
+	{
+		head = entry.next;
+	}
+	if (entry.next != NONE)
+	{
+		slots[entry.next].previous = entry.previous;
+	}
+	else
+	{
+		tail = entry.previous;
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::grow(Index new_capacity)
+{
+	if (new_capacity >= NONE / 2)
+	{
+		throw std::length_error{"LinkedHashTable::grow - too many values for 32-bit slot indices"};
+	}
+
+	std::size_t new_index_size = 1;
+	int new_shift = 32;
+	while (new_index_size < 2 * static_cast<std::size_t>(new_capacity))
+	{
+		new_index_size *= 2;
+		--new_shift;
+	}
+
+	SlotAllocator slot_allocator{allocator};
+	IndexAllocator index_allocator{allocator};
+	Slot* new_slots = SlotTraits::allocate(slot_allocator, new_capacity);
+	Index* new_index = nullptr;
+	Index moved = 0;
+	try
+	{
+		new_index = IndexTraits::allocate(index_allocator, new_index_size);
+		for (Index slot = head; slot != NONE; slot = slots[slot].next, ++moved)
+		{
+			ValueTraits::construct(allocator, reinterpret_cast<Value*>(&new_slots[moved].storage), std::move_if_noexcept(value(slot)));
+			new_slots[moved].hash = slots[slot].hash;
+			new_slots[moved].previous = moved == 0 ? NONE : moved - 1;
+			new_slots[moved].next = moved + 1;
+		}
+	}
+	catch (...)
+	{
+		for (Index slot = 0; slot < moved; ++slot)
+		{
+			ValueTraits::destroy(allocator, reinterpret_cast<Value*>(&new_slots[slot].storage));
+		}
+		if (new_index != nullptr)
+		{
+			IndexTraits::deallocate(index_allocator, new_index, new_index_size);
+		}
+		SlotTraits::deallocate(slot_allocator, new_slots, new_capacity);
+		throw;
+	}
+
+	release();
+	slots = new_slots;
+	slot_capacity = new_capacity;
+	used = count;
+	head = count == 0 ? NONE : 0;
+	tail = count == 0 ? NONE : count - 1;
+	free_list = NONE;
+	if (count > 0)
+	{
+		slots[tail].next = NONE;
+	}
+
+	index = new_index;
+	index_size = new_index_size;
+	index_shift = new_shift;
+	std::fill(index, index + index_size, NONE);
+	for (Index slot = 0; slot < count; ++slot)
+	{
+		index[probe_empty(slots[slot].hash)] = slot;
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::destroy_values()
+{
+	for (Index slot = head; slot != NONE; slot = slots[slot].next)
+	{
+		ValueTraits::destroy(allocator, pointer(slot));
+	}
+}
+
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename Predicate, typename Allocator>
+void LinkedHashTable<Value, Key, KeyOf, Hash, Predicate, Allocator>::release()
+{
+	destroy_values();
+	if (slots != nullptr)
+	{
+		SlotAllocator slot_allocator{allocator};
+		SlotTraits::deallocate(slot_allocator, slots, slot_capacity);
+	}
+	if (index != nullptr)
+	{
+		IndexAllocator index_allocator{allocator};
+		IndexTraits::deallocate(index_allocator, index, index_size);
+	}
+	slots = nullptr;
+	index = nullptr;
+}
+
+#endif // DATA_STRUCTURES_LINKED_HASH_TABLE_HPP
@@ -1,21 +1,46 @@
 // This module defines a standard singly-linked list implementation.
 // Caches a rear pointer, so appending is done in O(1) time.
+//
+// Nodes are obtained from Allocator (rebound to the node type), which defaults to std::allocator;
+// see pool_allocator.hpp for allocators that recycle nodes instead of returning them to the heap.
 #ifndef LINKED_LIST_HPP
 #define LINKED_LIST_HPP
 
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 
 
 template <typename T>
-class LinkedList
+struct LinkedListNode
+{
+	template <typename... Args>
+	explicit LinkedListNode(LinkedListNode<T>* the_next, Args&&... args)
+		: value(std::forward<Args>(args)...), next{the_next}
+	{
+	}
+
+	T value;
+	LinkedListNode<T>* next;
+};
+
+
+// The node allocator is a (private) base class, so that a stateless allocator takes up no space.
+template <typename T, typename Allocator = std::allocator<T>>
+class LinkedList : private std::allocator_traits<Allocator>::template rebind_alloc<LinkedListNode<T>>
 {
 public:
 	LinkedList();
-	LinkedList(const LinkedList<T>& right);
+	explicit LinkedList(const Allocator& allocator);
+	LinkedList(const LinkedList<T, Allocator>& right);
+
+	/* Takes right's nodes without copying them; right is left empty */
+	LinkedList(LinkedList<T, Allocator>&& right);
 
 	template <typename iterable>
 	explicit LinkedList(const iterable& v);
@@ -25,12 +50,13 @@ public:
 	// --- Operators ---
 	// Assigns right into this.
 	// Efficiently reuses dynamically allocated memory as necessary.
-	LinkedList<T>& operator=(const LinkedList<T>& right);
-	bool operator==(const LinkedList<T>& right) const;
-	bool operator!=(const LinkedList<T>& right) const;
+	LinkedList<T, Allocator>& operator=(const LinkedList<T, Allocator>& right);
+	LinkedList<T, Allocator>& operator=(LinkedList<T, Allocator>&& right);
+	bool operator==(const LinkedList<T, Allocator>& right) const;
+	bool operator!=(const LinkedList<T, Allocator>& right) const;
 
-	template <typename T2>
-	friend std::ostream& operator<<(std::ostream& os, const LinkedList<T>& right);
+	template <typename T2, typename A>
+	friend std::ostream& operator<<(std::ostream& os, const LinkedList<T2, A>& right);
 
 
 	// --- Member Functions ---
@@ -58,15 +84,42 @@ public:
 	/* Removes the first occurrence of item in the linked list */
 	void erase(const T& item);
 
+	/* Removes every item for which remove(item) returns true, in a single pass.
+	 * Returns the number of items removed.
+	 * O(N).
+	 */
+	template <typename Predicate>
+	int remove_if(Predicate remove);
+
 	/* Appends item to the back of the linked list.
 	 * O(1).
 	 */
 	void push_back(const T& item);
+	void push_back(T&& item);
 
 	/* Adds item to the front of the linked list.
 	 * O(1).
 	 */
 	void push_front(const T& item);
+	void push_front(T&& item);
+
+	/* Constructs T{args...} in place at the back/front of the linked list.
+	 * O(1).
+	 */
+	template <typename... Args>
+	void emplace_back(Args&&... args);
+
+	template <typename... Args>
+	void emplace_front(Args&&... args);
+
+	/* Moves the first node of source to the front of this, without reallocating or copying its item.
+	 * source must not be empty, and must use an allocator equal to this's.
+	 * O(1).
+	 */
+	void splice_front(LinkedList<T, Allocator>& source);
+
+	/* Returns a copy of the allocator used for this's nodes */
+	Allocator get_allocator() const;
 
 	/* Removes the last item in the linked list.
 	 * O(N).
@@ -80,12 +133,9 @@ public:
 
 
 protected:
-	struct node
-	{
-	public:
-		T value;
-		node* next;
-	};
+	typedef LinkedListNode<T> node;
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<node> NodeAllocator;
+	typedef std::allocator_traits<NodeAllocator> NodeTraits;
 	node* front;
 	node* rear;
 
@@ -105,15 +155,15 @@ public:
 		T& operator*() const;
 		T* operator->() const;
 
-		friend iterator LinkedList<T>::begin() const;
-		friend iterator LinkedList<T>::end() const;
+		friend iterator LinkedList<T, Allocator>::begin() const;
+		friend iterator LinkedList<T, Allocator>::end() const;
 
 		iterator();
 
 	private:
-		iterator(LinkedList<T>* ref, node* start);
+		iterator(LinkedList<T, Allocator>* ref, node* start);
 
-		LinkedList<T>* ref;
+		LinkedList<T, Allocator>* ref;
 		node* current;
 	};
 
@@ -123,41 +173,62 @@ private:
 
 	void deallocate_list(node*& start);
 	void _ensure_rear();
+
+	NodeAllocator& node_allocator();
+	const NodeAllocator& node_allocator() const;
+
+	template <typename... Args>
+	node* create_node(node* next, Args&&... args);
+	void destroy_node(node* n);
 };
 
 
 
 
-template <typename T>
-LinkedList<T>::LinkedList()
-	: front{nullptr}, rear{front}, length{0}
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList()
+	: NodeAllocator{}, front{nullptr}, rear{front}, length{0}
 {
 }
 
-template <typename T>
-LinkedList<T>::LinkedList(const LinkedList<T>& right)
-	: front{nullptr}, rear{front}, length{0}
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(const Allocator& allocator)
+	: NodeAllocator{allocator}, front{nullptr}, rear{front}, length{0}
+{
+}
+
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(const LinkedList<T, Allocator>& right)
+	: NodeAllocator{NodeTraits::select_on_container_copy_construction(right.node_allocator())}, front{nullptr}, rear{front}, length{0}
 {
 	for (node* current = right.front; current != nullptr; current = current->next)
 		push_back(current->value);
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::LinkedList(LinkedList<T, Allocator>&& right)
+	: NodeAllocator{right.node_allocator()}, front{right.front}, rear{right.rear}, length{right.length}
+{
+	right.front = right.rear = nullptr;
+	right.length = 0;
+}
+
+template <typename T, typename Allocator>
 template <typename iterable>
-LinkedList<T>::LinkedList(const iterable& v) : LinkedList<T>{}
+LinkedList<T, Allocator>::LinkedList(const iterable& v) : LinkedList<T, Allocator>{}
 {
 	for (const auto& i : v)
 		push_back(i);
 }
 
-template <typename T>
-LinkedList<T>::~LinkedList()
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::~LinkedList()
 {
 	deallocate_list(front);
 }
 
-template <typename T>
-LinkedList<T>& LinkedList<T>::operator=(const LinkedList<T>& right)
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(const LinkedList<T, Allocator>& right)
 {
 	if (this != &right)
 	{
@@ -175,8 +246,28 @@ LinkedList<T>& LinkedList<T>::operator=(const LinkedList<T>& right)
 	return *this;
 }
 
-template <typename T>
-bool LinkedList<T>::operator==(const LinkedList<T>& right) const
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(LinkedList<T, Allocator>&& right)
+{
+	if (this != &right && node_allocator() == right.node_allocator())
+	{
+		std::swap(front, right.front);
+		std::swap(rear, right.rear);
+		std::swap(length, right.length);
+	}
+	else if (this != &right)
+	{
+		// nodes cannot change hands between unequal allocators; move the items instead
+		clear();
+		for (node* current = right.front; current != nullptr; current = current->next)
+			push_back(std::move(current->value));
+		right.clear();
+	}
+	return *this;
+}
+
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::operator==(const LinkedList<T, Allocator>& right) const
 {
 	if (this == &right)
 		return true;
@@ -193,33 +284,33 @@ bool LinkedList<T>::operator==(const LinkedList<T>& right) const
 	return true;
 }
 
-template <typename T>
-bool LinkedList<T>::operator!=(const LinkedList<T>& right) const
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::operator!=(const LinkedList<T, Allocator>& right) const
 {
 	return !operator==(right);
 }
 
-template <typename T>
-std::ostream& operator<<(std::ostream& os, const LinkedList<T>& right)
+template <typename T, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const LinkedList<T, Allocator>& right)
 {
 	os << right.str();
 	return os;
 }
 
-template <typename T>
-int LinkedList<T>::size() const
+template <typename T, typename Allocator>
+int LinkedList<T, Allocator>::size() const
 {
 	return length;
 }
 
-template <typename T>
-bool LinkedList<T>::empty() const
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::empty() const
 {
 	return size() == 0;
 }
 
-template <typename T>
-bool LinkedList<T>::contains(const T& item) const
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::contains(const T& item) const
 {
 	for (node* current = front; current != nullptr; current = current->next)
 	{
@@ -229,8 +320,8 @@ bool LinkedList<T>::contains(const T& item) const
 	return false;
 }
 
-template <typename T>
-std::string LinkedList<T>::str() const
+template <typename T, typename Allocator>
+std::string LinkedList<T, Allocator>::str() const
 {
 	std::ostringstream result;
 	result << "linked_list(";
@@ -244,28 +335,28 @@ std::string LinkedList<T>::str() const
 	return result.str();
 }
 
-template <typename T>
-void LinkedList<T>::clear()
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::clear()
 {
 	deallocate_list(front);
 	front = rear = nullptr;
 	length = 0;
 }
 
-template <typename T>
-const T& LinkedList<T>::first() const
+template <typename T, typename Allocator>
+const T& LinkedList<T, Allocator>::first() const
 {
 	return front->value;
 }
 
-template <typename T>
-const T& LinkedList<T>::last() const
+template <typename T, typename Allocator>
+const T& LinkedList<T, Allocator>::last() const
 {
 	return rear->value;
 }
 
-template <typename T>
-void LinkedList<T>::erase(const T& item)
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::erase(const T& item)
 {
 	for (node** c = &front; *c != nullptr; c = &((*c)->next))
 	{
@@ -273,7 +364,7 @@ void LinkedList<T>::erase(const T& item)
 		{
 			node* last = *c;
 			*c = (*c)->next;
-			delete last;
+			destroy_node(last);
 
 			--length;
 			if (*c == nullptr)
@@ -284,29 +375,102 @@ void LinkedList<T>::erase(const T& item)
 	throw std::invalid_argument{"LinkedList::erase\n  item not in LinkedList"};
 }
 
-template <typename T>
-void LinkedList<T>::push_back(const T& item)
+template <typename T, typename Allocator>
+template <typename Predicate>
+int LinkedList<T, Allocator>::remove_if(Predicate remove)
 {
+	int removed = 0;
+	node* kept = nullptr;
+	for (node** c = &front; *c != nullptr;)
+	{
+		if (remove((*c)->value))
+		{
+			node* last = *c;
+			*c = last->next;
+			destroy_node(last);
+			++removed;
+		}
+		else
+		{
+			kept = *c;
+			c = &(kept->next);
+		}
+	}
+
+	length -= removed;
+	rear = kept;
+	return removed;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::push_back(const T& item)
+{
+	emplace_back(item);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::push_back(T&& item)
+{
+	emplace_back(std::move(item));
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::push_front(const T& item)
+{
+	emplace_front(item);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::push_front(T&& item)
+{
+	emplace_front(std::move(item));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void LinkedList<T, Allocator>::emplace_back(Args&&... args)
+{
+	node* created = create_node(nullptr, std::forward<Args>(args)...);
 	if (empty())
-		front = rear = new node{item};
+		front = rear = created;
 	else
-		rear = rear->next = new node{item};
+		rear = rear->next = created;
 
 	++length;
 }
 
-template <typename T>
-void LinkedList<T>::push_front(const T& item)
+template <typename T, typename Allocator>
+template <typename... Args>
+void LinkedList<T, Allocator>::emplace_front(Args&&... args)
 {
-	front = new node{item, front};
+	front = create_node(front, std::forward<Args>(args)...);
 	if (empty())
 		rear = front;
 
 	++length;
 }
 
-template <typename T>
-T LinkedList<T>::pop_back()
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::splice_front(LinkedList<T, Allocator>& source)
+{
+	if (source.empty())
+		throw std::out_of_range{"LinkedList::splice_front -- source is empty"};
+
+	node* moved = source.front;
+	source.front = moved->next;
+	if (--source.length == 0)
+		source.rear = nullptr;
+
+	moved->next = front;
+	front = moved;
+	if (empty())
+		rear = front;
+
+	++length;
+}
+
+template <typename T, typename Allocator>
+T LinkedList<T, Allocator>::pop_back()
 {
 	if (empty())
 		throw std::out_of_range{"LinkedList::pop_back -- empty"};
@@ -319,62 +483,62 @@ T LinkedList<T>::pop_back()
 	}
 
 	rear = c;
-	T value = c->next->value;
-	delete c->next;
+	T value = std::move(c->next->value);
+	destroy_node(c->next);
 	c->next = nullptr;
 
 	--length;
 	return value;
 }
 
-template <typename T>
-T LinkedList<T>::pop_front()
+template <typename T, typename Allocator>
+T LinkedList<T, Allocator>::pop_front()
 {
 	if (empty())
 		throw std::out_of_range{"LinkedList::pop_front - empty"};
 
-	T value = front->value;
+	T value = std::move(front->value);
 	node* to_delete = front;
 	front = front->next;
-	delete to_delete;
+	destroy_node(to_delete);
 
 	--length;
 	return value;
 }
 
-template <typename T>
-auto LinkedList<T>::begin() const -> LinkedList<T>::iterator
+template <typename T, typename Allocator>
+auto LinkedList<T, Allocator>::begin() const -> LinkedList<T, Allocator>::iterator
 {
-	return iterator{const_cast<LinkedList<T>*>(this), front};
+	return iterator{const_cast<LinkedList<T, Allocator>*>(this), front};
 }
 
-template <typename T>
-auto LinkedList<T>::end() const -> LinkedList<T>::iterator
+template <typename T, typename Allocator>
+auto LinkedList<T, Allocator>::end() const -> LinkedList<T, Allocator>::iterator
 {
-	return iterator{const_cast<LinkedList<T>*>(this), nullptr};
+	return iterator{const_cast<LinkedList<T, Allocator>*>(this), nullptr};
 }
 
-template <typename T>
-LinkedList<T>::iterator::iterator(LinkedList<T>* ll, node* start)
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::iterator::iterator(LinkedList<T, Allocator>* ll, node* start)
 	: ref{ll}, current{start}
 {
 }
 
-template <typename T>
-LinkedList<T>::iterator::iterator() : iterator(nullptr, nullptr)
+template <typename T, typename Allocator>
+LinkedList<T, Allocator>::iterator::iterator() : iterator(nullptr, nullptr)
 {
 }
 
-template <typename T>
-auto LinkedList<T>::iterator::operator++() -> LinkedList<T>::iterator&
+template <typename T, typename Allocator>
+auto LinkedList<T, Allocator>::iterator::operator++() -> LinkedList<T, Allocator>::iterator&
 {
 	if (current != nullptr)
 		current = current->next;
 	return *this;
 }
 
-template <typename T>
-auto LinkedList<T>::iterator::operator++(int) -> LinkedList<T>::iterator
+template <typename T, typename Allocator>
+auto LinkedList<T, Allocator>::iterator::operator++(int) -> LinkedList<T, Allocator>::iterator
 {
 	iterator to_return{*this};
 	operator++();
@@ -382,20 +546,20 @@ auto LinkedList<T>::iterator::operator++(int) -> LinkedList<T>::iterator
 	return to_return;
 }
 
-template <typename T>
-bool LinkedList<T>::iterator::operator==(const LinkedList<T>::iterator& right) const
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::iterator::operator==(const LinkedList<T, Allocator>::iterator& right) const
 {
-	return ref == right.ref && (current == nullptr || right.current == nullptr ? current == right.current : current->value == right.current->value);
+	return ref == right.ref && current == right.current;
 }
 
-template <typename T>
-bool LinkedList<T>::iterator::operator!=(const LinkedList<T>::iterator& right) const
+template <typename T, typename Allocator>
+bool LinkedList<T, Allocator>::iterator::operator!=(const LinkedList<T, Allocator>::iterator& right) const
 {
 	return !operator==(right);
 }
 
-template <typename T>
-T& LinkedList<T>::iterator::operator*() const
+template <typename T, typename Allocator>
+T& LinkedList<T, Allocator>::iterator::operator*() const
 {
 	if (current == nullptr)
 		throw std::out_of_range{"linked_list::iterator::operator* -- cursor past end"};
@@ -403,8 +567,8 @@ T& LinkedList<T>::iterator::operator*() const
 	return current->value;
 }
 
-template <typename T>
-T* LinkedList<T>::iterator::operator->() const
+template <typename T, typename Allocator>
+T* LinkedList<T, Allocator>::iterator::operator->() const
 {
 	if (current == nullptr)
 		throw std::out_of_range{"linked_list::iterator::operator-> -- cursor past end"};
@@ -413,17 +577,61 @@ T* LinkedList<T>::iterator::operator->() const
 }
 
 // ---
-template <typename T>
-void LinkedList<T>::deallocate_list(node*& start)
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::deallocate_list(node*& start)
+{
+	while (start != nullptr)
+	{
+		node* next = start->next;
+		destroy_node(start);
+		start = next;
+	}
+}
+
+template <typename T, typename Allocator>
+Allocator LinkedList<T, Allocator>::get_allocator() const
 {
-	if (start == nullptr)
-		return;
-	deallocate_list(start->next);
-	delete start;
+	return Allocator{node_allocator()};
 }
 
-template <typename T>
-void LinkedList<T>::_ensure_rear()
+template <typename T, typename Allocator>
+typename LinkedList<T, Allocator>::NodeAllocator& LinkedList<T, Allocator>::node_allocator()
+{
+	return *this;
+}
+
+template <typename T, typename Allocator>
+const typename LinkedList<T, Allocator>::NodeAllocator& LinkedList<T, Allocator>::node_allocator() const
+{
+	return *this;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename LinkedList<T, Allocator>::node* LinkedList<T, Allocator>::create_node(node* next, Args&&... args)
+{
+	node* created = NodeTraits::allocate(node_allocator(), 1);
+	try
+	{
+		NodeTraits::construct(node_allocator(), created, next, std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		NodeTraits::deallocate(node_allocator(), created, 1);
+		throw;
+	}
+	return created;
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::destroy_node(node* n)
+{
+	NodeTraits::destroy(node_allocator(), n);
+	NodeTraits::deallocate(node_allocator(), n, 1);
+}
+
+template <typename T, typename Allocator>
+void LinkedList<T, Allocator>::_ensure_rear()
 {
 	if (!empty())
 	{
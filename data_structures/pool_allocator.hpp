@@ -0,0 +1,307 @@
+// This header defines two allocators for the node-based containers
+// (LinkedList, HashMap, HashSet, BinarySearchTree, LinkedHashMap and LinkedHashSet),
+// which otherwise allocate every element's node separately with the global operator new.
+//
+// PoolAllocator draws nodes from a NodePool: memory is carved out of large chunks into
+// fixed-size blocks (one free list per 16-byte size class), and freed blocks are pushed back
+// onto their free list to be recycled by the next allocation of the same size.
+// A churn-heavy insert/erase loop therefore settles into reusing the same few chunks,
+// and never returns to the global heap.
+//
+// ArenaAllocator draws from a MonotonicArena, which only ever bumps a pointer;
+// deallocation is a no-op, and everything is released at once when the arena is destroyed.
+// It suits containers that are built once, read, and then thrown away.
+//
+// Both allocators share their pool/arena between copies (including rebound copies, which is how
+// a container obtains an allocator for its node type), and compare equal iff they share it.
+// A default-constructed allocator creates a new pool/arena of its own.
+// Neither is thread-safe: one pool/arena must only be used by one thread at a time.
+#ifndef DATA_STRUCTURES_POOL_ALLOCATOR_HPP
+#define DATA_STRUCTURES_POOL_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace
+{
+    std::size_t _NODE_POOL_GRANULARITY = 16;            // size classes are multiples of this; also the block alignment
+    std::size_t _NODE_POOL_LARGEST_BLOCK = 256;         // larger requests go straight to operator new
+    std::size_t _NODE_POOL_CHUNK_SIZE = 64 * 1024;
+    std::size_t _MONOTONIC_ARENA_INITIAL_CHUNK_SIZE = 4 * 1024;
+}
+
+
+
+class NodePool
+{
+public:
+    NodePool();
+    NodePool(const NodePool& right) = delete;
+    NodePool& operator=(const NodePool& right) = delete;
+    ~NodePool();
+
+    /* Returns a block of at least bytes bytes, aligned to alignment.
+     * O(1); recycles a freed block of the same size class if there is one.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /* Returns p (which must have come from allocate(bytes, alignment)) to its free list.
+     * O(1).
+     */
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment);
+
+    /* Returns the number of bytes obtained from the global heap so far */
+    std::size_t reserved() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::vector<FreeBlock*> free_lists;     // indexed by size class
+    std::vector<void*> chunks;
+    char* cursor;                           // unused tail of the newest chunk
+    char* chunk_end;
+
+    static bool pooled(std::size_t bytes, std::size_t alignment);
+    static std::size_t size_class_of(std::size_t bytes);
+};
+
+
+class MonotonicArena
+{
+public:
+    MonotonicArena();
+    MonotonicArena(const MonotonicArena& right) = delete;
+    MonotonicArena& operator=(const MonotonicArena& right) = delete;
+    ~MonotonicArena();
+
+    /* Returns a block of at least bytes bytes, aligned to alignment.
+     * O(1); chunks grow geometrically.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /* Does nothing; memory is only released when the arena is destroyed */
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment);
+
+    /* Returns the number of bytes obtained from the global heap so far */
+    std::size_t reserved() const;
+
+private:
+    std::vector<void*> chunks;
+    std::size_t next_chunk_size;
+    std::size_t total;
+    char* cursor;
+    char* chunk_end;
+};
+
+
+template <typename T, typename Resource>
+class ResourceAllocator
+{
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef ResourceAllocator<U, Resource> other;
+    };
+
+    ResourceAllocator();
+    explicit ResourceAllocator(std::shared_ptr<Resource> the_resource);
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U, Resource>& right);
+
+    T* allocate(std::size_t n);
+    void deallocate(T* p, std::size_t n);
+
+    /* Returns the pool/arena shared by this allocator */
+    const std::shared_ptr<Resource>& get_resource() const;
+
+    template <typename U>
+    bool operator==(const ResourceAllocator<U, Resource>& right) const;
+    template <typename U>
+    bool operator!=(const ResourceAllocator<U, Resource>& right) const;
+
+private:
+    std::shared_ptr<Resource> resource;
+};
+
+
+template <typename T>
+using PoolAllocator = ResourceAllocator<T, NodePool>;
+
+template <typename T>
+using ArenaAllocator = ResourceAllocator<T, MonotonicArena>;
+
+
+
+// NodePool
+inline NodePool::NodePool()
+    : free_lists(_NODE_POOL_LARGEST_BLOCK / _NODE_POOL_GRANULARITY + 1, nullptr), cursor{nullptr}, chunk_end{nullptr}
+{
+}
+
+inline NodePool::~NodePool()
+{
+    for (void* chunk : chunks)
+        ::operator delete(chunk);
+}
+
+inline void* NodePool::allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (!pooled(bytes, alignment))
+        return ::operator new(bytes);
+
+    std::size_t size_class = size_class_of(bytes);
+    FreeBlock*& free_list = free_lists[size_class];
+    if (free_list != nullptr)
+    {
+        FreeBlock* block = free_list;
+        free_list = block->next;
+        return block;
+    }
+
+    std::size_t block_size = size_class * _NODE_POOL_GRANULARITY;
+    if (static_cast<std::size_t>(chunk_end - cursor) < block_size)
+    {
+        // the leftover tail of the old chunk is abandoned; it is smaller than one block
+        cursor = static_cast<char*>(::operator new(_NODE_POOL_CHUNK_SIZE));
+        chunk_end = cursor + _NODE_POOL_CHUNK_SIZE;
+        chunks.push_back(cursor);
+    }
+    void* block = cursor;
+    cursor += block_size;
+    return block;
+}
+
+inline void NodePool::deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+    if (!pooled(bytes, alignment))
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    FreeBlock*& free_list = free_lists[size_class_of(bytes)];
+    free_list = new (p) FreeBlock{free_list};
+}
+
+inline std::size_t NodePool::reserved() const
+{
+    return chunks.size() * _NODE_POOL_CHUNK_SIZE;
+}
+
+inline bool NodePool::pooled(std::size_t bytes, std::size_t alignment)
+{
+    return bytes <= _NODE_POOL_LARGEST_BLOCK && alignment <= _NODE_POOL_GRANULARITY;
+}
+
+inline std::size_t NodePool::size_class_of(std::size_t bytes)
+{
+    return std::max<std::size_t>(1, (bytes + _NODE_POOL_GRANULARITY - 1) / _NODE_POOL_GRANULARITY);
+}
+
+
+// MonotonicArena
+inline MonotonicArena::MonotonicArena()
+    : next_chunk_size{_MONOTONIC_ARENA_INITIAL_CHUNK_SIZE}, total{0}, cursor{nullptr}, chunk_end{nullptr}
+{
+}
+
+inline MonotonicArena::~MonotonicArena()
+{
+    for (void* chunk : chunks)
+        ::operator delete(chunk);
+}
+
+inline void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(cursor) + alignment - 1) & ~(alignment - 1);
+    if (cursor == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(chunk_end))
+    {
+        std::size_t size = std::max(next_chunk_size, bytes + alignment);
+        next_chunk_size = size * 2;
+        total += size;
+
+        cursor = static_cast<char*>(::operator new(size));
+        chunk_end = cursor + size;
+        chunks.push_back(cursor);
+        aligned = (reinterpret_cast<std::uintptr_t>(cursor) + alignment - 1) & ~(alignment - 1);
+    }
+    cursor = reinterpret_cast<char*>(aligned + bytes);
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void MonotonicArena::deallocate(void*, std::size_t, std::size_t)
+{
+}
+
+inline std::size_t MonotonicArena::reserved() const
+{
+    return total;
+}
+
+
+// ResourceAllocator
+template <typename T, typename Resource>
+ResourceAllocator<T, Resource>::ResourceAllocator()
+    : resource{std::make_shared<Resource>()}
+{
+}
+
+template <typename T, typename Resource>
+ResourceAllocator<T, Resource>::ResourceAllocator(std::shared_ptr<Resource> the_resource)
+    : resource{std::move(the_resource)}
+{
+}
+
+template <typename T, typename Resource>
+template <typename U>
+ResourceAllocator<T, Resource>::ResourceAllocator(const ResourceAllocator<U, Resource>& right)
+    : resource{right.get_resource()}
+{
+}
+
+template <typename T, typename Resource>
+T* ResourceAllocator<T, Resource>::allocate(std::size_t n)
+{
+    return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+}
+
+template <typename T, typename Resource>
+void ResourceAllocator<T, Resource>::deallocate(T* p, std::size_t n)
+{
+    resource->deallocate(p, n * sizeof(T), alignof(T));
+}
+
+template <typename T, typename Resource>
+const std::shared_ptr<Resource>& ResourceAllocator<T, Resource>::get_resource() const
+{
+    return resource;
+}
+
+template <typename T, typename Resource>
+template <typename U>
+bool ResourceAllocator<T, Resource>::operator==(const ResourceAllocator<U, Resource>& right) const
+{
+    return resource == right.get_resource();
+}
+
+template <typename T, typename Resource>
+template <typename U>
+bool ResourceAllocator<T, Resource>::operator!=(const ResourceAllocator<U, Resource>& right) const
+{
+    return !operator==(right);
+}
+
+
+#endif // DATA_STRUCTURES_POOL_ALLOCATOR_HPP
@@ -1,22 +1,46 @@
 #ifndef DATA_STRUCTURES_QUEUE_HPP
 #define DATA_STRUCTURES_QUEUE_HPP
 
+// This templated header file defines Queue - a first-in, first-out sequence of items,
+// stored contiguously in a ring buffer whose number of slots is always a power of 2,
+// so the front and back wrap around by masking rather than dividing.
+//
+// A default-constructed Queue is unbounded: when its slots run out, it moves its items into twice as many.
+// A Queue constructed with a capacity is bounded: it allocates slots for capacity items up front, and never again;
+// push throws std::overflow_error when it is full, and try_push returns false instead.
+
 #include <algorithm>
 #include <iostream>
 #include <iterator>
-#include <list>
-#include <string>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 
 template <typename T>
 class Queue
 {
 public:
+    /* Constructs an empty, unbounded queue; no slots are allocated until the first push */
     Queue();
 
+    /* Constructs an empty queue bounded to capacity items, allocating all of their slots.
+     * Throws std::invalid_argument if capacity is not positive.
+     */
+    explicit Queue(int capacity);
+
     template <typename InputIterator>
     Queue(InputIterator first, InputIterator last);
 
+    Queue(const Queue<T>& other);
+    /* Leaves other empty and unbounded */
+    Queue(Queue<T>&& other) noexcept;
+    Queue<T>& operator=(const Queue<T>& other);
+    Queue<T>& operator=(Queue<T>&& other) noexcept;
+    ~Queue();
+
     template <typename Tother>
     friend std::ostream& operator<<(std::ostream& os, const Queue<Tother>& queue);
 
@@ -26,13 +50,61 @@ public:
 
     int size() const;
     bool empty() const;
+    bool full() const;
+    bool bounded() const;
+
+    /* Returns the most items the queue can hold: its bound, or (if unbounded) how many fit before it next grows */
+    int capacity() const;
+
+    /* Throws std::out_of_range if the queue is empty */
     const T& front() const;
+    const T& back() const;
     bool contains(const T& item) const;
 
     T& front();
+    T& back();
+
+    /* Enqueues item at the back.
+     * If the queue is bounded and full, throws std::overflow_error.
+     * Complexity:
+     *   Amortized Θ(1) (Θ(1) when bounded)
+     */
     void push(const T& item);
+    void push(T&& item);
+
+    /* Constructs T{args...} in place at the back of the queue */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /* Enqueues item and returns true, or returns false if the queue is bounded and full */
+    bool try_push(const T& item);
+    bool try_push(T&& item);
+
+    /* Enqueues the items of [first, last) in order, and returns how many were enqueued;
+     * a bounded queue stops once it is full. An unbounded queue given forward iterators grows at most once.
+     */
+    template <typename InputIterator>
+    int push_range(InputIterator first, InputIterator last);
+
+    /* Dequeues the front item; throws std::out_of_range if the queue is empty */
     void pop();
 
+    /* Removes the back item (the one pushed last); throws std::out_of_range if the queue is empty */
+    void pop_back();
+
+    /* Moves the front item into item, dequeues it and returns true, or returns false if the queue is empty */
+    bool try_pop(T& item);
+
+    /* Moves up to n items, from the front, into out (in order) and dequeues them; returns how many were dequeued */
+    template <typename OutputIterator>
+    int pop_n(int n, OutputIterator out);
+
+    /* Destroys every item; the slots are kept */
+    void clear();
+
+    /* Ensures an unbounded queue can hold n items without growing; a bounded queue is left as it is */
+    void reserve(int n);
+
 
     class iterator;
     auto begin() const -> iterator;
@@ -41,7 +113,7 @@ public:
     class iterator : public std::iterator<std::bidirectional_iterator_tag, T>
     {
     public:
-        iterator(Queue<T>* queue_ptr, typename std::list<T>::const_iterator start);
+        iterator(Queue<T>* queue_ptr, int start);
 
         auto operator++() -> iterator&;
         auto operator++(int) -> iterator;
@@ -57,28 +129,129 @@ public:
 
     private:
         Queue<T>* ref;
-        typename std::list<T>::const_iterator it;
+        int position;   // the number of items ahead of this one in the queue
     };
 
 protected:
-    std::list<T> array;
+    T* slots;           // slot_count slots, of which count (starting at head, wrapping around) hold items
+    int slot_count;     // 0, or a power of 2
+    int head;
+    int count;
+    int limit;          // the bound, or 0 if unbounded
+    int room;           // capacity(): limit if bounded, otherwise slot_count
+
+    /* Returns the slot holding the item position places behind the front */
+    T* slot(int position) const;
+
+    /* Moves the items into a ring of new_slot_count slots (a power of 2 no smaller than count), starting at slot 0 */
+    void reallocate(int new_slot_count);
+
+    /* Destroys every item, and releases the slots */
+    void release();
+
+    static int slots_for(int n);
 };
 
 
 
 template <typename T>
 Queue<T>::Queue()
+    : slots{nullptr}, slot_count{0}, head{0}, count{0}, limit{0}, room{0}
 {
 }
 
+template <typename T>
+Queue<T>::Queue(int capacity)
+    : Queue()
+{
+    if (capacity <= 0)
+    {
+        throw std::invalid_argument{"Queue - capacity must be positive"};
+    }
+    reallocate(slots_for(capacity));
+    limit = capacity;
+    room = capacity;
+}
+
 template <typename T>
 template <typename InputIterator>
 Queue<T>::Queue(InputIterator first, InputIterator last)
+    : Queue()
+{
+    push_range(first, last);
+}
+
+template <typename T>
+Queue<T>::Queue(const Queue<T>& other)
+    : Queue()
+{
+    // an unbounded copy's room is whatever reallocate gives it, not other's
+    if (other.bounded())
+    {
+        limit = other.limit;
+        room = other.room;
+        reallocate(other.slot_count);
+    }
+    else if (!other.empty())
+    {
+        reallocate(slots_for(other.count));
+    }
+    for (const T& item : other)
+    {
+        new (slot(count)) T(item);
+        ++count;
+    }
+}
+
+template <typename T>
+Queue<T>::Queue(Queue<T>&& other) noexcept
+    : slots{other.slots}, slot_count{other.slot_count}, head{other.head}, count{other.count}, limit{other.limit}, room{other.room}
+{
+    other.slots = nullptr;
+    other.slot_count = 0;
+    other.head = 0;
+    other.count = 0;
+    other.limit = 0;
+    other.room = 0;
+}
+
+template <typename T>
+Queue<T>& Queue<T>::operator=(const Queue<T>& other)
+{
+    if (this != &other)
+    {
+        Queue<T> copy{other};
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+Queue<T>& Queue<T>::operator=(Queue<T>&& other) noexcept
 {
-    for (; first != last; ++first)
+    if (this != &other)
     {
-        push(*first);
+        release();
+        slots = other.slots;
+        slot_count = other.slot_count;
+        head = other.head;
+        count = other.count;
+        limit = other.limit;
+        room = other.room;
+        other.slots = nullptr;
+        other.slot_count = 0;
+        other.head = 0;
+        other.count = 0;
+        other.limit = 0;
+        other.room = 0;
     }
+    return *this;
+}
+
+template <typename T>
+Queue<T>::~Queue()
+{
+    release();
 }
 
 template <typename T>
@@ -119,13 +292,31 @@ Queue<T>::operator bool() const
 template <typename T>
 int Queue<T>::size() const
 {
-    return array.size();
+    return count;
 }
 
 template <typename T>
 bool Queue<T>::empty() const
 {
-    return array.empty();
+    return count == 0;
+}
+
+template <typename T>
+bool Queue<T>::full() const
+{
+    return count == room;
+}
+
+template <typename T>
+bool Queue<T>::bounded() const
+{
+    return limit > 0;
+}
+
+template <typename T>
+int Queue<T>::capacity() const
+{
+    return room;
 }
 
 template <typename T>
@@ -137,49 +328,269 @@ bool Queue<T>::contains(const T& item) const
 template <typename T>
 const T& Queue<T>::front() const
 {
-    return array.front();
+    if (empty())
+    {
+        throw std::out_of_range{"Queue::front - empty"};
+    }
+    return *slot(0);
 }
 
 template <typename T>
 T& Queue<T>::front()
 {
-    return array.front();
+    return const_cast<T&>(static_cast<const Queue<T>&>(*this).front());
+}
+
+template <typename T>
+const T& Queue<T>::back() const
+{
+    if (empty())
+    {
+        throw std::out_of_range{"Queue::back - empty"};
+    }
+    return *slot(count - 1);
+}
+
+template <typename T>
+T& Queue<T>::back()
+{
+    return const_cast<T&>(static_cast<const Queue<T>&>(*this).back());
 }
 
 template <typename T>
 void Queue<T>::push(const T& item)
 {
-    array.push_back(item);
+    emplace(item);
+}
+
+template <typename T>
+void Queue<T>::push(T&& item)
+{
+    emplace(std::move(item));
+}
+
+template <typename T>
+template <typename... Args>
+void Queue<T>::emplace(Args&&... args)
+{
+    if (count < room)
+    {
+        new (slot(count)) T(std::forward<Args>(args)...);
+    }
+    else if (bounded())
+    {
+        throw std::overflow_error{"Queue::push - full"};
+    }
+    else
+    {
+        // the new item is made first, as args may refer to an item that growing is about to move
+        T item(std::forward<Args>(args)...);
+        reallocate(std::max(8, 2 * slot_count));
+        new (slot(count)) T(std::move(item));
+    }
+    ++count;
+}
+
+template <typename T>
+bool Queue<T>::try_push(const T& item)
+{
+    if (bounded() && full())
+    {
+        return false;
+    }
+    emplace(item);
+    return true;
+}
+
+template <typename T>
+bool Queue<T>::try_push(T&& item)
+{
+    if (bounded() && full())
+    {
+        return false;
+    }
+    emplace(std::move(item));
+    return true;
+}
+
+template <typename T>
+template <typename InputIterator>
+int Queue<T>::push_range(InputIterator first, InputIterator last)
+{
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+    if (!bounded() && std::is_base_of<std::forward_iterator_tag, Category>::value)
+    {
+        reserve(count + static_cast<int>(std::distance(first, last)));
+    }
+
+    int pushed = 0;
+    for (; first != last && !(bounded() && full()); ++first, ++pushed)
+    {
+        emplace(*first);
+    }
+    return pushed;
 }
 
 template <typename T>
 void Queue<T>::pop()
 {
-    array.pop_front();
+    if (empty())
+    {
+        throw std::out_of_range{"Queue::pop - empty"};
+    }
+    slot(0)->~T();
+    head = (head + 1) & (slot_count - 1);
+    --count;
+}
+
+template <typename T>
+void Queue<T>::pop_back()
+{
+    if (empty())
+    {
+        throw std::out_of_range{"Queue::pop_back - empty"};
+    }
+    slot(count - 1)->~T();
+    --count;
+}
+
+template <typename T>
+bool Queue<T>::try_pop(T& item)
+{
+    if (empty())
+    {
+        return false;
+    }
+    T* front_slot = slot(0);
+    item = std::move(*front_slot);
+    front_slot->~T();
+    head = (head + 1) & (slot_count - 1);
+    --count;
+    return true;
+}
+
+template <typename T>
+template <typename OutputIterator>
+int Queue<T>::pop_n(int n, OutputIterator out)
+{
+    int popped = std::max(0, std::min(n, count));
+
+    // the items leave in at most two contiguous runs: up to the end of the slots, then from slot 0
+    int first_run = std::min(popped, slot_count - head);
+    T* runs[] = {slots + head, slots};
+    int run_sizes[] = {first_run, popped - first_run};
+    for (int r = 0; r < 2; ++r)
+    {
+        out = std::move(runs[r], runs[r] + run_sizes[r], out);
+        for (T* item = runs[r]; item != runs[r] + run_sizes[r]; ++item)
+        {
+            item->~T();
+        }
+    }
+
+    if (popped > 0)
+    {
+        head = (head + popped) & (slot_count - 1);
+        count -= popped;
+    }
+    return popped;
+}
+
+template <typename T>
+void Queue<T>::clear()
+{
+    for (int i = 0; i < count; ++i)
+    {
+        slot(i)->~T();
+    }
+    head = 0;
+    count = 0;
+}
+
+template <typename T>
+void Queue<T>::reserve(int n)
+{
+    if (!bounded() && n > slot_count)
+    {
+        reallocate(slots_for(n));
+    }
+}
+
+template <typename T>
+T* Queue<T>::slot(int position) const
+{
+    return slots + ((head + position) & (slot_count - 1));
+}
+
+template <typename T>
+void Queue<T>::reallocate(int new_slot_count)
+{
+    T* new_slots = std::allocator<T>{}.allocate(new_slot_count);
+    for (int i = 0; i < count; ++i)
+    {
+        T* item = slot(i);
+        new (new_slots + i) T(std::move_if_noexcept(*item));
+        item->~T();
+    }
+    if (slots != nullptr)
+    {
+        std::allocator<T>{}.deallocate(slots, slot_count);
+    }
+    slots = new_slots;
+    slot_count = new_slot_count;
+    head = 0;
+    if (!bounded())
+    {
+        room = slot_count;
+    }
+}
+
+template <typename T>
+void Queue<T>::release()
+{
+    clear();
+    if (slots != nullptr)
+    {
+        std::allocator<T>{}.deallocate(slots, slot_count);
+        slots = nullptr;
+        slot_count = 0;
+        room = limit;
+    }
+}
+
+template <typename T>
+int Queue<T>::slots_for(int n)
+{
+    int result = 1;
+    while (result < n)
+    {
+        result *= 2;
+    }
+    return result;
 }
 
 template <typename T>
 auto Queue<T>::begin() const -> Queue<T>::iterator
 {
-    return iterator{const_cast<Queue<T>*>(this), array.begin()};
+    return iterator{const_cast<Queue<T>*>(this), 0};
 }
 
 template <typename T>
 auto Queue<T>::end() const -> Queue<T>::iterator
 {
-    return iterator{const_cast<Queue<T>*>(this), array.end()};
+    return iterator{const_cast<Queue<T>*>(this), count};
 }
 
 template <typename T>
-Queue<T>::iterator::iterator(Queue<T>* queue_ptr, typename std::list<T>::const_iterator start)
-    : ref{queue_ptr}, it{start}
+Queue<T>::iterator::iterator(Queue<T>* queue_ptr, int start)
+    : ref{queue_ptr}, position{start}
 {
 }
 
 template <typename T>
 auto Queue<T>::iterator::operator++() -> Queue<T>::iterator&
 {
-    ++it;
+    ++position;
     return *this;
 }
 
@@ -194,7 +605,7 @@ auto Queue<T>::iterator::operator++(int) -> Queue<T>::iterator
 template <typename T>
 auto Queue<T>::iterator::operator--() -> Queue<T>::iterator&
 {
-    --it;
+    --position;
     return *this;
 }
 
@@ -209,7 +620,7 @@ auto Queue<T>::iterator::operator--(int) -> Queue<T>::iterator
 template <typename T>
 bool Queue<T>::iterator::operator==(const iterator& other) const
 {
-    return ref == other.ref && it == other.it;
+    return ref == other.ref && position == other.position;
 }
 
 template <typename T>
@@ -221,13 +632,13 @@ bool Queue<T>::iterator::operator!=(const iterator& other) const
 template <typename T>
 const T& Queue<T>::iterator::operator*() const
 {
-    return *it;
+    return *ref->slot(position);
 }
 
 template <typename T>
 T* Queue<T>::iterator::operator->() const
 {
-    return &it;
+    return ref->slot(position);
 }
 
 
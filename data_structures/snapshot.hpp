@@ -0,0 +1,273 @@
+// This header defines the binary snapshot format that HashMap and LinkedHashMap save themselves in,
+// so that a large map can be reloaded in one streaming pass instead of being rebuilt by n insertions.
+//
+// A snapshot is a header followed by count entries:
+//   | "SNAP" | version | byte order mark | kind | key size | value size | count (64-bit) | geometry (64-bit) | entry x count
+// and each entry is its key's hash (as the map stores it) followed by its key and value, as SnapshotCodec encodes them.
+// Entries are written in the map's own order: bin by bin for a HashMap, insertion order for a LinkedHashMap;
+// geometry is the table's shape (HashMap bins, LinkedHashMap slot capacity), so the reloaded table is allocated
+// at its final size up front, and every entry is appended where its stored hash says, with no lookups or rehashing.
+// The maps' hash functions are unseeded, so the stored hashes double as the check that the reader's agrees:
+// one entry in every _SNAPSHOT_CHECK_STRIDE has its key hashed again, and the snapshot is rejected on any mismatch.
+//
+// SnapshotCodec<T> copies trivially copyable types byte for byte (its size is sizeof(T));
+// std::string is written length-prefixed, and any other type can be supported by specializing SnapshotCodec for it
+// (with a size of 0 if its encoding varies in length). The sizes are recorded, so a snapshot of another key or
+// value type is rejected rather than misread. Snapshots are written in the host's byte order, and read through
+// a read-only mapping of the file (see tools/trace_file.hpp).
+#ifndef DATA_STRUCTURES_SNAPSHOT_HPP
+#define DATA_STRUCTURES_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../tools/trace_file.hpp"
+
+
+namespace
+{
+    const char _SNAPSHOT_MAGIC[4] = {'S', 'N', 'A', 'P'};
+    const uint32_t _SNAPSHOT_VERSION = 1;
+    const uint32_t _SNAPSHOT_BYTE_ORDER_MARK = 0x01020304;
+    const uint32_t _SNAPSHOT_HASH_MAP = 1;
+    const uint32_t _SNAPSHOT_LINKED_HASH_MAP = 2;
+    const int _SNAPSHOT_CHECK_STRIDE = 1024;          // entries per re-hashed entry when reading
+    const std::size_t _SNAPSHOT_BUFFER_SIZE = 1 << 16;
+
+    struct _SnapshotHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t kind;
+        uint32_t key_size;
+        uint32_t value_size;
+        uint64_t count;
+        uint64_t geometry;
+    };
+}
+
+
+class SnapshotError : public std::runtime_error
+{
+public:
+    explicit SnapshotError(const std::string& what) : std::runtime_error{what} {}
+};
+
+
+class SnapshotWriter
+{
+public:
+    /* Creates path and writes the header; throws a SnapshotError if it cannot */
+    SnapshotWriter(const std::string& path, uint32_t kind, uint32_t key_size, uint32_t value_size, uint64_t count, uint64_t geometry);
+
+    void write_bytes(const void* source, std::size_t n);
+
+    template <typename T>
+    void write(const T& item);
+
+    /* Writes out whatever is still buffered; throws a SnapshotError if the snapshot could not be written */
+    void close();
+
+
+private:
+    std::string path;
+    std::ofstream out;
+    std::vector<char> buffer;
+
+    void flush();
+};
+
+
+class SnapshotReader
+{
+public:
+    /* Maps the snapshot at path; throws a SnapshotError if it cannot be opened,
+     * or is not a snapshot of the given kind with the given key and value sizes.
+     */
+    SnapshotReader(const std::string& path, uint32_t kind, uint32_t key_size, uint32_t value_size);
+
+    const std::string& path() const;
+    uint64_t count() const;
+    uint64_t geometry() const;
+
+    /* Returns a pointer to the next n bytes and moves past them; throws a SnapshotError if there are not n left */
+    const char* take(std::size_t n);
+
+    void read_bytes(void* destination, std::size_t n);
+
+    template <typename T>
+    T read();
+
+
+private:
+    std::string file_path;
+    MappedFile file;
+    const char* cursor;
+    uint64_t entries;
+    uint64_t shape;
+};
+
+
+/* Encodes a T into a snapshot, and decodes one again */
+template <typename T>
+struct SnapshotCodec
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SnapshotCodec - T is not trivially copyable; specialize SnapshotCodec<T> for it");
+
+    static const uint32_t size = sizeof(T);
+
+    static void write(SnapshotWriter& out, const T& item)
+    {
+        out.write_bytes(&item, sizeof(T));
+    }
+
+    static T read(SnapshotReader& in)
+    {
+        return in.read<T>();
+    }
+};
+
+template <>
+struct SnapshotCodec<std::string>
+{
+    static const uint32_t size = 0;
+
+    static void write(SnapshotWriter& out, const std::string& item)
+    {
+        out.write<uint64_t>(item.size());
+        out.write_bytes(item.data(), item.size());
+    }
+
+    static std::string read(SnapshotReader& in)
+    {
+        uint64_t length = in.read<uint64_t>();
+        if (length > std::string{}.max_size())
+            throw SnapshotError{"SnapshotCodec<std::string> - " + in.path() + " holds an impossible string length"};
+        const char* bytes = in.take(static_cast<std::size_t>(length));
+        return std::string{bytes, static_cast<std::size_t>(length)};
+    }
+};
+
+
+
+inline SnapshotWriter::SnapshotWriter(const std::string& the_path, uint32_t kind, uint32_t key_size, uint32_t value_size, uint64_t count, uint64_t geometry)
+    : path{the_path}, out{the_path, std::ios::binary | std::ios::trunc}
+{
+    if (!out)
+        throw SnapshotError{"SnapshotWriter - cannot open " + path};
+
+    buffer.reserve(_SNAPSHOT_BUFFER_SIZE);
+    _SnapshotHeader header;
+    std::memcpy(header.magic, _SNAPSHOT_MAGIC, sizeof(_SNAPSHOT_MAGIC));
+    header.version = _SNAPSHOT_VERSION;
+    header.byte_order = _SNAPSHOT_BYTE_ORDER_MARK;
+    header.kind = kind;
+    header.key_size = key_size;
+    header.value_size = value_size;
+    header.count = count;
+    header.geometry = geometry;
+    write(header);
+}
+
+inline void SnapshotWriter::write_bytes(const void* source, std::size_t n)
+{
+    if (buffer.size() + n > _SNAPSHOT_BUFFER_SIZE)
+        flush();
+    if (n >= _SNAPSHOT_BUFFER_SIZE)
+        out.write(static_cast<const char*>(source), n);
+    else
+        buffer.insert(buffer.end(), static_cast<const char*>(source), static_cast<const char*>(source) + n);
+}
+
+template <typename T>
+inline void SnapshotWriter::write(const T& item)
+{
+    write_bytes(&item, sizeof(T));
+}
+
+inline void SnapshotWriter::close()
+{
+    flush();
+    if (!out.flush())
+        throw SnapshotError{"SnapshotWriter - cannot write " + path};
+    out.close();
+}
+
+inline void SnapshotWriter::flush()
+{
+    out.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+
+
+inline SnapshotReader::SnapshotReader(const std::string& the_path, uint32_t kind, uint32_t key_size, uint32_t value_size)
+    : file_path{the_path}, file{[&the_path] {
+          try
+          {
+              return MappedFile{the_path};
+          }
+          catch (const TraceError&)
+          {
+              throw SnapshotError{"SnapshotReader - cannot open " + the_path};
+          }
+      }()}, cursor{file.begin()}
+{
+    _SnapshotHeader header;
+    read_bytes(&header, sizeof(header));
+    if (std::memcmp(header.magic, _SNAPSHOT_MAGIC, sizeof(_SNAPSHOT_MAGIC)) != 0)
+        throw SnapshotError{"SnapshotReader - " + file_path + " is not a snapshot"};
+    if (header.version != _SNAPSHOT_VERSION)
+        throw SnapshotError{"SnapshotReader - " + file_path + " has an unknown snapshot version"};
+    if (header.byte_order != _SNAPSHOT_BYTE_ORDER_MARK)
+        throw SnapshotError{"SnapshotReader - " + file_path + " was written with another byte order"};
+    if (header.kind != kind || header.key_size != key_size || header.value_size != value_size)
+        throw SnapshotError{"SnapshotReader - " + file_path + " is a snapshot of another type of map"};
+    entries = header.count;
+    shape = header.geometry;
+}
+
+inline const std::string& SnapshotReader::path() const
+{
+    return file_path;
+}
+
+inline uint64_t SnapshotReader::count() const
+{
+    return entries;
+}
+
+inline uint64_t SnapshotReader::geometry() const
+{
+    return shape;
+}
+
+inline const char* SnapshotReader::take(std::size_t n)
+{
+    if (static_cast<std::size_t>(file.end() - cursor) < n)
+        throw SnapshotError{"SnapshotReader - " + file_path + " is truncated"};
+    const char* taken = cursor;
+    cursor += n;
+    return taken;
+}
+
+inline void SnapshotReader::read_bytes(void* destination, std::size_t n)
+{
+    std::memcpy(destination, take(n), n);
+}
+
+template <typename T>
+inline T SnapshotReader::read()
+{
+    T item;
+    read_bytes(&item, sizeof(T));
+    return item;
+}
+
+#endif // DATA_STRUCTURES_SNAPSHOT_HPP
@@ -0,0 +1,109 @@
+// This program checks that an MPMCQueue of capacity 1 holds one item at a time: a second push is refused
+// rather than overwriting the first, and a pop of the emptied queue returns rather than spinning.
+// Then producers and consumers fill and drain a small queue together. Exits 1 on the first failure.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. tests/concurrent_queue_test.cpp -o concurrent_queue_test -pthread
+//   ./concurrent_queue_test
+#include "data_structures/concurrent_queue.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    void check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            std::exit(1);
+        }
+    }
+
+    void capacity_one()
+    {
+        MPMCQueue<std::string> queue{1};
+        check(queue.capacity() == 1, "a capacity of 1 is kept as 1");
+        check(queue.try_push("first"), "push into an empty queue of capacity 1");
+        check(!queue.try_push("second"), "push into a full queue of capacity 1 is refused");
+        check(queue.size() == 1 && queue.full(), "a queue of capacity 1 is full after one push");
+
+        bool threw = false;
+        try
+        {
+            queue.push("third");
+        }
+        catch (const std::overflow_error&)
+        {
+            threw = true;
+        }
+        check(threw, "push throws when a queue of capacity 1 is full");
+
+        std::string item;
+        check(queue.try_pop(item) && item == "first", "pop returns the one item");
+        check(!queue.try_pop(item), "pop of an emptied queue of capacity 1 fails");
+        check(queue.empty(), "a queue of capacity 1 is empty after its pop");
+
+        // around the ring a few times, which has more slots than the queue's capacity
+        for (int i = 0; i < 10; ++i)
+        {
+            check(queue.try_push(std::to_string(i)) && !queue.try_push("extra"), "push after a pop");
+            check(queue.try_pop(item) && item == std::to_string(i), "pop after a push");
+        }
+    }
+
+    void capacity_one_shared(int threads, int per_thread)
+    {
+        MPMCQueue<int> queue{1};
+        std::atomic<long long> sum{0};
+        std::atomic<int> popped{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&queue, per_thread] {
+                for (int i = 1; i <= per_thread; ++i)
+                {
+                    while (!queue.try_push(i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            workers.emplace_back([&queue, &sum, &popped, threads, per_thread] {
+                int item;
+                while (popped.load() < threads * per_thread)
+                {
+                    if (queue.try_pop(item))
+                    {
+                        sum += item;
+                        ++popped;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        check(sum == static_cast<long long>(threads) * per_thread * (per_thread + 1) / 2, "every item pushed is popped once");
+    }
+}
+
+
+int main()
+{
+    capacity_one();
+    capacity_one_shared(4, 5000);
+    std::cout << "concurrent_queue_test: all passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+// This program checks that iterating over a LinkedHashMap or a LinkedHashSet allocates nothing:
+// every global operator new is counted, and a full pass over each container (through operator* and
+// operator->) must leave the count where it was. It also checks that the passes see every item, in
+// insertion order, and that dereferencing an iterator past the end still throws. Exits 1 on the first failure.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. tests/linked_hash_iteration_test.cpp -o linked_hash_iteration_test
+//   ./linked_hash_iteration_test
+#include "data_structures/linked_hash_map.hpp"
+#include "data_structures/linked_hash_set.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+    long long allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return block;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+namespace
+{
+    const int N = 1000;
+
+    void check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            std::exit(1);
+        }
+    }
+
+    void map_iteration()
+    {
+        LinkedHashMap<int, int> map;
+        for (int i = 0; i < N; ++i)
+        {
+            map[i * 7] = i;
+        }
+
+        long long before = allocations;
+        int expected = 0;
+        bool ordered = true;
+        for (auto it = map.begin(); it != map.end(); ++it)
+        {
+            ordered = ordered && *it == expected * 7;
+            ++expected;
+        }
+        check(allocations == before, "iterating over a LinkedHashMap allocates nothing");
+        check(ordered && expected == N, "a LinkedHashMap iterates over its keys in insertion order");
+    }
+
+    void map_arrow()
+    {
+        LinkedHashMap<std::string, int> map;
+        for (int i = 0; i < N; ++i)
+        {
+            map[std::to_string(i) + " is a key long enough to be held on the heap"] = i;
+        }
+
+        long long before = allocations;
+        std::size_t length = 0;
+        for (auto it = map.begin(); it != map.end(); ++it)
+        {
+            length += it->size();
+        }
+        check(allocations == before, "operator-> of a LinkedHashMap iterator allocates nothing");
+        check(length > 0, "a LinkedHashMap's keys are seen through operator->");
+    }
+
+    void set_iteration()
+    {
+        LinkedHashSet<int> set;
+        for (int i = 0; i < N; ++i)
+        {
+            set.insert(N - i);
+        }
+
+        long long before = allocations;
+        int expected = N;
+        bool ordered = true;
+        for (int item : set)
+        {
+            ordered = ordered && item == expected;
+            --expected;
+        }
+        check(allocations == before, "iterating over a LinkedHashSet allocates nothing");
+        check(ordered && expected == 0, "a LinkedHashSet iterates in insertion order");
+    }
+
+    void past_end()
+    {
+        LinkedHashMap<int, int> map;
+        map[1] = 1;
+        LinkedHashSet<int> set;
+        set.insert(1);
+
+        bool map_threw = false;
+        try
+        {
+            *map.end();
+        }
+        catch (const std::runtime_error&)
+        {
+            map_threw = true;
+        }
+        bool set_threw = false;
+        try
+        {
+            *set.end();
+        }
+        catch (const std::runtime_error&)
+        {
+            set_threw = true;
+        }
+        check(map_threw && set_threw, "dereferencing an iterator past the end throws");
+    }
+}
+
+
+int main()
+{
+    map_iteration();
+    map_arrow();
+    set_iteration();
+    past_end();
+    std::cout << "linked_hash_iteration_test: all passed" << std::endl;
+    return 0;
+}
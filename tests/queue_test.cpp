@@ -0,0 +1,132 @@
+// This program checks that copies of a Queue keep working once pushed past the size they were copied at:
+// a copy of an unbounded queue whose ring has wrapped, a copy of a drained queue, the same through
+// copy assignment, and a copy of a bounded queue (which must stay bounded). Exits 1 on the first failure.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. tests/queue_test.cpp -o queue_test
+//   ./queue_test
+#include "data_structures/queue.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+
+namespace
+{
+    void check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            std::exit(1);
+        }
+    }
+
+    // pops every item, checking that they run from first to first + size - 1
+    void check_run(Queue<int>& queue, int first, int size, const char* what)
+    {
+        check(queue.size() == size, what);
+        for (int expected = first; expected < first + size; ++expected)
+        {
+            check(queue.front() == expected, what);
+            queue.pop();
+        }
+        check(queue.empty(), what);
+    }
+
+    void wrapped_copy()
+    {
+        Queue<int> queue;
+        for (int i = 0; i < 100; ++i)
+        {
+            queue.push(i);
+        }
+        for (int i = 0; i < 90; ++i)
+        {
+            queue.pop();
+        }
+
+        Queue<int> copy{queue};
+        for (int i = 100; i < 130; ++i)
+        {
+            copy.push(i);
+        }
+        check_run(copy, 90, 40, "copy of a wrapped queue, pushed past its size");
+        check_run(queue, 90, 10, "original of a wrapped queue");
+    }
+
+    void drained_copy()
+    {
+        Queue<int> queue;
+        queue.push(1);
+        queue.pop();
+
+        Queue<int> copy{queue};
+        for (int i = 0; i < 20; ++i)
+        {
+            copy.push(i);
+        }
+        check_run(copy, 0, 20, "copy of a drained queue");
+    }
+
+    void assigned_copy()
+    {
+        Queue<int> queue;
+        for (int i = 0; i < 12; ++i)
+        {
+            queue.push(i);
+        }
+        for (int i = 0; i < 9; ++i)
+        {
+            queue.pop();
+        }
+
+        Queue<int> copy;
+        copy.push(-1);
+        copy = queue;
+        for (int i = 12; i < 40; ++i)
+        {
+            copy.push(i);
+        }
+        check_run(copy, 9, 31, "copy-assigned wrapped queue");
+    }
+
+    void bounded_copy()
+    {
+        Queue<int> queue{5};
+        for (int i = 0; i < 5; ++i)
+        {
+            queue.push(i);
+        }
+        queue.pop();
+        queue.pop();
+
+        Queue<int> copy{queue};
+        check(copy.bounded() && copy.capacity() == 5, "copy of a bounded queue keeps its bound");
+        copy.push(5);
+        copy.push(6);
+        check(copy.full(), "copy of a bounded queue fills at its bound");
+        bool threw = false;
+        try
+        {
+            copy.push(7);
+        }
+        catch (const std::exception&)
+        {
+            threw = true;
+        }
+        check(threw, "copy of a bounded queue rejects a push past its bound");
+        check_run(copy, 2, 5, "copy of a bounded queue");
+    }
+}
+
+
+int main()
+{
+    wrapped_copy();
+    drained_copy();
+    assigned_copy();
+    bounded_copy();
+    std::cout << "queue_test: all passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+// This program pins the k convention of quick_select and deterministic_select: k counts from 0,
+// so k = 0 selects the smallest value and k = n - 1 the largest, and k = n (or a negative k) throws.
+// It checks every k of a small array with duplicates against a sorted copy. Exits 1 on the first failure.
+//
+// Build and run (from the repository root):
+//   g++ -std=c++14 -O2 -I. tests/selection_test.cpp -o selection_test
+//   ./selection_test
+#include "algorithms/selection.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+    void check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << what << std::endl;
+            std::exit(1);
+        }
+    }
+
+    template <typename Select>
+    bool throws(Select select)
+    {
+        try
+        {
+            select();
+        }
+        catch (const std::out_of_range&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void ends()
+    {
+        const std::vector<int> values{7, 3, 9, 1, 5, 8, 2};
+        const int n = values.size();
+
+        check(quick_select(values.begin(), values.end(), 0) == 1, "quick_select k = 0 is the smallest");
+        check(quick_select(values.begin(), values.end(), n - 1) == 9, "quick_select k = n - 1 is the largest");
+        check(deterministic_select(values.begin(), values.end(), 0) == 1, "deterministic_select k = 0 is the smallest");
+        check(deterministic_select(values.begin(), values.end(), n - 1) == 9, "deterministic_select k = n - 1 is the largest");
+        check(quick_select(values.begin(), values.end(), 0, std::greater<int>{}) == 9, "quick_select k = 0 under greater is the largest");
+
+        check(throws([&] { quick_select(values.begin(), values.end(), n); }), "quick_select k = n throws");
+        check(throws([&] { quick_select(values.begin(), values.end(), -1); }), "quick_select k = -1 throws");
+        check(throws([&] { deterministic_select(values.begin(), values.end(), n); }), "deterministic_select k = n throws");
+        check(throws([&] { deterministic_select(values.begin(), values.end(), -1); }), "deterministic_select k = -1 throws");
+        check(values == std::vector<int>({7, 3, 9, 1, 5, 8, 2}), "selecting leaves the range untouched");
+    }
+
+    void every_k()
+    {
+        // longer than a group of 5, so deterministic_select recurses on its medians
+        const std::vector<int> values{4, 12, 4, 0, 7, 12, 3, 9, 4, 1, 11, 0, 6};
+        std::vector<int> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        for (int k = 0; k < static_cast<int>(values.size()); ++k)
+        {
+            check(quick_select(values.begin(), values.end(), k) == sorted[k], "quick_select matches the sorted array");
+            check(deterministic_select(values.begin(), values.end(), k) == sorted[k], "deterministic_select matches the sorted array");
+        }
+    }
+}
+
+
+int main()
+{
+    ends();
+    every_k();
+    std::cout << "selection_test: all passed" << std::endl;
+    return 0;
+}
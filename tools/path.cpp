@@ -1,47 +1,26 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <cstring>
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include "path.hpp"
+#include "task_pool.hpp"
 
 
 
 namespace pathlib {
 
 Path::Path(const std::string& the_path, char separator)
-	: sep{separator}
+	: sep{separator}, stat_cached{false}
 {
 	set_name_attributes(the_path);
-	stat(_path.c_str(), &st);
-}
-
-Path::Path(const Path& other)
-	: _path{other._path}, _name{other._name}, _extension{other._extension},
-	  _parent{other._parent}, sep{other.sep}
-{
-	set_name_attributes(other._path);
-	stat(_path.c_str(), &st);
-}
-
-Path& Path::operator=(const Path& other)
-{
-	if (this != &other)
-	{
-		_path = other._path;
-		_name = other._name;
-		_extension = other._extension;
-		_parent = other._parent;
-		sep = other.sep;
-
-		set_name_attributes(other._path);
-		stat(_path.c_str(), &st);
-	}
-	return *this;
 }
 
 bool Path::operator==(const Path& other) const
@@ -60,19 +39,26 @@ std::ostream& operator<<(std::ostream& os, const Path& p)
 	return os;
 }
 
+void Path::refresh()
+{
+	stat_cached = false;
+	status();
+}
+
 bool Path::is_file() const
 {
-	return S_ISREG(st.st_mode);
+	return S_ISREG(status().st_mode);
 }
 
 bool Path::is_dir() const
 {
-	return S_ISDIR(st.st_mode);
+	return S_ISDIR(status().st_mode);
 }
 
 bool Path::exists() const
 {
-	return is_dir() || is_file();
+	mode_t mode = status().st_mode;
+	return S_ISDIR(mode) || S_ISREG(mode);
 }
 
 const std::string& Path::path() const
@@ -80,21 +66,19 @@ const std::string& Path::path() const
 	return _path;
 }
 
-const std::string& Path::name() const
+string_view Path::name() const
 {
-	ensure_existence("pathlib::Path::get_name");
-	return _name;
+	return string_view{_path}.substr(name_start);
 }
 
-std::string Path::extension() const
+string_view Path::extension() const
 {
-	return _extension;
+	return string_view{_path}.substr(extension_start);
 }
 
-const std::string& Path::parent() const
+string_view Path::parent() const
 {
-	ensure_existence("pathlib::Path::get_parent");
-	return _parent;
+	return string_view{_path}.substr(0, name_start);
 }
 
 std::vector<Path> Path::collectdir() const
@@ -109,11 +93,7 @@ std::vector<Path> Path::collectdir() const
 	while ((entry = readdir(dir)) != NULL)
 	{
 		if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
-		{
-			std::ostringstream fmt;
-			fmt << _path << sep << entry->d_name;
-			result.push_back(Path{fmt.str(), sep});
-		}
+			result.push_back(Path{_path + sep + entry->d_name, sep});
 	}
 
 	closedir(dir);
@@ -133,6 +113,196 @@ std::ifstream Path::open() const
 }
 
 
+auto Path::map(bool sequential, bool will_need) const -> Path::Mapping
+{
+	ensure_file("pathlib::Path::map");
+	int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		throw PathError{"Error opening path: " + _path};
+
+	struct stat opened;
+	if (fstat(fd, &opened) != 0)
+	{
+		close(fd);
+		throw PathError{"Error opening path: " + _path};
+	}
+	if (opened.st_size == 0)
+	{
+		close(fd);
+		return Mapping{NULL, 0};
+	}
+
+	std::size_t length = opened.st_size;
+	void* region = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (region == MAP_FAILED)
+		throw PathError{"Error mapping path: " + _path};
+
+	if (sequential)
+		madvise(region, length, MADV_SEQUENTIAL);
+	if (will_need)
+		madvise(region, length, MADV_WILLNEED);
+	return Mapping{static_cast<const char*>(region), length};
+}
+
+
+/// <mapping implementation>
+Path::Mapping::Mapping(const char* the_bytes, std::size_t the_length)
+	: bytes{the_bytes}, length{the_length}
+{
+}
+
+Path::Mapping::Mapping(Path::Mapping&& other) noexcept
+	: bytes{other.bytes}, length{other.length}
+{
+	other.bytes = NULL;
+	other.length = 0;
+}
+
+auto Path::Mapping::operator=(Path::Mapping&& other) noexcept -> Path::Mapping&
+{
+	if (this != &other)
+	{
+		release();
+		bytes = other.bytes;
+		length = other.length;
+		other.bytes = NULL;
+		other.length = 0;
+	}
+	return *this;
+}
+
+Path::Mapping::~Mapping()
+{
+	release();
+}
+
+const char* Path::Mapping::data() const
+{
+	return bytes;
+}
+
+std::size_t Path::Mapping::size() const
+{
+	return length;
+}
+
+const char* Path::Mapping::begin() const
+{
+	return bytes;
+}
+
+const char* Path::Mapping::end() const
+{
+	return bytes + length;
+}
+
+string_view Path::Mapping::view() const
+{
+	return string_view{bytes, length};
+}
+
+auto Path::Mapping::records(char delimiter) const -> Path::Records
+{
+	return Records{begin(), end(), delimiter};
+}
+
+auto Path::Mapping::chunks(std::size_t count, char delimiter) const -> std::vector<Path::Records>
+{
+	std::vector<Records> result;
+	const char* first = begin();
+	for (std::size_t i = 1; i <= count && first != end(); ++i)
+	{
+		const char* last = end();
+		if (i < count)
+		{
+			// the boundary moves on to just after the end of the record it falls in
+			const char* boundary = std::max(first, begin() + length / count * i);
+			const void* found = memchr(boundary, delimiter, end() - boundary);
+			last = found == NULL ? end() : static_cast<const char*>(found) + 1;
+		}
+		result.push_back(Records{first, last, delimiter});
+		first = last;
+	}
+	return result;
+}
+
+void Path::Mapping::release()
+{
+	if (bytes != NULL)
+		munmap(const_cast<char*>(bytes), length);
+	bytes = NULL;
+	length = 0;
+}
+/// </mapping implementation>
+
+
+/// <records implementation>
+Path::Records::Records(const char* the_first, const char* the_last, char the_delimiter)
+	: first{the_first}, last{the_last}, delimiter{the_delimiter}
+{
+}
+
+auto Path::Records::begin() const -> Path::Records::iterator
+{
+	return iterator{first, last, delimiter};
+}
+
+auto Path::Records::end() const -> Path::Records::iterator
+{
+	return iterator{last, last, delimiter};
+}
+
+string_view Path::Records::bytes() const
+{
+	return string_view{first, static_cast<std::size_t>(last - first)};
+}
+
+Path::Records::iterator::iterator(const char* first, const char* the_last, char the_delimiter)
+	: current{first}, last{the_last}, delimiter{the_delimiter}
+{
+	find_end();
+}
+
+auto Path::Records::iterator::operator++() -> Path::Records::iterator&
+{
+	current = record_end == last ? last : record_end + 1;
+	find_end();
+	return *this;
+}
+
+auto Path::Records::iterator::operator++(int) -> Path::Records::iterator
+{
+	iterator state{*this};
+	operator++();
+	return state;
+}
+
+bool Path::Records::iterator::operator==(const Path::Records::iterator& other) const
+{
+	return current == other.current;
+}
+
+bool Path::Records::iterator::operator!=(const Path::Records::iterator& other) const
+{
+	return !operator==(other);
+}
+
+string_view Path::Records::iterator::operator*() const
+{
+	if (current == last)
+		throw PathError{"Path::Records::iterator::operator* - iterator already past end"};
+	return string_view{current, static_cast<std::size_t>(record_end - current)};
+}
+
+void Path::Records::iterator::find_end()
+{
+	const void* found = current == last ? NULL : memchr(current, delimiter, last - current);
+	record_end = found == NULL ? last : static_cast<const char*>(found);
+}
+/// </records implementation>
+
+
 /// <iterator implementation>
 auto Path::begin() const -> Path::iterator
 {
@@ -191,7 +361,7 @@ Path Path::iterator::operator*() const
 {
 	if (opened_dir == NULL || current == NULL)
 		throw PathError{"Path::iterator::operator* - current position invalid; iterator already past end"};
-	return Path{ref->parent() + current->d_name};
+	return Path{ref->_path + ref->sep + current->d_name, ref->sep};
 }
 
 struct dirent* const Path::iterator::operator->() const
@@ -203,65 +373,224 @@ struct dirent* const Path::iterator::operator->() const
 /// </iterator implementation>
 
 
-/// <private member functions>
-void Path::ensure_existence(const std::string& function_name) const
+/// <rglob implementation>
+namespace
 {
-	if (!exists())
-		throw PathError{function_name + " -- path does not exist:\n " + _path};
+	const int DIRECTORY_FLAGS = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+
+	bool is_dot_or_dotdot(const char* name)
+	{
+		return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+	}
+
+	bool has_suffix(const char* name, const std::string& suffix)
+	{
+		std::size_t length = strlen(name);
+		return length >= suffix.size() && memcmp(name + length - suffix.size(), suffix.data(), suffix.size()) == 0;
+	}
+
+	// readdir's d_type where the filesystem fills it in; an fstatat relative to the open directory otherwise
+	unsigned char entry_type(int dir_fd, const struct dirent* found)
+	{
+		if (found->d_type != DT_UNKNOWN)
+			return found->d_type;
+
+		struct stat st;
+		if (fstatat(dir_fd, found->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+			return DT_UNKNOWN;
+		if (S_ISDIR(st.st_mode))
+			return DT_DIR;
+		if (S_ISREG(st.st_mode))
+			return DT_REG;
+		return S_ISLNK(st.st_mode) ? DT_LNK : DT_UNKNOWN;
+	}
+
+	// opens the directory fd refers to as a stream, which takes ownership of fd; NULL (and fd closed) on failure
+	DIR* open_stream(int fd)
+	{
+		if (fd < 0)
+			return NULL;
+		DIR* dir = fdopendir(fd);
+		if (dir == NULL)
+			close(fd);
+		return dir;
+	}
+
+	struct ParallelWalk
+	{
+		const std::string& suffix;
+		const std::function<void(const pathlib::Path::Entry&)>& visit;
+		TaskPool& pool;
+		char sep;
+
+		// visits what is directly in dir (prefix being its path and a separator), then its subdirectories all at once
+		void walk(DIR* dir, const std::string& prefix) const
+		{
+			struct Closer
+			{
+				DIR* dir;
+				~Closer() { closedir(dir); }
+			} closer{dir};
+
+			int fd = dirfd(dir);
+			std::vector<std::string> subdirectories;
+			pathlib::Path::Entry entry;
+			entry.name_start = prefix.size();
+			struct dirent* found;
+			while ((found = readdir(dir)) != NULL)
+			{
+				if (is_dot_or_dotdot(found->d_name))
+					continue;
+
+				unsigned char type = entry_type(fd, found);
+				if (type == DT_DIR)
+					subdirectories.push_back(found->d_name);
+				if (has_suffix(found->d_name, suffix))
+				{
+					entry.path.assign(prefix);
+					entry.path += found->d_name;
+					entry.type = type;
+					visit(entry);
+				}
+			}
+
+			pool.parallel_for(subdirectories.size(), [&](int i) {
+				DIR* child = open_stream(openat(fd, subdirectories[i].c_str(), DIRECTORY_FLAGS));
+				if (child != NULL)
+					walk(child, prefix + subdirectories[i] + sep);
+			});
+		}
+	};
 }
 
-void Path::ensure_dir(const std::string& function_name) const
+
+bool Path::Entry::is_dir() const
 {
-	if (!is_dir())
-		throw PathError{function_name + " -- path does not point to a valid directory:\n" + _path};
+	return type == DT_DIR;
 }
 
-void Path::ensure_file(const std::string& function_name) const
+bool Path::Entry::is_file() const
 {
-	if (!is_file())
-		throw PathError{function_name + " -- path does not point to a valid file:\n " + _path};
+	return type == DT_REG;
 }
 
-char* Path::c_canonize_pathname(char* pathname)
+const char* Path::Entry::name() const
 {
-	unsigned int length = strlen(pathname) - 1;
-	if (pathname[length] == sep)
-		pathname[length] = '\0';
+	return path.c_str() + name_start;
+}
 
-	return pathname;
+auto Path::rglob(const std::string& suffix) const -> Path::Walker
+{
+	ensure_dir("pathlib::Path::rglob");
+	int root = ::open(_path.c_str(), DIRECTORY_FLAGS & ~O_NOFOLLOW);
+	if (root < 0)
+		throw PathError{"Error opening path: " + _path};
+	return Walker{root, _path + sep, suffix, sep};
 }
 
-void Path::set_name_attributes(const std::string& pathname)
+void Path::rglob(const std::string& suffix, const std::function<void(const Entry&)>& visit, TaskPool& pool) const
+{
+	ensure_dir("pathlib::Path::rglob");
+	DIR* root = open_stream(::open(_path.c_str(), DIRECTORY_FLAGS & ~O_NOFOLLOW));
+	if (root == NULL)
+		throw PathError{"Error opening path: " + _path};
+	ParallelWalk{suffix, visit, pool, sep}.walk(root, _path + sep);
+}
+
+Path::Walker::Walker(int root, const std::string& prefix, const std::string& the_suffix, char separator)
+	: buffer{prefix}, suffix{the_suffix}, sep{separator}
+{
+	DIR* dir = open_stream(root);
+	if (dir == NULL)
+		throw PathError{"Error opening path: " + prefix};
+	frames.push_back(Frame{dir, prefix.size()});
+}
+
+Path::Walker::~Walker()
 {
-	char* buf = new char[pathname.size() + 1];
-	strcpy(buf, pathname.c_str());
-	_path = std::string{c_canonize_pathname(buf)};
-	char* pch = strchr(buf, sep);
+	for (const Frame& frame : frames)
+		closedir(frame.dir);
+}
+
+bool Path::Walker::next(Entry& entry)
+{
+	while (!frames.empty())
+	{
+		Frame top = frames.back();
+		struct dirent* found = readdir(top.dir);
+		if (found == NULL)
+		{
+			closedir(top.dir);
+			frames.pop_back();
+			continue;
+		}
+		if (is_dot_or_dotdot(found->d_name))
+			continue;
+
+		unsigned char type = entry_type(dirfd(top.dir), found);
+		bool matches = has_suffix(found->d_name, suffix);
+		if (type != DT_DIR && !matches)
+			continue;
+
+		buffer.resize(top.prefix_length);
+		buffer += found->d_name;
+		std::size_t length = buffer.size();
+		if (type == DT_DIR)
+		{
+			DIR* child = open_stream(openat(dirfd(top.dir), found->d_name, DIRECTORY_FLAGS));
+			if (child != NULL)
+			{
+				buffer += sep;
+				frames.push_back(Frame{child, buffer.size()});
+			}
+		}
+		if (matches)
+		{
+			entry.path.assign(buffer, 0, length);
+			entry.name_start = top.prefix_length;
+			entry.type = type;
+			return true;
+		}
+	}
+	return false;
+}
+/// </rglob implementation>
 
-	while (pch != NULL)
+
+/// <private member functions>
+const struct stat& Path::status() const
+{
+	if (!stat_cached)
 	{
-		char* next = strchr(pch + 1, sep);
-		if (next == NULL)
-			break;
-		else
-			pch = next;
+		if (stat(_path.c_str(), &st) != 0)
+			st.st_mode = 0;
+		stat_cached = true;
 	}
+	return st;
+}
 
-	// remove leading '/' from file name
-	if (pch[0] == sep)
-		++pch;
-	_name = std::string{pch};
+void Path::ensure_dir(const std::string& function_name) const
+{
+	if (!is_dir())
+		throw PathError{function_name + " -- path does not point to a valid directory:\n" + _path};
+}
 
-	// get extension from file name
-	char* ext = strchr(pch, '.');
-	_extension = ext == NULL ? "" : std::string{ext};
+void Path::ensure_file(const std::string& function_name) const
+{
+	if (!is_file())
+		throw PathError{function_name + " -- path does not point to a valid file:\n " + _path};
+}
 
-	// remove leading '/' from parent path name;
-	// get parent path
-	pch[0] = '\0';
-	_parent = std::string{buf};
+void Path::set_name_attributes(const std::string& pathname)
+{
+	// drop one trailing separator, unless it is all there is
+	_path = pathname.size() > 1 && pathname.back() == sep ? pathname.substr(0, pathname.size() - 1) : pathname;
 
-	delete[] buf;
+	std::size_t last = _path.rfind(sep);
+	name_start = last == std::string::npos || _path.size() == 1 ? 0 : last + 1;
+	extension_start = _path.find('.', name_start);
+	if (extension_start == std::string::npos)
+		extension_start = _path.size();
 }
 /// </private member functions>
 
@@ -4,6 +4,12 @@
 // as such, it will only function correctly on UNIX environments.
 // It is essentially a modern C++ wrapper around a C/POSIX library.
 //
+// A Path is one string and two offsets into it; name(), extension() and parent() are views of that string,
+// and nothing touches the filesystem until metadata is asked for (is_file(), is_dir(), exists(), ...).
+// The first such call runs stat and caches the result until refresh(), so a Path that is only
+// built and filtered by name makes no system calls. Because of that cache, a Path shared between threads
+// needs one metadata call (or refresh()) before they share it.
+//
 // **Developed and tested using clang-703.0.31**
 //
 // author: Geoffrey Ko (2016)
@@ -17,30 +23,100 @@
 	throw std::runtime_error{"Windows not supported; UNIX-based OS compatibility only"};
 #endif
 
+#include <cstddef>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <functional>
 #include <iterator>
 #include <string>
 #include <vector>
 #include <dirent.h>
 #include <sys/stat.h>
 
+// name(), extension() and parent(), and a mapped file's bytes and records, are handed out as pathlib::string_view:
+// std::string_view wherever the library has it, and otherwise (under C++14) the small stand-in below,
+// which has the part of its interface a caller needs; <experimental/string_view> is gone from newer libraries.
+#if defined(__has_include)
+#if __has_include(<string_view>) && __cplusplus >= 201703L
+#include <string_view>
+#define PATHLIB_STD_STRING_VIEW
+#endif
+#endif
+
+
+class TaskPool;
 
 namespace pathlib {
 
+#ifdef PATHLIB_STD_STRING_VIEW
+using string_view = std::string_view;
+#else
+/* A read-only view of characters someone else owns: a pointer and a length, valid for as long as they are */
+class string_view
+{
+public:
+	static const std::size_t npos = static_cast<std::size_t>(-1);
+
+	string_view() : first{nullptr}, count{0} {}
+	string_view(const char* the_first, std::size_t the_count) : first{the_first}, count{the_count} {}
+	string_view(const char* s) : first{s}, count{std::strlen(s)} {}
+	string_view(const std::string& s) : first{s.data()}, count{s.size()} {}
+
+	const char* data() const { return first; }
+	std::size_t size() const { return count; }
+	std::size_t length() const { return count; }
+	bool empty() const { return count == 0; }
+
+	const char* begin() const { return first; }
+	const char* end() const { return first + count; }
+	char operator[](std::size_t i) const { return first[i]; }
+	char front() const { return first[0]; }
+	char back() const { return first[count - 1]; }
+
+	/* Throws std::out_of_range if position is past the end */
+	string_view substr(std::size_t position, std::size_t n = npos) const
+	{
+		if (position > count)
+			throw std::out_of_range{"pathlib::string_view::substr - position past end"};
+		return string_view{first + position, n < count - position ? n : count - position};
+	}
+
+	int compare(string_view other) const
+	{
+		int result = std::memcmp(first, other.first, count < other.count ? count : other.count);
+		if (result != 0)
+			return result;
+		return count < other.count ? -1 : count > other.count ? 1 : 0;
+	}
+
+	explicit operator std::string() const { return std::string{first, count}; }
+
+	friend bool operator==(string_view a, string_view b) { return a.count == b.count && a.compare(b) == 0; }
+	friend bool operator!=(string_view a, string_view b) { return !(a == b); }
+	friend bool operator<(string_view a, string_view b) { return a.compare(b) < 0; }
+	friend std::ostream& operator<<(std::ostream& os, string_view view) { return os.write(view.first, view.count); }
+
+private:
+	const char* first;
+	std::size_t count;
+};
+#endif
+
 class Path
 {
 public:
 	explicit Path(const std::string& the_path, char separator = '/');
-	Path(const Path& other);
 
 	// Operators
-	Path& operator=(const Path& other);
 	bool operator==(const Path& other) const;
 	bool operator!=(const Path& other) const;
 	friend std::ostream& operator<<(std::ostream& os, const Path& p);
 
+	/* Runs stat again now, so the metadata accessors see the filesystem as it is */
+	void refresh();
+
 	// Non-Modifying Member Functions
 	/* Returns true if this _path points to a file */
 	bool is_file() const;
@@ -54,16 +130,19 @@ public:
 	/* Returns the full path; e.g., the string it was contructed with */
 	const std::string& path() const;
 
-	/* Returns the name of the path only */
-	const std::string& name() const;
+	/* Returns the name of the path only.
+	 * Like extension() and parent(), this is worked out from the path alone, whether or not it exists,
+	 * and views path(): it is valid for as long as this Path is, and until it is assigned to.
+	 */
+	string_view name() const;
 
-	/* Returns the name of the extension of path, or empty string if there is none */
-	std::string extension() const;
+	/* Returns the name's extension, from its first '.', or an empty view if there is none */
+	string_view extension() const;
 
-	/* Returns the full parent directory of this path;
+	/* Returns the full parent directory of this path, separator included;
 	 * e.g., the directory that this lies in.
 	 */
-	const std::string& parent() const;
+	string_view parent() const;
 
 	/* Returns a std::vector of Path objects consisting of all items directly in this Path.
 	 * this must be a directory.
@@ -80,6 +159,47 @@ public:
 	 */
 	std::ifstream open() const;
 
+	class Mapping;
+
+	/* Maps the file Path points to into memory, read-only, and returns the mapping's owner.
+	 * sequential and will_need pass MADV_SEQUENTIAL (read-ahead, and pages dropped once read past)
+	 * and MADV_WILLNEED (start reading it all in now) to madvise.
+	 * If Path does not point to a file, or it cannot be mapped, throws PathError.
+	 */
+	Mapping map(bool sequential = true, bool will_need = false) const;
+
+
+	/* An item found by rglob: its full path, and its type straight from readdir (DT_DIR, DT_REG, DT_LNK, ...).
+	 * Only a filesystem that leaves d_type as DT_UNKNOWN costs an fstatat per item.
+	 */
+	struct Entry
+	{
+		std::string path;
+		std::size_t name_start;		// where the name begins in path
+		unsigned char type;
+
+		bool is_dir() const;
+		bool is_file() const;
+		const char* name() const;
+	};
+
+	class Walker;
+
+	/* Returns a Walker over every item under this directory, at any depth, whose name ends with suffix
+	 * (every item, if suffix is empty); e.g., rglob(".txt") is Python's rglob("*.txt").
+	 * Nothing is read until Walker::next is called. Symbolic links are listed but not followed,
+	 * and directories that cannot be opened are skipped.
+	 * this must be a directory.
+	 */
+	Walker rglob(const std::string& suffix = "") const;
+
+	/* Calls visit on every item rglob(suffix) would list, fanning out over subdirectories on pool;
+	 * visit is called from several threads at once, in no particular order, and must copy any Entry it keeps.
+	 * Returns once the whole tree is walked; if visit throws, rethrows the first exception.
+	 * this must be a directory.
+	 */
+	void rglob(const std::string& suffix, const std::function<void(const Entry&)>& visit, TaskPool& pool) const;
+
 
 	/* Path throws PathError exception */
 	class PathError : public std::exception
@@ -122,18 +242,129 @@ public:
 	};
 
 
+	/* Lists a tree depth-first, parents before their children, holding one open directory per level below the root.
+	 * Names are matched against the suffix before anything is copied,
+	 * so items that do not match cost no allocation, and neither do ones that do once Entry::path has grown.
+	 */
+	class Walker
+	{
+	public:
+		Walker(Walker&& other) = default;
+		Walker(const Walker& other) = delete;
+		Walker& operator=(const Walker& other) = delete;
+		~Walker();
+
+		/* Stores the next item in entry and returns true, or returns false once the tree is exhausted */
+		bool next(Entry& entry);
+
+		friend Walker Path::rglob(const std::string& suffix) const;
+
+	private:
+		Walker(int root, const std::string& prefix, const std::string& suffix, char separator);
+
+		struct Frame
+		{
+			DIR* dir;
+			std::size_t prefix_length;	// the length of this directory's path in buffer, separator included
+		};
+
+		std::vector<Frame> frames;
+		std::string buffer;		// the current item's path; every frame's path is a prefix of it
+		std::string suffix;
+		char sep;
+	};
+
+
+	/* The records of a range of bytes, each up to (and without) a delimiter; the last needs none.
+	 * Iterating yields a string_view per record, found with memchr as it goes, so no record is ever copied.
+	 */
+	class Records
+	{
+	public:
+		Records(const char* first, const char* last, char delimiter = '\n');
+
+		class iterator : public std::iterator<std::forward_iterator_tag, string_view>
+		{
+		public:
+			iterator(const char* first, const char* last, char delimiter);
+			auto operator++() -> iterator&;
+			auto operator++(int) -> iterator;
+			bool operator==(const iterator& other) const;
+			bool operator!=(const iterator& other) const;
+			string_view operator*() const;
+
+		private:
+			const char* current;
+			const char* record_end;		// the delimiter after current's record, or last
+			const char* last;
+			char delimiter;
+
+			void find_end();
+		};
+
+		auto begin() const -> iterator;
+		auto end() const -> iterator;
+
+		/* Returns the bytes this covers */
+		string_view bytes() const;
+
+	private:
+		const char* first;
+		const char* last;
+		char delimiter;
+	};
+
+	/* A file mapped read-only, unmapped when destroyed; moving one hands the mapping over.
+	 * An empty file maps to no bytes at all.
+	 */
+	class Mapping
+	{
+	public:
+		Mapping(Mapping&& other) noexcept;
+		Mapping& operator=(Mapping&& other) noexcept;
+		Mapping(const Mapping& other) = delete;
+		Mapping& operator=(const Mapping& other) = delete;
+		~Mapping();
+
+		const char* data() const;
+		std::size_t size() const;
+		const char* begin() const;
+		const char* end() const;
+		string_view view() const;
+
+		/* Returns the file's records; records() are its lines */
+		Records records(char delimiter = '\n') const;
+
+		/* Splits the file into at most count ranges of about equal size, each ending just after a delimiter
+		 * (or at the end of the file), so that every record lies whole in one of them; e.g., one per thread.
+		 */
+		std::vector<Records> chunks(std::size_t count, char delimiter = '\n') const;
+
+		friend Mapping Path::map(bool sequential, bool will_need) const;
+
+	private:
+		Mapping(const char* the_bytes, std::size_t the_length);
+
+		const char* bytes;
+		std::size_t length;
+
+		void release();
+	};
+
+
 private:
 	std::string _path;
-	std::string _name;
-	std::string _extension;
-	std::string _parent;
+	std::size_t name_start;
+	std::size_t extension_start;	// _path.size() when the name has no extension
 	char sep;
-	struct stat st;
+	mutable struct stat st;
+	mutable bool stat_cached;
+
+	/* Returns the cached stat of _path, running it on first use; st_mode is 0 if the path does not exist */
+	const struct stat& status() const;
 
-	void ensure_existence(const std::string& function_name) const;
 	void ensure_dir(const std::string& function_name) const;
 	void ensure_file(const std::string& function_name) const;
-	char* c_canonize_pathname(char* pathname);
 	void set_name_attributes(const std::string& pathname);
 };
 
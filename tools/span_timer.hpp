@@ -0,0 +1,383 @@
+// This header defines spans - nanosecond timers for hot paths, which record into latency histograms.
+//
+// TIMED_SPAN("name"); times the rest of the enclosing scope, and records it under name.
+// Spans are compiled in only when SPAN_TIMER_ENABLE is defined (e.g. -DSPAN_TIMER_ENABLE);
+// otherwise TIMED_SPAN expands to nothing, and instrumented code is exactly what it would be without it.
+//
+// ns_clock reads std::chrono::steady_clock, or with SPAN_TIMER_RDTSC defined (on x86) the time-stamp counter,
+// which it calibrates against steady_clock once, the first time it converts ticks (calibrate() does so up front).
+//
+// Every span site keeps one LatencyHistogram per thread that passes through it. A thread only ever records
+// into its own, with relaxed atomic loads and stores, so recording takes no lock and no two threads write the
+// same counters; a thread only locks the site the first time it passes, to add its histogram.
+// Histograms outlive their threads.
+// LatencyHistogram buckets are log-linear, like an HDR histogram's: values under 32 ns have a bucket each,
+// and every power of two above is split into 32, so a percentile is within 1/32 (about 3%) of the true value.
+//
+// span_report(os) prints every site's count, mean, percentiles and maximum, merging the histograms of all
+// its threads - and of sites with the same name, such as the instantiations of a template's member.
+#ifndef SPAN_TIMER_HPP
+#define SPAN_TIMER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(SPAN_TIMER_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define SPAN_TIMER_HAS_RDTSC
+#endif
+
+
+class ns_clock
+{
+public:
+	/* Returns the current time, in ticks */
+	static uint64_t ticks();
+
+	/* Converts a number of ticks to nanoseconds */
+	static uint64_t to_ns(uint64_t ticks);
+
+	/* With the time-stamp counter, measures its frequency now (taking about 10 ms) rather than on first use */
+	static void calibrate();
+
+
+private:
+	static double ns_per_tick();
+};
+
+
+// What a LatencyHistogram (or several, merged) holds at one time
+struct SpanStats
+{
+	uint64_t count = 0;
+	uint64_t total_ns = 0;
+	uint64_t max_ns = 0;
+	std::vector<uint64_t> buckets;
+
+	double mean_ns() const;
+
+	/* Returns the smallest value that at least fraction (in [0, 1]) of the values are at most, up to the bucket */
+	uint64_t percentile(double fraction) const;
+
+	void merge(const SpanStats& other);
+};
+
+
+// Written by one thread, read by any
+class LatencyHistogram
+{
+public:
+	static const int SUB_BUCKET_BITS = 5;
+	static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static const int BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+	LatencyHistogram();
+	LatencyHistogram(const LatencyHistogram& other) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram& other) = delete;
+
+	/* Only the owning thread may record */
+	void record(uint64_t ns);
+
+	SpanStats stats() const;
+
+	/* Returns the bucket holding ns, and the largest value in a bucket */
+	static int bucket(uint64_t ns);
+	static uint64_t highest_in(int bucket);
+
+
+private:
+	std::atomic<uint64_t> counts[BUCKETS];
+	std::atomic<uint64_t> total;
+	std::atomic<uint64_t> max;
+
+	static void add(std::atomic<uint64_t>& counter, uint64_t value);
+};
+
+
+// One place in the code that is timed
+class SpanSite
+{
+public:
+	explicit SpanSite(const char* the_name);
+	~SpanSite();
+	SpanSite(const SpanSite& other) = delete;
+	SpanSite& operator=(const SpanSite& other) = delete;
+
+	const char* name() const;
+
+	/* Adds a histogram for the calling thread to record into; TIMED_SPAN calls it once per thread */
+	LatencyHistogram& add_thread();
+
+	/* Returns the merged stats of every thread's histogram */
+	SpanStats stats() const;
+
+	/* Returns every site constructed and not yet destroyed; the registry's lock must be held to read it */
+	static std::vector<SpanSite*>& registry();
+	static std::mutex& registry_lock();
+
+
+private:
+	const char* site_name;
+	mutable std::mutex lock;
+	std::deque<LatencyHistogram> histograms;
+};
+
+
+// Records the time from its construction to its destruction
+class ScopedSpan
+{
+public:
+	explicit ScopedSpan(LatencyHistogram& the_histogram) : histogram(the_histogram), started{ns_clock::ticks()} {}
+	~ScopedSpan() { histogram.record(ns_clock::to_ns(ns_clock::ticks() - started)); }
+
+	ScopedSpan(const ScopedSpan& other) = delete;
+	ScopedSpan& operator=(const ScopedSpan& other) = delete;
+
+
+private:
+	LatencyHistogram& histogram;
+	uint64_t started;
+};
+
+
+/* Prints one line per span name: count, mean, p50, p90, p99, p99.9 and max, in ns; prints nothing if no span ran */
+void span_report(std::ostream& os);
+
+
+#define SPAN_TIMER_CONCAT_(a, b) a##b
+#define SPAN_TIMER_CONCAT(a, b) SPAN_TIMER_CONCAT_(a, b)
+
+#ifdef SPAN_TIMER_ENABLE
+#define TIMED_SPAN(name) \
+	static SpanSite SPAN_TIMER_CONCAT(span_site_, __LINE__){name}; \
+	static thread_local LatencyHistogram& SPAN_TIMER_CONCAT(span_histogram_, __LINE__) = SPAN_TIMER_CONCAT(span_site_, __LINE__).add_thread(); \
+	ScopedSpan SPAN_TIMER_CONCAT(span_, __LINE__){SPAN_TIMER_CONCAT(span_histogram_, __LINE__)}
+#else
+#define TIMED_SPAN(name) static_cast<void>(0)
+#endif
+
+
+
+inline uint64_t ns_clock::ticks()
+{
+#ifdef SPAN_TIMER_HAS_RDTSC
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline uint64_t ns_clock::to_ns(uint64_t ticks)
+{
+#ifdef SPAN_TIMER_HAS_RDTSC
+	return static_cast<uint64_t>(ticks * ns_per_tick());
+#else
+	return ticks;
+#endif
+}
+
+inline void ns_clock::calibrate()
+{
+	ns_per_tick();
+}
+
+inline double ns_clock::ns_per_tick()
+{
+#ifdef SPAN_TIMER_HAS_RDTSC
+	static const double ratio = [] {
+		typedef std::chrono::steady_clock clock;
+		clock::time_point start = clock::now();
+		uint64_t first = __rdtsc();
+		while (clock::now() - start < std::chrono::milliseconds{10})
+			;
+		uint64_t last = __rdtsc();
+		double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+		return last == first ? 1.0 : elapsed / (last - first);
+	}();
+	return ratio;
+#else
+	return 1.0;
+#endif
+}
+
+
+inline double SpanStats::mean_ns() const
+{
+	return count == 0 ? 0 : total_ns / static_cast<double>(count);
+}
+
+inline uint64_t SpanStats::percentile(double fraction) const
+{
+	if (count == 0)
+		return 0;
+
+	uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * count)));
+	uint64_t seen = 0;
+	for (std::size_t i = 0; i < buckets.size(); ++i)
+	{
+		seen += buckets[i];
+		if (seen >= rank)
+			return std::min(LatencyHistogram::highest_in(i), max_ns);
+	}
+	return max_ns;
+}
+
+inline void SpanStats::merge(const SpanStats& other)
+{
+	count += other.count;
+	total_ns += other.total_ns;
+	max_ns = std::max(max_ns, other.max_ns);
+	buckets.resize(std::max(buckets.size(), other.buckets.size()));
+	for (std::size_t i = 0; i < other.buckets.size(); ++i)
+		buckets[i] += other.buckets[i];
+}
+
+
+inline LatencyHistogram::LatencyHistogram()
+	: total{0}, max{0}
+{
+	for (std::atomic<uint64_t>& count : counts)
+		count.store(0, std::memory_order_relaxed);
+}
+
+inline void LatencyHistogram::record(uint64_t ns)
+{
+	add(counts[bucket(ns)], 1);
+	add(total, ns);
+	if (ns > max.load(std::memory_order_relaxed))
+		max.store(ns, std::memory_order_relaxed);
+}
+
+inline SpanStats LatencyHistogram::stats() const
+{
+	SpanStats result;
+	result.buckets.resize(BUCKETS);
+	for (int i = 0; i < BUCKETS; ++i)
+	{
+		result.buckets[i] = counts[i].load(std::memory_order_relaxed);
+		result.count += result.buckets[i];
+	}
+	result.total_ns = total.load(std::memory_order_relaxed);
+	result.max_ns = max.load(std::memory_order_relaxed);
+	return result;
+}
+
+inline int LatencyHistogram::bucket(uint64_t ns)
+{
+	if (ns < SUB_BUCKETS)
+		return ns;
+
+#if defined(__GNUC__) || defined(__clang__)
+	int magnitude = 63 - __builtin_clzll(ns);
+#else
+	int magnitude = 63;
+	while ((ns >> magnitude) == 0)
+		--magnitude;
+#endif
+	int shift = magnitude - SUB_BUCKET_BITS;
+	return SUB_BUCKETS + shift * SUB_BUCKETS + static_cast<int>((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+inline uint64_t LatencyHistogram::highest_in(int bucket)
+{
+	if (bucket < SUB_BUCKETS)
+		return bucket;
+
+	int shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+	uint64_t lowest = static_cast<uint64_t>(SUB_BUCKETS + (bucket - SUB_BUCKETS) % SUB_BUCKETS) << shift;
+	return lowest + ((uint64_t{1} << shift) - 1);
+}
+
+inline void LatencyHistogram::add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+	// the owning thread is the only writer, so a plain read-modify-write is enough; readers see whole values
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+
+inline SpanSite::SpanSite(const char* the_name)
+	: site_name{the_name}
+{
+	std::lock_guard<std::mutex> guard{registry_lock()};
+	registry().push_back(this);
+}
+
+inline SpanSite::~SpanSite()
+{
+	std::lock_guard<std::mutex> guard{registry_lock()};
+	std::vector<SpanSite*>& sites = registry();
+	sites.erase(std::remove(sites.begin(), sites.end(), this), sites.end());
+}
+
+inline const char* SpanSite::name() const
+{
+	return site_name;
+}
+
+inline LatencyHistogram& SpanSite::add_thread()
+{
+	std::lock_guard<std::mutex> guard{lock};
+	histograms.emplace_back();
+	return histograms.back();
+}
+
+inline SpanStats SpanSite::stats() const
+{
+	std::lock_guard<std::mutex> guard{lock};
+	SpanStats result;
+	for (const LatencyHistogram& histogram : histograms)
+		result.merge(histogram.stats());
+	return result;
+}
+
+inline std::vector<SpanSite*>& SpanSite::registry()
+{
+	static std::vector<SpanSite*> sites;
+	return sites;
+}
+
+inline std::mutex& SpanSite::registry_lock()
+{
+	static std::mutex registry_mutex;
+	return registry_mutex;
+}
+
+
+inline void span_report(std::ostream& os)
+{
+	std::map<std::string, SpanStats> by_name;
+	{
+		std::lock_guard<std::mutex> guard{SpanSite::registry_lock()};
+		for (const SpanSite* site : SpanSite::registry())
+			by_name[site->name()].merge(site->stats());
+	}
+	if (by_name.empty())
+		return;
+
+	std::ios::fmtflags flags = os.flags();
+	os << std::left << std::setw(40) << "span" << std::right << std::setw(12) << "count" << std::setw(12) << "mean ns";
+	os << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "p99.9";
+	os << std::setw(12) << "max" << std::endl;
+	for (const auto& pair : by_name)
+	{
+		const SpanStats& stats = pair.second;
+		os << std::left << std::setw(40) << pair.first << std::right << std::setw(12) << stats.count;
+		os << std::setw(12) << std::fixed << std::setprecision(1) << stats.mean_ns();
+		os << std::setw(10) << stats.percentile(0.5) << std::setw(10) << stats.percentile(0.9);
+		os << std::setw(10) << stats.percentile(0.99) << std::setw(10) << stats.percentile(0.999);
+		os << std::setw(12) << stats.max_ns << std::endl;
+	}
+	os.flags(flags);
+}
+
+#endif // SPAN_TIMER_HPP
@@ -0,0 +1,190 @@
+// This header defines TaskPool - a fixed set of worker threads that run queued tasks.
+//
+// submit() queues one task and returns a std::future for its result.
+// parallel_for(n, f) runs f(0), ..., f(n - 1) over the workers *and* the calling thread,
+// and returns once all of them have finished (rethrowing the first exception any of them threw).
+// The calling thread keeps claiming indices itself while it waits, so parallel_for may be called
+// from inside a task without deadlocking, even when every worker is busy.
+//
+// TaskPool::shared() is a process-wide pool with one worker per hardware thread,
+// which the parallel algorithms use unless they are handed a pool of their own.
+#ifndef TASK_POOL_HPP
+#define TASK_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class TaskPool
+{
+public:
+	/* Starts threads workers; 0 starts one per hardware thread */
+	explicit TaskPool(int threads = 0);
+	TaskPool(const TaskPool& other) = delete;
+	TaskPool& operator=(const TaskPool& other) = delete;
+
+	/* Runs every task already queued, then joins the workers */
+	~TaskPool();
+
+	int threads() const;
+
+	/* Queues task() to run on a worker, and returns a future for its result */
+	template <typename Function>
+	auto submit(Function task) -> std::future<decltype(task())>;
+
+	/* Calls f(i) for every i in [0, n), spread over the workers and the calling thread.
+	 * Returns once every call has returned; if any threw, rethrows the first exception.
+	 */
+	template <typename Function>
+	void parallel_for(int n, Function f);
+
+	/* Returns the process-wide pool */
+	static TaskPool& shared();
+
+
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex lock;
+	std::condition_variable available;
+	bool stopping;
+
+	void run_worker();
+	void enqueue(std::function<void()> task);
+};
+
+
+
+inline TaskPool::TaskPool(int threads)
+	: stopping{false}
+{
+	if (threads <= 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (int i = 0; i < threads; ++i)
+		workers.emplace_back([this] { run_worker(); });
+}
+
+inline TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> guard{lock};
+		stopping = true;
+	}
+	available.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+inline int TaskPool::threads() const
+{
+	return workers.size();
+}
+
+template <typename Function>
+auto TaskPool::submit(Function task) -> std::future<decltype(task())>
+{
+	// std::function needs a copyable target, so the packaged_task is shared
+	auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::move(task));
+	std::future<decltype(task())> result = packaged->get_future();
+	enqueue([packaged] { (*packaged)(); });
+	return result;
+}
+
+template <typename Function>
+void TaskPool::parallel_for(int n, Function f)
+{
+	if (n <= 0)
+		return;
+
+	// helpers that only start after every index is claimed find nothing left to do;
+	// they share the state, so it outlives this call if need be
+	struct State
+	{
+		State(int the_n, Function the_f) : n{the_n}, f(std::move(the_f)), next{0}, finished{0} {}
+
+		int n;
+		Function f;
+		std::atomic<int> next;
+		std::atomic<int> finished;
+		std::mutex lock;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+	auto state = std::make_shared<State>(n, std::move(f));
+
+	auto work = [state] {
+		for (int i = state->next++; i < state->n; i = state->next++)
+		{
+			try
+			{
+				state->f(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard{state->lock};
+				if (!state->error)
+					state->error = std::current_exception();
+			}
+
+			if (++state->finished == state->n)
+			{
+				std::lock_guard<std::mutex> guard{state->lock};
+				state->done.notify_all();
+			}
+		}
+	};
+
+	for (int i = 0, helpers = std::min(n - 1, threads()); i < helpers; ++i)
+		enqueue(work);
+	work();
+
+	std::unique_lock<std::mutex> guard{state->lock};
+	state->done.wait(guard, [&state] { return state->finished == state->n; });
+	if (state->error)
+		std::rethrow_exception(state->error);
+}
+
+inline TaskPool& TaskPool::shared()
+{
+	static TaskPool pool;
+	return pool;
+}
+
+inline void TaskPool::run_worker()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> guard{lock};
+			available.wait(guard, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+				return;
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+inline void TaskPool::enqueue(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> guard{lock};
+		tasks.push_back(std::move(task));
+	}
+	available.notify_one();
+}
+
+#endif // TASK_POOL_HPP
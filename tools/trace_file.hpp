@@ -0,0 +1,389 @@
+// This header defines a compact binary trace format for the simulators' inputs, and the tools to read and write it.
+//
+// A trace is a header followed by sections, each a section header followed by count 32-bit ints:
+//   | "TRCE" | version | byte order mark | sections | kind | reserved | count (64-bit) | int32 x count | kind | ...
+// Every field is 4-byte aligned, so a mapped trace's sections are read in place, as int32_t arrays.
+// What the sections mean (and their kinds) is up to each simulator.
+// Traces are written in the host's byte order; a reader rejects a trace with the wrong byte order mark.
+//
+// MappedFile maps a whole file read-only (or reads it into memory, where mmap is not available).
+// TraceReader views the sections of a mapped trace without copying them; TraceWriter writes a trace.
+// parse_int() and parse_ints() are a from_chars-style parser for the legacy whitespace-separated text inputs.
+#ifndef TRACE_FILE_HPP
+#define TRACE_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRACE_FILE_HAS_MMAP
+#endif
+
+
+class TraceError : public std::runtime_error
+{
+public:
+	explicit TraceError(const std::string& what) : std::runtime_error{what} {}
+};
+
+
+class MappedFile
+{
+public:
+	/* Throws a TraceError if the file cannot be opened */
+	explicit MappedFile(const std::string& path);
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+	~MappedFile();
+
+	const char* data() const;
+	std::size_t size() const;
+	const char* begin() const;
+	const char* end() const;
+
+
+private:
+	const char* bytes;
+	std::size_t length;
+	bool mapped;
+	std::vector<char> buffer;	// the file's contents, if it is not mapped
+
+	void release();
+};
+
+
+struct TraceSection
+{
+	uint32_t kind;
+	const int32_t* data;
+	std::size_t size;
+
+	const int32_t* begin() const { return data; }
+	const int32_t* end() const { return data + size; }
+};
+
+
+class TraceReader
+{
+public:
+	/* Maps the trace at path; throws a TraceError if it cannot be opened or is not a well-formed trace */
+	explicit TraceReader(const std::string& path);
+
+	std::size_t sections() const;
+	const TraceSection& section(std::size_t i) const;
+
+	/* Returns the first section of the given kind, or nullptr if there is none */
+	const TraceSection* find(uint32_t kind) const;
+
+
+private:
+	MappedFile file;
+	std::vector<TraceSection> views;
+};
+
+
+class TraceWriter
+{
+public:
+	/* Appends a section of values[0, count) */
+	void add_section(uint32_t kind, const int32_t* values, std::size_t count);
+	void add_section(uint32_t kind, const std::vector<int32_t>& values);
+
+	/* Writes the trace to path; throws a TraceError if it cannot */
+	void write(const std::string& path) const;
+
+
+private:
+	std::vector<std::pair<uint32_t, std::vector<int32_t>>> pending;
+};
+
+
+/* Parses a (possibly negative) decimal int at the start of [first, last) into value, like std::from_chars.
+ * Returns the end of the number, or first if [first, last) does not start with one (value is then unchanged).
+ */
+const char* parse_int(const char* first, const char* last, int32_t& value);
+
+/* Appends to values every int of the line starting at first, skipping spaces and tabs between them.
+ * Stops at the end of the line, or at the first character that is neither blank nor part of a number;
+ * returns where it stopped.
+ */
+const char* parse_ints(const char* first, const char* last, std::vector<int32_t>& values);
+
+/* Returns the start of the line after the one containing first, or last */
+const char* next_line(const char* first, const char* last);
+
+
+
+namespace
+{
+	const char _TRACE_MAGIC[4] = {'T', 'R', 'C', 'E'};
+	const uint32_t _TRACE_VERSION = 1;
+	const uint32_t _TRACE_BYTE_ORDER_MARK = 0x01020304;
+
+	struct _TraceHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t byte_order;
+		uint32_t sections;
+	};
+
+	struct _TraceSectionHeader
+	{
+		uint32_t kind;
+		uint32_t reserved;
+		uint64_t count;
+	};
+}
+
+
+
+inline MappedFile::MappedFile(const std::string& path)
+	: bytes{nullptr}, length{0}, mapped{false}
+{
+#ifdef TRACE_FILE_HAS_MMAP
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		throw TraceError{"MappedFile - cannot open " + path};
+
+	struct stat info = {};
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		void* region = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (region != MAP_FAILED)
+		{
+			madvise(region, info.st_size, MADV_SEQUENTIAL);
+			bytes = static_cast<const char*>(region);
+			length = info.st_size;
+			mapped = true;
+		}
+	}
+	close(fd);
+	if (mapped || info.st_size == 0)
+		return;
+#endif
+
+	std::ifstream in{path, std::ios::binary};
+	if (!in)
+		throw TraceError{"MappedFile - cannot open " + path};
+	in.seekg(0, std::ios::end);
+	buffer.resize(static_cast<std::size_t>(in.tellg()));
+	in.seekg(0);
+	in.read(buffer.data(), buffer.size());
+	bytes = buffer.data();
+	length = buffer.size();
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+	: bytes{other.bytes}, length{other.length}, mapped{other.mapped}, buffer(std::move(other.buffer))
+{
+	other.bytes = nullptr;
+	other.length = 0;
+	other.mapped = false;
+}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		bytes = other.bytes;
+		length = other.length;
+		mapped = other.mapped;
+		buffer = std::move(other.buffer);
+		other.bytes = nullptr;
+		other.length = 0;
+		other.mapped = false;
+	}
+	return *this;
+}
+
+inline MappedFile::~MappedFile()
+{
+	release();
+}
+
+inline const char* MappedFile::data() const
+{
+	return bytes;
+}
+
+inline std::size_t MappedFile::size() const
+{
+	return length;
+}
+
+inline const char* MappedFile::begin() const
+{
+	return bytes;
+}
+
+inline const char* MappedFile::end() const
+{
+	return bytes + length;
+}
+
+inline void MappedFile::release()
+{
+#ifdef TRACE_FILE_HAS_MMAP
+	if (mapped)
+		munmap(const_cast<char*>(bytes), length);
+#endif
+	bytes = nullptr;
+	length = 0;
+	mapped = false;
+}
+
+
+
+inline TraceReader::TraceReader(const std::string& path)
+	: file{path}
+{
+	_TraceHeader header;
+	if (file.size() < sizeof(header))
+		throw TraceError{"TraceReader - " + path + " is too short to be a trace"};
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (std::memcmp(header.magic, _TRACE_MAGIC, sizeof(_TRACE_MAGIC)) != 0)
+		throw TraceError{"TraceReader - " + path + " is not a trace"};
+	if (header.version != _TRACE_VERSION)
+		throw TraceError{"TraceReader - " + path + " has an unknown trace version"};
+	if (header.byte_order != _TRACE_BYTE_ORDER_MARK)
+		throw TraceError{"TraceReader - " + path + " was written with another byte order"};
+
+	std::size_t position = sizeof(header);
+	for (uint32_t i = 0; i < header.sections; ++i)
+	{
+		_TraceSectionHeader section;
+		if (file.size() - position < sizeof(section))
+			throw TraceError{"TraceReader - " + path + " is truncated"};
+		std::memcpy(&section, file.data() + position, sizeof(section));
+		position += sizeof(section);
+
+		if (section.count > (file.size() - position) / sizeof(int32_t))
+			throw TraceError{"TraceReader - " + path + " is truncated"};
+		// the file starts page-aligned (or new-aligned), and every field before this is a multiple of 4 bytes
+		const int32_t* values = reinterpret_cast<const int32_t*>(file.data() + position);
+		views.push_back(TraceSection{section.kind, values, static_cast<std::size_t>(section.count)});
+		position += section.count * sizeof(int32_t);
+	}
+}
+
+inline std::size_t TraceReader::sections() const
+{
+	return views.size();
+}
+
+inline const TraceSection& TraceReader::section(std::size_t i) const
+{
+	if (i >= views.size())
+		throw std::out_of_range{"TraceReader::section - index out of range"};
+	return views[i];
+}
+
+inline const TraceSection* TraceReader::find(uint32_t kind) const
+{
+	for (const TraceSection& view : views)
+		if (view.kind == kind)
+			return &view;
+	return nullptr;
+}
+
+
+
+inline void TraceWriter::add_section(uint32_t kind, const int32_t* values, std::size_t count)
+{
+	pending.emplace_back(kind, std::vector<int32_t>(values, values + count));
+}
+
+inline void TraceWriter::add_section(uint32_t kind, const std::vector<int32_t>& values)
+{
+	pending.emplace_back(kind, values);
+}
+
+inline void TraceWriter::write(const std::string& path) const
+{
+	std::ofstream out{path, std::ios::binary | std::ios::trunc};
+	if (!out)
+		throw TraceError{"TraceWriter - cannot open " + path};
+
+	_TraceHeader header;
+	std::memcpy(header.magic, _TRACE_MAGIC, sizeof(_TRACE_MAGIC));
+	header.version = _TRACE_VERSION;
+	header.byte_order = _TRACE_BYTE_ORDER_MARK;
+	header.sections = static_cast<uint32_t>(pending.size());
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	for (const auto& section : pending)
+	{
+		_TraceSectionHeader section_header{section.first, 0, section.second.size()};
+		out.write(reinterpret_cast<const char*>(&section_header), sizeof(section_header));
+		out.write(reinterpret_cast<const char*>(section.second.data()), section.second.size() * sizeof(int32_t));
+	}
+
+	if (!out.flush())
+		throw TraceError{"TraceWriter - cannot write " + path};
+}
+
+
+
+inline const char* parse_int(const char* first, const char* last, int32_t& value)
+{
+	const char* cursor = first;
+	bool negative = cursor != last && *cursor == '-';
+	if (negative)
+		++cursor;
+	if (cursor == last || *cursor < '0' || *cursor > '9')
+		return first;
+
+	// accumulate negatively, so that INT32_MIN parses without overflow
+	int64_t result = 0;
+	for (; cursor != last && *cursor >= '0' && *cursor <= '9'; ++cursor)
+	{
+		result = result * 10 - (*cursor - '0');
+		if (result < INT32_MIN)
+			return first;
+	}
+	if (!negative && result == INT32_MIN)
+		return first;
+
+	value = static_cast<int32_t>(negative ? result : -result);
+	return cursor;
+}
+
+inline const char* parse_ints(const char* first, const char* last, std::vector<int32_t>& values)
+{
+	while (true)
+	{
+		while (first != last && (*first == ' ' || *first == '\t' || *first == '\r'))
+			++first;
+
+		int32_t value;
+		const char* end = parse_int(first, last, value);
+		if (end == first)
+			return first;
+		values.push_back(value);
+		first = end;
+	}
+}
+
+inline const char* next_line(const char* first, const char* last)
+{
+	if (first == last)
+		return last;
+	const char* newline = static_cast<const char*>(std::memchr(first, '\n', last - first));
+	return newline == nullptr ? last : newline + 1;
+}
+
+#endif // TRACE_FILE_HPP